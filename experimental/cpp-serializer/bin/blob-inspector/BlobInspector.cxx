@@ -3,19 +3,26 @@
 
 #include <iostream>
 #include <sstream>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
 
 #include "proton/codec.h"
 #include "proton/proton_wrapper.h"
 
 #include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
 
+#include "amqp/AMQPHeader.h"
 #include "amqp/CompositeFactory.h"
+#include "amqp/wire/Verifier.h"
 #include "amqp/schema/described-types/Envelope.h"
 
 /******************************************************************************/
 
 BlobInspector::BlobInspector (CordaBytes & cb_)
     : m_data { pn_data (cb_.size()) }
+    , m_body { cb_.bytes() }
+    , m_size { cb_.size() }
 {
     // returns how many bytes we processed which right now we don't care
     // about but I assume there is a case where it doesn't process the
@@ -26,23 +33,146 @@ BlobInspector::BlobInspector (CordaBytes & cb_)
 
 /******************************************************************************/
 
-std::string
-BlobInspector::dump() {
+BlobInspector::BlobInspector (const char * blob_, size_t size_)
+    : m_data { nullptr }
+    , m_body { nullptr }
+    , m_size { 0 }
+{
+    const size_t header = amqp::AMQP_HEADER.size() + 1;
+
+    if (size_ < header
+        || !std::equal (amqp::AMQP_HEADER.begin(), amqp::AMQP_HEADER.end(), blob_))
+    {
+        throw std::runtime_error ("Not a Corda stream");
+    }
+
+    if (blob_[header - 1] != amqp::DATA_AND_STOP) {
+        throw std::runtime_error ("Unsupported encoding");
+    }
+
+    m_body = blob_ + header;
+    m_size = size_ - header;
+    m_data = pn_data (m_size);
+
+    auto size = static_cast<ssize_t>(size_ - header);
+
+    if (pn_data_decode (m_data, blob_ + header, size) != size) {
+        pn_data_free (m_data);
+        throw std::runtime_error ("Malformed blob");
+    }
+}
+
+/******************************************************************************/
+
+BlobInspector::~BlobInspector() {
+    pn_data_free (m_data);
+}
+
+/******************************************************************************/
+
+std::unique_ptr<amqp::internal::schema::Envelope>
+BlobInspector::envelope (pn_data_t * data_) {
     std::unique_ptr<amqp::internal::schema::Envelope> envelope;
 
-    if (pn_data_is_described (m_data)) {
-        proton::auto_enter p (m_data);
+    if (pn_data_is_described (data_)) {
+        proton::auto_enter p (data_);
 
-        auto a = pn_data_get_ulong(m_data);
+        auto a = pn_data_get_ulong(data_);
 
         envelope.reset (
                 dynamic_cast<amqp::internal::schema::Envelope *> (
-                        amqp::internal::AMQPDescriptorRegistory[a]->build(m_data).release()));
+                        amqp::internal::AMQPDescriptorRegistory[a]->build(data_).release()));
+    }
+
+    return envelope;
+}
+
+/******************************************************************************/
+
+void
+BlobInspector::expect (CordaBytes & cb_) {
+    auto data = pn_data (cb_.size());
+
+    pn_data_decode (data, cb_.bytes(), cb_.size());
+
+    m_expected = envelope (data);
+
+    pn_data_free (data);
+
+    if (!m_expected) {
+        throw std::runtime_error ("Expected blob has no envelope");
     }
+}
+
+/******************************************************************************/
+
+void
+BlobInspector::trust() {
+    m_trusted = true;
+}
+
+/******************************************************************************/
+
+void
+BlobInspector::share (std::shared_ptr<amqp::internal::Mappings> mappings_) {
+    m_mappings = std::move (mappings_);
+}
+
+/******************************************************************************/
+
+std::string
+BlobInspector::dump() {
+    if (m_trusted) {
+        return read();
+    }
+
+    try {
+        return read();
+    } catch (const std::runtime_error & e) {
+        // The checked readers know what went wrong but not where, proton
+        // doesn't tell us, so on failure only pay for a pass of the wire
+        // verifier over the whole blob to find the byte to blame
+        std::vector<char> blob (amqp::AMQP_HEADER.begin(), amqp::AMQP_HEADER.end());
+        blob.push_back (amqp::DATA_AND_STOP);
+        blob.insert (blob.end(), m_body, m_body + m_size);
+
+        auto verdict = amqp::internal::wire::verify (blob.data(), blob.size());
+
+        if (verdict.ok) {
+            throw;
+        }
+
+        throw std::runtime_error (
+            std::string (e.what())
+                + " (offset " + std::to_string (verdict.offset)
+                + ": " + verdict.error + ")");
+    }
+}
+
+/******************************************************************************/
+
+std::string
+BlobInspector::read() {
+    auto envelope = BlobInspector::envelope (m_data);
 
     amqp::internal::CompositeFactory cf;
 
-    cf.process (envelope->schema());
+    // a checked read also makes sure each enum's name matches its ordinal
+    if (m_trusted) {
+        cf.trust();
+    } else {
+        cf.validate (true);
+    }
+
+    if (m_mappings) {
+        cf.share (m_mappings);
+    }
+
+    if (m_expected) {
+        cf.expect (m_expected->schema(), m_expected->transforms());
+    }
+
+    cf.process (envelope->schema(), envelope->transforms());
 
     auto reader = cf.byDescriptor (envelope->descriptor());
     assert (reader);
@@ -62,7 +192,7 @@ BlobInspector::dump() {
 
             // We wrap our output like this to make sure it's valid JSON to
             // facilitate easy pretty printing
-            ss << reader->dump ("{ Parsed", m_data, envelope->schema())->dump()
+            ss << reader->dump ("{ \"Parsed\"", m_data, envelope->schema())->dump()
                << " }";
 
             return ss.str();
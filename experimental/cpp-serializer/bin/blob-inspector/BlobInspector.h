@@ -1,21 +1,92 @@
 #pragma once
 
 #include <iosfwd>
+#include <memory>
 #include "CordaBytes.h"
 
 /******************************************************************************/
 
 struct pn_data_t;
 
+namespace amqp::internal {
+
+    class Mappings;
+
+}
+
+namespace amqp::internal::schema {
+
+    class Envelope;
+
+}
+
 /******************************************************************************/
 
 class BlobInspector {
     private :
         pn_data_t * m_data;
 
+        /**
+         * The encoded body of the blob, past its header, kept so a failed
+         * decode can be explained by the wire verifier
+         */
+        const char * m_body;
+        size_t       m_size;
+
+        bool m_trusted { false };
+
+        /**
+         * The schema of the blob we're to read this one as, if any
+         */
+        std::unique_ptr<amqp::internal::schema::Envelope> m_expected;
+
+        /**
+         * Where what's compiled to read one version of a type as another
+         * is kept between blobs, if anywhere
+         */
+        std::shared_ptr<amqp::internal::Mappings> m_mappings;
+
+        static std::unique_ptr<amqp::internal::schema::Envelope> envelope (
+            pn_data_t *);
+
+        std::string read();
+
     public :
         BlobInspector (CordaBytes &);
 
+        /**
+         * Inspect a complete blob, header and all, in place. Nothing is
+         * copied so [blob_] must outlive the call to [dump], which makes
+         * this the way to read blobs straight out of a mapped pack.
+         */
+        BlobInspector (const char * blob_, size_t size_);
+
+        BlobInspector (const BlobInspector &) = delete;
+        BlobInspector & operator= (const BlobInspector &) = delete;
+
+        ~BlobInspector();
+
+        /**
+         * Read the blob as the versions of its types found in [cb_], a
+         * blob written by the version of the code we want to see the
+         * data as
+         */
+        void expect (CordaBytes & cb_);
+
+        /**
+         * Skip the per value type and UTF-8 checks when reading, see
+         * [CompositeFactory::trust], and the cross check of each enum's
+         * name against its ordinal, see [CompositeFactory::validate]
+         */
+        void trust();
+
+        /**
+         * Keep what's compiled to read the blob as the types [expect]ed
+         * in [mappings_], and reuse whatever's there already, rather
+         * than compile it afresh for every blob
+         */
+        void share (std::shared_ptr<amqp::internal::Mappings> mappings_);
+
         std::string dump();
 
 };
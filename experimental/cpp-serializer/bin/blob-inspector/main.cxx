@@ -1,13 +1,26 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <map>
+#include <set>
+#include <mutex>
+#include <vector>
+#include <algorithm>
 #include <cstddef>
+#include <cctype>
+#include <cstdlib>
+#include <optional>
+#include <filesystem>
+#include <string_view>
 
 #include <assert.h>
 #include <string.h>
 #include <proton/types.h>
 #include <proton/codec.h>
 #include <sys/stat.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
 
 #include "debug.h"
 
@@ -18,24 +31,1123 @@
 #include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
 
 #include "amqp/schema/described-types/Envelope.h"
+#include "amqp/Mappings.h"
 #include "amqp/CompositeFactory.h"
+#include "amqp/wire/Blob.h"
+#include "amqp/wire/Text.h"
+#include "amqp/wire/TypeCache.h"
+#include "amqp/wire/Verifier.h"
+#include "amqp/wire/Classifier.h"
+#include "amqp/stats/Profile.h"
+#include "amqp/filter/Query.h"
+#include "amqp/diff/Diff.h"
+#include "amqp/index/Keys.h"
+#include "amqp/index/Extractor.h"
+#include "io/BatchReader.h"
+#include "io/Cache.h"
+#include "io/Index.h"
+#include "io/Pack.h"
+#include "io/Encoding.h"
+#include "io/Stream.h"
 #include "CordaBytes.h"
 #include "BlobInspector.h"
 
 /******************************************************************************/
 
+namespace {
+
+    /**
+     * Set by --trusted, skip checking each value as it's read
+     */
+    bool trusted { false };
+
+    /**
+     * Set by --cache, dumps of blobs seen before
+     */
+    uPtr<io::Cache> cache;
+
+    /**
+     * Set by --expect, the blob whose versions of its types the others
+     * are read as
+     */
+    uPtr<CordaBytes> expected;
+
+    /**
+     * What's compiled to read one version of a type as another, kept
+     * for every blob after the first that needs it
+     */
+    auto mappings = std::make_shared<amqp::internal::Mappings>();
+
+    /**
+     * What cached dumps are tagged with, change them whenever the dump
+     * does so earlier ones stop being found. Dumps read without checks
+     * are kept apart from checked ones as they needn't be the same for a
+     * bad blob.
+     */
+    constexpr const char * DUMP_FORMAT { "dump/2" };
+    constexpr const char * TRUSTED_DUMP_FORMAT { "dump/2/trusted" };
+
+    std::string
+    inspect (const char * blob_, size_t size_) {
+        io::CacheKey key { };
+        std::string rtn;
+
+        // what a blob reads as depends on the expected blob too
+        if (cache && !expected) {
+            key = io::Cache::key (
+                blob_, size_, trusted ? TRUSTED_DUMP_FORMAT : DUMP_FORMAT);
+
+            if (cache->get (key, rtn)) {
+                return rtn;
+            }
+        }
+
+        BlobInspector inspector (blob_, size_);
+
+        if (trusted) {
+            inspector.trust();
+        }
+
+        if (expected) {
+            inspector.expect (*expected);
+            inspector.share (mappings);
+        }
+
+        rtn = inspector.dump();
+
+        if (cache && !expected) {
+            cache->put (key, rtn);
+        }
+
+        return rtn;
+    }
+
+    void
+    usage (const char * name_) {
+        std::cerr << "usage: " << name_ << " [--trusted] [--cache <dir>]"
+            << " [--expect <blob>] <blob>"
+            << std::endl
+            << "       " << name_ << " --verify <blob> [<blob> ...]"
+            << std::endl
+            << "       " << name_ << " --classify <blob> [<blob> ...]"
+            << std::endl
+            << "       " << name_ << " --stats <type> <blob> [<blob> ...]"
+            << std::endl
+            << "       " << name_ << " --filter <expr> [--filter <expr> ...]"
+            << " <blob> [<blob> ...]" << std::endl
+            << "       " << name_ << " --diff <blob> <blob>" << std::endl
+            << "       " << name_ << " --enum-codes <blob> [<blob> ...]"
+            << std::endl
+            << "       " << name_ << " --pack <pack> [<id> ...]" << std::endl
+            << "       " << name_ << " --index <index> <field>[,<field> ...]"
+            << " <blob|pack|dir> [...]" << std::endl
+            << "       " << name_ << " --lookup <index> <expr>" << std::endl
+            << "       " << name_ << " --hex | --base64 [--column <n>]"
+            << " [<file> ...]" << std::endl
+            << "       " << name_ << " --stream [<file>]" << std::endl
+            << "  --trusted don't type check values or validate strings"
+            << " as they're read, for blobs from a trusted source, applies"
+            << " to every mode but --verify, --classify, --stats, --filter,"
+            << " --diff, --enum-codes and --index" << std::endl
+            << "  --cache   keep the dump of each blob in <dir>, keyed by a"
+            << " hash of its bytes, and print that rather than decode a blob"
+            << " seen before, applies to every mode --trusted does unless"
+            << " there's an --expect" << std::endl
+            << "  --expect  read the blobs as the versions of their types"
+            << " found in this blob, applies to every mode --trusted does"
+            << std::endl
+            << "  --verify  check each blob is well formed without"
+            << " decoding it" << std::endl
+            << "  --classify count the blobs holding each outer type,"
+            << " without decoding them" << std::endl
+            << "  --stats   print, as JSON, counts, nulls, ranges, distinct"
+            << " and most frequent values and collection lengths of every"
+            << " field of the blobs holding <type>, its name or fingerprint"
+            << std::endl
+            << "  --filter  print the blobs matching <expr>, e.g."
+            << " 'a.b > 10 && c in [\"X\", \"Y\"]', followed by"
+            << " the numbers of the filters they matched if there's more"
+            << " than one" << std::endl
+            << "  --diff    print each field that differs between two"
+            << " blobs as 'path : old -> new'" << std::endl
+            << "  --enum-codes print each blob, one per line, as JSON with"
+            << " every enum written as its ordinal and the constants of each"
+            << " enum type listed once after the value" << std::endl
+            << "  --pack    print the blobs with the given ids, or every"
+            << " blob, from a pack as '<id> <blob>'" << std::endl
+            << "  --index   write an index of the values of each field, a"
+            << " dotted path, in the blobs given, those in packs and those"
+            << " under directories" << std::endl
+            << "  --lookup  print the indexed blobs matching <expr>,"
+            << " comparisons of one field joined by &&, as '<id> <blob>'"
+            << " or '<path> <blob>'" << std::endl
+            << "  --hex     print the blob encoded on each line of the files,"
+            << " or stdin, as hex, optionally prefixed \\x or 0x" << std::endl
+            << "  --base64  likewise for base64" << std::endl
+            << "  --column  take the blob from the <n>th, counting from 1,"
+            << " comma separated column of each line" << std::endl
+            << "  --stream  print, one per line, each of the blobs written"
+            << " back to back to <file>, or stdin" << std::endl;
+    }
+
+    /**
+     * Read the whole of [path_] into [buffer_]
+     */
+    bool
+    slurp (const char * path_, std::vector<char> & buffer_) {
+        std::ifstream file { path_, std::ios::in | std::ios::binary };
+
+        if (!file) {
+            return false;
+        }
+
+        file.seekg (0, std::ios::end);
+        buffer_.resize (file.tellg());
+        file.seekg (0, std::ios::beg);
+        file.read (buffer_.data(), buffer_.size());
+
+        return true;
+    }
+
+    /**
+     * Print PASS or FAIL, with the offset of the problem, for each blob
+     * and exit non zero if any failed. The blobs are read in bulk and
+     * verified in parallel but reported in the order they were given.
+     */
+    int
+    verify (int argc, char ** argv) {
+        std::vector<std::string> paths (argv, argv + argc);
+        std::vector<amqp::internal::wire::Verdict> verdicts (paths.size());
+
+        io::batchReader()->read (paths, [&verdicts](const io::Completion & c_) {
+            if (c_.error) {
+                verdicts[c_.index] = { false, 0, "Can't open" };
+            } else {
+                verdicts[c_.index] = amqp::internal::wire::verify (c_.data, c_.size);
+            }
+        });
+
+        int rtn { EXIT_SUCCESS };
+
+        for (size_t i { 0 } ; i < paths.size() ; ++i) {
+            if (verdicts[i]) {
+                std::cout << paths[i] << " PASS" << std::endl;
+            } else {
+                std::cout << paths[i] << " FAIL " << verdicts[i].offset
+                    << " " << verdicts[i].error << std::endl;
+                rtn = EXIT_FAILURE;
+            }
+        }
+
+        return rtn;
+    }
+
+    /**
+     * Print how many of the blobs hold each outer type, most common
+     * first, as '<count> <name> <fingerprint>'. Nothing past the front
+     * of the envelope is decoded so this runs as fast as the blobs can
+     * be read, one worker is plenty.
+     */
+    int
+    classify (int argc, char ** argv) {
+        struct Count {
+            std::string name;
+            size_t      count { 0 };
+        };
+
+        std::vector<std::string> paths (argv, argv + argc);
+        std::map<std::string, Count, std::less<>> counts;
+        amqp::internal::wire::Classifier classifier;
+
+        int rtn { EXIT_SUCCESS };
+
+        io::Options options;
+        options.workers = 1;
+
+        io::batchReader (options)->read (paths, [&](const io::Completion & c_) {
+            if (c_.error) {
+                std::cerr << c_.path << ": Can't open" << std::endl;
+                rtn = EXIT_FAILURE;
+                return;
+            }
+
+            try {
+                auto c = classifier.classify (c_.data, c_.size);
+                auto it = counts.find (c.fingerprint);
+
+                if (it == counts.end()) {
+                    it = counts.emplace (
+                        std::string (c.fingerprint),
+                        Count { std::string (c.name) }).first;
+                }
+
+                ++it->second.count;
+            } catch (const amqp::internal::wire::Error & e) {
+                std::cerr << c_.path << ": " << e.what() << " at " << e.offset()
+                    << std::endl;
+                rtn = EXIT_FAILURE;
+            }
+        });
+
+        std::vector<decltype (counts)::const_pointer> sorted;
+        sorted.reserve (counts.size());
+
+        for (const auto & c : counts) {
+            sorted.push_back (&c);
+        }
+
+        std::stable_sort (sorted.begin(), sorted.end(), [](auto a_, auto b_) {
+            return a_->second.count > b_->second.count;
+        });
+
+        for (const auto * c : sorted) {
+            std::cout << c->second.count << " "
+                << (c->second.name.empty() ? "<unknown>" : c->second.name) << " "
+                << c->first << "\n";
+        }
+
+        std::cout << std::flush;
+
+        return rtn;
+    }
+
+    /**
+     * Profile every field of the blobs holding [type_], given by name
+     * or fingerprint, printing the statistics as JSON. The blobs are
+     * read in bulk and walked in parallel, each worker counting into a
+     * profile of its own that's only merged with the others at the end.
+     */
+    int
+    stats (const char * type_, int argc, char ** argv) {
+        using amqp::internal::stats::Profile;
+
+        std::vector<std::string> paths (argv, argv + argc);
+
+        std::mutex mutex;
+        std::vector<uPtr<Profile>> idle;
+
+        int rtn { EXIT_SUCCESS };
+        size_t skipped { 0 };
+
+        io::batchReader()->read (paths, [&](const io::Completion & c_) {
+            uPtr<Profile> profile;
+
+            {
+                std::lock_guard<std::mutex> lock (mutex);
+
+                if (c_.error) {
+                    std::cerr << c_.path << ": Can't open" << std::endl;
+                    rtn = EXIT_FAILURE;
+                    return;
+                }
+
+                if (idle.empty()) {
+                    profile = std::make_unique<Profile> (type_);
+                } else {
+                    profile = std::move (idle.back());
+                    idle.pop_back();
+                }
+            }
+
+            bool counted { false };
+            std::string error;
+
+            try {
+                counted = profile->add (c_.data, c_.size);
+            } catch (const amqp::internal::wire::Error & e) {
+                error = std::string (e.what()) + " at " + std::to_string (e.offset());
+            } catch (const std::runtime_error & e) {
+                error = e.what();
+            }
+
+            std::lock_guard<std::mutex> lock (mutex);
+
+            if (!error.empty()) {
+                std::cerr << c_.path << ": " << error << std::endl;
+                rtn = EXIT_FAILURE;
+            } else if (!counted) {
+                ++skipped;
+            }
+
+            idle.push_back (std::move (profile));
+        });
+
+        Profile total (type_);
+
+        for (const auto & p : idle) {
+            total.merge (*p);
+        }
+
+        if (skipped) {
+            std::cerr << skipped << " blobs of other types skipped" << std::endl;
+        }
+
+        std::cout << total.dump() << std::endl;
+
+        return rtn;
+    }
+
+    /**
+     * Every filter is evaluated against each blob in a single pass
+     */
+    int
+    filter (int argc, char ** argv) {
+        using amqp::internal::filter::Expression;
+
+        std::vector<uPtr<Expression>> expressions;
+
+        int i { 0 };
+
+        try {
+            for ( ; i + 1 < argc && strcmp (argv[i], "--filter") == 0 ; i += 2) {
+                expressions.push_back (Expression::parse (argv[i + 1]));
+            }
+        } catch (const std::runtime_error & e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // the blobs of a run mostly share a schema, which this keeps the
+        // types of, and the filters compiled against them, between files
+        amqp::internal::filter::Matcher match (expressions);
+
+        std::vector<char> buffer;
+        int rtn { EXIT_SUCCESS };
+
+        for ( ; i < argc ; ++i) {
+            if (!slurp (argv[i], buffer)) {
+                std::cerr << argv[i] << ": Can't open" << std::endl;
+                rtn = EXIT_FAILURE;
+                continue;
+            }
+
+            try {
+                auto matched = match (buffer.data(), buffer.size());
+
+                if (std::none_of (matched.begin(), matched.end(), [](bool b_) { return b_; })) {
+                    continue;
+                }
+
+                std::cout << argv[i];
+
+                if (matched.size() > 1) {
+                    for (size_t j { 0 } ; j < matched.size() ; ++j) {
+                        if (matched[j]) std::cout << " " << j + 1;
+                    }
+                }
+
+                std::cout << std::endl;
+            } catch (const amqp::internal::wire::Error & e) {
+                std::cerr << argv[i] << ": " << e.what() << " at " << e.offset()
+                    << std::endl;
+                rtn = EXIT_FAILURE;
+            }
+        }
+
+        return rtn;
+    }
+
+    /**
+     * Exits 0 when the blobs hold the same values, 1 when they don't and
+     * 2 if either can't be read
+     */
+    int
+    diff (const char * from_, const char * to_) {
+        std::vector<char> from, to;
+
+        for (auto [path, buffer] : { std::pair (from_, &from), std::pair (to_, &to) }) {
+            if (!slurp (path, *buffer)) {
+                std::cerr << path << ": Can't open" << std::endl;
+                return 2;
+            }
+        }
+
+        try {
+            auto differences = amqp::internal::diff::diff (
+                from.data(), from.size(), to.data(), to.size());
+
+            for (const auto & d : differences) {
+                std::cout << (d.path.empty() ? "<root>" : d.path) << " : "
+                    << d.from.value_or ("-") << " -> "
+                    << d.to.value_or ("-") << std::endl;
+            }
+
+            return differences.empty() ? 0 : 1;
+        } catch (const amqp::internal::wire::Error & e) {
+            std::cerr << e.what() << " at " << e.offset() << std::endl;
+        } catch (const std::runtime_error & e) {
+            std::cerr << e.what() << std::endl;
+        }
+
+        return 2;
+    }
+
+    /**
+     * The blobs are walked on the wire, never decoded, and the types of
+     * each schema kept for the blobs after it that share it
+     */
+    int
+    enumCodes (int argc, char ** argv) {
+        amqp::internal::wire::TypeCache types;
+
+        std::vector<char> buffer;
+        std::vector<const amqp::internal::wire::Type *> enums;
+        std::string out;
+
+        int rtn { EXIT_SUCCESS };
+
+        for (int i { 0 } ; i < argc ; ++i) {
+            if (!slurp (argv[i], buffer)) {
+                std::cerr << argv[i] << ": Can't open" << std::endl;
+                rtn = EXIT_FAILURE;
+                continue;
+            }
+
+            try {
+                amqp::internal::wire::Blob blob (buffer.data(), buffer.size());
+
+                auto type = types.root (blob).second;
+                auto cursor = blob.object();
+
+                out.clear();
+                amqp::internal::wire::enumCodes (cursor, *type, out, enums);
+
+                std::cout << out << "\n";
+            } catch (const amqp::internal::wire::Error & e) {
+                std::cerr << argv[i] << ": " << e.what() << " at " << e.offset()
+                    << std::endl;
+                rtn = EXIT_FAILURE;
+            } catch (const std::runtime_error & e) {
+                std::cerr << argv[i] << ": " << e.what() << std::endl;
+                rtn = EXIT_FAILURE;
+            }
+        }
+
+        std::cout << std::flush;
+
+        return rtn;
+    }
+
+    /**
+     * Blobs are inspected straight out of the mapped pack, a scan
+     * reads the pack front to back
+     */
+    int
+    pack (int argc, char ** argv) {
+        int rtn { EXIT_SUCCESS };
+
+        auto print = [&rtn](const io::PackEntry & entry_) {
+            try {
+                std::cout << entry_.id << " "
+                    << inspect (entry_.data, entry_.size) << "\n";
+            } catch (const std::runtime_error & e) {
+                std::cerr << entry_.id << ": " << e.what() << std::endl;
+                rtn = EXIT_FAILURE;
+            }
+        };
+
+        try {
+            io::Pack pack (argv[0]);
+
+            if (argc == 1) {
+                pack.scan (print);
+            }
+
+            for (int i { 1 } ; i < argc ; ++i) {
+                if (auto entry = pack.find (argv[i])) {
+                    print (*entry);
+                } else {
+                    std::cerr << argv[i] << ": Not in pack" << std::endl;
+                    rtn = EXIT_FAILURE;
+                }
+            }
+        } catch (const std::runtime_error & e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << std::flush;
+
+        return rtn;
+    }
+
+
+    /**
+     * Blobs are read one at a time and their keys gathered by an external
+     * sort, so memory stays bounded however large the corpus. Only blobs
+     * holding at least one of the fields are entered in the index.
+     */
+    int
+    buildIndex (const char * index_, const char * fields_, int argc, char ** argv) {
+        std::vector<std::string> fields;
+
+        for (std::string_view rest { fields_ } ; ; ) {
+            auto comma = rest.find (',');
+            fields.emplace_back (rest.substr (0, comma));
+
+            if (comma == std::string_view::npos) {
+                break;
+            }
+
+            rest.remove_prefix (comma + 1);
+        }
+
+        int rtn { EXIT_SUCCESS };
+
+        try {
+            amqp::internal::index::Extractor extractor (fields);
+            io::IndexWriter writer (index_, fields);
+
+            std::vector<std::pair<size_t, std::string>> keys;
+
+            auto add = [&](
+                const std::string & source_,
+                std::string_view name_,
+                const char * blob_,
+                size_t size_
+            ) {
+                keys.clear();
+
+                try {
+                    extractor.extract (blob_, size_, [&keys](size_t field_, const std::string & key_) {
+                        keys.emplace_back (field_, key_);
+                    });
+                } catch (const amqp::internal::wire::Error & e) {
+                    std::cerr << name_ << ": " << e.what() << " at " << e.offset()
+                        << std::endl;
+                    rtn = EXIT_FAILURE;
+                    return;
+                } catch (const std::runtime_error & e) {
+                    std::cerr << name_ << ": " << e.what() << std::endl;
+                    rtn = EXIT_FAILURE;
+                    return;
+                }
+
+                if (keys.empty()) {
+                    return;
+                }
+
+                auto blob = writer.blob (source_, name_);
+
+                for (const auto & key : keys) {
+                    writer.add (key.first, blob, key.second);
+                }
+            };
+
+            std::vector<char> buffer;
+
+            auto file = [&](const std::string & path_) {
+                if (io::Pack::is (path_)) {
+                    io::Pack (path_).scan ([&](const io::PackEntry & entry_) {
+                        add (path_, entry_.id, entry_.data, entry_.size);
+                    });
+                } else if (slurp (path_.c_str(), buffer)) {
+                    add ("", path_, buffer.data(), buffer.size());
+                } else {
+                    std::cerr << path_ << ": Can't open" << std::endl;
+                    rtn = EXIT_FAILURE;
+                }
+            };
+
+            for (int i { 0 } ; i < argc ; ++i) {
+                if (!std::filesystem::is_directory (argv[i])) {
+                    file (argv[i]);
+                    continue;
+                }
+
+                std::vector<std::string> paths;
+
+                for (const auto & e : std::filesystem::recursive_directory_iterator (argv[i])) {
+                    if (e.is_regular_file()) {
+                        paths.push_back (e.path().string());
+                    }
+                }
+
+                std::sort (paths.begin(), paths.end());
+
+                for (const auto & path : paths) {
+                    file (path);
+                }
+            }
+
+            writer.close();
+        } catch (const std::runtime_error & e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        return rtn;
+    }
+
+    /**
+     * Only the blobs the index points at are read and decoded, each once
+     * however many of its keys matched, in the order they were indexed
+     */
+    int
+    lookup (const char * index_, const char * expression_) {
+        int rtn { EXIT_SUCCESS };
+
+        try {
+            io::Index index (index_);
+
+            auto [field, ranges] = amqp::internal::index::ranges (
+                *amqp::internal::filter::Expression::parse (expression_));
+
+            std::set<uint32_t> blobs;
+
+            for (const auto & r : ranges) {
+                index.range (
+                    field,
+                    io::Bound { r.from, r.fromInclusive },
+                    io::Bound { r.to, r.toInclusive },
+                    [&blobs](const io::IndexEntry & entry_) { blobs.insert (entry_.blob); });
+            }
+
+            std::map<std::string_view, uPtr<io::Pack>> packs;
+            std::vector<char> buffer;
+
+            for (auto b : blobs) {
+                auto [source, name] = index.blob (b);
+
+                try {
+                    if (source.empty()) {
+                        if (!slurp (std::string (name).c_str(), buffer)) {
+                            std::cerr << name << ": Can't open" << std::endl;
+                            rtn = EXIT_FAILURE;
+                            continue;
+                        }
+
+                        std::cout << name << " "
+                            << inspect (buffer.data(), buffer.size()) << "\n";
+
+                        continue;
+                    }
+
+                    auto & pack = packs[source];
+
+                    if (!pack) {
+                        pack = std::make_unique<io::Pack> (std::string (source));
+                    }
+
+                    if (auto entry = pack->find (name)) {
+                        std::cout << name << " " << inspect (entry->data, entry->size) << "\n";
+                    } else {
+                        std::cerr << name << ": Not in pack " << source << std::endl;
+                        rtn = EXIT_FAILURE;
+                    }
+                } catch (const std::runtime_error & e) {
+                    std::cerr << name << ": " << e.what() << std::endl;
+                    rtn = EXIT_FAILURE;
+                }
+            }
+        } catch (const std::runtime_error & e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << std::flush;
+
+        return rtn;
+    }
+
+    /**
+     * The [column_]th, counting from 1, comma separated field of [line_]
+     * with any quotes around it removed. Quoted fields may hold commas,
+     * an encoded blob never holds a quote so there's no unescaping to do.
+     */
+    std::optional<std::string_view>
+    column (std::string_view line_, size_t column_) {
+        size_t start { 0 };
+
+        for (size_t n { 1 } ; ; ++n) {
+            size_t end;
+
+            if (start < line_.size() && line_[start] == '"') {
+                end = start + 1;
+
+                while (end < line_.size()) {
+                    if (line_[end] == '"' && (end + 1 == line_.size() || line_[end + 1] != '"')) {
+                        break;
+                    }
+
+                    end += line_[end] == '"' ? 2 : 1;
+                }
+
+                if (n == column_) {
+                    return line_.substr (start + 1, end - start - 1);
+                }
+
+                end = line_.find (',', end);
+            } else {
+                end = line_.find (',', start);
+
+                if (n == column_) {
+                    return line_.substr (start, end == std::string_view::npos
+                        ? std::string_view::npos
+                        : end - start);
+                }
+            }
+
+            if (end == std::string_view::npos) {
+                return std::nullopt;
+            }
+
+            start = end + 1;
+        }
+    }
+
+    /**
+     * One blob per line of each file, or of stdin if there are none,
+     * encoded as hex or base64. The line and the decoded blob are held in
+     * buffers reused from line to line.
+     */
+    int
+    text (int argc, char ** argv, bool base64_) {
+        size_t field { 0 };
+        int i { 0 };
+
+        if (argc > 1 && strcmp (argv[0], "--column") == 0) {
+            field = std::strtoul (argv[1], nullptr, 10);
+            i = 2;
+
+            if (field == 0) {
+                std::cerr << "Columns count from 1" << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        std::vector<const char *> sources (argv + i, argv + argc);
+
+        if (sources.empty()) {
+            sources.push_back ("-");
+        }
+
+        std::string line;
+        std::vector<char> blob;
+        int rtn { EXIT_SUCCESS };
+
+        for (const auto * source : sources) {
+            std::ifstream file;
+
+            if (strcmp (source, "-") != 0) {
+                file.open (source);
+
+                if (!file) {
+                    std::cerr << source << ": Can't open" << std::endl;
+                    rtn = EXIT_FAILURE;
+                    continue;
+                }
+            }
+
+            std::istream & in = file.is_open() ? file : std::cin;
+
+            for (size_t n { 1 } ; std::getline (in, line) ; ++n) {
+                auto fail = [&](const std::string & why_) {
+                    std::cerr << source << ":" << n << ": " << why_ << std::endl;
+                    rtn = EXIT_FAILURE;
+                };
+
+                std::string_view encoded (line);
+
+                while (!encoded.empty() && std::isspace (static_cast<unsigned char>(encoded.back()))) {
+                    encoded.remove_suffix (1);
+                }
+
+                if (encoded.empty()) {
+                    continue;
+                }
+
+                if (field) {
+                    auto value = column (encoded, field);
+
+                    if (!value) {
+                        fail ("No column " + std::to_string (field));
+                        continue;
+                    }
+
+                    encoded = *value;
+                }
+
+                bool decoded;
+
+                if (base64_) {
+                    decoded = io::base64::decode (encoded.data(), encoded.size(), blob);
+                } else {
+                    // Postgres writes bytea as \x..., others use 0x...
+                    if (encoded.size() >= 2 && (encoded[0] == '\\' || encoded[0] == '0')
+                        && (encoded[1] == 'x' || encoded[1] == 'X'))
+                    {
+                        encoded.remove_prefix (2);
+                    }
+
+                    decoded = io::hex::decode (encoded.data(), encoded.size(), blob);
+                }
+
+                if (!decoded) {
+                    fail (base64_ ? "Not valid base64" : "Not valid hex");
+                    continue;
+                }
+
+                try {
+                    std::cout << inspect (blob.data(), blob.size()) << "\n";
+                } catch (const std::runtime_error & e) {
+                    fail (e.what());
+                }
+            }
+        }
+
+        std::cout << std::flush;
+
+        return rtn;
+    }
+
+
+    /**
+     * Blobs are cut from the stream as they arrive, using the size of
+     * each envelope to find where the next blob starts. Those lying
+     * wholly within a chunk are decoded in place, only one straddling two
+     * chunks is copied, byte by byte until its size is known and then in
+     * bulk.
+     */
+    int
+    stream (const char * path_) {
+        int fd { STDIN_FILENO };
+
+        if (path_ && (fd = ::open (path_, O_RDONLY | O_CLOEXEC)) < 0) {
+            std::cerr << path_ << ": " << strerror (errno) << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        int rtn { EXIT_SUCCESS };
+        size_t blobs { 0 }, offset { 0 };
+
+        auto print = [&](const char * blob_, size_t size_) {
+            try {
+                std::cout << inspect (blob_, size_) << "\n";
+            } catch (const std::runtime_error & e) {
+                std::cerr << "Blob " << blobs << " at " << offset << ": "
+                    << e.what() << std::endl;
+                rtn = EXIT_FAILURE;
+            }
+
+            ++blobs;
+            offset += size_;
+        };
+
+        std::vector<char> carry;
+
+        try {
+            io::Stream in (fd);
+
+            for (auto chunk = in.next() ; !chunk.empty() ; chunk = in.next()) {
+                size_t at { 0 };
+
+                while (!carry.empty() && at < chunk.size()) {
+                    auto size = amqp::internal::wire::extent (carry.data(), carry.size());
+                    auto take = size
+                        ? std::min (*size - carry.size(), chunk.size() - at)
+                        : 1;
+
+                    carry.insert (carry.end(), chunk.data() + at, chunk.data() + at + take);
+                    at += take;
+
+                    if (size && carry.size() == *size) {
+                        print (carry.data(), carry.size());
+                        carry.clear();
+                    }
+                }
+
+                while (at < chunk.size()) {
+                    auto size = amqp::internal::wire::extent (
+                        chunk.data() + at, chunk.size() - at);
+
+                    if (!size || *size > chunk.size() - at) {
+                        carry.assign (chunk.data() + at, chunk.data() + chunk.size());
+                        break;
+                    }
+
+                    print (chunk.data() + at, *size);
+                    at += *size;
+                }
+
+                std::cout << std::flush;
+            }
+
+            if (!carry.empty()) {
+                std::cerr << "Blob " << blobs << " at " << offset
+                    << ": Truncated" << std::endl;
+                rtn = EXIT_FAILURE;
+            }
+        } catch (const amqp::internal::wire::Error & e) {
+            // without a size there's no finding the next blob
+            std::cerr << "Blob " << blobs << " at " << offset + e.offset()
+                << ": " << e.what() << std::endl;
+            rtn = EXIT_FAILURE;
+        } catch (const std::runtime_error & e) {
+            std::cerr << e.what() << std::endl;
+            rtn = EXIT_FAILURE;
+        }
+
+        std::cout << std::flush;
+
+        // the stream, and with it the thread reading fd, has gone by now
+        if (fd != STDIN_FILENO) {
+            ::close (fd);
+        }
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
 int
 main (int argc, char **argv) {
     struct stat results { };
 
-    if (stat(argv[1], &results) != 0) {
+    const char * blob { nullptr };
+    const char * expect { nullptr };
+
+    for (;;) {
+        if (argc > 1 && strcmp (argv[1], "--trusted") == 0) {
+            trusted = true;
+            argv[1] = argv[0];
+            --argc;
+            ++argv;
+        } else if (argc > 2 && strcmp (argv[1], "--expect") == 0) {
+            try {
+                expected = std::make_unique<CordaBytes> (argv[2]);
+            } catch (const std::runtime_error & e) {
+                std::cerr << argv[2] << ": " << e.what() << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            argv[2] = argv[0];
+            argc -= 2;
+            argv += 2;
+        } else if (argc > 2 && strcmp (argv[1], "--cache") == 0) {
+            try {
+                cache = std::make_unique<io::Cache> (argv[2]);
+            } catch (const std::runtime_error & e) {
+                std::cerr << e.what() << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            argv[2] = argv[0];
+            argc -= 2;
+            argv += 2;
+        } else {
+            break;
+        }
+    }
+
+    if (argc > 2 && strcmp (argv[1], "--verify") == 0) {
+        return verify (argc - 2, argv + 2);
+    }
+
+    if (argc > 2 && strcmp (argv[1], "--classify") == 0) {
+        return classify (argc - 2, argv + 2);
+    }
+
+    if (argc > 3 && strcmp (argv[1], "--stats") == 0) {
+        return stats (argv[2], argc - 3, argv + 3);
+    }
+
+    if (argc > 3 && strcmp (argv[1], "--filter") == 0) {
+        return filter (argc - 1, argv + 1);
+    }
+
+    if (argc == 4 && strcmp (argv[1], "--diff") == 0) {
+        return diff (argv[2], argv[3]);
+    }
+
+    if (argc > 2 && strcmp (argv[1], "--enum-codes") == 0) {
+        return enumCodes (argc - 2, argv + 2);
+    }
+
+    if (argc > 2 && strcmp (argv[1], "--pack") == 0) {
+        return pack (argc - 2, argv + 2);
+    }
+
+    if (argc > 4 && strcmp (argv[1], "--index") == 0) {
+        return buildIndex (argv[2], argv[3], argc - 4, argv + 4);
+    }
+
+    if (argc == 4 && strcmp (argv[1], "--lookup") == 0) {
+        return lookup (argv[2], argv[3]);
+    }
+
+    if ((argc == 2 || argc == 3) && strcmp (argv[1], "--stream") == 0) {
+        return stream (argc == 3 ? argv[2] : nullptr);
+    }
+
+    if (argc > 1 && strcmp (argv[1], "--hex") == 0) {
+        return text (argc - 2, argv + 2, false);
+    }
+
+    if (argc > 1 && strcmp (argv[1], "--base64") == 0) {
+        return text (argc - 2, argv + 2, true);
+    }
+
+    for (int i { 1 } ; i < argc ; ++i) {
+        if (strcmp (argv[i], "--expect") == 0 && i + 1 < argc) {
+            expect = argv[++i];
+        } else if (!blob) {
+            blob = argv[i];
+        } else {
+            usage (argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!blob) {
+        usage (argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (stat(blob, &results) != 0) {
         return EXIT_FAILURE;
     }
 
-    CordaBytes cb (argv[1]);
+    if (expect) {
+        if (stat (expect, &results) != 0) {
+            return EXIT_FAILURE;
+        }
+
+        expected = std::make_unique<CordaBytes> (expect);
+    }
+
+    if (cache && !expected) {
+        std::vector<char> buffer;
+
+        if (!slurp (blob, buffer)) {
+            return EXIT_FAILURE;
+        }
+
+        try {
+            std::cout << inspect (buffer.data(), buffer.size()) << std::endl;
+        } catch (const std::runtime_error & e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    CordaBytes cb (blob);
     
     if (cb.encoding() == amqp::DATA_AND_STOP) {
         BlobInspector blobInspector (cb);
+
+        if (trusted) {
+            blobInspector.trust();
+        }
+
+        if (expected) {
+            blobInspector.expect (*expected);
+        }
+
         auto val = blobInspector.dump();
         std::cout << val << std::endl;
     } else {
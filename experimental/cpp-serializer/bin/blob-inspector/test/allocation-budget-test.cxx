@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+#include <proton/codec.h>
+
+#include "CordaBytes.h"
+#include "BlobInspector.h"
+
+#include "test-utils/BlobBuilder.h"
+#include "test-utils/AllocationScope.h"
+
+/******************************************************************************
+ *
+ * Allocation budgets for dumping the fixture blobs. Only the dump itself is
+ * measured, reading the file and proton's decode of it are not ours to
+ * tune. Budgets sit a little above what a dump currently costs so any
+ * regression shows up here, when a change makes things cheaper lower them.
+ *
+ ******************************************************************************/
+
+namespace {
+
+    const std::string filepath ("../../test-files/"); // NOLINT
+
+    void
+    budget (const std::string & file_, size_t allocations_) {
+        CordaBytes cb (filepath + file_);
+        BlobInspector inspector (cb);
+
+        test::AllocationScope scope;
+        auto val = inspector.dump();
+
+        EXPECT_LE (scope.allocations(), allocations_) << file_;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (AllocationBudget, fixtures) { // NOLINT
+    budget ("_i_", 44);
+    budget ("_l_", 45);
+    budget ("_Oi_", 44);
+    budget ("_Ai_", 123);
+    budget ("_Li_", 133);
+    budget ("_Le_", 218);
+    budget ("_Mis_", 123);
+    budget ("_MiLs_", 233);
+    budget ("_Mi_is__", 209);
+    budget ("_Pls_", 110);
+    budget ("_e_", 122);
+    budget ("_i_is__", 88);
+    budget ("_Ci_", 102);
+    budget ("__i_LMis_l__", 296);
+    budget ("_ALd_", 215);
+}
+
+/******************************************************************************/
+
+/**
+ * A blob far bigger than any of the fixtures, a list of strings, run
+ * through the same file based path the inspector uses
+ */
+TEST (AllocationBudget, largeList) { // NOLINT
+    const int elements { 10000 };
+
+    test::BlobBuilder bb;
+
+    bb.composite ("net.corda.A", "net.corda:A", {
+        { "a", "*", { "java.util.List<string>" } } });
+    bb.restricted ("java.util.List<string>", "net.corda:LS", "list");
+
+    auto path = test::toFile (bb.build ("net.corda:A", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t * data_) {
+            test::putDescribed (data_, "net.corda:LS", [](pn_data_t * data_) {
+                test::putList (data_, [](pn_data_t * data_) {
+                    for (int i { 0 } ; i < elements ; ++i) {
+                        test::putString (data_, std::to_string (i));
+                    }
+                });
+            });
+        });
+    }));
+
+    CordaBytes cb (path);
+    std::remove (path.c_str());
+
+    BlobInspector inspector (cb);
+
+    test::AllocationScope scope;
+    auto val = inspector.dump();
+
+    EXPECT_LE (scope.allocations(), 3 * elements);
+}
+
+/******************************************************************************/
@@ -2,6 +2,10 @@
 #include "CordaBytes.h"
 #include "BlobInspector.h"
 
+#include "amqp/CDecoder.h"
+#include "amqp/wire/Verifier.h"
+#include "amqp/wire/Classifier.h"
+
 const std::string filepath ("../../test-files/"); // NOLINT
 
 /******************************************************************************
@@ -24,7 +28,7 @@ test (const std::string & file_, const std::string & result_) {
  * int
  */
 TEST (BlobInspector, _i_) { // NOLINT
-    test ("_i_", "{ Parsed : { a : 69 } }");
+    test ("_i_", R"({ "Parsed" : { "a" : 69 } })");
 }
 
 /******************************************************************************/
@@ -33,7 +37,7 @@ TEST (BlobInspector, _i_) { // NOLINT
  * long
  */
 TEST (BlobInspector, _l_) { // NOLINT
-    test ("_l_", "{ Parsed : { x : 100000000000 } }");
+    test ("_l_", R"({ "Parsed" : { "x" : 100000000000 } })");
 }
 
 /******************************************************************************/
@@ -42,7 +46,7 @@ TEST (BlobInspector, _l_) { // NOLINT
  * int
  */
 TEST (BlobInspector, _Oi_) { // NOLINT
-    test ("_Oi_", "{ Parsed : { a : 1 } }");
+    test ("_Oi_", R"({ "Parsed" : { "a" : 1 } })");
 }
 
 /******************************************************************************/
@@ -51,7 +55,7 @@ TEST (BlobInspector, _Oi_) { // NOLINT
  * int
  */
 TEST (BlobInspector, _Ai_) { // NOLINT
-    test ("_Ai_", "{ Parsed : { z : [ 1, 2, 3, 4, 5, 6 ] } }");
+    test ("_Ai_", R"({ "Parsed" : { "z" : [ 1, 2, 3, 4, 5, 6 ] } })");
 }
 
 /******************************************************************************/
@@ -60,7 +64,7 @@ TEST (BlobInspector, _Ai_) { // NOLINT
  * List of ints
  */
 TEST (BlobInspector, _Li_) { // NOLINT
-    test ("_Li_", "{ Parsed : { a : [ 1, 2, 3, 4, 5, 6 ] } }");
+    test ("_Li_", R"({ "Parsed" : { "a" : [ 1, 2, 3, 4, 5, 6 ] } })");
 }
 
 /******************************************************************************/
@@ -71,13 +75,13 @@ TEST (BlobInspector, _Li_) { // NOLINT
 TEST (BlobInspector, _L_i__) { // NOLINT
     test (
         "_L_i__",
-        "{ Parsed : { listy : [ { a : 1 }, { a : 2 }, { a : 3 } ] } }");
+        R"({ "Parsed" : { "listy" : [ { "a" : 1 }, { "a" : 2 }, { "a" : 3 } ] } })");
 }
 
 /******************************************************************************/
 
 TEST (BlobInspector, _Le_) { // NOLINT
-    test ("_Le_", "{ Parsed : { listy : [ A, B, C ] } }");
+    test ("_Le_", R"({ "Parsed" : { "listy" : [ "A", "B", "C" ] } })");
 }
 
 /******************************************************************************/
@@ -97,7 +101,7 @@ TEST (BlobInspector,_Le_2) { // NOLINT
  */
 TEST (BlobInspector, _Mis_) { // NOLINT
     test ("_Mis_",
-        R"({ Parsed : { a : { 1 : "two", 3 : "four", 5 : "six" } } })");
+        R"({ "Parsed" : { "a" : { "1" : "two", "3" : "four", "5" : "six" } } })");
 }
 
 /******************************************************************************/
@@ -107,7 +111,7 @@ TEST (BlobInspector, _Mis_) { // NOLINT
  */
 TEST (BlobInspector, _MiLs_) { // NOLINT
     test ("_MiLs_",
-        R"({ Parsed : { a : { 1 : [ "two", "three", "four" ], 5 : [ "six" ], 7 : [  ] } } })");
+        R"({ "Parsed" : { "a" : { "1" : [ "two", "three", "four" ], "5" : [ "six" ], "7" : [  ] } } })");
 }
 
 /******************************************************************************/
@@ -117,27 +121,27 @@ TEST (BlobInspector, _MiLs_) { // NOLINT
  */
 TEST (BlobInspector, _Mi_is__) { // NOLINT
     test ("_Mi_is__",
-        R"({ Parsed : { a : { 1 : { a : 2, b : "three" }, 4 : { a : 5, b : "six" }, 7 : { a : 8, b : "nine" } } } })");
+        R"({ "Parsed" : { "a" : { "1" : { "a" : 2, "b" : "three" }, "4" : { "a" : 5, "b" : "six" }, "7" : { "a" : 8, "b" : "nine" } } } })");
 }
 
 /******************************************************************************/
 
 TEST (BlobInspector,_Pls_) { // NOLINT
     test ("_Pls_",
-            R"({ Parsed : { a : { first : 1, second : "two" } } })");
+            R"({ "Parsed" : { "a" : { "first" : 1, "second" : "two" } } })");
 }
 
 /******************************************************************************/
 
 TEST (BlobInspector, _e_) { // NOLINT
-    test ("_e_", "{ Parsed : { e : A } }");
+    test ("_e_", R"({ "Parsed" : { "e" : "A" } })");
 }
 
 /******************************************************************************/
 
 TEST (BlobInspector, _i_is__) { // NOLINT
     test ("_i_is__",
-            R"({ Parsed : { a : 1, b : { a : 2, b : "three" } } })");
+            R"({ "Parsed" : { "a" : 1, "b" : { "a" : 2, "b" : "three" } } })");
 }
 
 /******************************************************************************/
@@ -145,7 +149,7 @@ TEST (BlobInspector, _i_is__) { // NOLINT
 // Array of unboxed integers
 TEST (BlobInspector, _Ci_) { // NOLINT
     test ("_Ci_",
-        R"({ Parsed : { z : [ 1, 2, 3 ] } })");
+        R"({ "Parsed" : { "z" : [ 1, 2, 3 ] } })");
 }
 
 /******************************************************************************/
@@ -158,14 +162,217 @@ TEST (BlobInspector, _Ci_) { // NOLINT
  */
 TEST (BlobInspector, __i_LMis_l__) { // NOLINT
     test ("__i_LMis_l__",
-        R"({ Parsed : { x : [ { 1 : "two", 3 : "four", 5 : "six" }, { 7 : "eight", 9 : "ten" } ], y : { x : 1000000 }, z : { a : 666 } } })");
+        R"({ "Parsed" : { "x" : [ { "1" : "two", "3" : "four", "5" : "six" }, { "7" : "eight", "9" : "ten" } ], "y" : { "x" : 1000000 }, "z" : { "a" : 666 } } })");
 }
 
 /******************************************************************************/
 
 TEST (BlobInspector, _ALd_) { // NOLINT
     test ("_ALd_",
-            R"({ Parsed : { a : [ [ 10.100000, 11.200000, 12.300000 ], [  ], [ 13.400000 ] ] } })");
+            R"({ "Parsed" : { "a" : [ [ 10.1, 11.2, 12.3 ], [  ], [ 13.4 ] ] } })");
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * verify Tests
+ *
+ ******************************************************************************/
+
+/**
+ * Every blob the JVM wrote for us is well formed, including those we
+ * can't yet decode
+ */
+TEST (BlobInspector, verify) { // NOLINT
+    for (const auto & file : {
+        "_ALd_", "_Ai_", "_Ci_", "_L_i__", "_Le_", "_Le_2", "_Li_",
+        "_MiLs_", "_Mi_is__", "_Mis_", "_Oi_", "_Pls_", "__i_LMis_l__",
+        "_e_", "_i_", "_i_is__", "_l_" })
+    {
+        std::ifstream in { filepath + file, std::ios::in | std::ios::binary };
+        std::vector<char> blob {
+            std::istreambuf_iterator<char> (in),
+            std::istreambuf_iterator<char>() };
+
+        auto verdict = amqp::internal::wire::verify (blob.data(), blob.size());
+
+        EXPECT_TRUE (verdict) << file << " : " << verdict.offset << " " << verdict.error;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Inspecting a blob in place reads the same as going through CordaBytes
+ */
+TEST (BlobInspector, view) { // NOLINT
+    for (const auto & file : { "_i_", "_Mis_", "_ALd_" }) {
+        std::ifstream in { filepath + file, std::ios::in | std::ios::binary };
+        std::vector<char> blob {
+            std::istreambuf_iterator<char> (in),
+            std::istreambuf_iterator<char>() };
+
+        CordaBytes cb (filepath + file);
+
+        EXPECT_EQ (
+            BlobInspector (cb).dump(),
+            BlobInspector (blob.data(), blob.size()).dump()) << file;
+    }
+
+    const char notABlob[] { 'c', 'o', 'r', 'd', 'a', 2, 0, 0 };
+
+    EXPECT_THROW ( // NOLINT
+        BlobInspector (notABlob, sizeof (notABlob)),
+        std::runtime_error);
+}
+
+/******************************************************************************/
+
+/**
+ * Trusting a well formed blob changes nothing about how it reads
+ */
+TEST (BlobInspector, trusted) { // NOLINT
+    for (const auto & file : {
+        "_ALd_", "_Ai_", "_Ci_", "_L_i__", "_Le_", "_Li_",
+        "_MiLs_", "_Mi_is__", "_Mis_", "_Oi_", "_Pls_", "__i_LMis_l__",
+        "_e_", "_i_", "_i_is__", "_l_" })
+    {
+        CordaBytes cb (filepath + file);
+
+        BlobInspector trusted (cb);
+        trusted.trust();
+
+        EXPECT_EQ (BlobInspector (cb).dump(), trusted.dump()) << file;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * When a checked read fails the error says where in the blob the
+ * problem lies
+ */
+TEST (BlobInspector, offset) { // NOLINT
+    std::ifstream in { filepath + "_Mis_", std::ios::in | std::ios::binary };
+    std::vector<char> blob {
+        std::istreambuf_iterator<char> (in),
+        std::istreambuf_iterator<char>() };
+
+    // break the UTF-8 of the "four" in the payload
+    const std::string four { "four" };
+    auto i = std::search (blob.begin(), blob.end(), four.begin(), four.end());
+    ASSERT_NE (blob.end(), i);
+    *(i + 1) = '\xff';
+
+    auto verdict = amqp::internal::wire::verify (blob.data(), blob.size());
+    ASSERT_FALSE (verdict);
+
+    try {
+        BlobInspector (blob.data(), blob.size()).dump();
+        FAIL() << "Expected a throw";
+    } catch (const std::runtime_error & e) {
+        EXPECT_NE (
+            std::string::npos,
+            std::string (e.what()).find (
+                "(offset " + std::to_string (verdict.offset) + ": "))
+            << e.what();
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Every blob the JVM wrote for us can be classified, each being named
+ * for the class that wrote it, the two _Le_ blobs sharing a type
+ */
+TEST (BlobInspector, classify) { // NOLINT
+    amqp::internal::wire::Classifier classifier;
+
+    for (const auto & file : {
+        "_ALd_", "_Ai_", "_Ci_", "_L_i__", "_Le_", "_Li_",
+        "_MiLs_", "_Mi_is__", "_Mis_", "_Oi_", "_Pls_", "__i_LMis_l__",
+        "_e_", "_i_", "_i_is__", "_l_" })
+    {
+        std::ifstream in { filepath + file, std::ios::in | std::ios::binary };
+        std::vector<char> blob {
+            std::istreambuf_iterator<char> (in),
+            std::istreambuf_iterator<char>() };
+
+        auto c = classifier.classify (blob.data(), blob.size());
+
+        EXPECT_EQ (std::string ("net.corda.blobwriter.") + file, c.name);
+    }
+
+    std::ifstream in { filepath + "_Le_2", std::ios::in | std::ios::binary };
+    std::vector<char> blob {
+        std::istreambuf_iterator<char> (in),
+        std::istreambuf_iterator<char>() };
+
+    EXPECT_EQ ("net.corda.blobwriter._Le_", classifier.classify (blob.data(), blob.size()).name);
+    EXPECT_EQ (16U, classifier.size());
+}
+
+/******************************************************************************/
+
+/**
+ * Through the C interface a back reference, which the inspector itself
+ * can't yet follow, is still valid JSON
+ */
+TEST (BlobInspector, cReferences) { // NOLINT
+    std::ifstream in { filepath + "_Le_2", std::ios::in | std::ios::binary };
+    std::vector<char> blob {
+        std::istreambuf_iterator<char> (in),
+        std::istreambuf_iterator<char>() };
+
+    amqp_blob_t blobs[] { { blob.data(), blob.size() } };
+    amqp_result_t results[1];
+    std::vector<char> out (1024);
+
+    auto * decoder = amqp_decoder_new();
+
+    ASSERT_EQ (1U, amqp_decode (
+        decoder, blobs, 1, AMQP_FORMAT_JSON, out.data(), out.size(), results));
+
+    amqp_decoder_free (decoder);
+
+    ASSERT_EQ (AMQP_OK, results[0].status);
+    EXPECT_EQ (
+        R"({ "listy" : [ "A", "B", "C", { "$ref" : 1 }, { "$ref" : 0 } ] })",
+        std::string (out.data() + results[0].offset, results[0].size));
+}
+
+/******************************************************************************/
+
+/**
+ * A checked read cross checks each enum's name against its ordinal, a
+ * trusted one goes by the ordinal alone
+ */
+TEST (BlobInspector, enumNames) { // NOLINT
+    std::ifstream in { filepath + "_e_", std::ios::in | std::ios::binary };
+    std::vector<char> blob {
+        std::istreambuf_iterator<char> (in),
+        std::istreambuf_iterator<char>() };
+
+    // the value is written as "A" and ordinal 0, name it "B" instead
+    const std::string value { '\xa1', '\x01', 'A', '\x54', '\x00' };
+    auto at = std::string (blob.begin(), blob.end()).find (value);
+
+    ASSERT_NE (std::string::npos, at);
+    blob[at + 2] = 'B';
+
+    try {
+        BlobInspector (blob.data(), blob.size()).dump();
+        FAIL() << "the name was not checked";
+    } catch (const std::runtime_error & e) {
+        EXPECT_NE (std::string::npos, std::string (e.what()).find ("doesn't match ordinal"))
+            << e.what();
+    }
+
+    BlobInspector trusted (blob.data(), blob.size());
+    trusted.trust();
+
+    EXPECT_EQ (R"({ "Parsed" : { "e" : "A" } })", trusted.dump());
 }
 
 /******************************************************************************/
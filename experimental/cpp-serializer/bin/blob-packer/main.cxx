@@ -0,0 +1,99 @@
+#include <iostream>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <filesystem>
+
+#include "amqp/wire/Blob.h"
+#include "io/Pack.h"
+#include "io/BatchReader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    void
+    usage (const char * name_) {
+        std::cerr << "usage: " << name_ << " <pack> <blob | directory> [...]"
+            << std::endl
+            << "  Writes every blob into a single pack. A blob's id is its"
+            << " path relative to the directory it was found in, or the"
+            << " path as given for a file." << std::endl;
+    }
+
+}
+
+/******************************************************************************/
+
+int
+main (int argc, char **argv) {
+    if (argc < 3) {
+        usage (argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::string> paths, ids;
+
+    for (int i { 2 } ; i < argc ; ++i) {
+        std::error_code ec;
+
+        if (!std::filesystem::is_directory (argv[i], ec)) {
+            paths.emplace_back (argv[i]);
+            ids.emplace_back (argv[i]);
+            continue;
+        }
+
+        for (const auto & entry : std::filesystem::recursive_directory_iterator (argv[i], ec)) {
+            if (entry.is_regular_file (ec)) {
+                paths.push_back (entry.path().string());
+                ids.push_back (entry.path().lexically_relative (argv[i]).string());
+            }
+        }
+
+        if (ec) {
+            std::cerr << argv[i] << ": " << ec.message() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    int rtn { EXIT_SUCCESS };
+
+    try {
+        io::PackWriter writer (argv[1]);
+
+        // the writer appends as blobs arrive so one worker is all it
+        // can use
+        io::Options options;
+        options.workers = 1;
+
+        io::batchReader (options)->read (paths, [&](const io::Completion & c_) {
+            if (c_.error) {
+                std::cerr << c_.path << ": " << std::strerror (c_.error) << std::endl;
+                rtn = EXIT_FAILURE;
+                return;
+            }
+
+            try {
+                amqp::internal::wire::Blob blob (c_.data, c_.size);
+
+                writer.add (ids[c_.index], blob.descriptor(), c_.data, c_.size);
+            } catch (const amqp::internal::wire::Error & e) {
+                std::cerr << c_.path << ": " << e.what() << " at " << e.offset()
+                    << ", skipped" << std::endl;
+                rtn = EXIT_FAILURE;
+            }
+        });
+
+        writer.close();
+
+        std::cout << "Packed " << io::Pack (argv[1]).size() << " of "
+            << paths.size() << " blobs" << std::endl;
+    } catch (const std::runtime_error & e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
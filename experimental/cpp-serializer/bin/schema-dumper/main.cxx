@@ -1,92 +1,244 @@
 #include <iostream>
-#include <iomanip>
-#include <fstream>
+#include <sstream>
 #include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <filesystem>
+#include <string_view>
+#include <unordered_map>
 
-#include <assert.h>
-#include <string.h>
 #include <proton/types.h>
 #include <proton/codec.h>
-#include <sys/stat.h>
-#include <sstream>
 
 #include "debug.h"
 
 #include "proton/proton_wrapper.h"
 
-#include "amqp/AMQPHeader.h"
-#include "amqp/AMQPSectionId.h"
 #include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
+#include "amqp/wire/Blob.h"
+#include "io/BatchReader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    void
+    usage (const char * name_) {
+        std::cerr << "usage: " << name_ << " <blob | directory> [...]" << std::endl
+            << "  Prints each distinct schema found the first time it's seen"
+            << " and, once every blob has been read, how many blobs used"
+            << " each one. Directories are searched recursively." << std::endl;
+    }
+
+    /**
+     * Schemas are told apart by the set of fingerprints they describe,
+     * the first blob found with each is kept as its example
+     */
+    class Catalogue {
+        private :
+            struct Entry {
+                size_t      id;
+                size_t      count;
+                std::string example;
+            };
+
+            std::unordered_map<std::string, Entry> m_schemas;
+
+            /**
+             * Reused from blob to blob so the common case, a schema we've
+             * seen before, allocates nothing
+             */
+            std::vector<std::string_view> m_fingerprints;
+            std::string m_key;
+            std::stringstream m_rendered;
+
+            pn_data_t * m_data;
+
+            size_t m_blobs { 0 };
+            size_t m_failures { 0 };
+
+        public :
+            Catalogue() : m_data (pn_data (0)) { }
+            Catalogue (const Catalogue &) = delete;
+
+            ~Catalogue() {
+                pn_data_free (m_data);
+            }
+
+            void add (const io::Completion &);
 
-#include "amqp/schema/described-types/Envelope.h"
-#include "amqp/CompositeFactory.h"
+            void summarise() const;
+
+            size_t failures() const { return m_failures; }
+
+        private :
+            void render (const amqp::internal::wire::Blob &, const Entry &);
+    };
+
+}
 
 /******************************************************************************/
 
 void
-printNode (pn_data_t * d_) {
-    std::stringstream ss;
-
-    if (pn_data_is_described (d_)) {
-        amqp::internal::AMQPDescriptorRegistory[22UL]->read (d_, ss);
+Catalogue::add (const io::Completion & blob_) {
+    if (blob_.error) {
+        std::cerr << blob_.path << ": " << std::strerror (blob_.error) << std::endl;
+        ++m_failures;
+        return;
     }
 
-    std::cout << ss.str() << std::endl;
+    try {
+        amqp::internal::wire::Blob blob (blob_.data, blob_.size);
+
+        blob.fingerprints (m_fingerprints);
+        std::sort (m_fingerprints.begin(), m_fingerprints.end());
+
+        m_key.clear();
+
+        for (const auto & fingerprint : m_fingerprints) {
+            m_key.append (fingerprint);
+            m_key += '\n';
+        }
+
+        ++m_blobs;
+
+        auto it = m_schemas.find (m_key);
+
+        if (it != m_schemas.end()) {
+            ++it->second.count;
+            return;
+        }
+
+        auto & entry = m_schemas.emplace (
+            m_key,
+            Entry { m_schemas.size() + 1, 1, blob_.path }).first->second;
+
+        render (blob, entry);
+    } catch (const amqp::internal::wire::Error & e) {
+        std::cerr << blob_.path << ": " << e.what() << " at "
+            << e.offset() << std::endl;
+        ++m_failures;
+    } catch (const std::runtime_error & e) {
+        std::cerr << blob_.path << ": " << e.what() << std::endl;
+        ++m_failures;
+    }
 }
 
+/******************************************************************************/
+
+/**
+ * Only the schema section is decoded, the payload is never looked at
+ */
+void
+Catalogue::render (const amqp::internal::wire::Blob & blob_, const Entry & entry_) {
+    auto size = static_cast<ssize_t>(blob_.schemaEnd() - blob_.schemaStart());
+
+    pn_data_clear (m_data);
+
+    if (pn_data_decode (m_data, blob_.bytes() + blob_.schemaStart(), size) != size) {
+        throw amqp::internal::wire::Error ("Malformed schema", blob_.schemaStart());
+    }
+
+    pn_data_rewind (m_data);
+    pn_data_next (m_data);
+
+    m_rendered.str ("");
+    m_rendered << "Schema " << entry_.id << " (first seen in " << entry_.example
+        << ")\n";
+
+    amqp::internal::AMQPDescriptorRegistory[22UL]->read (m_data, m_rendered);
+
+    m_rendered << '\n';
+
+    auto rendered = m_rendered.str();
+
+    std::fwrite (rendered.data(), 1, rendered.size(), stdout);
+}
 
 /******************************************************************************/
 
 void
-data_and_stop(std::ifstream & f_, ssize_t sz) {
-    char * blob = new char[sz];
-    memset (blob, 0, sz);
-    f_.read(blob, sz);
+Catalogue::summarise() const {
+    std::vector<const Entry *> entries;
+    entries.reserve (m_schemas.size());
+
+    for (const auto & schema : m_schemas) {
+        entries.push_back (&schema.second);
+    }
+
+    std::sort (entries.begin(), entries.end(), [](auto a_, auto b_) {
+        return a_->id < b_->id;
+    });
 
-    pn_data_t * d = pn_data(sz);
+    std::fprintf (stdout, "%zu blobs, %zu distinct schemas",
+        m_blobs, m_schemas.size());
 
-    // returns how many bytes we processed which right now we don't care
-    // about but I assume there is a case where it doesn't process the
-    // entire file
-    auto rtn = pn_data_decode (d, blob, sz);
-    assert (rtn == sz);
+    if (m_failures) {
+        std::fprintf (stdout, ", %zu unreadable", m_failures);
+    }
 
-    printNode (d);
+    std::fputc ('\n', stdout);
 
+    for (const auto * entry : entries) {
+        std::fprintf (stdout, "  Schema %zu : %zu\n", entry->id, entry->count);
+    }
 }
 
 /******************************************************************************/
 
 int
 main (int argc, char **argv) {
-    struct stat results { };
-
-    if (stat(argv[1], &results) != 0) {
+    if (argc < 2) {
+        usage (argv[0]);
         return EXIT_FAILURE;
     }
 
-    std::ifstream f (argv[1], std::ios::in | std::ios::binary);
-    std::array<char, 7> header { };
-    f.read(header.data(), 7);
+    // output is only ever written in whole schemas, no need to flush
+    // any more often than the buffer fills
+    static char buffer[1 << 16];
+    std::setvbuf (stdout, buffer, _IOFBF, sizeof (buffer));
 
-    if (header != amqp::AMQP_HEADER) {
-        std::cerr << "Bad Header in blob" << std::endl;
-        return EXIT_FAILURE;
-    }
+    std::vector<std::string> paths;
 
-    amqp::amqp_section_id_t encoding;
-    f.read((char *)&encoding, 1);
+    for (int i { 1 } ; i < argc ; ++i) {
+        std::error_code ec;
 
-    if (encoding == amqp::DATA_AND_STOP) {
-        data_and_stop(f, results.st_size - 8);
-    } else {
-        std::cerr << "BAD ENCODING " << encoding << " != "
-            << amqp::DATA_AND_STOP << std::endl;
+        if (!std::filesystem::is_directory (argv[i], ec)) {
+            paths.emplace_back (argv[i]);
+            continue;
+        }
 
-        return EXIT_FAILURE;
+        for (const auto & entry : std::filesystem::recursive_directory_iterator (argv[i], ec)) {
+            if (entry.is_regular_file (ec)) {
+                paths.push_back (entry.path().string());
+            }
+        }
+
+        if (ec) {
+            std::cerr << argv[i] << ": " << ec.message() << std::endl;
+        }
     }
 
-    return EXIT_SUCCESS;
+    Catalogue catalogue;
+
+    // the catalogue isn't thread safe, one worker is plenty given only
+    // the schemas are decoded and the reads are all still in flight
+    // together
+    io::Options options;
+    options.workers = 1;
+
+    io::batchReader (options)->read (paths, [&catalogue](const io::Completion & c_) {
+        catalogue.add (c_);
+    });
+
+    catalogue.summarise();
+
+    std::fflush (stdout);
+
+    return catalogue.failures() ? EXIT_FAILURE : EXIT_SUCCESS;
 }
 
 /******************************************************************************/
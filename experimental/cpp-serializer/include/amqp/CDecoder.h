@@ -0,0 +1,154 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+/******************************************************************************
+ *
+ * The C interface to the decoder
+ *
+ ******************************************************************************/
+
+/**
+ * For runtimes that can call C but not C++. Blobs are decoded a batch at
+ * a time so a caller crossing a foreign function boundary pays for it
+ * once per batch rather than once per blob. Nothing is allocated for the
+ * caller, results are written into a buffer it owns, and nothing is
+ * thrown, each blob gets a status of its own.
+ *
+ * A decoder keeps the types of every schema it has seen so blobs sharing
+ * a schema, as blobs of a type almost always do, only have it decoded
+ * once. Decoders aren't thread safe, use one per thread.
+ *
+ * e.g.
+ *
+ *      amqp_decoder_t * decoder = amqp_decoder_new();
+ *
+ *      size_t done = amqp_decode (
+ *          decoder, blobs, count, AMQP_FORMAT_JSON, out, capacity, results);
+ *
+ *      for (size_t i = 0 ; i < done ; ++i) {
+ *          if (results[i].status == AMQP_OK) {
+ *              use (out + results[i].offset, results[i].size);
+ *          }
+ *      }
+ *
+ *      amqp_decoder_free (decoder);
+ */
+
+/**
+ * Only these functions are exported from the shared library, everything
+ * behind them is hidden
+ */
+#if defined (__GNUC__)
+#define AMQP_API __attribute__ ((visibility ("default")))
+#else
+#define AMQP_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct amqp_decoder amqp_decoder_t;
+
+typedef struct {
+    const char * bytes;
+    size_t       size;
+} amqp_blob_t;
+
+typedef enum {
+    /**
+     * The payload as the blob inspector prints it, with a reference to an
+     * object written earlier in the blob as { "$ref" : N }
+     */
+    AMQP_FORMAT_JSON   = 0,
+
+    /**
+     * The payload's own AMQP encoding, checked against the schema and
+     * without the envelope and schema around it, for a caller with an
+     * AMQP decoder of its own
+     */
+    AMQP_FORMAT_BINARY = 1,
+
+    /**
+     * As JSON but with enums dictionary encoded, each written as its
+     * ordinal with the constants of its type given once alongside,
+     *
+     * e.g. { "value" : { "e" : 1 }, "enums" : { "net.corda.E" : [ "A", "B" ] } }
+     */
+    AMQP_FORMAT_JSON_ENUM_CODES = 2
+} amqp_format_t;
+
+typedef enum {
+    AMQP_OK        = 0,
+
+    /**
+     * The blob isn't a well formed Corda blob or its payload doesn't
+     * match its schema. The result is a description of what's wrong.
+     */
+    AMQP_MALFORMED = 1,
+
+    /**
+     * The result didn't fit in what was left of the output buffer. Its
+     * size is the space it needs, nothing was written and the batch
+     * stopped at this blob.
+     */
+    AMQP_NO_SPACE  = 2,
+
+    /**
+     * Anything else, the result is a description of what went wrong
+     */
+    AMQP_FAILED    = 3
+} amqp_status_t;
+
+typedef struct {
+    int32_t  status;
+
+    /**
+     * Where in the output buffer the result was written and its size,
+     * there's no terminating null
+     */
+    size_t   offset;
+    size_t   size;
+
+    /**
+     * For a malformed blob the offset into it, header included, of
+     * where it was found to be wrong
+     */
+    size_t   error_offset;
+} amqp_result_t;
+
+/**
+ * Null if there's not the memory for one
+ */
+AMQP_API amqp_decoder_t * amqp_decoder_new (void);
+
+AMQP_API void amqp_decoder_free (amqp_decoder_t * decoder);
+
+/**
+ * Decode the [count] blobs of [blobs], writing each result into [out]
+ * after the one before and its status, offset and size into the matching
+ * entry of [results].
+ *
+ * Returns how many blobs were decoded. That's [count] unless a result
+ * didn't fit, in which case the result of the blob after the last one
+ * decoded is AMQP_NO_SPACE and those after it are untouched; call again
+ * from that blob with more space.
+ */
+AMQP_API size_t amqp_decode (
+    amqp_decoder_t *    decoder,
+    const amqp_blob_t * blobs,
+    size_t              count,
+    amqp_format_t       format,
+    char *              out,
+    size_t              capacity,
+    amqp_result_t *     results);
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
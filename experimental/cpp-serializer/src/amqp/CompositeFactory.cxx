@@ -15,6 +15,7 @@
 
 #include "reader/Reader.h"
 #include "reader/CompositeReader.h"
+#include "reader/DispatchReader.h"
 #include "reader/RestrictedReader.h"
 #include "reader/restricted-readers/MapReader.h"
 #include "reader/restricted-readers/ListReader.h"
@@ -84,14 +85,97 @@ namespace {
 void
 amqp::internal::
 CompositeFactory::process (const SchemaType & schema_) {
+    static const schema::TransformSchema none;
+
+    process (schema_, none);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+CompositeFactory::process (
+    const SchemaType & schema_,
+    const schema::TransformSchema & transforms_
+) {
     DBG ("process schema" << std::endl);
 
+    m_transforms = &transforms_;
+
     for (const auto & i : dynamic_cast<const schema::Schema &>(schema_)) {
         for (const auto & j : i) {
             process (*j);
             m_readersByDescriptor[j->descriptor()] = m_readersByType[j->name()];
         }
     }
+
+    m_transforms = nullptr;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+CompositeFactory::validate (bool validate_) {
+    m_validate = validate_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+CompositeFactory::trust() {
+    m_trusted = true;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+CompositeFactory::share (std::shared_ptr<Mappings> mappings_) {
+    m_mappings = std::move (mappings_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+CompositeFactory::expect (
+    const SchemaType & schema_,
+    const schema::TransformSchema & transforms_
+) {
+    for (const auto & i : dynamic_cast<const schema::Schema &>(schema_)) {
+        for (const auto & j : i) {
+            if (j->type() == schema::AMQPTypeNotation::composite_t) {
+                auto & expected = m_expectedComposites[j->name()];
+
+                expected.descriptor = j->descriptor();
+
+                for (const auto & f : dynamic_cast<const schema::Composite &> (*j).fields()) {
+                    expected.fields.push_back ({
+                        f->name(), f->type(), f->defaultValue(), f->mandatory() });
+                }
+
+                continue;
+            }
+
+            const auto & restricted = dynamic_cast<const schema::Restricted &> (*j);
+
+            if (restricted.restrictedType() != schema::Restricted::RestrictedTypes::enum_t) {
+                continue;
+            }
+
+            auto & expected = m_expectedEnums[j->name()];
+
+            expected.descriptor = j->descriptor();
+            expected.constants = dynamic_cast<const schema::Enum &> (
+                restricted).makeChoices();
+
+            for (const auto & t : transforms_.transforms (j->name())) {
+                expected.transforms.emplace_back (*t);
+            }
+        }
+    }
 }
 
 /******************************************************************************/
@@ -127,11 +211,14 @@ CompositeFactory::processComposite (
 ) {
     DBG ("processComposite - " << type_.name() << std::endl);
     std::vector<std::weak_ptr<reader::Reader>> readers;
+    std::vector<std::string> names;
+    std::vector<bool> mandatory;
 
     const auto & fields = dynamic_cast<const schema::Composite &> (
             type_).fields();
 
     readers.reserve (fields.size());
+    names.reserve (fields.size());
 
     for (const auto & field : fields) {
         DBG ("  Field: " << field->name() << ": \"" << field->type()
@@ -144,23 +231,65 @@ CompositeFactory::processComposite (
             reader = computeIfAbsent<reader::Reader> (
                     m_readersByType,
                     field->resolvedType(),
-                    [&field]() -> std::shared_ptr<reader::PropertyReader> {
-                        return reader::PropertyReader::make (field);
+                    [&field, this]() -> std::shared_ptr<reader::PropertyReader> {
+                        return reader::PropertyReader::make (field, m_trusted, this);
                     });
         }
         else {
             // Insertion sorting ensures any type we depend on will have
-            // already been created and thus exist in the map
-            reader = m_readersByType[field->resolvedType()];
+            // already been created and thus exist in the map, unless
+            // it's an interface or abstract class in which case only
+            // its implementations are in the schema
+            auto declared = m_readersByType.find (field->resolvedType());
+
+            if (field->type() == "*" || declared == m_readersByType.end()) {
+                reader = m_dispatchers.emplace_back (
+                    std::make_shared<reader::DispatchReader> (
+                        field->resolvedType(),
+                        m_readersByDescriptor,
+                        declared == m_readersByType.end()
+                            ? decltype (reader) { }
+                            : declared->second));
+            } else {
+                reader = declared->second;
+            }
         }
 
-
         assert (reader);
         readers.emplace_back (reader);
+        names.push_back (field->name());
         assert (readers.back().lock());
+
+        if (!m_trusted) {
+            mandatory.push_back (field->mandatory());
+        }
     }
 
-    return std::make_shared<reader::CompositeReader> (type_.name(), readers);
+    auto expected = m_expectedComposites.find (type_.name());
+
+    // the same fingerprint means the same fields, nothing to map
+    if (expected == m_expectedComposites.end()
+        || expected->second.descriptor == type_.descriptor())
+    {
+        return std::make_shared<reader::CompositeReader> (
+            type_.name(), readers, names, std::move (mandatory));
+    }
+
+    auto & mapping = m_mappings->fieldMapping (
+        type_.descriptor(), expected->second.descriptor);
+
+    if (!mapping) {
+        mapping = std::make_shared<const reader::FieldMapping> (
+            type_.name(),
+            fields,
+            expected->second.fields);
+    }
+
+    return std::make_shared<reader::CompositeReader> (
+        type_.name(),
+        readers,
+        mapping,
+        std::move (mandatory));
 }
 
 /******************************************************************************/
@@ -172,9 +301,44 @@ CompositeFactory::processEnum (
 ) {
     DBG ("Processing Enum - " << enum_.name() << std::endl); // NOLINT
 
+    auto expected = m_expectedEnums.find (enum_.name());
+
+    if (expected == m_expectedEnums.end()) {
+        return std::make_shared<reader::EnumReader> (
+            enum_.name(),
+            enum_.makeChoices(),
+            m_validate);
+    }
+
+    auto & table = m_mappings->enumTransforms (
+        enum_.descriptor(), expected->second.descriptor);
+
+    if (!table) {
+        std::vector<const schema::TransformElement *> transforms;
+
+        if (m_transforms) {
+            for (const auto & t : m_transforms->transforms (enum_.name())) {
+                transforms.push_back (t.get());
+            }
+        }
+
+        for (const auto & t : expected->second.transforms) {
+            transforms.push_back (&t);
+        }
+
+        table = std::make_shared<const schema::EnumTransforms> (
+            schema::compileEnumTransforms (
+                enum_.makeChoices(),
+                expected->second.constants,
+                transforms));
+    }
+
     return std::make_shared<reader::EnumReader> (
         enum_.name(),
-        enum_.makeChoices());
+        enum_.makeChoices(),
+        expected->second.constants,
+        table,
+        m_validate);
 }
 
 /******************************************************************************/
@@ -191,11 +355,19 @@ CompositeFactory::fetchReaderForRestricted (const std::string & type_) {
         rtn = computeIfAbsent<reader::Reader>(
                 m_readersByType,
                 type_,
-                [& type_]() -> std::shared_ptr<reader::PropertyReader> {
-                    return reader::PropertyReader::make (type_);
+                [& type_, this]() -> std::shared_ptr<reader::PropertyReader> {
+                    return reader::PropertyReader::make (type_, m_trusted, this);
                 });
+    } else if (auto it = m_readersByType.find (type_) ; it != m_readersByType.end()) {
+        rtn = it->second;
     } else {
-        rtn = m_readersByType[type_];
+        // a container of an interface or abstract class, each element
+        // says what it is
+        rtn = m_dispatchers.emplace_back (
+            std::make_shared<reader::DispatchReader> (
+                type_,
+                m_readersByDescriptor,
+                decltype (rtn) { }));
     }
 
     if (!rtn) {
@@ -5,9 +5,11 @@
 #include <map>
 #include <set>
 #include <memory>
+#include <vector>
 
 #include "types.h"
 
+#include "amqp/Mappings.h"
 #include "amqp/ICompositeFactory.h"
 #include "amqp/schema/described-types/Schema.h"
 #include "amqp/schema/described-types/Envelope.h"
@@ -17,6 +19,9 @@
 #include "amqp/schema/restricted-types/Array.h"
 #include "amqp/schema/restricted-types/List.h"
 #include "amqp/schema/restricted-types/Enum.h"
+#include "amqp/schema/described-types/TransformSchema.h"
+#include "amqp/schema/EnumTransforms.h"
+#include "amqp/reader/FieldMapping.h"
 
 /******************************************************************************/
 
@@ -29,14 +34,94 @@ namespace amqp::internal {
             using CompositePtr = uPtr<schema::Composite>;
             using EnvelopePtr  = uPtr<schema::Envelope>;
 
+            /**
+             * The constants, and the transforms applied to get there, of an
+             * enum as the caller expects to read it
+             */
+            struct ExpectedEnum {
+                std::string                           descriptor;
+                std::vector<std::string>              constants;
+                std::vector<schema::TransformElement> transforms;
+            };
+
+            /**
+             * The fields of a composite as the caller expects to read it
+             */
+            struct ExpectedComposite {
+                std::string                        descriptor;
+                std::vector<reader::ExpectedField> fields;
+            };
+
             spStrMap_t<reader::Reader> m_readersByType;
             spStrMap_t<reader::Reader> m_readersByDescriptor;
 
+            /**
+             * One per field, or container, whose type is only known from
+             * the descriptor written with each value. The readers that
+             * use them only hold weak references
+             */
+            std::vector<std::shared_ptr<reader::Reader>> m_dispatchers;
+
+            std::map<std::string, ExpectedEnum> m_expectedEnums;
+            std::map<std::string, ExpectedComposite> m_expectedComposites;
+
+            /**
+             * Compiled field mappings and transform tables, our own
+             * unless we're given somewhere longer lived to keep them
+             */
+            std::shared_ptr<Mappings> m_mappings { std::make_shared<Mappings>() };
+
+            /**
+             * The transforms of the schema currently being processed
+             */
+            const schema::TransformSchema * m_transforms { nullptr };
+
+            bool m_validate { false };
+
+            bool m_trusted { false };
+
         public :
             CompositeFactory() = default;
 
             void process (const SchemaType &) override;
 
+            void process (const SchemaType &, const schema::TransformSchema &);
+
+            /**
+             * Have the readers cross check redundant information in the
+             * blob, such as the name written alongside each enum's
+             * ordinal, rather than trusting it. Must be called before
+             * [process]
+             */
+            void validate (bool validate_);
+
+            /**
+             * The blob came from somewhere we trust, typically our own
+             * node's vault, so build property readers that skip checking
+             * each value's type tag and the UTF-8 of its strings. A blob
+             * that isn't what its schema says it is will be misread
+             * rather than rejected. Must be called before [process]
+             */
+            void trust();
+
+            /**
+             * Look for what's needed to read one version of a type as
+             * another in [mappings_], and keep anything compiled there,
+             * so it's shared with other factories. Must be called before
+             * [process]
+             */
+            void share (std::shared_ptr<Mappings> mappings_);
+
+            /**
+             * Read types as they appear in [schema_] rather than as they
+             * were written. Enum constants are mapped between the two
+             * using the transforms of both and composite fields are
+             * matched by name, those we don't expect being skipped and
+             * those missing given their default. Must be called before
+             * [process]
+             */
+            void expect (const SchemaType & schema_, const schema::TransformSchema &);
+
             const std::shared_ptr<ReaderType> byType (
                     const std::string &) override;
 
@@ -0,0 +1,29 @@
+#include "Mappings.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::Mappings
+ *
+ ******************************************************************************/
+
+std::shared_ptr<const amqp::internal::reader::FieldMapping> &
+amqp::internal::
+Mappings::fieldMapping (
+    const std::string & wire_,
+    const std::string & expected_
+) {
+    return m_fields[Key (wire_, expected_)];
+}
+
+/******************************************************************************/
+
+std::shared_ptr<const amqp::internal::schema::EnumTransforms> &
+amqp::internal::
+Mappings::enumTransforms (
+    const std::string & wire_,
+    const std::string & expected_
+) {
+    return m_enums[Key (wire_, expected_)];
+}
+
+/******************************************************************************/
@@ -0,0 +1,55 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "amqp/reader/FieldMapping.h"
+#include "amqp/schema/EnumTransforms.h"
+
+/******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * What a [CompositeFactory] compiles to read one version of a type as
+     * another, kept so the factories of a run over many blobs, which
+     * almost always share their schemas, compile each only once. Keyed
+     * by the fingerprints of the type as it was written and as it's
+     * expected.
+     *
+     * Not thread safe, share one between factories used on one thread.
+     */
+    class Mappings {
+        private :
+            using Key = std::pair<std::string, std::string>;
+
+            std::map<Key, std::shared_ptr<const reader::FieldMapping>> m_fields;
+            std::map<Key, std::shared_ptr<const schema::EnumTransforms>> m_enums;
+
+        public :
+            /**
+             * The field mapping of a composite written as [wire_] and
+             * read as [expected_], empty until it's been compiled
+             */
+            std::shared_ptr<const reader::FieldMapping> & fieldMapping (
+                const std::string & wire_,
+                const std::string & expected_);
+
+            /**
+             * The transform table of an enum written as [wire_] and read
+             * as [expected_], empty until it's been compiled
+             */
+            std::shared_ptr<const schema::EnumTransforms> & enumTransforms (
+                const std::string & wire_,
+                const std::string & expected_);
+
+            size_t size() const { return m_fields.size() + m_enums.size(); }
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,150 @@
+#include "amqp/CDecoder.h"
+
+#include <new>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+
+#include "wire/Blob.h"
+#include "wire/Text.h"
+#include "wire/Cursor.h"
+#include "wire/Verifier.h"
+#include "wire/TypeCache.h"
+
+/******************************************************************************/
+
+/**
+ * What's kept between batches, the types of every schema seen and the
+ * buffer each result is rendered into before it's copied out
+ */
+struct amqp_decoder {
+    amqp::internal::wire::TypeCache types;
+    std::string                     scratch;
+
+    std::vector<const amqp::internal::wire::Type *> enums;
+};
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::wire;
+
+    /**
+     * Render [blob_] into the decoder's scratch buffer, throwing as the
+     * rest of the library does if it can't be
+     */
+    void
+    render (amqp_decoder_t & decoder_, const amqp_blob_t & blob_, amqp_format_t format_) {
+        Blob blob (blob_.bytes, blob_.size);
+
+        auto [types, type] = decoder_.types.root (blob);
+
+        auto cursor = blob.object();
+
+        switch (format_) {
+            case AMQP_FORMAT_JSON :
+                text (cursor, *type, cursor.code(), decoder_.scratch, Style { true, nullptr });
+                break;
+            case AMQP_FORMAT_JSON_ENUM_CODES :
+                enumCodes (cursor, *type, decoder_.scratch, decoder_.enums);
+                break;
+            case AMQP_FORMAT_BINARY :
+                Verifier (*types).verify (cursor);
+
+                decoder_.scratch.assign (
+                    blob_.bytes + blob.objectStart(),
+                    blob.objectEnd() - blob.objectStart());
+                break;
+            default :
+                throw std::invalid_argument ("Unknown output format");
+        }
+    }
+
+    /**
+     * Decode one blob into the scratch buffer, the status of the attempt
+     */
+    amqp_status_t
+    decode (
+        amqp_decoder_t & decoder_,
+        const amqp_blob_t & blob_,
+        amqp_format_t format_,
+        amqp_result_t & result_
+    ) {
+        decoder_.scratch.clear();
+        result_.error_offset = 0;
+
+        try {
+            render (decoder_, blob_, format_);
+            return AMQP_OK;
+        } catch (const Error & e) {
+            decoder_.scratch = e.what();
+            result_.error_offset = e.offset();
+            return AMQP_MALFORMED;
+        } catch (const std::exception & e) {
+            decoder_.scratch = e.what();
+            return AMQP_FAILED;
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+amqp_decoder_t *
+amqp_decoder_new() {
+    return new (std::nothrow) amqp_decoder { };
+}
+
+/******************************************************************************/
+
+void
+amqp_decoder_free (amqp_decoder_t * decoder_) {
+    delete decoder_;
+}
+
+/******************************************************************************/
+
+size_t
+amqp_decode (
+    amqp_decoder_t *    decoder_,
+    const amqp_blob_t * blobs_,
+    size_t              count_,
+    amqp_format_t       format_,
+    char *              out_,
+    size_t              capacity_,
+    amqp_result_t *     results_
+) {
+    size_t used { 0 };
+
+    for (size_t i { 0 } ; i < count_ ; ++i) {
+        auto & result = results_[i];
+
+        // nothing can escape to a caller that isn't C++, running out of
+        // memory included
+        try {
+            result.status = decode (*decoder_, blobs_[i], format_, result);
+        } catch (...) {
+            result.status = AMQP_FAILED;
+            result.size = 0;
+            result.offset = used;
+            continue;
+        }
+
+        result.offset = used;
+        result.size = decoder_->scratch.size();
+
+        if (result.size > capacity_ - used) {
+            result.status = AMQP_NO_SPACE;
+            return i;
+        }
+
+        std::memcpy (out_ + used, decoder_->scratch.data(), result.size);
+        used += result.size;
+    }
+
+    return count_;
+}
+
+/******************************************************************************/
@@ -0,0 +1,412 @@
+#include "Diff.h"
+
+#include <map>
+#include <cstring>
+#include <algorithm>
+
+#include "wire/Blob.h"
+#include "wire/Text.h"
+
+/******************************************************************************/
+
+using amqp::internal::wire::Cursor;
+using amqp::internal::wire::Type;
+
+namespace codes = amqp::internal::wire::codes;
+
+/******************************************************************************/
+
+namespace {
+
+    const Type &
+    root (const amqp::internal::wire::TypeTable & types_, Cursor cursor_) {
+        if (cursor_.code() != codes::DESCRIBED) {
+            cursor_.fail ("Expected a described object");
+        }
+
+        auto code = cursor_.code();
+
+        if (!Cursor::isSymbol (code)) {
+            cursor_.fail ("Expected a fingerprint");
+        }
+
+        auto type = types_.byDescriptor (cursor_.bytes (code));
+
+        if (!type) {
+            cursor_.fail ("Fingerprint not found in the schema");
+        }
+
+        return *type;
+    }
+
+    std::string
+    field (const std::string & path_, const std::string & field_) {
+        return path_.empty() ? field_ : path_ + "." + field_;
+    }
+
+    std::string
+    element (const std::string & path_, const std::string & key_) {
+        return path_ + "[" + key_ + "]";
+    }
+
+    /**
+     * Render the value at [offset_] without disturbing [cursor_]
+     */
+    std::string
+    textAt (const Cursor & cursor_, size_t offset_, const Type & type_) {
+        auto c = cursor_;
+        c.seek (offset_);
+
+        return amqp::internal::wire::text (c, type_);
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::diff::diff
+ *
+ ******************************************************************************/
+
+std::vector<amqp::internal::diff::Difference>
+amqp::internal::diff::
+diff (
+    const char * from_, size_t fromSize_,
+    const char * to_, size_t toSize_
+) {
+    wire::Blob from (from_, fromSize_);
+    wire::Blob to (to_, toSize_);
+
+    auto fromTypes = from.types();
+    auto toTypes = to.types();
+
+    auto fromCursor = from.object();
+    auto toCursor = to.object();
+
+    std::vector<Difference> rtn;
+
+    Differ (rtn).value (
+        fromCursor, root (*fromTypes, fromCursor),
+        toCursor, root (*toTypes, toCursor),
+        "");
+
+    return rtn;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::diff::Differ
+ *
+ ******************************************************************************/
+
+amqp::internal::diff::
+Differ::Differ (std::vector<Difference> & differences_)
+    : m_differences (differences_)
+{ }
+
+/******************************************************************************/
+
+void
+amqp::internal::diff::
+Differ::report (
+    const std::string & path_,
+    std::optional<std::string> from_,
+    std::optional<std::string> to_
+) {
+    m_differences.push_back ({ path_, std::move (from_), std::move (to_) });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::diff::
+Differ::value (
+    Cursor & from_, const Type & fromType_,
+    Cursor & to_, const Type & toType_,
+    const std::string & path_
+) {
+    auto fromEnd = from_;
+    auto toEnd = to_;
+
+    fromEnd.skip();
+    toEnd.skip();
+
+    auto size = fromEnd.offset() - from_.offset();
+
+    // identical encodings are identical values, no need to look inside
+    if (size == toEnd.offset() - to_.offset()
+        && std::memcmp (from_.data(), to_.data(), size) == 0)
+    {
+        from_ = fromEnd;
+        to_ = toEnd;
+        return;
+    }
+
+    auto structured = [](const Type & type_) {
+        return type_.kind == Type::Kind::composite_t
+            || type_.kind == Type::Kind::list_t
+            || type_.kind == Type::Kind::array_t
+            || type_.kind == Type::Kind::map_t;
+    };
+
+    if (fromType_.kind != toType_.kind
+        || !structured (fromType_)
+        || from_.peek() != codes::DESCRIBED
+        || to_.peek() != codes::DESCRIBED)
+    {
+        leaf (from_, fromType_, to_, toType_, path_);
+        from_ = fromEnd;
+        to_ = toEnd;
+        return;
+    }
+
+    auto a = from_;
+    auto b = to_;
+
+    a.code();
+    b.code();
+
+    auto da = a.code();
+    auto db = b.code();
+
+    // one or both is a reference to an earlier object, nothing to descend into
+    if (!Cursor::isSymbol (da) || !Cursor::isSymbol (db)) {
+        leaf (from_, fromType_, to_, toType_, path_);
+        from_ = fromEnd;
+        to_ = toEnd;
+        return;
+    }
+
+    // for an interface, the implementations each side holds
+    auto fromType = fromType_.instance (a.bytes (da));
+    auto toType = toType_.instance (b.bytes (db));
+
+    if (!fromType) {
+        a.fail ("Fingerprint doesn't match the expected type");
+    }
+
+    if (!toType) {
+        b.fail ("Fingerprint doesn't match the expected type");
+    }
+
+    if (fromType->kind != toType->kind) {
+        leaf (from_, fromType_, to_, toType_, path_);
+        from_ = fromEnd;
+        to_ = toEnd;
+        return;
+    }
+
+    switch (fromType->kind) {
+        case Type::Kind::composite_t :
+            composite (a, *fromType, b, *toType, path_);
+            break;
+        case Type::Kind::map_t :
+            map (a, *fromType, b, *toType, path_);
+            break;
+        default :
+            if (Cursor::isList (a.peek()) && Cursor::isList (b.peek())) {
+                list (a, *fromType, b, *toType, path_);
+            } else {
+                leaf (from_, fromType_, to_, toType_, path_);
+            }
+            break;
+    }
+
+    from_ = fromEnd;
+    to_ = toEnd;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::diff::
+Differ::leaf (
+    Cursor & from_, const Type & fromType_,
+    Cursor & to_, const Type & toType_,
+    const std::string & path_
+) {
+    auto a = wire::text (from_, fromType_);
+    auto b = wire::text (to_, toType_);
+
+    if (a != b) {
+        report (path_, std::move (a), std::move (b));
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * The same version of a type compares field by field, different ones
+ * match their fields by name
+ */
+void
+amqp::internal::diff::
+Differ::composite (
+    Cursor & from_, const Type & fromType_,
+    Cursor & to_, const Type & toType_,
+    const std::string & path_
+) {
+    auto ca = from_.code();
+    auto cb = to_.code();
+
+    if (!Cursor::isList (ca)) from_.fail ("Expected a list of fields");
+    if (!Cursor::isList (cb)) to_.fail ("Expected a list of fields");
+
+    auto la = from_.compound (ca);
+    auto lb = to_.compound (cb);
+
+    if (la.count > fromType_.fields.size()) from_.fail ("More values than fields");
+    if (lb.count > toType_.fields.size()) to_.fail ("More values than fields");
+
+    if (fromType_.descriptor == toType_.descriptor) {
+        for (uint32_t i { 0 } ; i < std::min (la.count, lb.count) ; ++i) {
+            value (
+                from_, *fromType_.children[i],
+                to_, *toType_.children[i],
+                field (path_, fromType_.fields[i]));
+        }
+
+        for (auto i = lb.count ; i < la.count ; ++i) {
+            report (
+                field (path_, fromType_.fields[i]),
+                wire::text (from_, *fromType_.children[i]),
+                std::nullopt);
+        }
+
+        for (auto i = la.count ; i < lb.count ; ++i) {
+            report (
+                field (path_, toType_.fields[i]),
+                std::nullopt,
+                wire::text (to_, *toType_.children[i]));
+        }
+
+        return;
+    }
+
+    std::vector<size_t> oa, ob;
+
+    for (uint32_t i { 0 } ; i < la.count ; ++i) {
+        oa.push_back (from_.offset());
+        from_.skip();
+    }
+
+    for (uint32_t i { 0 } ; i < lb.count ; ++i) {
+        ob.push_back (to_.offset());
+        to_.skip();
+    }
+
+    auto find = [](const Type & type_, size_t count_, const std::string & name_) {
+        auto end = type_.fields.begin() + count_;
+        return static_cast<size_t>(std::find (type_.fields.begin(), end, name_) - type_.fields.begin());
+    };
+
+    for (size_t i { 0 } ; i < la.count ; ++i) {
+        const auto & name = fromType_.fields[i];
+        auto j = find (toType_, lb.count, name);
+
+        if (j == lb.count) {
+            report (field (path_, name), textAt (from_, oa[i], *fromType_.children[i]), std::nullopt);
+            continue;
+        }
+
+        auto a = from_;
+        auto b = to_;
+
+        a.seek (oa[i]);
+        b.seek (ob[j]);
+
+        value (a, *fromType_.children[i], b, *toType_.children[j], field (path_, name));
+    }
+
+    for (size_t j { 0 } ; j < lb.count ; ++j) {
+        const auto & name = toType_.fields[j];
+
+        if (find (fromType_, la.count, name) == la.count) {
+            report (field (path_, name), std::nullopt, textAt (to_, ob[j], *toType_.children[j]));
+        }
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::diff::
+Differ::list (
+    Cursor & from_, const Type & fromType_,
+    Cursor & to_, const Type & toType_,
+    const std::string & path_
+) {
+    auto la = from_.compound (from_.code());
+    auto lb = to_.compound (to_.code());
+
+    const auto & ea = *fromType_.children[0];
+    const auto & eb = *toType_.children[0];
+
+    for (uint32_t i { 0 } ; i < std::min (la.count, lb.count) ; ++i) {
+        value (from_, ea, to_, eb, element (path_, std::to_string (i)));
+    }
+
+    for (auto i = lb.count ; i < la.count ; ++i) {
+        report (element (path_, std::to_string (i)), wire::text (from_, ea), std::nullopt);
+    }
+
+    for (auto i = la.count ; i < lb.count ; ++i) {
+        report (element (path_, std::to_string (i)), std::nullopt, wire::text (to_, eb));
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Maps compare entry by entry, matched on the text of their keys
+ */
+void
+amqp::internal::diff::
+Differ::map (
+    Cursor & from_, const Type & fromType_,
+    Cursor & to_, const Type & toType_,
+    const std::string & path_
+) {
+    auto ca = from_.code();
+    auto cb = to_.code();
+
+    if (!Cursor::isMap (ca)) from_.fail ("Expected a map");
+    if (!Cursor::isMap (cb)) to_.fail ("Expected a map");
+
+    auto ma = from_.compound (ca);
+    auto mb = to_.compound (cb);
+
+    std::map<std::string, size_t> entries;
+
+    for (uint32_t i { 0 } ; i < mb.count ; i += 2) {
+        auto key = wire::text (to_, *toType_.children[0]);
+        entries[key] = to_.offset();
+        to_.skip();
+    }
+
+    for (uint32_t i { 0 } ; i < ma.count ; i += 2) {
+        auto key = wire::text (from_, *fromType_.children[0]);
+        auto entry = entries.find (key);
+
+        if (entry == entries.end()) {
+            report (element (path_, key), wire::text (from_, *fromType_.children[1]), std::nullopt);
+            continue;
+        }
+
+        auto b = to_;
+        b.seek (entry->second);
+
+        value (from_, *fromType_.children[1], b, *toType_.children[1], element (path_, key));
+
+        entries.erase (entry);
+    }
+
+    for (const auto & entry : entries) {
+        report (
+            element (path_, entry.first),
+            std::nullopt,
+            textAt (to_, entry.second, *toType_.children[1]));
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,94 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <optional>
+
+#include "wire/Cursor.h"
+#include "wire/TypeTable.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::diff {
+
+    /**
+     * A value that differs between two blobs. [path] locates it from the
+     * root object, fields separated by dots and elements of collections
+     * in brackets, e.g. "amount.tokens[3]". A value missing from one side,
+     * because the field or element doesn't exist there, is empty.
+     */
+    struct Difference {
+        std::string                path;
+        std::optional<std::string> from;
+        std::optional<std::string> to;
+    };
+
+    /**
+     * Compare the payloads of two complete Corda blobs field by field.
+     *
+     * The payloads are walked in lockstep using their own schemas so the
+     * blobs may have been written by different versions of a type, fields
+     * are then matched by name. Wherever the encodings of two matching
+     * values are byte for byte identical they're skipped without being
+     * decoded, so comparing near identical blobs costs little more than
+     * a memcmp.
+     *
+     * @throws wire::Error if either blob is malformed
+     */
+    std::vector<Difference> diff (
+        const char * from_, size_t fromSize_,
+        const char * to_, size_t toSize_);
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::diff {
+
+    class Differ {
+        private :
+            std::vector<Difference> & m_differences;
+
+            void report (
+                const std::string &,
+                std::optional<std::string>,
+                std::optional<std::string>);
+
+            void leaf (
+                wire::Cursor &, const wire::Type &,
+                wire::Cursor &, const wire::Type &,
+                const std::string &);
+
+            void composite (
+                wire::Cursor &, const wire::Type &,
+                wire::Cursor &, const wire::Type &,
+                const std::string &);
+
+            void list (
+                wire::Cursor &, const wire::Type &,
+                wire::Cursor &, const wire::Type &,
+                const std::string &);
+
+            void map (
+                wire::Cursor &, const wire::Type &,
+                wire::Cursor &, const wire::Type &,
+                const std::string &);
+
+        public :
+            explicit Differ (std::vector<Difference> & differences_);
+
+            /**
+             * Compare the value of [fromType_] at [from_] with that of
+             * [toType_] at [to_], leaving both cursors after them
+             */
+            void value (
+                wire::Cursor & from_, const wire::Type & fromType_,
+                wire::Cursor & to_, const wire::Type & toType_,
+                const std::string & path_);
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,308 @@
+#include "Expression.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::filter;
+
+    /**
+     * A recursive descent parser over the grammar
+     *
+     *      or         := and ( "||" and )*
+     *      and        := unary ( "&&" unary )*
+     *      unary      := "!" unary | "(" or ")" | comparison
+     *      comparison := path ( op literal | "in" "[" literal ( "," literal )* "]" )?
+     *      path       := identifier ( "." identifier )*
+     */
+    class Parser {
+        private :
+            const std::string & m_text;
+            size_t m_pos { 0 };
+
+            [[noreturn]] void fail (const std::string & what_) const {
+                throw std::runtime_error (
+                    "Bad filter at character " + std::to_string (m_pos + 1)
+                        + ": " + what_);
+            }
+
+            void space() {
+                while (m_pos < m_text.size() && std::isspace (m_text[m_pos])) {
+                    ++m_pos;
+                }
+            }
+
+            static bool identStart (char c_) {
+                return std::isalpha (c_) || c_ == '_' || c_ == '$';
+            }
+
+            static bool identPart (char c_) {
+                return std::isalnum (c_) || c_ == '_' || c_ == '$';
+            }
+
+            /**
+             * Consume [token_] if it's next, words must not run on into
+             * an identifier
+             */
+            bool accept (const char * token_) {
+                space();
+
+                auto len = std::char_traits<char>::length (token_);
+
+                if (m_text.compare (m_pos, len, token_) != 0) {
+                    return false;
+                }
+
+                if (identStart (token_[0])
+                    && m_pos + len < m_text.size()
+                    && identPart (m_text[m_pos + len]))
+                {
+                    return false;
+                }
+
+                m_pos += len;
+
+                return true;
+            }
+
+            void expect (const char * token_) {
+                if (!accept (token_)) {
+                    fail (std::string ("expected ") + token_);
+                }
+            }
+
+            std::string identifier() {
+                space();
+
+                if (m_pos == m_text.size() || !identStart (m_text[m_pos])) {
+                    fail ("expected a field name");
+                }
+
+                auto start = m_pos;
+
+                while (m_pos < m_text.size() && identPart (m_text[m_pos])) {
+                    ++m_pos;
+                }
+
+                return m_text.substr (start, m_pos - start);
+            }
+
+            Literal literal() {
+                space();
+
+                Literal rtn;
+
+                if (accept ("null")) {
+                    return rtn;
+                }
+
+                if (accept ("true")) {
+                    rtn.kind = Literal::Kind::bool_t;
+                    rtn.b = true;
+                    return rtn;
+                }
+
+                if (accept ("false")) {
+                    rtn.kind = Literal::Kind::bool_t;
+                    return rtn;
+                }
+
+                if (m_pos == m_text.size()) {
+                    fail ("expected a value");
+                }
+
+                auto quote = m_text[m_pos];
+
+                if (quote == '"' || quote == '\'') {
+                    rtn.kind = Literal::Kind::string_t;
+
+                    for (++m_pos ; ; ++m_pos) {
+                        if (m_pos == m_text.size()) {
+                            fail ("unterminated string");
+                        }
+
+                        if (m_text[m_pos] == quote) {
+                            ++m_pos;
+                            return rtn;
+                        }
+
+                        if (m_text[m_pos] == '\\' && m_pos + 1 < m_text.size()) {
+                            ++m_pos;
+                        }
+
+                        rtn.s.push_back (m_text[m_pos]);
+                    }
+                }
+
+                const char * start = m_text.c_str() + m_pos;
+                char * end;
+
+                auto i = std::strtoll (start, &end, 10);
+
+                if (end == start) {
+                    fail ("expected a value");
+                }
+
+                if (*end == '.' || *end == 'e' || *end == 'E') {
+                    rtn.kind = Literal::Kind::double_t;
+                    rtn.d = std::strtod (start, &end);
+                } else {
+                    rtn.kind = Literal::Kind::int_t;
+                    rtn.i = i;
+                }
+
+                m_pos += end - start;
+
+                return rtn;
+            }
+
+            uPtr<Expression> comparison() {
+                std::vector<std::string> path { identifier() };
+
+                while (accept (".")) {
+                    path.push_back (identifier());
+                }
+
+                static const std::pair<const char *, Expression::Op> ops[] {
+                    { "==", Expression::Op::eq_t },
+                    { "!=", Expression::Op::ne_t },
+                    { "<=", Expression::Op::le_t },
+                    { ">=", Expression::Op::ge_t },
+                    { "<",  Expression::Op::lt_t },
+                    { ">",  Expression::Op::gt_t }
+                };
+
+                for (const auto & op : ops) {
+                    if (accept (op.first)) {
+                        return std::make_unique<Expression> (
+                            op.second, std::move (path), std::vector<Literal> { literal() });
+                    }
+                }
+
+                if (accept ("in")) {
+                    std::vector<Literal> set;
+
+                    expect ("[");
+
+                    do {
+                        set.push_back (literal());
+                    } while (accept (","));
+
+                    expect ("]");
+
+                    return std::make_unique<Expression> (
+                        Expression::Op::in_t, std::move (path), std::move (set));
+                }
+
+                Literal t;
+                t.kind = Literal::Kind::bool_t;
+                t.b = true;
+
+                return std::make_unique<Expression> (
+                    Expression::Op::eq_t, std::move (path), std::vector<Literal> { t });
+            }
+
+            uPtr<Expression> unary() {
+                if (accept ("!") || accept ("not")) {
+                    std::vector<uPtr<Expression>> child;
+                    child.push_back (unary());
+
+                    return std::make_unique<Expression> (
+                        Expression::Op::not_t, std::move (child));
+                }
+
+                if (accept ("(")) {
+                    auto rtn = disjunction();
+                    expect (")");
+                    return rtn;
+                }
+
+                return comparison();
+            }
+
+            uPtr<Expression> binary (
+                Expression::Op op_,
+                const char * symbol_,
+                const char * word_,
+                uPtr<Expression> (Parser::*next_)()
+            ) {
+                std::vector<uPtr<Expression>> children;
+
+                children.push_back ((this->*next_)());
+
+                while (accept (symbol_) || accept (word_)) {
+                    children.push_back ((this->*next_)());
+                }
+
+                if (children.size() == 1) {
+                    return std::move (children.front());
+                }
+
+                return std::make_unique<Expression> (op_, std::move (children));
+            }
+
+            uPtr<Expression> conjunction() {
+                return binary (Expression::Op::and_t, "&&", "and", &Parser::unary);
+            }
+
+            uPtr<Expression> disjunction() {
+                return binary (Expression::Op::or_t, "||", "or", &Parser::conjunction);
+            }
+
+        public :
+            explicit Parser (const std::string & text_) : m_text (text_) { }
+
+            uPtr<Expression> parse() {
+                auto rtn = disjunction();
+
+                space();
+
+                if (m_pos != m_text.size()) {
+                    fail ("unexpected trailing input");
+                }
+
+                return rtn;
+            }
+    };
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::filter::Expression
+ *
+ ******************************************************************************/
+
+uPtr<amqp::internal::filter::Expression>
+amqp::internal::filter::
+Expression::parse (const std::string & expression_) {
+    return Parser (expression_).parse();
+}
+
+/******************************************************************************/
+
+amqp::internal::filter::
+Expression::Expression (
+    Op op_,
+    std::vector<uPtr<Expression>> children_
+) : m_op (op_)
+  , m_children (std::move (children_))
+{ }
+
+/******************************************************************************/
+
+amqp::internal::filter::
+Expression::Expression (
+    Op op_,
+    std::vector<std::string> path_,
+    std::vector<Literal> literals_
+) : m_op (op_)
+  , m_path (std::move (path_))
+  , m_literals (std::move (literals_))
+{ }
+
+/******************************************************************************/
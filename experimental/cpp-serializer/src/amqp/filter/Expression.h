@@ -0,0 +1,92 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "types.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::filter {
+
+    struct Literal {
+        enum class Kind { null_t, bool_t, int_t, double_t, string_t };
+
+        Kind        kind { Kind::null_t };
+        bool        b { false };
+        int64_t     i { 0 };
+        double      d { 0.0 };
+        std::string s;
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::filter {
+
+    /**
+     * A parsed filter, independent of any schema. The language is
+     * comparisons of dotted field paths against literals combined with
+     * the usual boolean operators, e.g.
+     *
+     *      owner == "O=Bank A, L=London, C=GB"
+     *      amount.quantity > 1000 && (status in ["PAID", "SETTLED"] || !flagged)
+     *
+     * Comparison operators are == != < <= > >= and in, boolean ones are
+     * && (or "and"), || (or "or") and ! (or "not"). Literals are numbers,
+     * double or single quoted strings, true, false and null. A bare path
+     * is shorthand for path == true.
+     *
+     * Enums compare by constant name, as strings.
+     */
+    class Expression {
+        public :
+            enum class Op {
+                and_t, or_t, not_t,
+                eq_t, ne_t, lt_t, le_t, gt_t, ge_t, in_t
+            };
+
+        private :
+            Op m_op;
+
+            std::vector<std::string>     m_path;
+            std::vector<Literal>         m_literals;
+            std::vector<uPtr<Expression>> m_children;
+
+        public :
+            /**
+             * @throws std::runtime_error describing where [expression_]
+             * stopped making sense
+             */
+            static uPtr<Expression> parse (const std::string & expression_);
+
+            Expression (Op, std::vector<uPtr<Expression>>);
+            Expression (Op, std::vector<std::string>, std::vector<Literal>);
+
+            Op op() const { return m_op; }
+
+            bool comparison() const { return m_op >= Op::eq_t; }
+
+            /**
+             * For comparisons, the field names leading from the root
+             * object to the value compared
+             */
+            const std::vector<std::string> & path() const { return m_path; }
+
+            /**
+             * For comparisons, what the value is compared to, a single
+             * literal or, for in, the set of them
+             */
+            const std::vector<Literal> & literals() const { return m_literals; }
+
+            const std::vector<uPtr<Expression>> & children() const { return m_children; }
+    };
+
+}
+
+/******************************************************************************/
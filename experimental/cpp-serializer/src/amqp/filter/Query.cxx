@@ -0,0 +1,690 @@
+#include "Query.h"
+
+#include <algorithm>
+
+#include "wire/Blob.h"
+
+/******************************************************************************/
+
+using amqp::internal::wire::Cursor;
+
+namespace codes = amqp::internal::wire::codes;
+
+/******************************************************************************/
+
+namespace {
+
+    using amqp::internal::filter::Literal;
+
+    int
+    nibble (char c_) {
+        if (c_ >= '0' && c_ <= '9') return c_ - '0';
+        if (c_ >= 'a' && c_ <= 'f') return c_ - 'a' + 10;
+        if (c_ >= 'A' && c_ <= 'F') return c_ - 'A' + 10;
+
+        return -1;
+    }
+
+    /**
+     * [literals_] as they compare against a binary field, strings of hex
+     * as the bytes they spell out. A string that isn't hex can't equal
+     * any bytes, as a literal of the wrong type can't, so it becomes one.
+     */
+    std::vector<Literal>
+    unhex (const std::vector<Literal> & literals_) {
+        auto rtn = literals_;
+
+        for (auto & literal : rtn) {
+            if (literal.kind != Literal::Kind::string_t) {
+                continue;
+            }
+
+            std::string decoded;
+            bool hex { literal.s.size() % 2 == 0 };
+
+            for (size_t i { 0 } ; hex && i < literal.s.size() ; i += 2) {
+                auto hi = nibble (literal.s[i]);
+                auto lo = nibble (literal.s[i + 1]);
+
+                hex = hi >= 0 && lo >= 0;
+                decoded += static_cast<char>((hi << 4) | lo);
+            }
+
+            if (hex) {
+                literal.s = std::move (decoded);
+            } else {
+                literal.kind = Literal::Kind::bool_t;
+            }
+        }
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::filter::match
+ *
+ ******************************************************************************/
+
+std::vector<bool>
+amqp::internal::filter::
+match (
+    const std::vector<uPtr<Expression>> & expressions_,
+    const char * blob_,
+    size_t size_
+) {
+    return Matcher (expressions_) (blob_, size_);
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::filter::Matcher
+ *
+ ******************************************************************************/
+
+amqp::internal::filter::
+Matcher::Matcher (const std::vector<uPtr<Expression>> & expressions_) {
+    for (const auto & e : expressions_) {
+        m_expressions.push_back (e.get());
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::filter::
+Matcher::~Matcher() = default;
+
+/******************************************************************************/
+
+std::vector<bool>
+amqp::internal::filter::
+Matcher::operator() (const char * blob_, size_t size_) {
+    wire::Blob blob (blob_, size_);
+
+    auto root = m_types.root (blob).second;
+
+    auto & query = m_queries[root];
+
+    if (!query) {
+        query = std::make_unique<Query> (m_expressions, *root);
+    }
+
+    auto cursor = blob.object();
+
+    return query->evaluate (cursor);
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::filter::Query
+ *
+ ******************************************************************************/
+
+struct amqp::internal::filter::Query::State {
+    std::vector<Result> comparisons;
+    std::vector<Result> results;
+    size_t              undecided;
+};
+
+/******************************************************************************/
+
+amqp::internal::filter::
+Query::Query (
+    const std::vector<const Expression *> & expressions_,
+    const wire::Type & root_
+) : m_root (root_) {
+    for (const auto * e : expressions_) {
+        m_roots.push_back (compile (*e));
+    }
+
+    gather (m_step);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::filter::
+Query::compile (const Expression & expression_) {
+    auto index = m_nodes.size();
+
+    m_nodes.push_back ({ expression_.op() });
+
+    if (expression_.comparison()) {
+        m_nodes[index].comparison = m_comparisons.size();
+        m_comparisons.push_back ({ expression_.op(), &expression_.literals() });
+
+        auto comparison = m_nodes[index].comparison;
+
+        if (expression_.path().empty()
+            || !bind (m_step, m_root, comparison, expression_.path(), 0))
+        {
+            m_missing.push_back (comparison);
+        }
+    } else {
+        for (const auto & child : expression_.children()) {
+            auto c = compile (*child);
+            m_nodes[index].children.push_back (c);
+        }
+    }
+
+    return index;
+}
+
+/******************************************************************************/
+
+/**
+ * Resolve the path of comparison [comparison_], from its [from_]th name
+ * on, to the field indices leading to it from [step_], a composite of
+ * [type_], adding steps to the walk as needed.
+ *
+ * @return false if the path doesn't exist
+ */
+bool
+amqp::internal::filter::
+Query::bind (
+    Step & step_,
+    const wire::Type & type_,
+    size_t comparison_,
+    const std::vector<std::string> & path_,
+    size_t from_
+) {
+    if (type_.kind != wire::Type::Kind::composite_t) {
+        return false;
+    }
+
+    auto field = std::find (type_.fields.begin(), type_.fields.end(), path_[from_]);
+
+    if (field == type_.fields.end()) {
+        return false;
+    }
+
+    auto index = field - type_.fields.begin();
+    const auto * child = type_.children[index];
+
+    step_.fields.resize (std::max (step_.fields.size(), type_.fields.size()));
+
+    if (from_ + 1 == path_.size()) {
+        if (child->primitive() || child->kind == wire::Type::Kind::enum_t) {
+            if (child->kind == wire::Type::Kind::binary_t) {
+                auto & comparison = m_comparisons[comparison_];
+                comparison.bytes = unhex (*comparison.literals);
+            }
+
+            step_.fields[index].comparisons.push_back (comparison_);
+            return true;
+        }
+
+        return false;
+    }
+
+    auto & next = step_.fields[index].step;
+
+    if (!next) {
+        next = std::make_unique<Step>();
+    }
+
+    if (!child->implementations) {
+        return bind (*next, *child, comparison_, path_, from_ + 1);
+    }
+
+    // only the value says what implements an interface so bind the rest
+    // of the path against every type that might
+    for (const auto & type : child->implementations->types()) {
+        if (type.second.descriptor.empty()) {
+            continue;
+        }
+
+        auto & implementation = next->implementations[&type.second];
+
+        if (!implementation) {
+            implementation = std::make_unique<Step>();
+        }
+
+        if (!bind (*implementation, type.second, comparison_, path_, from_ + 1)) {
+            implementation->missing.push_back (comparison_);
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::filter::
+Query::gather (Step & step_) {
+    for (auto & field : step_.fields) {
+        step_.all.insert (
+            step_.all.end(), field.comparisons.begin(), field.comparisons.end());
+
+        if (field.step) {
+            gather (*field.step);
+
+            step_.all.insert (
+                step_.all.end(), field.step->all.begin(), field.step->all.end());
+        }
+    }
+
+    for (auto & implementation : step_.implementations) {
+        gather (*implementation.second);
+    }
+
+    // every implementation has the same comparisons, bound or missing, so
+    // any one of them says which are below an interface
+    if (!step_.implementations.empty()) {
+        const auto & any = *step_.implementations.begin()->second;
+
+        step_.all.insert (step_.all.end(), any.all.begin(), any.all.end());
+        step_.all.insert (step_.all.end(), any.missing.begin(), any.missing.end());
+    }
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::filter::
+Query::compare (const Comparison & comparison_, const Value & value_) {
+    /*
+     * Order [value_] against [literal_], false if they can't be compared
+     */
+    auto order = [&value_](const Literal & literal_, int & order_) -> bool {
+        using Kind = Literal::Kind;
+
+        auto sign = [](auto a_, auto b_) { return (a_ > b_) - (a_ < b_); };
+
+        switch (value_.kind) {
+            case Kind::int_t :
+                if (literal_.kind == Kind::int_t) {
+                    order_ = sign (value_.i, literal_.i);
+                    return true;
+                }
+                if (literal_.kind == Kind::double_t) {
+                    order_ = sign (static_cast<double>(value_.i), literal_.d);
+                    return true;
+                }
+                return false;
+            case Kind::double_t :
+                if (literal_.kind == Kind::int_t) {
+                    order_ = sign (value_.d, static_cast<double>(literal_.i));
+                    return true;
+                }
+                if (literal_.kind == Kind::double_t) {
+                    order_ = sign (value_.d, literal_.d);
+                    return true;
+                }
+                return false;
+            case Kind::bool_t :
+                if (literal_.kind == Kind::bool_t) {
+                    order_ = sign (value_.b, literal_.b);
+                    return true;
+                }
+                return false;
+            case Kind::string_t :
+                if (literal_.kind == Kind::string_t) {
+                    order_ = sign (value_.s.compare (literal_.s), 0);
+                    return true;
+                }
+                return false;
+            default :
+                return false;
+        }
+    };
+
+    auto equal = [&value_, &order](const Literal & literal_) {
+        if (value_.kind == Literal::Kind::null_t || literal_.kind == Literal::Kind::null_t) {
+            return value_.kind == literal_.kind;
+        }
+
+        int o;
+
+        return order (literal_, o) && o == 0;
+    };
+
+    const auto & literals = comparison_.bytes.empty()
+        ? *comparison_.literals
+        : comparison_.bytes;
+
+    switch (comparison_.op) {
+        case Expression::Op::eq_t : return equal (literals[0]);
+        case Expression::Op::ne_t : return !equal (literals[0]);
+        case Expression::Op::in_t : return std::any_of (literals.begin(), literals.end(), equal);
+        default : break;
+    }
+
+    int o;
+
+    if (!order (literals[0], o)) {
+        return false;
+    }
+
+    switch (comparison_.op) {
+        case Expression::Op::lt_t : return o < 0;
+        case Expression::Op::le_t : return o <= 0;
+        case Expression::Op::gt_t : return o > 0;
+        case Expression::Op::ge_t : return o >= 0;
+        default : return false;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Read a primitive or enum of [type_] whose constructor, [code_], has
+ * already been read
+ */
+amqp::internal::filter::Query::Value
+amqp::internal::filter::
+Query::read (Cursor & cursor_, const wire::Type & type_, uint8_t code_) {
+    Value rtn;
+
+    if (code_ == codes::NULL_) {
+        return rtn;
+    }
+
+    switch (type_.kind) {
+        case wire::Type::Kind::int_t :
+        case wire::Type::Kind::long_t :
+            rtn.kind = Literal::Kind::int_t;
+            rtn.i = cursor_.integer (code_);
+            break;
+        case wire::Type::Kind::double_t :
+            rtn.kind = Literal::Kind::double_t;
+            rtn.d = cursor_.real (code_);
+            break;
+        case wire::Type::Kind::bool_t :
+            rtn.kind = Literal::Kind::bool_t;
+            rtn.b = cursor_.boolean (code_);
+            break;
+        case wire::Type::Kind::string_t :
+            rtn.kind = Literal::Kind::string_t;
+            rtn.s = cursor_.bytes (code_);
+            break;
+        case wire::Type::Kind::binary_t :
+            // against the literals decoded from hex when the query was bound
+            rtn.kind = Literal::Kind::string_t;
+            rtn.s = cursor_.bytes (code_);
+            break;
+        case wire::Type::Kind::enum_t : {
+            if (code_ != codes::DESCRIBED) {
+                cursor_.fail ("Expected an enum");
+            }
+
+            auto descriptor = cursor_.code();
+
+            if (Cursor::isULong (descriptor) && wire::isReference (cursor_.ulong (descriptor))) {
+                cursor_.skip();
+                return rtn;
+            }
+
+            cursor_.skip (descriptor);
+
+            auto list = cursor_.compound (cursor_.code());
+
+            if (list.count != 2) {
+                cursor_.fail ("Expected an enum's name and ordinal");
+            }
+
+            cursor_.skip();
+
+            auto ordinal = cursor_.integer (cursor_.code());
+
+            if (ordinal < 0 || static_cast<size_t>(ordinal) >= type_.constants.size()) {
+                cursor_.fail ("Enum ordinal out of range");
+            }
+
+            rtn.kind = Literal::Kind::string_t;
+            rtn.s = type_.constants[ordinal];
+            break;
+        }
+        default :
+            cursor_.fail ("Can't compare a " + type_.name);
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+amqp::internal::filter::Query::Result
+amqp::internal::filter::
+Query::evaluate (size_t node_, const std::vector<Result> & comparisons_) const {
+    const auto & node = m_nodes[node_];
+
+    switch (node.op) {
+        case Expression::Op::not_t : {
+            auto r = evaluate (node.children[0], comparisons_);
+            return r == unknown ? unknown : (r == yes ? no : yes);
+        }
+        case Expression::Op::and_t :
+        case Expression::Op::or_t : {
+            // the value that decides the whole, no for and, yes for or
+            auto decisive = node.op == Expression::Op::and_t ? no : yes;
+            auto rtn = decisive == no ? yes : no;
+
+            for (auto child : node.children) {
+                auto r = evaluate (child, comparisons_);
+
+                if (r == decisive) {
+                    return decisive;
+                }
+
+                if (r == unknown) {
+                    rtn = unknown;
+                }
+            }
+
+            return rtn;
+        }
+        default :
+            return comparisons_[node.comparison];
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Record the outcome of comparison [comparison_] and re-evaluate any
+ * expression yet to be decided.
+ *
+ * @return true once every expression is decided
+ */
+bool
+amqp::internal::filter::
+Query::resolve (size_t comparison_, const Value & value_, State & state_) const {
+    state_.comparisons[comparison_] = compare (m_comparisons[comparison_], value_) ? yes : no;
+
+    for (size_t i { 0 } ; i < m_roots.size() ; ++i) {
+        if (state_.results[i] == unknown) {
+            state_.results[i] = evaluate (m_roots[i], state_.comparisons);
+
+            if (state_.results[i] != unknown) {
+                --state_.undecided;
+            }
+        }
+    }
+
+    return state_.undecided == 0;
+}
+
+/******************************************************************************/
+
+/**
+ * Resolve [comparisons_] against null, for values that aren't there
+ */
+bool
+amqp::internal::filter::
+Query::nullify (const std::vector<size_t> & comparisons_, State & state_) const {
+    for (auto c : comparisons_) {
+        if (state_.comparisons[c] == unknown && resolve (c, { }, state_)) {
+            return true;
+        }
+    }
+
+    return state_.undecided == 0;
+}
+
+/******************************************************************************/
+
+/**
+ * Walk the fields of a composite of [type_], the cursor positioned just
+ * after its descriptor.
+ *
+ * @return true if every expression was decided along the way, in which
+ * case the cursor is left wherever that happened
+ */
+bool
+amqp::internal::filter::
+Query::walk (
+    Cursor & cursor_,
+    const Step & step_,
+    const wire::Type & type_,
+    State & state_
+) const {
+    auto code = cursor_.code();
+
+    if (!Cursor::isList (code)) {
+        cursor_.fail ("Expected a list of fields");
+    }
+
+    auto list = cursor_.compound (code);
+
+    size_t i { 0 };
+
+    for ( ; i < list.count ; ++i) {
+        if (i >= step_.fields.size()
+            || (step_.fields[i].comparisons.empty() && !step_.fields[i].step))
+        {
+            cursor_.skip();
+            continue;
+        }
+
+        const auto & field = step_.fields[i];
+        const auto & child = *type_.children[i];
+
+        code = cursor_.code();
+
+        if (!field.comparisons.empty()) {
+            auto value = read (cursor_, child, code);
+
+            for (auto c : field.comparisons) {
+                if (resolve (c, value, state_)) {
+                    return true;
+                }
+            }
+
+            continue;
+        }
+
+        if (code == codes::NULL_) {
+            if (nullify (field.step->all, state_)) {
+                return true;
+            }
+
+            continue;
+        }
+
+        if (code != codes::DESCRIBED) {
+            cursor_.fail ("Expected a described value");
+        }
+
+        auto descriptor = cursor_.code();
+
+        if (Cursor::isSymbol (descriptor)) {
+            auto type = child.instance (cursor_.bytes (descriptor));
+
+            if (!type) {
+                cursor_.fail ("Fingerprint doesn't match the expected type");
+            }
+
+            const auto * step = field.step.get();
+
+            if (!step->implementations.empty()) {
+                auto implementation = step->implementations.find (type);
+
+                if (implementation == step->implementations.end()) {
+                    cursor_.fail ("Fingerprint not found in the schema");
+                }
+
+                step = implementation->second.get();
+
+                if (nullify (step->missing, state_)) {
+                    return true;
+                }
+
+                // nothing further to look at in a restricted type
+                if (type->kind != wire::Type::Kind::composite_t) {
+                    cursor_.skip();
+                    continue;
+                }
+            }
+
+            if (walk (cursor_, *step, *type, state_)) {
+                return true;
+            }
+        } else if (Cursor::isULong (descriptor) && wire::isReference (cursor_.ulong (descriptor))) {
+            cursor_.skip();
+
+            if (nullify (field.step->all, state_)) {
+                return true;
+            }
+        } else {
+            cursor_.fail ("Expected a fingerprint");
+        }
+    }
+
+    // anything the writer didn't send is null
+    for ( ; i < step_.fields.size() ; ++i) {
+        if (nullify (step_.fields[i].comparisons, state_)
+            || (step_.fields[i].step && nullify (step_.fields[i].step->all, state_)))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/******************************************************************************/
+
+std::vector<bool>
+amqp::internal::filter::
+Query::evaluate (Cursor & cursor_) const {
+    State state {
+        std::vector<Result> (m_comparisons.size(), unknown),
+        std::vector<Result> (m_roots.size(), unknown),
+        m_roots.size() };
+
+    bool done = nullify (m_missing, state);
+
+    if (!done && !m_step.all.empty()) {
+        if (cursor_.code() != codes::DESCRIBED) {
+            cursor_.fail ("Expected a described object");
+        }
+
+        auto code = cursor_.code();
+
+        if (!Cursor::isSymbol (code) || cursor_.bytes (code) != m_root.descriptor) {
+            cursor_.fail ("Fingerprint doesn't match the expected type");
+        }
+
+        done = walk (cursor_, m_step, m_root, state);
+    }
+
+    if (!done) {
+        nullify (m_step.all, state);
+    }
+
+    std::vector<bool> rtn;
+
+    rtn.reserve (state.results.size());
+
+    for (auto r : state.results) {
+        rtn.push_back (r == yes);
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
@@ -0,0 +1,213 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <string_view>
+
+#include "types.h"
+
+#include "Expression.h"
+
+#include "wire/Cursor.h"
+#include "wire/TypeTable.h"
+#include "wire/TypeCache.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::filter {
+
+    /**
+     * Evaluate [expressions_] against the payload of a complete Corda
+     * blob in a single pass. For more than one blob use a [Matcher].
+     *
+     * @return whether each expression matched
+     * @throws wire::Error if the blob is malformed
+     */
+    std::vector<bool> match (
+        const std::vector<uPtr<Expression>> & expressions_,
+        const char * blob_,
+        size_t size_);
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::filter {
+
+    /**
+     * A set of expressions bound to the types of one schema, rooted at
+     * the type of the payload.
+     *
+     * Binding resolves every path to the field indices leading to it so
+     * evaluation walks the payload once, in place, visiting only the
+     * fields some expression refers to and skipping everything else by
+     * its size prefix. Each comparison is resolved as soon as its field
+     * is reached and the walk is abandoned once every expression's result
+     * is known.
+     *
+     * Paths that don't exist in the schema, or that lead to something
+     * other than a primitive or an enum, compare as if the value were
+     * null. Blobs of other types or versions therefore simply don't match.
+     * A path through a field typed as an interface is bound against each
+     * type in the schema, which one is followed is up to the value.
+     */
+    class Query {
+        private :
+            /**
+             * The three valued logic of partially evaluated expressions
+             */
+            enum Result : int8_t { unknown = -1, no = 0, yes = 1 };
+
+            /**
+             * A value read from the wire, views into the blob rather than
+             * copies of it
+             */
+            struct Value {
+                Literal::Kind    kind { Literal::Kind::null_t };
+                bool             b { false };
+                int64_t          i { 0 };
+                double           d { 0.0 };
+                std::string_view s;
+            };
+
+            struct Comparison {
+                Expression::Op              op;
+                const std::vector<Literal> * literals;
+
+                /**
+                 * For a binary field its literals with the hex decoded, so
+                 * the bytes on the wire are compared as they are
+                 */
+                std::vector<Literal>        bytes;
+            };
+
+            /**
+             * Expressions flattened into an array, comparisons index
+             * [m_comparisons], everything else their children
+             */
+            struct Node {
+                Expression::Op      op;
+                size_t              comparison { 0 };
+                std::vector<size_t> children;
+            };
+
+            /**
+             * What to do with each field of a composite we walk through,
+             * either compare it or descend into it, or if neither, skip it
+             */
+            struct Step {
+                struct Field {
+                    std::vector<size_t> comparisons;
+                    uPtr<Step>          step;
+                };
+
+                std::vector<Field>  fields;
+
+                /**
+                 * For a step into a field typed as an interface, the step
+                 * to take for each type in the schema that could be its
+                 * implementation, the rest of the paths bound against it
+                 */
+                std::map<const wire::Type *, uPtr<Step>> implementations;
+
+                /**
+                 * For a step of [implementations], the comparisons whose
+                 * paths don't exist in its type
+                 */
+                std::vector<size_t> missing;
+
+                /**
+                 * Every comparison at or below this step
+                 */
+                std::vector<size_t> all;
+            };
+
+            const wire::Type & m_root;
+
+            std::vector<Comparison> m_comparisons;
+            std::vector<Node>       m_nodes;
+            std::vector<size_t>     m_roots;
+
+            Step                    m_step;
+
+            /**
+             * Comparisons whose path couldn't be resolved
+             */
+            std::vector<size_t>     m_missing;
+
+            size_t compile (const Expression &);
+            bool bind (Step &, const wire::Type &, size_t, const std::vector<std::string> &, size_t);
+            static void gather (Step &);
+
+            static bool compare (const Comparison &, const Value &);
+            static Value read (wire::Cursor &, const wire::Type &, uint8_t);
+
+            Result evaluate (size_t, const std::vector<Result> &) const;
+
+            struct State;
+
+            bool walk (wire::Cursor &, const Step &, const wire::Type &, State &) const;
+            bool resolve (size_t, const Value &, State &) const;
+            bool nullify (const std::vector<size_t> &, State &) const;
+
+        public :
+            Query (const std::vector<const Expression *> &, const wire::Type & root_);
+
+            /**
+             * @param cursor_ positioned at the described payload
+             */
+            std::vector<bool> evaluate (wire::Cursor & cursor_) const;
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::filter {
+
+    /**
+     * Evaluates a set of expressions against blob after blob. The types
+     * of each schema are kept in a [wire::TypeCache] and the expressions
+     * compiled against them once per payload type found, so a run over
+     * blobs that share a schema decodes it and binds the expressions only
+     * for the first of them.
+     *
+     * The expressions must outlive the matcher, not thread safe.
+     */
+    class Matcher {
+        private :
+            std::vector<const Expression *> m_expressions;
+
+            wire::TypeCache m_types;
+
+            /**
+             * Keyed by the payload's type, which belongs to the table of
+             * one schema so identifies both
+             */
+            std::map<const wire::Type *, uPtr<Query>> m_queries;
+
+        public :
+            explicit Matcher (const std::vector<uPtr<Expression>> & expressions_);
+
+            ~Matcher();
+
+            /**
+             * @return whether each expression matched
+             * @throws wire::Error if the blob is malformed
+             */
+            std::vector<bool> operator() (const char * blob_, size_t size_);
+
+            /**
+             * How many times the expressions have been compiled
+             */
+            size_t compiled() const { return m_queries.size(); }
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,272 @@
+#include "Extractor.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "Keys.h"
+
+#include "wire/Blob.h"
+#include "wire/Text.h"
+#include "amqp/json/Json.h"
+
+/******************************************************************************/
+
+using amqp::internal::wire::Type;
+using amqp::internal::wire::Cursor;
+
+namespace codes = amqp::internal::wire::codes;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Read the descriptor of a described value whose DESCRIBED code has
+     * been read, where [type_] is expected.
+     *
+     * @return the type the value actually holds, something implementing
+     * [type_] if that's an interface, or nullptr for a reference to a
+     * value seen earlier
+     */
+    const Type *
+    describe (
+        Cursor & cursor_,
+        const amqp::internal::wire::TypeTable & types_,
+        const Type & type_
+    ) {
+        auto descriptor = cursor_.code();
+
+        if (Cursor::isSymbol (descriptor)) {
+            auto fingerprint = cursor_.bytes (descriptor);
+
+            if (fingerprint == type_.descriptor) {
+                return &type_;
+            }
+
+            auto rtn = types_.byDescriptor (fingerprint);
+
+            if (!rtn) {
+                cursor_.fail ("Fingerprint not found in the schema");
+            }
+
+            return rtn;
+        }
+
+        if (Cursor::isULong (descriptor)
+            && amqp::internal::wire::isReference (cursor_.ulong (descriptor)))
+        {
+            cursor_.skip();
+            return nullptr;
+        }
+
+        cursor_.fail ("Expected a fingerprint");
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::index::Extractor
+ *
+ ******************************************************************************/
+
+amqp::internal::index::
+Extractor::Extractor (const std::vector<std::string> & paths_) {
+    for (const auto & path : paths_) {
+        std::vector<std::string> names;
+        size_t start { 0 };
+
+        for (;;) {
+            auto dot = path.find ('.', start);
+            names.push_back (path.substr (start, dot - start));
+
+            if (names.back().empty()) {
+                throw std::runtime_error ("Empty field name in \"" + path + "\"");
+            }
+
+            if (dot == std::string::npos) {
+                break;
+            }
+
+            start = dot + 1;
+        }
+
+        m_paths.push_back (std::move (names));
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::index::
+Extractor::extract (
+    const char * blob_,
+    size_t size_,
+    const std::function<void (size_t, const std::string &)> & f_
+) {
+    wire::Blob blob (blob_, size_);
+
+    auto [types, root] = m_types.root (blob);
+
+    for (size_t i { 0 } ; i < m_paths.size() ; ++i) {
+        auto cursor = blob.object();
+        const auto * type = root;
+        uint8_t code;
+
+        if (find (cursor, *types, m_paths[i], type, code) && key (cursor, *types, *type, code)) {
+            f_ (i, m_key);
+        }
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Walk from the payload to the field at [path_], leaving [cursor_] just
+ * after its format code, which is put in [code_], and its type in
+ * [type_].
+ *
+ * @return false if there's no value there
+ */
+bool
+amqp::internal::index::
+Extractor::find (
+    Cursor & cursor_,
+    const wire::TypeTable & types_,
+    const std::vector<std::string> & path_,
+    const Type * & type_,
+    uint8_t & code_
+) const {
+    code_ = cursor_.code();
+
+    for (const auto & name : path_) {
+        if (code_ == codes::NULL_ || type_->primitive()) {
+            return false;
+        }
+
+        if (code_ != codes::DESCRIBED) {
+            cursor_.fail ("Expected a described value");
+        }
+
+        type_ = describe (cursor_, types_, *type_);
+
+        if (!type_ || type_->kind != Type::Kind::composite_t) {
+            return false;
+        }
+
+        auto field = std::find (type_->fields.begin(), type_->fields.end(), name);
+
+        if (field == type_->fields.end()) {
+            return false;
+        }
+
+        auto index = static_cast<size_t>(field - type_->fields.begin());
+
+        code_ = cursor_.code();
+
+        if (!Cursor::isList (code_)) {
+            cursor_.fail ("Expected a list of fields");
+        }
+
+        if (index >= cursor_.compound (code_).count) {
+            return false;
+        }
+
+        for (size_t i { 0 } ; i < index ; ++i) {
+            cursor_.skip();
+        }
+
+        type_ = type_->children[index];
+        code_ = cursor_.code();
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+
+/**
+ * Key the value of [type_] whose format code, [code_], has just been read
+ *
+ * @return false for nulls and references, which aren't indexed
+ */
+bool
+amqp::internal::index::
+Extractor::key (
+    Cursor & cursor_,
+    const wire::TypeTable & types_,
+    const Type & type_,
+    uint8_t code_
+) {
+    if (code_ == codes::NULL_) {
+        return false;
+    }
+
+    switch (type_.kind) {
+        case Type::Kind::int_t :
+        case Type::Kind::long_t :
+            m_key = integer (cursor_.integer (code_));
+            return true;
+        case Type::Kind::double_t : {
+            auto value = cursor_.real (code_);
+
+            if (std::isnan (value)) {
+                return false;
+            }
+
+            m_key = real (value);
+            return true;
+        }
+        case Type::Kind::bool_t :
+            m_key = boolean (cursor_.boolean (code_));
+            return true;
+        case Type::Kind::string_t :
+            m_key = string (cursor_.bytes (code_));
+            return true;
+        case Type::Kind::binary_t : {
+            // keyed as it's printed and filtered, hex without the quotes
+            auto hex = json::hex (cursor_.bytes (code_));
+            m_key = string (std::string_view (hex).substr (1, hex.size() - 2));
+            return true;
+        }
+        default :
+            break;
+    }
+
+    if (code_ != codes::DESCRIBED) {
+        cursor_.fail ("Expected a described value");
+    }
+
+    auto start = cursor_.offset() - 1;
+    const auto * type = describe (cursor_, types_, type_);
+
+    if (!type) {
+        return false;
+    }
+
+    if (type->kind == Type::Kind::enum_t) {
+        auto list = cursor_.compound (cursor_.code());
+
+        if (list.count != 2) {
+            cursor_.fail ("Expected an enum's name and ordinal");
+        }
+
+        cursor_.skip();
+
+        auto ordinal = cursor_.integer (cursor_.code());
+
+        if (ordinal < 0 || static_cast<size_t>(ordinal) >= type->constants.size()) {
+            cursor_.fail ("Enum ordinal out of range");
+        }
+
+        m_key = string (type->constants[ordinal]);
+        return true;
+    }
+
+    cursor_.seek (start);
+    m_key = string (wire::text (cursor_, *type));
+
+    return true;
+}
+
+/******************************************************************************/
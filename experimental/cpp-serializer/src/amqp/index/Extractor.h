@@ -0,0 +1,66 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "wire/Cursor.h"
+#include "wire/TypeCache.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::index {
+
+    /**
+     * Pulls the values of a fixed set of fields out of blobs as index
+     * [Keys]. Paths name fields of composites from the payload down, as
+     * in filters; a field typed as an interface is followed into
+     * whatever implements it. Primitives and enums are keyed as values,
+     * anything else as its text, the way the inspector dumps it.
+     *
+     * Each path costs a walk of the payload as far as its field, every
+     * field before it skipped by size. Nulls, fields the writer didn't
+     * send and paths that don't exist in a blob's schema give nothing.
+     *
+     * Not thread safe, use one per thread.
+     */
+    class Extractor {
+        private :
+            std::vector<std::vector<std::string>> m_paths;
+
+            wire::TypeCache m_types;
+
+            std::string m_key;
+
+            bool find (
+                wire::Cursor &,
+                const wire::TypeTable &,
+                const std::vector<std::string> &,
+                const wire::Type * &,
+                uint8_t &) const;
+
+            bool key (wire::Cursor &, const wire::TypeTable &, const wire::Type &, uint8_t);
+
+        public :
+            /**
+             * @throws std::runtime_error if a path has an empty field name
+             */
+            explicit Extractor (const std::vector<std::string> & paths_);
+
+            /**
+             * Call [f_] with the number of each path that holds a value
+             * in the blob and the key of that value
+             *
+             * @throws wire::Error if the blob is malformed
+             */
+            void extract (
+                const char * blob_,
+                size_t size_,
+                const std::function<void (size_t, const std::string &)> & f_);
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,300 @@
+#include "Keys.h"
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+/******************************************************************************/
+
+using amqp::internal::filter::Literal;
+using amqp::internal::filter::Expression;
+
+namespace tags = amqp::internal::index::tags;
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    bigEndian (char tag_, uint64_t value_) {
+        std::string rtn (9, tag_);
+
+        for (int i { 8 } ; i > 0 ; --i) {
+            rtn[i] = static_cast<char>(value_ & 0xff);
+            value_ >>= 8;
+        }
+
+        return rtn;
+    }
+
+    /**
+     * Every key of kind [tag_]
+     */
+    amqp::internal::index::Range
+    whole (char tag_) {
+        return { std::string (1, tag_), true, std::string (1, static_cast<char>(tag_ + 1)), false };
+    }
+
+    amqp::internal::index::Range
+    point (std::string key_) {
+        return { key_, true, key_, true };
+    }
+
+    /**
+     * Whether [d_] is a whole number an int64_t can hold
+     */
+    bool
+    integral (double d_) {
+        return std::isfinite (d_)
+            && d_ == std::floor (d_)
+            && d_ >= -9223372036854775808.0
+            && d_ < 9223372036854775808.0;
+    }
+
+    /**
+     * The keys a value equal to [literal_] could have
+     */
+    void
+    points (const Literal & literal_, std::vector<amqp::internal::index::Range> & out_) {
+        using namespace amqp::internal::index;
+
+        switch (literal_.kind) {
+            case Literal::Kind::null_t :
+                throw std::runtime_error ("Nulls aren't indexed");
+            case Literal::Kind::bool_t :
+                out_.push_back (point (boolean (literal_.b)));
+                break;
+            case Literal::Kind::int_t :
+                out_.push_back (point (integer (literal_.i)));
+                out_.push_back (point (real (static_cast<double>(literal_.i))));
+                break;
+            case Literal::Kind::double_t :
+                out_.push_back (point (real (literal_.d)));
+
+                if (integral (literal_.d)) {
+                    out_.push_back (point (integer (static_cast<int64_t>(literal_.d))));
+                }
+
+                break;
+            case Literal::Kind::string_t :
+                out_.push_back (point (string (literal_.s)));
+                break;
+        }
+    }
+
+    /**
+     * The keys of values above or below [literal_], as [op_] says
+     */
+    void
+    side (
+        Expression::Op op_,
+        const Literal & literal_,
+        std::vector<amqp::internal::index::Range> & out_
+    ) {
+        using namespace amqp::internal::index;
+
+        bool above = op_ == Expression::Op::gt_t || op_ == Expression::Op::ge_t;
+        bool inclusive = op_ == Expression::Op::le_t || op_ == Expression::Op::ge_t;
+
+        auto bounded = [above, &out_](char tag_, std::string key_, bool inclusive_) {
+            auto range = whole (tag_);
+
+            if (above) {
+                range.from = std::move (key_);
+                range.fromInclusive = inclusive_;
+            } else {
+                range.to = std::move (key_);
+                range.toInclusive = inclusive_;
+            }
+
+            out_.push_back (std::move (range));
+        };
+
+        switch (literal_.kind) {
+            case Literal::Kind::null_t :
+                throw std::runtime_error ("Nulls aren't indexed");
+            case Literal::Kind::bool_t :
+                bounded (tags::BOOL, boolean (literal_.b), inclusive);
+                break;
+            case Literal::Kind::string_t :
+                bounded (tags::STRING, string (literal_.s), inclusive);
+                break;
+            case Literal::Kind::int_t :
+                bounded (tags::INTEGER, integer (literal_.i), inclusive);
+                bounded (tags::DOUBLE, real (static_cast<double>(literal_.i)), inclusive);
+                break;
+            case Literal::Kind::double_t : {
+                if (std::isnan (literal_.d)) {
+                    break;
+                }
+
+                bounded (tags::DOUBLE, real (literal_.d), inclusive);
+
+                // the nearest integer on the right side of it
+                auto edge = above ? std::ceil (literal_.d) : std::floor (literal_.d);
+
+                if (integral (edge)) {
+                    bounded (tags::INTEGER, integer (static_cast<int64_t>(edge)),
+                        inclusive || edge != literal_.d);
+                } else if ((edge > 0) != above) {
+                    out_.push_back (whole (tags::INTEGER));
+                }
+
+                break;
+            }
+        }
+    }
+
+    /**
+     * The keys in both [a_] and [b_]
+     */
+    std::vector<amqp::internal::index::Range>
+    intersect (
+        const std::vector<amqp::internal::index::Range> & a_,
+        const std::vector<amqp::internal::index::Range> & b_
+    ) {
+        std::vector<amqp::internal::index::Range> rtn;
+
+        for (const auto & a : a_) {
+            for (const auto & b : b_) {
+                auto range = a;
+
+                if (b.from > range.from || (b.from == range.from && !b.fromInclusive)) {
+                    range.from = b.from;
+                    range.fromInclusive = b.fromInclusive;
+                }
+
+                if (b.to < range.to || (b.to == range.to && !b.toInclusive)) {
+                    range.to = b.to;
+                    range.toInclusive = b.toInclusive;
+                }
+
+                if (range.from < range.to
+                    || (range.from == range.to && range.fromInclusive && range.toInclusive))
+                {
+                    rtn.push_back (std::move (range));
+                }
+            }
+        }
+
+        return rtn;
+    }
+
+    /**
+     * The comparisons of a conjunction
+     */
+    void
+    gather (const Expression & expression_, std::vector<const Expression *> & out_) {
+        if (expression_.op() == Expression::Op::and_t) {
+            for (const auto & child : expression_.children()) {
+                gather (*child, out_);
+            }
+        } else if (expression_.comparison()) {
+            out_.push_back (&expression_);
+        } else {
+            throw std::runtime_error (
+                "Only comparisons joined by && can be answered from an index");
+        }
+    }
+
+}
+
+/******************************************************************************
+ *
+ * Keys
+ *
+ ******************************************************************************/
+
+std::string
+amqp::internal::index::
+boolean (bool value_) {
+    return { tags::BOOL, static_cast<char>(value_) };
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::index::
+integer (int64_t value_) {
+    return bigEndian (tags::INTEGER, static_cast<uint64_t>(value_) ^ (1ULL << 63));
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::index::
+real (double value_) {
+    if (value_ == 0.0) {
+        value_ = 0.0;
+    }
+
+    uint64_t bits;
+    std::memcpy (&bits, &value_, sizeof (bits));
+
+    return bigEndian (tags::DOUBLE, bits & (1ULL << 63) ? ~bits : bits ^ (1ULL << 63));
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::index::
+string (std::string_view value_) {
+    std::string rtn (1, tags::STRING);
+    rtn += value_;
+
+    return rtn;
+}
+
+/******************************************************************************
+ *
+ * ranges
+ *
+ ******************************************************************************/
+
+std::pair<std::string, std::vector<amqp::internal::index::Range>>
+amqp::internal::index::
+ranges (const filter::Expression & expression_) {
+    std::vector<const Expression *> comparisons;
+    gather (expression_, comparisons);
+
+    const auto & path = comparisons.front()->path();
+
+    std::vector<Range> rtn;
+
+    for (const auto * comparison : comparisons) {
+        if (comparison->path() != path) {
+            throw std::runtime_error (
+                "Every comparison has to be of the same field to be answered from an index");
+        }
+
+        std::vector<Range> ranges;
+
+        switch (comparison->op()) {
+            case Expression::Op::eq_t :
+            case Expression::Op::in_t :
+                for (const auto & literal : comparison->literals()) {
+                    points (literal, ranges);
+                }
+                break;
+            case Expression::Op::ne_t :
+                throw std::runtime_error ("!= can't be answered from an index");
+            default :
+                side (comparison->op(), comparison->literals()[0], ranges);
+                break;
+        }
+
+        rtn = comparison == comparisons.front()
+            ? std::move (ranges)
+            : intersect (rtn, ranges);
+    }
+
+    std::string dotted;
+
+    for (const auto & name : path) {
+        dotted += (dotted.empty() ? "" : ".") + name;
+    }
+
+    return { std::move (dotted), std::move (rtn) };
+}
+
+/******************************************************************************/
@@ -0,0 +1,69 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+#include "filter/Expression.h"
+
+/******************************************************************************/
+
+/**
+ * Index keys. Each is a tag saying what kind of value it holds followed
+ * by the value encoded so that comparing keys as unsigned bytes orders
+ * them as the values they hold. Values of different kinds never compare
+ * equal and sort apart, each kind's keys falling between its tag and
+ * the next character.
+ *
+ * Integers are big endian with the sign bit flipped, doubles big endian
+ * with the sign bit flipped if positive and every bit if negative, and
+ * strings as they are. Binaries, enums and anything else keyed as text
+ * are strings, as the filter language compares them.
+ */
+namespace amqp::internal::index::tags {
+
+    constexpr char BOOL    = 'b';
+    constexpr char DOUBLE  = 'd';
+    constexpr char INTEGER = 'i';
+    constexpr char STRING  = 's';
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::index {
+
+    std::string boolean (bool);
+    std::string integer (int64_t);
+    std::string real (double);
+    std::string string (std::string_view);
+
+    /**
+     * The keys from [from] to [to], both always given
+     */
+    struct Range {
+        std::string from;
+        bool        fromInclusive;
+        std::string to;
+        bool        toInclusive;
+    };
+
+    /**
+     * The field [expression_] looks at, as a dotted path, and the ranges
+     * of keys holding values that satisfy it. Only comparisons of a single
+     * field, alone or joined by &&, can be answered from an index, and of
+     * those neither != nor comparisons with null, nulls not being indexed.
+     *
+     * Integers and doubles compare as numbers, as they do in filters, so
+     * a comparison with either gives ranges of both. Ranges may overlap.
+     *
+     * @throws std::runtime_error if [expression_] can't be answered
+     */
+    std::pair<std::string, std::vector<Range>> ranges (const filter::Expression & expression_);
+
+}
+
+/******************************************************************************/
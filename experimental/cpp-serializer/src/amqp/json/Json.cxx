@@ -0,0 +1,212 @@
+#include "Json.h"
+
+#include <cmath>
+#include <charconv>
+
+#if defined (__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    constexpr char hex[] = "0123456789abcdef";
+
+    inline bool
+    special (unsigned char c_) {
+        return c_ < 0x20 || c_ == '"' || c_ == '\\';
+    }
+
+    /**
+     * @return the index of the first byte of [str_] at or after [i_]
+     * that has to be escaped, or its size if there are none
+     */
+    size_t
+    scan (std::string_view str_, size_t i_) {
+        const auto * p = reinterpret_cast<const unsigned char *>(str_.data());
+        auto size = str_.size();
+
+#if defined (__SSE2__)
+        const auto quote = _mm_set1_epi8 ('"');
+        const auto slash = _mm_set1_epi8 ('\\');
+        const auto control = _mm_set1_epi8 (0x1f);
+
+        for ( ; i_ + 16 <= size ; i_ += 16) {
+            auto block = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(p + i_));
+
+            // there's no unsigned byte compare, but c <= 0x1f exactly
+            // when max (c, 0x1f) == 0x1f
+            auto hits = _mm_or_si128 (
+                _mm_or_si128 (
+                    _mm_cmpeq_epi8 (block, quote),
+                    _mm_cmpeq_epi8 (block, slash)),
+                _mm_cmpeq_epi8 (_mm_max_epu8 (block, control), control));
+
+            if (auto mask = _mm_movemask_epi8 (hits)) {
+                return i_ + __builtin_ctz (static_cast<unsigned>(mask));
+            }
+        }
+#endif
+
+        for ( ; i_ < size ; ++i_) {
+            if (special (p[i_])) {
+                return i_;
+            }
+        }
+
+        return size;
+    }
+
+    void
+    escape (unsigned char c_, std::string & out_) {
+        switch (c_) {
+            case '"'  : out_ += "\\\""; break;
+            case '\\' : out_ += "\\\\"; break;
+            case '\b' : out_ += "\\b"; break;
+            case '\f' : out_ += "\\f"; break;
+            case '\n' : out_ += "\\n"; break;
+            case '\r' : out_ += "\\r"; break;
+            case '\t' : out_ += "\\t"; break;
+            default :
+                out_ += "\\u00";
+                out_ += hex[c_ >> 4];
+                out_ += hex[c_ & 0xf];
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::json::
+quote (std::string_view str_, std::string & out_) {
+    out_.reserve (out_.size() + str_.size() + 2);
+    out_ += '"';
+
+    for (size_t i { 0 } ; i < str_.size() ; ) {
+        auto next = scan (str_, i);
+
+        out_.append (str_.data() + i, next - i);
+
+        if (next == str_.size()) {
+            break;
+        }
+
+        escape (static_cast<unsigned char>(str_[next]), out_);
+        i = next + 1;
+    }
+
+    out_ += '"';
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::json::
+quote (std::string_view str_) {
+    std::string rtn;
+    quote (str_, rtn);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::json::
+hex (std::string_view bytes_, std::string & out_) {
+    static constexpr char digits[] { "0123456789ABCDEF" };
+
+    auto at = out_.size();
+
+    out_.resize (at + 2 * bytes_.size() + 2);
+
+    auto * p = out_.data() + at;
+
+    *p++ = '"';
+
+    for (unsigned char c : bytes_) {
+        *p++ = digits[c >> 4];
+        *p++ = digits[c & 0xf];
+    }
+
+    *p = '"';
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::json::
+hex (std::string_view bytes_) {
+    std::string rtn;
+    hex (bytes_, rtn);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::json::
+number (int64_t value_, std::string & out_) {
+    char buffer[24];
+
+    auto res = std::to_chars (buffer, buffer + sizeof (buffer), value_);
+
+    out_.append (buffer, res.ptr);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::json::
+number (double value_, std::string & out_) {
+    if (!std::isfinite (value_)) {
+        out_ += "null";
+        return;
+    }
+
+    char buffer[32];
+
+    auto res = std::to_chars (buffer, buffer + sizeof (buffer), value_);
+
+    out_.append (buffer, res.ptr);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::json::
+number (int64_t value_) {
+    std::string rtn;
+    number (value_, rtn);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::json::
+number (double value_) {
+    std::string rtn;
+    number (value_, rtn);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::json::
+key (std::string str_, bool quoted_) {
+    if (quoted_) {
+        return str_;
+    }
+
+    return quote (str_);
+}
+
+/******************************************************************************/
@@ -0,0 +1,87 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+/******************************************************************************/
+
+/**
+ * The formatting kernel behind everything the readers dump. Every
+ * function appends to the caller's buffer so output can be built up
+ * without a temporary per value.
+ */
+namespace amqp::internal::json {
+
+    /**
+     * Append [str_] as a quoted JSON string. The common case of nothing
+     * needing an escape is found a block of bytes at a time and copied
+     * in one go.
+     */
+    void quote (std::string_view str_, std::string & out_);
+
+    std::string quote (std::string_view str_);
+
+    /**
+     * Append [bytes_] as a quoted string of upper case hex digits, the
+     * way Corda prints opaque bytes
+     */
+    void hex (std::string_view bytes_, std::string & out_);
+
+    std::string hex (std::string_view bytes_);
+
+    /**
+     * Append [value_] in decimal
+     */
+    void number (int64_t value_, std::string & out_);
+
+    /**
+     * Append the shortest text that reads back as exactly [value_]. JSON
+     * has no way of writing NaN or the infinities so they become null.
+     */
+    void number (double value_, std::string & out_);
+
+    std::string number (int64_t value_);
+    std::string number (double value_);
+
+    inline std::string
+    number (int32_t value_) {
+        return number (static_cast<int64_t>(value_));
+    }
+
+    inline const char *
+    boolean (bool value_) {
+        return value_ ? "true" : "false";
+    }
+
+    /**
+     * Any arithmetic value as its JSON literal
+     */
+    template<typename T>
+    std::string
+    arithmetic (T value_) {
+        static_assert (std::is_arithmetic_v<T>);
+
+        if constexpr (std::is_same_v<T, bool>) {
+            return boolean (value_);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return number (static_cast<double>(value_));
+        } else {
+            return number (static_cast<int64_t>(value_));
+        }
+    }
+
+    /**
+     * Object keys have to be strings. [str_] is used as is when [quoted_]
+     * says it was rendered as one and quoted otherwise, a number say.
+     * Only the caller knows which, a string key can itself start with a
+     * quote.
+     */
+    std::string key (std::string str_, bool quoted_);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,176 @@
+#include "BinaryValue.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <proton/codec.h>
+
+#include "proton/proton_wrapper.h"
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+#include "amqp/CompositeFactory.h"
+#include "amqp/schema/described-types/Envelope.h"
+#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::BinaryValue::Nested
+ *
+ ******************************************************************************/
+
+/**
+ * Everything a decoded nested blob needs kept alive, its own proton tree
+ * holds the bytes of any binary values found within it
+ */
+struct amqp::internal::reader::BinaryValue::Nested {
+    pn_data_t *                       data;
+    uPtr<schema::Envelope>            envelope;
+    uPtr<amqp::reader::IValue>        value;
+
+    Nested (std::string_view body_, CompositeFactory & factory_)
+        : data (pn_data (body_.size()))
+    {
+        auto size = static_cast<ssize_t>(body_.size());
+
+        if (pn_data_decode (data, body_.data(), body_.size()) != size) {
+            pn_data_free (data);
+            throw std::runtime_error ("Malformed nested blob");
+        }
+
+        try {
+            read (factory_);
+        } catch (...) {
+            pn_data_free (data);
+            throw;
+        }
+    }
+
+    ~Nested() {
+        pn_data_free (data);
+    }
+
+    void
+    read (CompositeFactory & factory_) {
+        pn_data_rewind (data);
+        pn_data_next (data);
+
+        if (!pn_data_is_described (data)) {
+            throw std::runtime_error ("Nested blob has no envelope");
+        }
+
+        {
+            proton::auto_enter p (data);
+
+            envelope.reset (
+                dynamic_cast<schema::Envelope *> (
+                    AMQPDescriptorRegistory[pn_data_get_ulong (data)]->build (data).release()));
+        }
+
+        if (!envelope) {
+            throw std::runtime_error ("Nested blob has no envelope");
+        }
+
+        factory_.process (envelope->schema(), envelope->transforms());
+
+        auto reader = factory_.byDescriptor (envelope->descriptor());
+
+        if (!reader) {
+            throw std::runtime_error ("Nested blob's type isn't in its schema");
+        }
+
+        pn_data_rewind (data);
+        pn_data_next (data);
+
+        proton::auto_enter p (data);
+        pn_data_next (data);
+        proton::auto_enter p2 (data);
+
+        value = reader->dump (data, envelope->schema());
+    }
+};
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::BinaryValue
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+BinaryValue::BinaryValue (
+    std::string_view bytes_,
+    CompositeFactory * factory_
+) : m_named (false)
+  , m_bytes (bytes_)
+  , m_factory (factory_)
+{ }
+
+/******************************************************************************/
+
+amqp::internal::reader::
+BinaryValue::BinaryValue (
+    std::string property_,
+    std::string_view bytes_,
+    CompositeFactory * factory_
+) : m_property (std::move (property_))
+  , m_named (true)
+  , m_bytes (bytes_)
+  , m_factory (factory_)
+{ }
+
+/******************************************************************************/
+
+amqp::internal::reader::
+BinaryValue::~BinaryValue() = default;
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+BinaryValue::blob() const {
+    return m_bytes.size() > AMQP_HEADER.size()
+        && std::equal (AMQP_HEADER.begin(), AMQP_HEADER.end(), m_bytes.begin())
+        && m_bytes[AMQP_HEADER.size()] == DATA_AND_STOP;
+}
+
+/******************************************************************************/
+
+const amqp::reader::IValue &
+amqp::internal::reader::
+BinaryValue::decode() const {
+    if (!m_nested) {
+        if (!blob()) {
+            throw std::runtime_error ("Binary value isn't a Corda blob");
+        }
+
+        if (!m_factory) {
+            throw std::runtime_error ("Binary value wasn't read by a factory");
+        }
+
+        m_nested = std::make_unique<Nested> (
+            m_bytes.substr (AMQP_HEADER.size() + 1),
+            *m_factory);
+    }
+
+    return *m_nested->value;
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+BinaryValue::dump() const {
+    std::string rtn;
+
+    if (m_named) {
+        rtn.reserve (m_property.size() + 3 + 2 * m_bytes.size() + 2);
+        rtn += m_property;
+        rtn += " : ";
+    }
+
+    json::hex (m_bytes, rtn);
+
+    return rtn;
+}
+
+/******************************************************************************/
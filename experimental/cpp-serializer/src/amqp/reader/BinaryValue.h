@@ -0,0 +1,79 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "Reader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal {
+
+    class CompositeFactory;
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * An AMQP binary value, held as a view of the bytes where proton
+     * left them rather than a copy. Those bytes, and the factory that
+     * read them, must outlive the value.
+     *
+     * Corda embeds whole serialised objects as binary, the components
+     * of a transaction for instance, so a value that starts with the
+     * Corda header can be decoded as a blob in its own right. That only
+     * happens if asked for, and then once, with the readers of the
+     * factory that read the enclosing blob so types the two share are
+     * only built once. Dumping the value prints its bytes as hex either
+     * way, looking at a transaction doesn't cost decoding every
+     * component of it.
+     */
+    class BinaryValue : public Value {
+        private :
+            struct Nested;
+
+            std::string        m_property;
+            bool               m_named;
+            std::string_view   m_bytes;
+            CompositeFactory * m_factory;
+
+            mutable std::unique_ptr<Nested> m_nested;
+
+        public :
+            BinaryValue (std::string_view bytes_, CompositeFactory *);
+
+            BinaryValue (
+                std::string property_,
+                std::string_view bytes_,
+                CompositeFactory *);
+
+            ~BinaryValue() override;
+
+            std::string_view bytes() const { return m_bytes; }
+
+            /**
+             * True if the bytes look like a Corda blob, i.e. start with
+             * its header and the section id we can decode
+             */
+            bool blob() const;
+
+            /**
+             * The nested blob's payload, decoded on first call
+             *
+             * @throws std::runtime_error if the bytes aren't a blob we
+             * can read
+             */
+            const amqp::reader::IValue & decode() const;
+
+            std::string dump() const override;
+    };
+
+}
+
+/******************************************************************************/
@@ -10,6 +10,7 @@
 #include "Reader.h"
 #include "amqp/reader/IReader.h"
 #include "proton/proton_wrapper.h"
+#include "amqp/json/Json.h"
 
 /******************************************************************************/
 
@@ -27,10 +28,19 @@ CompositeReader::m_name { // NOLINT
 amqp::internal::reader::
 CompositeReader::CompositeReader (
         std::string type_,
-        sVec<std::weak_ptr<Reader>> & readers_
+        sVec<std::weak_ptr<Reader>> & readers_,
+        const std::vector<std::string> & names_,
+        std::vector<bool> mandatory_
 ) : m_readers (readers_)
   , m_type (std::move (type_))
+  , m_mandatory (std::move (mandatory_))
 {
+    m_keys.reserve (names_.size());
+
+    for (const auto & name : names_) {
+        m_keys.push_back (json::quote (name));
+    }
+
     DBG ("MAKE CompositeReader: " << m_type << ": " << m_readers.size() << std::endl); // NOLINT
     for (auto const reader : m_readers) {
         assert (reader.lock());
@@ -42,6 +52,46 @@ CompositeReader::CompositeReader (
 
 /******************************************************************************/
 
+amqp::internal::reader::
+CompositeReader::CompositeReader (
+        std::string type_,
+        sVec<std::weak_ptr<Reader>> & readers_,
+        std::shared_ptr<const FieldMapping> mapping_,
+        std::vector<bool> mandatory_
+) : m_readers (readers_)
+  , m_type (std::move (type_))
+  , m_mapping (std::move (mapping_))
+  , m_mandatory (std::move (mandatory_))
+{
+    m_keys.reserve (m_mapping->slots().size());
+
+    for (const auto & slot : m_mapping->slots()) {
+        m_keys.push_back (json::quote (slot.name));
+    }
+
+    assert (m_mapping->wireToLocal().size() == m_readers.size());
+}
+
+/******************************************************************************/
+
+/**
+ * Property readers write a null as null, it's here that we know whether
+ * the field the [i_]th value on the wire belongs to is allowed one
+ */
+void
+amqp::internal::reader::
+CompositeReader::checkNull (
+    size_t i_,
+    const std::string & key_,
+    pn_data_t * data_
+) const {
+    if (i_ < m_mandatory.size() && m_mandatory[i_] && pn_data_type (data_) == PN_NULL) {
+        throw std::runtime_error ("Null for the mandatory field " + key_ + " of " + m_type);
+    }
+}
+
+/******************************************************************************/
+
 const std::string &
 amqp::internal::reader::
 CompositeReader::name() const {
@@ -90,21 +140,23 @@ CompositeReader::_dump (
         << type()
         << std::endl); // NOLINT
 
+    if (m_mapping) {
+        return _dumpMapped (data_, schema_);
+    }
+
+    // Whoever picked us, the factory or a dispatching field, already
+    // matched the descriptor so there's no need to look it up in the
+    // schema again
     proton::is_described (data_);
     proton::auto_enter ae (data_);
+    proton::is_symbol (data_);
 
-    const auto & it = schema_.fromDescriptor (
-            proton::get_symbol<std::string>(data_));
-
-    auto & fields = dynamic_cast<schema::Composite &> (
-            *(it->second.get())).fields();
-
-    assert (fields.size() == m_readers.size());
+    assert (m_keys.size() == m_readers.size());
 
     pn_data_next (data_);
 
     sVec<uPtr<amqp::reader::IValue>> read;
-    read.reserve (fields.size());
+    read.reserve (m_readers.size());
 
     proton::is_list (data_);
     {
@@ -112,13 +164,14 @@ CompositeReader::_dump (
 
         for (int i (0) ; i < m_readers.size() ; ++i) {
             if (auto l =  m_readers[i].lock()) {
-                DBG (fields[i]->name() << " "
+                DBG (m_keys[i] << " "
                     << (l ? "true" : "false") << std::endl); // NOLINT
 
-                read.emplace_back (l->dump (fields[i]->name(), data_, schema_));
+                checkNull (i, m_keys[i], data_);
+                read.emplace_back (l->dump (m_keys[i], data_, schema_));
             } else {
                 std::stringstream s;
-                s << "null field reader: " << fields[i]->name();
+                s << "null field reader: " << m_keys[i];
                 throw std::runtime_error (s.str());
             }
         }
@@ -129,6 +182,59 @@ CompositeReader::_dump (
 
 /******************************************************************************/
 
+/**
+ * The names of the fields come from the mapping so, unlike when reading
+ * a type as it was written, there's no need to find it in the schema
+ */
+sVec<uPtr<amqp::reader::IValue>>
+amqp::internal::reader::
+CompositeReader::_dumpMapped (
+        pn_data_t * data_,
+        const SchemaType & schema_
+) const {
+    const auto & wireToLocal = m_mapping->wireToLocal();
+    const auto & slots = m_mapping->slots();
+
+    proton::is_described (data_);
+    proton::auto_enter ae (data_);
+
+    pn_data_next (data_);
+
+    sVec<uPtr<amqp::reader::IValue>> read (slots.size());
+
+    proton::is_list (data_);
+    {
+        proton::auto_enter ae (data_);
+
+        for (size_t i (0) ; i < m_readers.size() ; ++i) {
+            auto local = wireToLocal[i];
+
+            if (local == FieldMapping::SKIP) {
+                pn_data_next (data_);
+            } else if (auto l = m_readers[i].lock()) {
+                checkNull (i, m_keys[local], data_);
+                read[local] = l->dump (m_keys[local], data_, schema_);
+            } else {
+                std::stringstream s;
+                s << "null field reader: " << slots[local].name;
+                throw std::runtime_error (s.str());
+            }
+        }
+    }
+
+    for (size_t i (0) ; i < slots.size() ; ++i) {
+        if (slots[i].wire == FieldMapping::SKIP) {
+            read[i] = std::make_unique<TypedPair<std::string>> (
+                m_keys[i],
+                std::string (slots[i].defaultValue));
+        }
+    }
+
+    return read;
+}
+
+/******************************************************************************/
+
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
 CompositeReader::dump (
@@ -3,6 +3,7 @@
 /******************************************************************************/
 
 #include "Reader.h"
+#include "FieldMapping.h"
 
 #include <any>
 #include <vector>
@@ -21,10 +22,39 @@ namespace amqp::internal::reader {
 
             std::string m_type;
 
+            /**
+             * The name of each field quoted and escaped, ready to be
+             * used as its key. Indexed as the fields are on the wire or,
+             * when there's a mapping, by the local slot.
+             */
+            std::vector<std::string> m_keys;
+
+            /**
+             * Set when the type was written as a different version of
+             * the one we're expecting to read
+             */
+            std::shared_ptr<const FieldMapping> m_mapping;
+
+            /**
+             * Which of the fields, as they are on the wire, can't be null.
+             * Empty when reading trusted blobs, which aren't checked.
+             */
+            std::vector<bool> m_mandatory;
+
+            void checkNull (size_t, const std::string &, pn_data_t *) const;
+
         public :
             CompositeReader (
                 std::string,
-                std::vector<std::weak_ptr<Reader>> &);
+                std::vector<std::weak_ptr<Reader>> &,
+                const std::vector<std::string> &,
+                std::vector<bool> mandatory_ = { });
+
+            CompositeReader (
+                std::string,
+                std::vector<std::weak_ptr<Reader>> &,
+                std::shared_ptr<const FieldMapping>,
+                std::vector<bool> mandatory_ = { });
 
             ~CompositeReader() override = default;
 
@@ -48,6 +78,10 @@ namespace amqp::internal::reader {
             std::vector<std::unique_ptr<amqp::reader::IValue>> _dump (
                 pn_data_t *,
                 const SchemaType &) const;
+
+            std::vector<std::unique_ptr<amqp::reader::IValue>> _dumpMapped (
+                pn_data_t *,
+                const SchemaType &) const;
     };
 
 }
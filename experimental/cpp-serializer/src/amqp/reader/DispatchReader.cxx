@@ -0,0 +1,142 @@
+#include "DispatchReader.h"
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <proton/codec.h>
+
+#include "debug.h"
+#include "proton/proton_wrapper.h"
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+DispatchReader::m_name { // NOLINT
+    "Dispatch Reader"
+};
+
+/******************************************************************************/
+
+amqp::internal::reader::
+DispatchReader::DispatchReader (
+    std::string type_,
+    const spStrMap_t<Reader> & byDescriptor_,
+    std::weak_ptr<Reader> declared_
+) : m_type (std::move (type_))
+  , m_byDescriptor (byDescriptor_)
+  , m_declared (std::move (declared_))
+{
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+DispatchReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+DispatchReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
+
+/**
+ * Peek at the descriptor of the value at the current node, leaving the
+ * node where it was for the reader we pick to consume
+ */
+const amqp::internal::reader::Reader &
+amqp::internal::reader::
+DispatchReader::target (pn_data_t * data_) const {
+    if (!pn_data_is_described (data_)) {
+        if (auto declared = m_declared.lock()) {
+            return *declared;
+        }
+
+        proton::is_described (data_);
+    }
+
+    proton::auto_enter ae (data_);
+    proton::is_symbol (data_);
+
+    auto descriptor = pn_data_get_symbol (data_);
+
+    for (size_t i { 0 } ; i < m_entries ; ++i) {
+        const auto & entry = m_cache[i];
+
+        if (entry.descriptor.size() == descriptor.size
+            && std::memcmp (entry.descriptor.data(), descriptor.start, descriptor.size) == 0)
+        {
+            return *entry.reader;
+        }
+    }
+
+    std::string key (descriptor.start, descriptor.size);
+
+    auto it = m_byDescriptor.find (key);
+
+    if (it == m_byDescriptor.end() || !it->second) {
+        std::stringstream ss;
+        ss << "No type with descriptor " << key << " for a field of type "
+           << m_type;
+        throw std::runtime_error (ss.str());
+    }
+
+    DBG ("Dispatch " << m_type << " -> " << it->second->type() << std::endl); // NOLINT
+
+    if (m_entries < CACHE_SIZE) {
+        m_cache[m_entries].descriptor = std::move (key);
+        m_cache[m_entries].reader = it->second.get();
+        ++m_entries;
+    }
+
+    return *it->second;
+}
+
+/******************************************************************************/
+
+std::any
+amqp::internal::reader::
+DispatchReader::read (pn_data_t * data_) const {
+    return target (data_).read (data_);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+DispatchReader::readString (pn_data_t * data_) const {
+    return target (data_).readString (data_);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+DispatchReader::dump (
+    const std::string & name_,
+    pn_data_t * data_,
+    const SchemaType & schema_
+) const {
+    return target (data_).dump (name_, data_, schema_);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+DispatchReader::dump (
+    pn_data_t * data_,
+    const SchemaType & schema_
+) const {
+    return target (data_).dump (data_, schema_);
+}
+
+/******************************************************************************/
@@ -0,0 +1,91 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "Reader.h"
+
+#include <array>
+#include <string>
+
+#include "types.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Reads a field whose declared type doesn't tell us what's actually
+     * on the wire, a field typed "*" or one typed as an interface or
+     * abstract class. The concrete type only comes from the descriptor
+     * written with each value.
+     *
+     * Rather than go to the factory's table of readers by descriptor for
+     * every value, each field site remembers the descriptors it has seen
+     * and the readers they resolved to. Most such fields only ever hold
+     * one type, so the first entry almost always hits, and those that
+     * hold a few still get away with comparing a handful of fingerprints.
+     * Once a site has seen more types than it can cache, it goes to the
+     * table every time.
+     *
+     * Readers are only ever used by one thread at a time so the cache,
+     * being an implementation detail of an otherwise const reader, is
+     * mutable and unguarded.
+     */
+    class DispatchReader : public Reader {
+        public :
+            static constexpr size_t CACHE_SIZE { 4 };
+
+        private :
+            struct Entry {
+                std::string    descriptor;
+                const Reader * reader { nullptr };
+            };
+
+            static const std::string m_name;
+
+            const std::string m_type;
+
+            /**
+             * The factory's readers by descriptor, it outlives every
+             * reader it builds
+             */
+            const spStrMap_t<Reader> & m_byDescriptor;
+
+            /**
+             * Read values that aren't described, a null for instance,
+             * with the reader of the declared type if there is one
+             */
+            std::weak_ptr<Reader> m_declared;
+
+            mutable std::array<Entry, CACHE_SIZE> m_cache;
+            mutable size_t m_entries { 0 };
+
+            const Reader & target (pn_data_t *) const;
+
+        public :
+            DispatchReader (
+                std::string,
+                const spStrMap_t<Reader> &,
+                std::weak_ptr<Reader>);
+
+            ~DispatchReader() override = default;
+
+            const std::string & name() const override;
+            const std::string & type() const override;
+
+            std::any read (pn_data_t *) const override;
+            std::string readString (pn_data_t *) const override;
+
+            uPtr<amqp::reader::IValue> dump (
+                const std::string &,
+                pn_data_t *,
+                const SchemaType &) const override;
+
+            uPtr<amqp::reader::IValue> dump (
+                pn_data_t *,
+                const SchemaType &) const override;
+    };
+
+}
+
+/******************************************************************************/
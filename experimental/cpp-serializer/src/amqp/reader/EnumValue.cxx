@@ -0,0 +1,49 @@
+#include "EnumValue.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::EnumValue
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+EnumValue::EnumValue (
+    int32_t code_,
+    std::shared_ptr<const EnumDictionary> dictionary_
+) : m_named (false)
+  , m_code (code_)
+  , m_dictionary (std::move (dictionary_))
+{ }
+
+/******************************************************************************/
+
+amqp::internal::reader::
+EnumValue::EnumValue (
+    std::string property_,
+    int32_t code_,
+    std::shared_ptr<const EnumDictionary> dictionary_
+) : m_property (std::move (property_))
+  , m_named (true)
+  , m_code (code_)
+  , m_dictionary (std::move (dictionary_))
+{ }
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+EnumValue::constant() const {
+    return (*m_dictionary)[m_code];
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+EnumValue::dump() const {
+    auto value = json::quote (constant());
+
+    return m_named ? m_property + " : " + value : value;
+}
+
+/******************************************************************************/
@@ -0,0 +1,56 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "Reader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * The constants of an enum, shared between the reader that built
+     * them and every value it reads
+     */
+    using EnumDictionary = std::vector<std::string>;
+
+    /**
+     * A dictionary encoded enum value, the index of the constant plus
+     * the dictionary of constants it indexes. Reading one involves no
+     * string work at all, the constant's name is only looked up if the
+     * value is dumped.
+     */
+    class EnumValue : public Value {
+        private :
+            std::string                           m_property;
+            bool                                  m_named;
+            int32_t                               m_code;
+            std::shared_ptr<const EnumDictionary> m_dictionary;
+
+        public :
+            EnumValue (
+                int32_t code_,
+                std::shared_ptr<const EnumDictionary> dictionary_);
+
+            EnumValue (
+                std::string property_,
+                int32_t code_,
+                std::shared_ptr<const EnumDictionary> dictionary_);
+
+            int32_t code() const { return m_code; }
+
+            const EnumDictionary & dictionary() const { return *m_dictionary; }
+
+            const std::string & constant() const;
+
+            std::string dump() const override;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,57 @@
+#include "FieldMapping.h"
+
+#include <sstream>
+#include <stdexcept>
+
+#include "field-types/Field.h"
+
+/******************************************************************************/
+
+amqp::internal::reader::
+FieldMapping::FieldMapping (
+    const std::string & type_,
+    const std::vector<uPtr<schema::Field>> & wire_,
+    const std::vector<ExpectedField> & local_
+) : m_wireToLocal (wire_.size(), SKIP)
+{
+    m_slots.reserve (local_.size());
+
+    for (const auto & field : local_) {
+        Slot slot { field.name, SKIP, field.defaultValue };
+
+        for (size_t i { 0 } ; i < wire_.size() ; ++i) {
+            if (wire_[i]->name() != field.name) {
+                continue;
+            }
+
+            if (wire_[i]->type() != field.type) {
+                std::stringstream ss;
+                ss << "Field " << type_ << "::" << field.name
+                   << " was written as " << wire_[i]->type()
+                   << " but is expected to be " << field.type;
+                throw std::runtime_error (ss.str());
+            }
+
+            slot.wire = static_cast<int32_t>(i);
+            m_wireToLocal[i] = static_cast<int32_t>(m_slots.size());
+            break;
+        }
+
+        if (slot.wire == SKIP) {
+            if (slot.defaultValue.empty()) {
+                if (field.mandatory) {
+                    std::stringstream ss;
+                    ss << "Mandatory field " << type_ << "::" << field.name
+                       << " is missing and has no default";
+                    throw std::runtime_error (ss.str());
+                }
+
+                slot.defaultValue = "null";
+            }
+        }
+
+        m_slots.emplace_back (std::move (slot));
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,88 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "types.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    class Field;
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * The parts of a field of the version of a composite the caller
+     * expects that are needed to map another version onto it. Copied
+     * out of the expected schema so it needn't outlive the factory.
+     */
+    struct ExpectedField {
+        std::string name;
+        std::string type;
+        std::string defaultValue;
+        bool        mandatory;
+    };
+
+    /**
+     * How to read the fields of a composite as it was written as the
+     * fields of the version of it we expect. Built once when the readers
+     * are created so decoding an evolved type costs no more than one that
+     * matches, each wire slot is either read into a local slot or skipped
+     * and local slots nothing was written for are given their default.
+     */
+    class FieldMapping {
+        public :
+            static constexpr int32_t SKIP = -1;
+
+            struct Slot {
+                std::string name;
+
+                /**
+                 * The position of the field on the wire or [SKIP] if it
+                 * wasn't written and [defaultValue] should be used
+                 */
+                int32_t     wire;
+                std::string defaultValue;
+            };
+
+        private :
+            /**
+             * For each field on the wire the local slot it's read
+             * into, or [SKIP] if we don't have one
+             */
+            std::vector<int32_t> m_wireToLocal;
+
+            std::vector<Slot> m_slots;
+
+        public :
+            /**
+             * @throws std::runtime_error if the versions can't be
+             * reconciled, a field changed type or a mandatory field
+             * with no default is missing from the wire
+             */
+            FieldMapping (
+                const std::string & type_,
+                const std::vector<uPtr<schema::Field>> & wire_,
+                const std::vector<ExpectedField> & local_);
+
+            const std::vector<int32_t> & wireToLocal() const {
+                return m_wireToLocal;
+            }
+
+            const std::vector<Slot> & slots() const {
+                return m_slots;
+            }
+    };
+
+}
+
+/******************************************************************************/
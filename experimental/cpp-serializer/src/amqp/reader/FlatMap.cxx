@@ -0,0 +1,98 @@
+#include "FlatMap.h"
+
+#include <sstream>
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::FlatMap
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+FlatMap::FlatMap (
+    std::shared_ptr<const Reader> keyReader_,
+    std::shared_ptr<const Reader> valueReader_,
+    size_t reserve_
+) : m_named (false)
+  , m_keyReader (std::move (keyReader_))
+  , m_valueReader (std::move (valueReader_))
+{
+    m_keys.reserve (reserve_);
+    m_values.reserve (reserve_);
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::
+FlatMap::FlatMap (
+    std::string property_,
+    std::shared_ptr<const Reader> keyReader_,
+    std::shared_ptr<const Reader> valueReader_,
+    size_t reserve_
+) : FlatMap (std::move (keyReader_), std::move (valueReader_), reserve_)
+{
+    m_property = std::move (property_);
+    m_named = true;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+FlatMap::emplace_back (Scalar key_, Scalar value_) {
+    m_keys.emplace_back (std::move (key_));
+    m_values.emplace_back (std::move (value_));
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Scalar *
+amqp::internal::reader::
+FlatMap::find (const Scalar & key_) const {
+    if (!m_index) {
+        m_index = std::make_unique<std::unordered_map<Scalar, size_t>> (
+            m_keys.size());
+
+        for (size_t i { 0 } ; i < m_keys.size() ; ++i) {
+            // on a duplicate the first written wins
+            m_index->emplace (m_keys[i], i);
+        }
+    }
+
+    auto it = m_index->find (key_);
+
+    return it == m_index->end() ? nullptr : &m_values[it->second];
+}
+
+/******************************************************************************/
+
+/**
+ * Formatted identically to a map read into ValuePairs
+ */
+std::string
+amqp::internal::reader::
+FlatMap::dump() const {
+    std::stringstream ss;
+
+    if (m_named) {
+        ss << m_property << " : ";
+    }
+
+    ss << "{ ";
+
+    for (size_t i { 0 } ; i < m_keys.size() ; ++i) {
+        if (i) {
+            ss << ", ";
+        }
+
+        ss << json::key (m_keyReader->dumpScalar (m_keys[i]), m_keyReader->quoted())
+           << " : "
+           << m_valueReader->dumpScalar (m_values[i]);
+    }
+
+    ss << " }";
+
+    return ss.str();
+}
+
+/******************************************************************************/
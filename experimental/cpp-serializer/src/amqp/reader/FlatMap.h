@@ -0,0 +1,74 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "Reader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * A map whose keys and values are both scalars. Rather than an IValue
+     * per key, value and the pair holding them, entries are kept in two
+     * contiguous arrays in the order they were written, which for Corda is
+     * deterministic.
+     *
+     * Keyed lookup is through [find], the first call builds a hash index
+     * over the keys so maps that are only ever dumped never pay for one.
+     * As that index is built lazily [find] isn't safe to call from several
+     * threads at once.
+     */
+    class FlatMap : public Value {
+        private :
+            std::string m_property;
+            bool        m_named;
+
+            std::vector<Scalar> m_keys;
+            std::vector<Scalar> m_values;
+
+            /**
+             * Keep the readers alive so the map can be dumped after the
+             * factory that made them has gone
+             */
+            std::shared_ptr<const Reader> m_keyReader;
+            std::shared_ptr<const Reader> m_valueReader;
+
+            mutable std::unique_ptr<std::unordered_map<Scalar, size_t>> m_index;
+
+        public :
+            FlatMap (
+                std::shared_ptr<const Reader> keyReader_,
+                std::shared_ptr<const Reader> valueReader_,
+                size_t reserve_);
+
+            FlatMap (
+                std::string property_,
+                std::shared_ptr<const Reader> keyReader_,
+                std::shared_ptr<const Reader> valueReader_,
+                size_t reserve_);
+
+            void emplace_back (Scalar key_, Scalar value_);
+
+            size_t size() const { return m_keys.size(); }
+
+            const Scalar & key (size_t i_) const { return m_keys[i_]; }
+            const Scalar & value (size_t i_) const { return m_values[i_]; }
+
+            /**
+             * @return the value stored against [key_] or nullptr if there
+             * isn't one
+             */
+            const Scalar * find (const Scalar & key_) const;
+
+            std::string dump() const override;
+    };
+
+}
+
+/******************************************************************************/
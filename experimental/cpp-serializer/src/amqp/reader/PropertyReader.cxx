@@ -5,10 +5,12 @@
 #include "amqp/reader/property-readers/LongPropertyReader.h"
 #include "amqp/reader/property-readers/StringPropertyReader.h"
 #include "amqp/reader/property-readers/DoublePropertyReader.h"
+#include "amqp/reader/property-readers/BinaryPropertyReader.h"
 
 #include <map>
 #include <string>
 #include <iostream>
+#include <stdexcept>
 #include <functional>
 
 #include <proton/codec.h>
@@ -21,36 +23,67 @@ namespace {
 
     using namespace amqp::internal::reader;
 
-    std::map<
-            std::string,
-            std::shared_ptr<amqp::internal::reader::PropertyReader>(*)()
-    > propertyMap = { // NOLINT
-        {
-            "int", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<IntPropertyReader> ();
-            }
-        },
-        {
-            "string", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<StringPropertyReader> ();
-            }
-        },
-        {
-            "boolean", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<BoolPropertyReader> ();
-            }
-        },
-        {
-            "long", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<LongPropertyReader> ();
-            }
-        },
-        {
-            "double", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<DoublePropertyReader> ();
+    using Factory = amqp::internal::CompositeFactory;
+
+    using Maker = std::shared_ptr<PropertyReader>(*)(Factory *);
+
+    template<typename Policy>
+    const std::map<std::string, Maker> &
+    propertyMap() {
+        static const std::map<std::string, Maker> map = { // NOLINT
+            {
+                "int", [](Factory *) -> std::shared_ptr<PropertyReader> {
+                    return std::make_shared<IntPropertyReader<Policy>> ();
+                }
+            },
+            {
+                "string", [](Factory *) -> std::shared_ptr<PropertyReader> {
+                    return std::make_shared<StringPropertyReader<Policy>> ();
+                }
+            },
+            {
+                "boolean", [](Factory *) -> std::shared_ptr<PropertyReader> {
+                    return std::make_shared<BoolPropertyReader<Policy>> ();
+                }
+            },
+            {
+                "long", [](Factory *) -> std::shared_ptr<PropertyReader> {
+                    return std::make_shared<LongPropertyReader<Policy>> ();
+                }
+            },
+            {
+                "double", [](Factory *) -> std::shared_ptr<PropertyReader> {
+                    return std::make_shared<DoublePropertyReader<Policy>> ();
+                }
+            },
+            {
+                "binary", [](Factory * factory_) -> std::shared_ptr<PropertyReader> {
+                    return std::make_shared<BinaryPropertyReader<Policy>> (factory_);
+                }
             }
+        };
+
+        return map;
+    }
+
+    std::shared_ptr<PropertyReader>
+    make (
+        const std::string & type_,
+        bool trusted_,
+        Factory * factory_
+    ) {
+        const auto & map = trusted_
+            ? propertyMap<proton::Trusted>()
+            : propertyMap<proton::Checked>();
+
+        auto it = map.find (type_);
+
+        if (it == map.end()) {
+            throw std::runtime_error ("No reader for primitive type " + type_);
         }
-    };
+
+        return it->second (factory_);
+    }
 
 }
 
@@ -60,26 +93,52 @@ namespace {
  *
  ******************************************************************************/
 
+bool
+amqp::internal::reader::
+PropertyReader::null (pn_data_t * data_) {
+    if (pn_data_type (data_) != PN_NULL) {
+        return false;
+    }
+
+    pn_data_next (data_);
+
+    return true;
+}
+
+/******************************************************************************/
+
 std::shared_ptr<amqp::internal::reader::PropertyReader>
 amqp::internal::reader::
-PropertyReader::make (const FieldPtr & field_) {
-    return propertyMap[field_->type()]();
+PropertyReader::make (
+    const FieldPtr & field_,
+    bool trusted_,
+    CompositeFactory * factory_
+) {
+    return ::make (field_->type(), trusted_, factory_);
 }
 
 /******************************************************************************/
 
 std::shared_ptr<amqp::internal::reader::PropertyReader>
 amqp::internal::reader::
-PropertyReader::make (const std::string & type_) {
-    return propertyMap[type_]();
+PropertyReader::make (
+    const std::string & type_,
+    bool trusted_,
+    CompositeFactory * factory_
+) {
+    return ::make (type_, trusted_, factory_);
 }
 
 /******************************************************************************/
 
 std::shared_ptr<amqp::internal::reader::PropertyReader>
 amqp::internal::reader::
-PropertyReader::make (const internal::schema::Field & field_) {
-    return propertyMap[field_.type()]();
+PropertyReader::make (
+    const internal::schema::Field & field_,
+    bool trusted_,
+    CompositeFactory * factory_
+) {
+    return ::make (field_.type(), trusted_, factory_);
 }
 
 /******************************************************************************/
@@ -8,6 +8,14 @@
 
 /******************************************************************************/
 
+namespace amqp::internal {
+
+    class CompositeFactory;
+
+}
+
+/******************************************************************************/
+
 namespace amqp::internal::reader {
 
     class PropertyReader : public Reader {
@@ -16,11 +24,27 @@ namespace amqp::internal::reader {
 
         public :
             /**
-             * Static Factory method for creating appropriate derived types
+             * Static Factory method for creating appropriate derived types,
+             * [trusted_] picks the instantiations that don't check what
+             * they read. [factory_], if given, is what binary values use
+             * to decode any blob nested within them
+             *
+             * @throws std::runtime_error for a type that isn't primitive
              */
-            static std::shared_ptr<PropertyReader> make (const internal::schema::Field &);
-            static std::shared_ptr<PropertyReader> make (const FieldPtr &);
-            static std::shared_ptr<PropertyReader> make (const std::string &);
+            static std::shared_ptr<PropertyReader> make (
+                const internal::schema::Field &,
+                bool trusted_ = false,
+                CompositeFactory * factory_ = nullptr);
+
+            static std::shared_ptr<PropertyReader> make (
+                const FieldPtr &,
+                bool trusted_ = false,
+                CompositeFactory * factory_ = nullptr);
+
+            static std::shared_ptr<PropertyReader> make (
+                const std::string &,
+                bool trusted_ = false,
+                CompositeFactory * factory_ = nullptr);
 
             PropertyReader() = default;
             ~PropertyReader() override = default;
@@ -42,6 +66,15 @@ namespace amqp::internal::reader {
 
             const std::string & name() const override = 0;
             const std::string & type() const override = 0;
+
+        protected :
+            /**
+             * True, having moved past it, if the current node is a null.
+             * A field that isn't mandatory can hold one in place of its
+             * primitive, whether one that is may is up to the composite
+             * reading it
+             */
+            static bool null (pn_data_t *);
     };
 
 }
@@ -1,88 +1,47 @@
 #include "Reader.h"
 
 #include <memory>
-#include <sstream>
+#include <stdexcept>
 
 /******************************************************************************/
 
 namespace {
 
+    /**
+     * The brackets either side of a map or a list
+     */
     struct AutoMap {
-        std::stringstream & m_stream;
-
-        AutoMap (
-                const std::string & s,
-                std::stringstream & stream_
-        ) : m_stream (stream_) {
-            m_stream << s << " : { ";
-        }
-
-        explicit AutoMap (std::stringstream & stream_)
-            : m_stream (stream_)
-        {
-            m_stream << "{ ";
-        }
-
-        ~AutoMap() {
-            m_stream << " }";
-        }
+        static constexpr const char * open = "{ ";
+        static constexpr const char * close = " }";
     };
 
     struct AutoList {
-        std::stringstream & m_stream;
-
-        AutoList (
-                const std::string & s,
-                std::stringstream & stream_
-        ) : m_stream (stream_) {
-            m_stream << s << " : [ ";
-        }
-
-        explicit AutoList (std::stringstream & stream_)
-            : m_stream (stream_)
-        {
-            m_stream << "[ ";
-        }
-
-        ~AutoList() {
-            m_stream << " ]";
-        }
+        static constexpr const char * open = "[ ";
+        static constexpr const char * close = " ]";
     };
 
     template<class Auto, class T>
     std::string
-    dumpPair (const std::string & name_, const T & begin_, const T & end_) {
-        std::stringstream rtn;
-        {
-            Auto am (name_, rtn);
-
-            if (begin_ != end_) {
-                rtn << (*(begin_))->dump();
-                for (auto it(std::next(begin_)); it != end_; ++it) {
-                    rtn << ", " << (*it)->dump();
-                }
+    dumpSingle (const T & begin_, const T & end_, std::string rtn_ = { }) {
+        rtn_ += Auto::open;
+
+        for (auto it (begin_) ; it != end_ ; ++it) {
+            if (it != begin_) {
+                rtn_ += ", ";
             }
+
+            rtn_ += (*it)->dump();
         }
 
-        return rtn.str();
+        rtn_ += Auto::close;
+
+        return rtn_;
     }
 
     template<class Auto, class T>
     std::string
-    dumpSingle (const T & begin_, const T & end_) {
-        std::stringstream rtn;
-        {
-            Auto am (rtn);
-
-            if (begin_ != end_) {
-                rtn << (*(begin_))->dump();
-                for (auto it(std::next(begin_)); it != end_; ++it) {
-                    rtn << ", " << (*it)->dump();
-                }
-            }
-        }
-
-        return rtn.str();
+    dumpPair (const std::string & name_, const T & begin_, const T & end_) {
+        return dumpSingle<Auto> (begin_, end_, name_ + " : ");
     }
 
 }
@@ -96,11 +55,7 @@ namespace {
 std::string
 amqp::internal::reader::
 ValuePair::dump() const {
-    std::stringstream ss;
-
-    ss << m_key->dump() << " : " << m_value->dump();
-
-    return ss.str();
+    return json::key (m_key->dump(), m_quoted) + " : " + m_value->dump();
 }
 
 /******************************************************************************
@@ -172,3 +127,41 @@ TypedSingle<sVec<uPtr<amqp::internal::reader::Single>>>::dump() const {
 }
 
 /******************************************************************************/
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Reader
+ *
+ ******************************************************************************/
+
+bool
+amqp::internal::reader::
+Reader::isScalar() const {
+    return false;
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::Scalar
+amqp::internal::reader::
+Reader::readScalar (pn_data_t *) const {
+    throw std::logic_error (type() + " can't be read as a scalar");
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+Reader::dumpScalar (const Scalar &) const {
+    throw std::logic_error (type() + " can't be read as a scalar");
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+Reader::quoted() const {
+    return false;
+}
+
+/******************************************************************************/
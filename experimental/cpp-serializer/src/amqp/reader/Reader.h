@@ -7,9 +7,12 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <variant>
+#include <cstdint>
 
 #include "amqp/schema/described-types/Schema.h"
 #include "amqp/reader/IReader.h"
+#include "amqp/json/Json.h"
 
 /******************************************************************************/
 
@@ -73,7 +76,9 @@ namespace amqp::internal::reader {
     /*
      * A Pair represents an association between a property and
      * the value of the property, i.e. a : b where property
-     * a has value b
+     * a has value b. The property is held as the key it's dumped
+     * as, for fields that's their name already quoted and escaped
+     * by the composite reader that owns them.
      */
     class Pair : public Value {
         protected :
@@ -134,13 +139,20 @@ namespace amqp::internal::reader {
             uPtr<amqp::reader::IValue> m_key;
             uPtr<amqp::reader::IValue> m_value;
 
+            /**
+             * Whether [m_key] dumps as a JSON string, see [Reader::quoted]
+             */
+            bool m_quoted;
+
         public :
             ValuePair (
                 decltype (m_key) key_,
-                decltype (m_value) value_
+                decltype (m_value) value_,
+                bool quoted_
             ) : Value ()
               , m_key (std::move (key_))
               , m_value (std::move (value_))
+              , m_quoted (quoted_)
         { }
 
         std::string dump() const override;
@@ -158,7 +170,7 @@ template<typename T>
 inline std::string
 amqp::internal::reader::
 TypedSingle<T>::dump() const {
-    return std::to_string (m_value);
+    return json::arithmetic (m_value);
 }
 
 template<>
@@ -198,7 +210,7 @@ template<typename T>
 inline std::string
 amqp::internal::reader::
 TypedPair<T>::dump() const {
-    return m_property + " : " + std::to_string (m_value);
+    return m_property + " : " + json::arithmetic (m_value);
 }
 
 template<>
@@ -238,6 +250,12 @@ namespace amqp::internal::reader  {
 
     using IReader = amqp::reader::IReader<schema::SchemaMap::const_iterator>;
 
+    /**
+     * A single primitive, or enum, value held without the IValue wrapping
+     * [dump] would give it so containers of them can be stored flat
+     */
+    using Scalar = std::variant<int32_t, int64_t, double, bool, std::string>;
+
     /**
      * Interface that represents an object that has the ability to consume
      * the payload of a Corda serialized blob in a way defined by some
@@ -267,6 +285,28 @@ namespace amqp::internal::reader  {
             uPtr<amqp::reader::IValue> dump(
                 pn_data_t *,
                 const SchemaType &) const override = 0;
+
+            /**
+             * True for readers of values that can be read as a [Scalar],
+             * only then may [readScalar] and [dumpScalar] be called
+             */
+            virtual bool isScalar() const;
+
+            /**
+             * Read the value at the current node and move past it
+             */
+            virtual Scalar readScalar (pn_data_t *) const;
+
+            /**
+             * Format [value_] exactly as [dump] would have
+             */
+            virtual std::string dumpScalar (const Scalar & value_) const;
+
+            /**
+             * True if what this writes for a value is a JSON string, so
+             * used as a map key it needs no quoting of its own
+             */
+            virtual bool quoted() const;
     };
 
 }
@@ -0,0 +1,145 @@
+#include "BinaryPropertyReader.h"
+
+#include <string_view>
+
+#include <proton/codec.h>
+
+#include "proton/proton_wrapper.h"
+#include "amqp/json/Json.h"
+#include "amqp/reader/BinaryValue.h"
+
+/******************************************************************************/
+
+namespace {
+
+    template<typename Policy>
+    std::string_view
+    readAndNext (pn_data_t * data_) {
+        auto bytes = proton::readAndNext<pn_bytes_t, Policy> (data_);
+
+        return { bytes.start, bytes.size };
+    }
+
+}
+
+/******************************************************************************
+ *
+ * BinaryPropertyReader statics
+ *
+ ******************************************************************************/
+
+template<typename Policy>
+const std::string
+amqp::internal::reader::
+BinaryPropertyReader<Policy>::m_type { // NOLINT
+        "binary"
+};
+
+/******************************************************************************/
+
+template<typename Policy>
+const std::string
+amqp::internal::reader::
+BinaryPropertyReader<Policy>::m_name { // NOLINT
+        "Binary Reader"
+};
+
+/******************************************************************************
+ *
+ * class BinaryPropertyReader
+ *
+ ******************************************************************************/
+
+template<typename Policy>
+amqp::internal::reader::
+BinaryPropertyReader<Policy>::BinaryPropertyReader (CompositeFactory * factory_)
+    : m_factory (factory_)
+{ }
+
+/******************************************************************************/
+
+/**
+ * A view of the bytes, valid for as long as [data_] is
+ */
+template<typename Policy>
+std::any
+amqp::internal::reader::
+BinaryPropertyReader<Policy>::read (pn_data_t * data_) const {
+    return std::any { ::readAndNext<Policy> (data_) };
+}
+
+/******************************************************************************/
+
+template<typename Policy>
+std::string
+amqp::internal::reader::
+BinaryPropertyReader<Policy>::readString (pn_data_t * data_) const {
+    return json::hex (::readAndNext<Policy> (data_));
+}
+
+/******************************************************************************/
+
+template<typename Policy>
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+BinaryPropertyReader<Policy>::dump (
+    const std::string & name_,
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    return std::make_unique<BinaryValue> (
+            name_,
+            ::readAndNext<Policy> (data_),
+            m_factory);
+}
+
+/******************************************************************************/
+
+template<typename Policy>
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+BinaryPropertyReader<Policy>::dump (
+        pn_data_t * data_,
+        const SchemaType & schema_) const
+{
+    return std::make_unique<BinaryValue> (
+            ::readAndNext<Policy> (data_),
+            m_factory);
+}
+
+/******************************************************************************/
+
+/**
+ * Bytes are always written as a string of hex digits
+ */
+template<typename Policy>
+bool
+amqp::internal::reader::
+BinaryPropertyReader<Policy>::quoted() const {
+    return true;
+}
+
+/******************************************************************************/
+
+template<typename Policy>
+const std::string &
+amqp::internal::reader::
+BinaryPropertyReader<Policy>::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+template<typename Policy>
+const std::string &
+amqp::internal::reader::
+BinaryPropertyReader<Policy>::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
+
+template class amqp::internal::reader::BinaryPropertyReader<proton::Checked>;
+template class amqp::internal::reader::BinaryPropertyReader<proton::Trusted>;
+
+/******************************************************************************/
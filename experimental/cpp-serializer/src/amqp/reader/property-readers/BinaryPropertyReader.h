@@ -0,0 +1,59 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "PropertyReader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal {
+
+    class CompositeFactory;
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Reads binary values as [BinaryValue]s viewing proton's copy of the
+     * bytes. Unlike the other property readers it knows the factory that
+     * built it so any Corda blob nested in a value can be decoded with
+     * the same readers. Instantiated for both [proton::Checked] and
+     * [proton::Trusted]
+     */
+    template<typename Policy>
+    class BinaryPropertyReader : public PropertyReader {
+        private :
+            static const std::string m_name;
+            static const std::string m_type;
+
+            CompositeFactory * m_factory;
+
+        public :
+            explicit BinaryPropertyReader (CompositeFactory * factory_ = nullptr);
+
+            std::string readString (pn_data_t *) const override;
+
+            std::any read (pn_data_t *) const override;
+
+            uPtr<amqp::reader::IValue> dump (
+                const std::string &,
+                pn_data_t *,
+                const SchemaType &
+            ) const override;
+
+            uPtr<amqp::reader::IValue> dump (
+                pn_data_t *,
+                const SchemaType &
+            ) const override;
+
+            bool quoted() const override;
+
+            const std::string & name() const override;
+            const std::string & type() const override;
+    };
+}
+
+/******************************************************************************/
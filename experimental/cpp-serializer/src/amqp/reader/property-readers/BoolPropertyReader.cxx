@@ -1,6 +1,7 @@
 #include "BoolPropertyReader.h"
 
 #include "proton/proton_wrapper.h"
+#include "amqp/json/Json.h"
 
 /******************************************************************************
  *
@@ -8,17 +9,19 @@
  *
  ******************************************************************************/
 
+template<typename Policy>
 const std::string
 amqp::internal::reader::
-BoolPropertyReader::m_name { // NOLINT
+BoolPropertyReader<Policy>::m_name { // NOLINT
         "Bool Reader"
 };
 
 /******************************************************************************/
 
+template<typename Policy>
 const std::string
 amqp::internal::reader::
-BoolPropertyReader::m_type { // NOLINT
+BoolPropertyReader<Policy>::m_type { // NOLINT
         "bool"
 };
 
@@ -28,60 +31,106 @@ BoolPropertyReader::m_type { // NOLINT
  *
  ******************************************************************************/
 
+template<typename Policy>
 std::any
 amqp::internal::reader::
-BoolPropertyReader::read (pn_data_t * data_) const {
-    return std::any (proton::readAndNext<bool> (data_));
+BoolPropertyReader<Policy>::read (pn_data_t * data_) const {
+    return std::any (proton::readAndNext<bool, Policy> (data_));
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 std::string
 amqp::internal::reader::
-BoolPropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<bool> (data_));
+BoolPropertyReader<Policy>::readString (pn_data_t * data_) const {
+    return json::boolean (proton::readAndNext<bool, Policy> (data_));
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-BoolPropertyReader::dump (
+BoolPropertyReader<Policy>::dump (
         const std::string & name_,
         pn_data_t * data_,
         const SchemaType & schema_) const
 {
+    if (null (data_)) {
+        return std::make_unique<TypedPair<std::string>> (name_, "null");
+    }
+
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            std::to_string (proton::readAndNext<bool> (data_)));
+            json::boolean (proton::readAndNext<bool, Policy> (data_)));
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-BoolPropertyReader::dump (
+BoolPropertyReader<Policy>::dump (
         pn_data_t * data_,
         const SchemaType & schema_) const
 {
+    if (null (data_)) {
+        return std::make_unique<TypedSingle<std::string>> ("null");
+    }
+
     return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<bool> (data_)));
+            json::boolean (proton::readAndNext<bool, Policy> (data_)));
 }
 
 /******************************************************************************/
 
+template<typename Policy>
+bool
+amqp::internal::reader::
+BoolPropertyReader<Policy>::isScalar() const {
+    return true;
+}
+
+/******************************************************************************/
+
+template<typename Policy>
+amqp::internal::reader::Scalar
+amqp::internal::reader::
+BoolPropertyReader<Policy>::readScalar (pn_data_t * data_) const {
+    return proton::readAndNext<bool, Policy> (data_);
+}
+
+/******************************************************************************/
+
+template<typename Policy>
+std::string
+amqp::internal::reader::
+BoolPropertyReader<Policy>::dumpScalar (const Scalar & value_) const {
+    return json::boolean (std::get<bool> (value_));
+}
+
+/******************************************************************************/
+
+template<typename Policy>
 const std::string &
 amqp::internal::reader::
-BoolPropertyReader::name() const {
+BoolPropertyReader<Policy>::name() const {
     return m_name;
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 const std::string &
 amqp::internal::reader::
-BoolPropertyReader::type() const {
+BoolPropertyReader<Policy>::type() const {
     return m_type;
 }
 
 /******************************************************************************/
+
+template class amqp::internal::reader::BoolPropertyReader<proton::Checked>;
+template class amqp::internal::reader::BoolPropertyReader<proton::Trusted>;
+
+/******************************************************************************/
@@ -8,6 +8,10 @@
 
 namespace amqp::internal::reader {
 
+    /**
+     * Instantiated for both [proton::Checked] and [proton::Trusted]
+     */
+    template<typename Policy>
     class BoolPropertyReader : public PropertyReader {
         private :
             static const std::string m_name;
@@ -29,6 +33,10 @@ namespace amqp::internal::reader {
                 const SchemaType &
             ) const override;
 
+            bool isScalar() const override;
+            Scalar readScalar (pn_data_t *) const override;
+            std::string dumpScalar (const Scalar &) const override;
+
             const std::string & name() const override;
             const std::string & type() const override;
     };
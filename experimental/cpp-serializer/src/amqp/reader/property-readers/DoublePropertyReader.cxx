@@ -1,6 +1,7 @@
 #include "DoublePropertyReader.h"
 
 #include "proton/proton_wrapper.h"
+#include "amqp/json/Json.h"
 
 /******************************************************************************
  *
@@ -8,15 +9,17 @@
  *
  ******************************************************************************/
 
+template<typename Policy>
 const std::string
 amqp::internal::reader::
-DoublePropertyReader::m_name { // NOLINT
+DoublePropertyReader<Policy>::m_name { // NOLINT
     "Double Reader"
 };
 
+template<typename Policy>
 const std::string
 amqp::internal::reader::
-DoublePropertyReader::m_type { // NOLINT
+DoublePropertyReader<Policy>::m_type { // NOLINT
     "double"
 };
 
@@ -26,60 +29,106 @@ DoublePropertyReader::m_type { // NOLINT
  *
  ******************************************************************************/
 
+template<typename Policy>
 std::any
 amqp::internal::reader::
-DoublePropertyReader::read (pn_data_t * data_) const {
-    return std::any { proton::readAndNext<double> (data_) };
+DoublePropertyReader<Policy>::read (pn_data_t * data_) const {
+    return std::any { proton::readAndNext<double, Policy> (data_) };
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 std::string
 amqp::internal::reader::
-DoublePropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<double> (data_));
+DoublePropertyReader<Policy>::readString (pn_data_t * data_) const {
+    return json::number (proton::readAndNext<double, Policy> (data_));
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-DoublePropertyReader::dump (
+DoublePropertyReader<Policy>::dump (
     const std::string & name_,
     pn_data_t * data_,
     const SchemaType & schema_) const
 {
+    if (null (data_)) {
+        return std::make_unique<TypedPair<std::string>> (name_, "null");
+    }
+
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            std::to_string (proton::readAndNext<double> (data_)));
+            json::number (proton::readAndNext<double, Policy> (data_)));
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-DoublePropertyReader::dump (
+DoublePropertyReader<Policy>::dump (
         pn_data_t * data_,
         const SchemaType & schema_) const
 {
+    if (null (data_)) {
+        return std::make_unique<TypedSingle<std::string>> ("null");
+    }
+
     return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<double> (data_)));
+            json::number (proton::readAndNext<double, Policy> (data_)));
 }
 
 /******************************************************************************/
 
+template<typename Policy>
+bool
+amqp::internal::reader::
+DoublePropertyReader<Policy>::isScalar() const {
+    return true;
+}
+
+/******************************************************************************/
+
+template<typename Policy>
+amqp::internal::reader::Scalar
+amqp::internal::reader::
+DoublePropertyReader<Policy>::readScalar (pn_data_t * data_) const {
+    return proton::readAndNext<double, Policy> (data_);
+}
+
+/******************************************************************************/
+
+template<typename Policy>
+std::string
+amqp::internal::reader::
+DoublePropertyReader<Policy>::dumpScalar (const Scalar & value_) const {
+    return json::number (std::get<double> (value_));
+}
+
+/******************************************************************************/
+
+template<typename Policy>
 const std::string &
 amqp::internal::reader::
-DoublePropertyReader::name() const {
+DoublePropertyReader<Policy>::name() const {
     return m_name;
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 const std::string &
 amqp::internal::reader::
-DoublePropertyReader::type() const {
+DoublePropertyReader<Policy>::type() const {
     return m_type;
 }
 
 /******************************************************************************/
+
+template class amqp::internal::reader::DoublePropertyReader<proton::Checked>;
+template class amqp::internal::reader::DoublePropertyReader<proton::Trusted>;
+
+/******************************************************************************/
@@ -6,6 +6,7 @@
 #include <proton/codec.h>
 
 #include "proton/proton_wrapper.h"
+#include "amqp/json/Json.h"
 #include "amqp/reader/IReader.h"
 
 /******************************************************************************
@@ -14,17 +15,19 @@
  *
  ******************************************************************************/
 
+template<typename Policy>
 const std::string
 amqp::internal::reader::
-IntPropertyReader::m_name { // NOLINT
+IntPropertyReader<Policy>::m_name { // NOLINT
     "Int Reader"
 };
 
 /******************************************************************************/
 
+template<typename Policy>
 const std::string
 amqp::internal::reader::
-IntPropertyReader::m_type { // NOLINT
+IntPropertyReader<Policy>::m_type { // NOLINT
     "int"
 };
 
@@ -34,60 +37,106 @@ IntPropertyReader::m_type { // NOLINT
  *
  ******************************************************************************/
 
+template<typename Policy>
 std::any
 amqp::internal::reader::
-IntPropertyReader::read (pn_data_t * data_) const {
-    return std::any { proton::readAndNext<int> (data_) };
+IntPropertyReader<Policy>::read (pn_data_t * data_) const {
+    return std::any { proton::readAndNext<int, Policy> (data_) };
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 std::string
 amqp::internal::reader::
-IntPropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<int> (data_));
+IntPropertyReader<Policy>::readString (pn_data_t * data_) const {
+    return json::number (proton::readAndNext<int, Policy> (data_));
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-IntPropertyReader::dump (
+IntPropertyReader<Policy>::dump (
     const std::string & name_,
     pn_data_t * data_,
     const SchemaType & schema_) const
 {
+    if (null (data_)) {
+        return std::make_unique<TypedPair<std::string>> (name_, "null");
+    }
+
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            std::to_string (proton::readAndNext<int> (data_)));
+            json::number (proton::readAndNext<int, Policy> (data_)));
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-IntPropertyReader::dump (
+IntPropertyReader<Policy>::dump (
     pn_data_t * data_,
     const SchemaType & schema_) const
 {
+    if (null (data_)) {
+        return std::make_unique<TypedSingle<std::string>> ("null");
+    }
+
     return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<int> (data_)));
+            json::number (proton::readAndNext<int, Policy> (data_)));
 }
 
 /******************************************************************************/
 
+template<typename Policy>
+bool
+amqp::internal::reader::
+IntPropertyReader<Policy>::isScalar() const {
+    return true;
+}
+
+/******************************************************************************/
+
+template<typename Policy>
+amqp::internal::reader::Scalar
+amqp::internal::reader::
+IntPropertyReader<Policy>::readScalar (pn_data_t * data_) const {
+    return proton::readAndNext<int, Policy> (data_);
+}
+
+/******************************************************************************/
+
+template<typename Policy>
+std::string
+amqp::internal::reader::
+IntPropertyReader<Policy>::dumpScalar (const Scalar & value_) const {
+    return json::number (std::get<int32_t> (value_));
+}
+
+/******************************************************************************/
+
+template<typename Policy>
 const std::string &
 amqp::internal::reader::
-IntPropertyReader::name() const {
+IntPropertyReader<Policy>::name() const {
     return m_name;
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 const std::string &
 amqp::internal::reader::
-IntPropertyReader::type() const {
+IntPropertyReader<Policy>::type() const {
     return m_type;
 }
 
 /******************************************************************************/
+
+template class amqp::internal::reader::IntPropertyReader<proton::Checked>;
+template class amqp::internal::reader::IntPropertyReader<proton::Trusted>;
+
+/******************************************************************************/
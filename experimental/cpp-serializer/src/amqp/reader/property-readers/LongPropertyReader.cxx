@@ -1,6 +1,7 @@
 #include "LongPropertyReader.h"
 
 #include "proton/proton_wrapper.h"
+#include "amqp/json/Json.h"
 
 /******************************************************************************
  *
@@ -8,17 +9,19 @@
  *
  ******************************************************************************/
 
+template<typename Policy>
 const std::string
 amqp::internal::reader::
-LongPropertyReader::m_name { // NOLINT
+LongPropertyReader<Policy>::m_name { // NOLINT
         "Long Reader"
 };
 
 /******************************************************************************/
 
+template<typename Policy>
 const std::string
 amqp::internal::reader::
-LongPropertyReader::m_type { // NOLINT
+LongPropertyReader<Policy>::m_type { // NOLINT
         "long"
 };
 
@@ -28,60 +31,106 @@ LongPropertyReader::m_type { // NOLINT
  *
  ******************************************************************************/
 
+template<typename Policy>
 std::any
 amqp::internal::reader::
-LongPropertyReader::read (pn_data_t * data_) const {
-    return std::any { proton::readAndNext<long> (data_) };
+LongPropertyReader<Policy>::read (pn_data_t * data_) const {
+    return std::any { proton::readAndNext<long, Policy> (data_) };
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 std::string
 amqp::internal::reader::
-LongPropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<long> (data_));
+LongPropertyReader<Policy>::readString (pn_data_t * data_) const {
+    return json::number (proton::readAndNext<long, Policy> (data_));
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-LongPropertyReader::dump (
+LongPropertyReader<Policy>::dump (
     const std::string & name_,
     pn_data_t * data_,
     const SchemaType & schema_) const
 {
+    if (null (data_)) {
+        return std::make_unique<TypedPair<std::string>> (name_, "null");
+    }
+
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            std::to_string (proton::readAndNext<long> (data_)));
+            json::number (proton::readAndNext<long, Policy> (data_)));
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-LongPropertyReader::dump (
+LongPropertyReader<Policy>::dump (
     pn_data_t * data_,
     const SchemaType & schema_) const
 {
+    if (null (data_)) {
+        return std::make_unique<TypedSingle<std::string>> ("null");
+    }
+
     return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<long> (data_)));
+            json::number (proton::readAndNext<long, Policy> (data_)));
 }
 
 /******************************************************************************/
 
+template<typename Policy>
+bool
+amqp::internal::reader::
+LongPropertyReader<Policy>::isScalar() const {
+    return true;
+}
+
+/******************************************************************************/
+
+template<typename Policy>
+amqp::internal::reader::Scalar
+amqp::internal::reader::
+LongPropertyReader<Policy>::readScalar (pn_data_t * data_) const {
+    return static_cast<int64_t> (proton::readAndNext<long, Policy> (data_));
+}
+
+/******************************************************************************/
+
+template<typename Policy>
+std::string
+amqp::internal::reader::
+LongPropertyReader<Policy>::dumpScalar (const Scalar & value_) const {
+    return json::number (std::get<int64_t> (value_));
+}
+
+/******************************************************************************/
+
+template<typename Policy>
 const std::string &
 amqp::internal::reader::
-LongPropertyReader::name() const {
+LongPropertyReader<Policy>::name() const {
     return m_name;
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 const std::string &
 amqp::internal::reader::
-LongPropertyReader::type() const {
+LongPropertyReader<Policy>::type() const {
     return m_type;
 }
 
 /******************************************************************************/
+
+template class amqp::internal::reader::LongPropertyReader<proton::Checked>;
+template class amqp::internal::reader::LongPropertyReader<proton::Trusted>;
+
+/******************************************************************************/
@@ -3,6 +3,7 @@
 #include <proton/codec.h>
 
 #include "proton/proton_wrapper.h"
+#include "amqp/json/Json.h"
 
 /******************************************************************************
  *
@@ -10,17 +11,19 @@
  *
  ******************************************************************************/
 
+template<typename Policy>
 const std::string
 amqp::internal::reader::
-StringPropertyReader::m_type { // NOLINT
+StringPropertyReader<Policy>::m_type { // NOLINT
         "string"
 };
 
 /******************************************************************************/
 
+template<typename Policy>
 const std::string
 amqp::internal::reader::
-StringPropertyReader::m_name { // NOLINT
+StringPropertyReader<Policy>::m_name { // NOLINT
         "String Reader"
 };
 
@@ -30,60 +33,107 @@ StringPropertyReader::m_name { // NOLINT
  *
  ******************************************************************************/
 
+template<typename Policy>
 std::any
 amqp::internal::reader::
-StringPropertyReader::read (pn_data_t * data_) const {
-    return std::any { proton::readAndNext<std::string> (data_) };
+StringPropertyReader<Policy>::read (pn_data_t * data_) const {
+    return std::any { proton::readAndNext<std::string, Policy> (data_) };
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 std::string
 amqp::internal::reader::
-StringPropertyReader::readString (pn_data_t * data_) const {
-    return proton::readAndNext<std::string> (data_);
+StringPropertyReader<Policy>::readString (pn_data_t * data_) const {
+    return proton::readAndNext<std::string, Policy> (data_);
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-StringPropertyReader::dump (
+StringPropertyReader<Policy>::dump (
     const std::string & name_,
     pn_data_t * data_,
     const SchemaType & schema_) const
 {
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            "\"" + proton::readAndNext<std::string> (data_) + "\"");
+            json::quote (proton::readAndNext<std::string, Policy> (data_)));
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
-StringPropertyReader::dump (
+StringPropertyReader<Policy>::dump (
         pn_data_t * data_,
         const SchemaType & schema_) const
 {
     return std::make_unique<TypedSingle<std::string>> (
-            "\"" + proton::readAndNext<std::string> (data_) + "\"");
+            json::quote (proton::readAndNext<std::string, Policy> (data_)));
 }
 
 /******************************************************************************/
 
+template<typename Policy>
+bool
+amqp::internal::reader::
+StringPropertyReader<Policy>::isScalar() const {
+    return true;
+}
+
+/******************************************************************************/
+
+template<typename Policy>
+amqp::internal::reader::Scalar
+amqp::internal::reader::
+StringPropertyReader<Policy>::readScalar (pn_data_t * data_) const {
+    return proton::readAndNext<std::string, Policy> (data_);
+}
+
+/******************************************************************************/
+
+template<typename Policy>
+std::string
+amqp::internal::reader::
+StringPropertyReader<Policy>::dumpScalar (const Scalar & value_) const {
+    return json::quote (std::get<std::string> (value_));
+}
+
+/******************************************************************************/
+
+template<typename Policy>
+bool
+amqp::internal::reader::
+StringPropertyReader<Policy>::quoted() const {
+    return true;
+}
+
+/******************************************************************************/
+
+template<typename Policy>
 const std::string &
 amqp::internal::reader::
-StringPropertyReader::name() const {
+StringPropertyReader<Policy>::name() const {
     return m_name;
 }
 
 /******************************************************************************/
 
+template<typename Policy>
 const std::string &
 amqp::internal::reader::
-StringPropertyReader::type() const {
+StringPropertyReader<Policy>::type() const {
     return m_type;
 }
 
 /******************************************************************************/
+
+template class amqp::internal::reader::StringPropertyReader<proton::Checked>;
+template class amqp::internal::reader::StringPropertyReader<proton::Trusted>;
+
+/******************************************************************************/
@@ -1,5 +1,8 @@
 #include "EnumReader.h"
 
+#include <cstring>
+#include <numeric>
+
 #include "amqp/reader/IReader.h"
 #include "amqp/schema/Descriptors.h"
 #include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
@@ -7,57 +10,126 @@
 
 /******************************************************************************/
 
+namespace {
+
+    std::shared_ptr<const amqp::internal::schema::EnumTransforms>
+    identity (size_t size_) {
+        auto rtn = std::make_shared<amqp::internal::schema::EnumTransforms> (size_);
+
+        std::iota (rtn->begin(), rtn->end(), 0);
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
 amqp::internal::reader::
 EnumReader::EnumReader (
     std::string type_,
-    std::vector<std::string> choices_
+    std::vector<std::string> choices_,
+    bool validate_
 ) : RestrictedReader (std::move (type_))
-  , m_choices (std::move (choices_)
-) {
+  , m_wire (choices_)
+  , m_dictionary (std::make_shared<const EnumDictionary> (std::move (choices_)))
+  , m_transforms (identity (m_wire.size()))
+  , m_validate (validate_)
+{
 
 }
 
 /******************************************************************************/
 
-namespace {
+amqp::internal::reader::
+EnumReader::EnumReader (
+    std::string type_,
+    std::vector<std::string> wire_,
+    std::vector<std::string> choices_,
+    std::shared_ptr<const schema::EnumTransforms> transforms_,
+    bool validate_
+) : RestrictedReader (std::move (type_))
+  , m_wire (std::move (wire_))
+  , m_dictionary (std::make_shared<const EnumDictionary> (std::move (choices_)))
+  , m_transforms (std::move (transforms_))
+  , m_validate (validate_)
+{
+
+}
+
+/******************************************************************************/
+
+const std::shared_ptr<const amqp::internal::reader::EnumDictionary> &
+amqp::internal::reader::
+EnumReader::dictionary() const {
+    return m_dictionary;
+}
+
+/******************************************************************************/
+
+int32_t
+amqp::internal::reader::
+EnumReader::code (pn_data_t * data_) const {
+    proton::is_described (data_);
+
+    proton::auto_enter ae (data_);
+
+    /*
+     * Referenced objects are added to a stream when the serialiser
+     * notices it's writing a value it's already written, so to save
+     * space it will just link back to that. Currently we have
+     * no mechanism for decoding that so just throw an error
+     */
+    if (pn_data_type (data_) == PN_ULONG) {
+        if (amqp::stripCorda(pn_data_get_ulong(data_)) ==
+            amqp::schema::descriptors::REFERENCED_OBJECT
+        ) {
+            throw std::runtime_error (
+                    "Currently don't support referenced objects");
+        }
+    }
+
+    // we know what we are so there's no need to look at the fingerprint
+    pn_data_next (data_);
 
-    std::string
-    getValue (pn_data_t * data_) {
-        proton::is_described (data_);
+    proton::auto_list_enter ale (data_, true);
 
+    /*
+     * A string representation of the enumerated value comes first,
+     * followed by its ordinal which is all we need
+     */
+    auto name = pn_data_get_string (data_);
+
+    pn_data_next (data_);
+
+    auto ordinal = pn_data_get_int (data_);
+
+    if (ordinal < 0 || static_cast<size_t>(ordinal) >= m_transforms->size()) {
+        throw std::runtime_error (
+            "Enum ordinal " + std::to_string (ordinal) + " out of range for "
+                + type());
+    }
+
+    if (m_validate) {
+        const auto & expected = m_wire[ordinal];
+
+        if (name.size != expected.size()
+            || std::memcmp (name.start, expected.data(), name.size) != 0)
         {
-            proton::auto_enter ae (data_);
-
-            /*
-             * Referenced objects are added to a stream when the serialiser
-             * notices it's writing a value it's already written, so to save
-             * space it will just link back to that. Currently we have
-             * no mechanism for decoding that so just throw an error
-             */
-            if (pn_data_type (data_) == PN_ULONG) {
-                if (amqp::stripCorda(pn_data_get_ulong(data_)) ==
-                amqp::schema::descriptors::REFERENCED_OBJECT
-            ) {
-                    throw std::runtime_error (
-                            "Currently don't support referenced objects");
-                }
-            }
-
-            auto fingerprint = proton::readAndNext<std::string>(data_);
-
-            proton::auto_list_enter ale (data_, true);
-
-            return proton::readAndNext<std::string>(data_);
-
-            /*
-             * After a string representation of the enumerated value
-             * the ordinal value is also encoded. We don't need that for
-             * just dumping things to a string but if I don't leave this
-             * here I'll forget its even a thing
-             */
-            // auto idx = proton::readAndNext<int>(data_);
+            throw std::runtime_error (
+                "Enum " + type() + " constant " + std::string (name.start, name.size)
+                    + " doesn't match ordinal " + std::to_string (ordinal));
         }
     }
+
+    auto code = (*m_transforms)[ordinal];
+
+    if (code == schema::ENUM_TRANSFORM_MISSING) {
+        throw std::runtime_error (
+            "Enum constant has no equivalent in " + type());
+    }
+
+    return code;
 }
 
 /******************************************************************************/
@@ -72,9 +144,7 @@ EnumReader::dump (
     proton::auto_next an (data_);
     proton::is_described (data_);
 
-    return std::make_unique<TypedPair<std::string>> (
-            name_,
-            getValue(data_));
+    return std::make_unique<EnumValue> (name_, code (data_), m_dictionary);
 }
 
 /******************************************************************************/
@@ -88,7 +158,41 @@ EnumReader::dump(
     proton::auto_next an (data_);
     proton::is_described (data_);
 
-    return std::make_unique<TypedSingle<std::string>> (getValue(data_));
+    return std::make_unique<EnumValue> (code (data_), m_dictionary);
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+EnumReader::isScalar() const {
+    return true;
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::Scalar
+amqp::internal::reader::
+EnumReader::readScalar (pn_data_t * data_) const {
+    proton::auto_next an (data_);
+
+    return code (data_);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+EnumReader::dumpScalar (const Scalar & value_) const {
+    return json::quote ((*m_dictionary)[std::get<int32_t> (value_)]);
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+EnumReader::quoted() const {
+    return true;
 }
 
 /******************************************************************************/
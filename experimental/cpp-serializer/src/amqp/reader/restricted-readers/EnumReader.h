@@ -1,16 +1,54 @@
 #pragma once
 
 #include "RestrictedReader.h"
+#include "EnumValue.h"
+
+#include "amqp/schema/EnumTransforms.h"
 
 /******************************************************************************/
 
 namespace amqp::internal::reader {
 
+    /**
+     * Enums are written as their constant's name and ordinal, we decode
+     * them by ordinal alone into an index into the constants we're
+     * reading as, which are handed out as a dictionary so the values
+     * never copy a string. In validating mode the name is cross-checked
+     * against the constant at that ordinal in the schema.
+     */
     class EnumReader : public RestrictedReader {
         private :
-            std::vector<std::string> m_choices;
+            /**
+             * The constants as written, only needed to validate
+             */
+            std::vector<std::string> m_wire;
+
+            /**
+             * The constants we output, the same as [m_wire] unless the
+             * enum is being read as a different version of itself
+             */
+            std::shared_ptr<const EnumDictionary> m_dictionary;
+
+            /**
+             * Maps the ordinal on the wire to an index into [m_dictionary]
+             */
+            std::shared_ptr<const schema::EnumTransforms> m_transforms;
+
+            bool m_validate;
+
+            int32_t code (pn_data_t *) const;
+
         public :
-            EnumReader (std::string, std::vector<std::string>);
+            EnumReader (std::string, std::vector<std::string>, bool validate_ = false);
+
+            EnumReader (
+                std::string,
+                std::vector<std::string>,
+                std::vector<std::string>,
+                std::shared_ptr<const schema::EnumTransforms>,
+                bool validate_ = false);
+
+            const std::shared_ptr<const EnumDictionary> & dictionary() const;
 
             std::unique_ptr<amqp::reader::IValue> dump(
                 const std::string &,
@@ -20,6 +58,16 @@ namespace amqp::internal::reader {
             std::unique_ptr<amqp::reader::IValue> dump(
                 pn_data_t *,
                 const SchemaType &) const override;
+
+            /**
+             * As a scalar an enum is its code, the index of its constant
+             * in [dictionary]
+             */
+            bool isScalar() const override;
+            Scalar readScalar (pn_data_t *) const override;
+            std::string dumpScalar (const Scalar &) const override;
+
+            bool quoted() const override;
     };
 
 }
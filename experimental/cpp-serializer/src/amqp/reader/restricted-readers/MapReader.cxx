@@ -1,6 +1,7 @@
 #include "MapReader.h"
 
 #include "Reader.h"
+#include "FlatMap.h"
 #include "amqp/reader/IReader.h"
 #include "proton/proton_wrapper.h"
 
@@ -36,11 +37,18 @@ MapReader::dump_(
         decltype (dump_(data_, schema_)) rtn;
         rtn.reserve (am.elements() / 2);
 
+        auto keyReader = m_keyReader.lock();
+
         for (int i {0} ; i < am.elements() ; i += 2) {
+            // the key must be read before the value, argument evaluation
+            // order isn't something we can rely on
+            auto key = keyReader->dump (data_, schema_);
+
             rtn.emplace_back (
                 std::make_unique<ValuePair> (
-                    m_keyReader.lock()->dump (data_, schema_),
-                    m_valueReader.lock()->dump (data_, schema_)
+                    std::move (key),
+                    m_valueReader.lock()->dump (data_, schema_),
+                    keyReader->quoted()
                 )
             );
         }
@@ -51,6 +59,48 @@ MapReader::dump_(
 
 /******************************************************************************/
 
+bool
+amqp::internal::reader::
+MapReader::flat() const {
+    auto key = m_keyReader.lock();
+    auto value = m_valueReader.lock();
+
+    return key && value && key->isScalar() && value->isScalar();
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+MapReader::dumpFlat (
+    const std::string * name_,
+    pn_data_t * data_
+) const {
+    proton::is_described (data_);
+    proton::auto_enter ae (data_);
+
+    // as with dump_ we know our types so skip the descriptor
+    pn_data_next (data_);
+
+    proton::auto_map_enter am (data_, true);
+
+    auto keyReader = m_keyReader.lock();
+    auto valueReader = m_valueReader.lock();
+
+    auto rtn = name_
+        ? std::make_unique<FlatMap> (*name_, keyReader, valueReader, am.elements() / 2)
+        : std::make_unique<FlatMap> (keyReader, valueReader, am.elements() / 2);
+
+    for (size_t i {0} ; i < am.elements() ; i += 2) {
+        auto key = keyReader->readScalar (data_);
+        rtn->emplace_back (std::move (key), valueReader->readScalar (data_));
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
 MapReader::dump(
@@ -60,6 +110,10 @@ MapReader::dump(
 ) const {
     proton::auto_next an (data_);
 
+    if (flat()) {
+        return dumpFlat (&name_, data_);
+    }
+
     return std::make_unique<TypedPair<sVec<uPtr<amqp::reader::IValue>>>>(
             name_,
             dump_ (data_, schema_));
@@ -75,6 +129,10 @@ MapReader::dump(
 ) const  {
     proton::auto_next an (data_);
 
+    if (flat()) {
+        return dumpFlat (nullptr, data_);
+    }
+
     return std::make_unique<TypedSingle<sVec<uPtr<amqp::reader::IValue>>>>(
             dump_ (data_, schema_));
 }
@@ -18,6 +18,16 @@ namespace amqp::internal::reader {
                     pn_data_t *,
                     const SchemaType &) const;
 
+            /**
+             * When both keys and values are scalars the map is read
+             * flat, see [FlatMap]
+             */
+            bool flat() const;
+
+            uPtr<amqp::reader::IValue> dumpFlat (
+                    const std::string *,
+                    pn_data_t *) const;
+
         public :
             MapReader (
                 const std::string & type_,
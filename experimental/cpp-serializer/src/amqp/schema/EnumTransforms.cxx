@@ -0,0 +1,95 @@
+#include "EnumTransforms.h"
+
+#include <unordered_map>
+
+#include "described-types/TransformElement.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using Transforms = std::vector<const amqp::internal::schema::TransformElement *>;
+
+    /**
+     * Find the first transform of kind [type_] that leads away from
+     * [constant_], forwards from it or, if [reversed_], backwards, and
+     * hasn't already been followed
+     */
+    const amqp::internal::schema::TransformElement *
+    find (
+        const Transforms & transforms_,
+        std::vector<bool> & used_,
+        amqp::internal::schema::TransformTypes type_,
+        const std::string & constant_,
+        bool reversed_ = false
+    ) {
+        for (size_t i { 0 } ; i < transforms_.size() ; ++i) {
+            const auto * t = transforms_[i];
+
+            if (!used_[i]
+                && t->type() == type_
+                && (reversed_ ? t->to() : t->from()) == constant_)
+            {
+                used_[i] = true;
+                return t;
+            }
+        }
+
+        return nullptr;
+    }
+
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::EnumTransforms
+amqp::internal::schema::compileEnumTransforms (
+    const std::vector<std::string> & wire_,
+    const std::vector<std::string> & local_,
+    const std::vector<const TransformElement *> & transforms_
+) {
+    std::unordered_map<std::string, int32_t> local;
+
+    for (size_t i { 0 } ; i < local_.size() ; ++i) {
+        local.emplace (local_[i], static_cast<int32_t>(i));
+    }
+
+    EnumTransforms rtn (wire_.size(), ENUM_TRANSFORM_MISSING);
+
+    for (size_t i { 0 } ; i < wire_.size() ; ++i) {
+        auto constant = wire_[i];
+
+        // each transform is followed at most once so a cycle in a
+        // malformed schema can't loop forever
+        std::vector<bool> used (transforms_.size(), false);
+
+        while (true) {
+            auto it = local.find (constant);
+            if (it != local.end()) {
+                rtn[i] = it->second;
+                break;
+            }
+
+            if (const auto * t = find (
+                    transforms_, used, TransformTypes::rename_t, constant))
+            {
+                constant = t->to();
+            } else if (const auto * t = find (
+                    transforms_, used, TransformTypes::rename_t, constant, true))
+            {
+                // written by a version newer than the one we're reading as
+                constant = t->from();
+            } else if (const auto * t = find (
+                    transforms_, used, TransformTypes::enum_default_t, constant))
+            {
+                constant = t->to();
+            } else {
+                break;
+            }
+        }
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
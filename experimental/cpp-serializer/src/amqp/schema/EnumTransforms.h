@@ -0,0 +1,48 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    class TransformElement;
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * An enum's transforms resolved against the constants of the version
+     * of it we're reading as. Indexed by the ordinal a value was written
+     * with it yields the index of the local constant to use, or
+     * ENUM_TRANSFORM_MISSING if no transform leads to one.
+     */
+    using EnumTransforms = std::vector<int32_t>;
+
+    constexpr int32_t ENUM_TRANSFORM_MISSING = -1;
+
+    /**
+     * Build the table mapping the constants, in ordinal order, of an enum
+     * as it was written [wire_] onto the constants of the version we want
+     * to read it as [local_].
+     *
+     * Renames are followed forward and EnumDefaults, for constants we
+     * don't know, substituted until we land on a constant we do. All of
+     * the string matching happens here so applying the result costs one
+     * array index per value.
+     */
+    EnumTransforms compileEnumTransforms (
+        const std::vector<std::string> & wire_,
+        const std::vector<std::string> & local_,
+        const std::vector<const TransformElement *> & transforms_);
+
+}
+
+/******************************************************************************/
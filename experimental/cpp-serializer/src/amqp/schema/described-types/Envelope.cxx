@@ -15,6 +15,11 @@ operator << (
         const amqp::internal::schema::Envelope & e_
 ) {
     stream_ << *(e_.m_schema);
+
+    if (!e_.m_transforms->empty()) {
+        stream_ << *(e_.m_transforms);
+    }
+
     return stream_;
 }
 
@@ -32,6 +37,19 @@ Envelope::Envelope (
     std::string descriptor_
 ) : m_schema (std::move (schema_))
   , m_descriptor (std::move (descriptor_))
+  , m_transforms (std::make_unique<TransformSchema>())
+{ }
+
+/******************************************************************************/
+
+amqp::internal::schema::
+Envelope::Envelope (
+    uPtr<Schema> & schema_,
+    std::string descriptor_,
+    uPtr<TransformSchema> & transforms_
+) : m_schema (std::move (schema_))
+  , m_descriptor (std::move (descriptor_))
+  , m_transforms (std::move (transforms_))
 { }
 
 /******************************************************************************/
@@ -51,3 +69,11 @@ Envelope::descriptor() const {
 }
 
 /******************************************************************************/
+
+const amqp::internal::schema::TransformSchema &
+amqp::internal::schema::
+Envelope::transforms() const {
+    return *m_transforms;
+}
+
+/******************************************************************************/
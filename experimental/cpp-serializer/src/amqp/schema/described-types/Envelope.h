@@ -5,6 +5,7 @@
 #include "amqp/AMQPDescribed.h"
 
 #include "amqp/schema/described-types/Schema.h"
+#include "amqp/schema/described-types/TransformSchema.h"
 
 #include <iosfwd>
 
@@ -19,6 +20,7 @@ namespace amqp::internal::schema {
         private :
             std::unique_ptr<Schema> m_schema;
             std::string m_descriptor;
+            std::unique_ptr<TransformSchema> m_transforms;
 
         public :
             Envelope() = delete;
@@ -27,8 +29,15 @@ namespace amqp::internal::schema {
                 std::unique_ptr<Schema> & schema_,
                 std::string descriptor_);
 
+            Envelope (
+                std::unique_ptr<Schema> & schema_,
+                std::string descriptor_,
+                std::unique_ptr<TransformSchema> & transforms_);
+
             const ISchemaType & schema() const;
 
+            const TransformSchema & transforms() const;
+
             const std::string & descriptor() const;
     };
 
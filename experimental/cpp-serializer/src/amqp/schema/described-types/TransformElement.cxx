@@ -0,0 +1,59 @@
+#include "TransformElement.h"
+
+#include <iostream>
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    std::ostream &
+    operator << (std::ostream & stream_, const TransformElement & transform_) {
+        stream_ << transform_.m_type << " : "
+            << transform_.m_from << " -> " << transform_.m_to;
+
+        return stream_;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::schema::TransformElement
+ *
+ ******************************************************************************/
+
+amqp::internal::schema::
+TransformElement::TransformElement (
+    TransformTypes type_,
+    std::string from_,
+    std::string to_
+) : m_type (type_)
+  , m_from (std::move (from_))
+  , m_to (std::move (to_))
+{ }
+
+/******************************************************************************/
+
+amqp::internal::schema::TransformTypes
+amqp::internal::schema::
+TransformElement::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+TransformElement::from() const {
+    return m_from;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+TransformElement::to() const {
+    return m_to;
+}
+
+/******************************************************************************/
@@ -0,0 +1,47 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <iosfwd>
+#include <string>
+
+#include "amqp/AMQPDescribed.h"
+#include "TransformElementKey.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * A single transform applied to a type as it evolved. Both kinds we
+     * understand describe one constant becoming another
+     *
+     *   Rename      - a constant once called [from] is now called [to]
+     *   EnumDefault - a constant [from] was added and any reader that
+     *                 doesn't know it should read it as [to]
+     *
+     * On the wire the EnumDefault pair is written [to, from], old then new,
+     * we store them the same way round as a Rename to keep the tables that
+     * are built from them simple.
+     */
+    class TransformElement : public AMQPDescribed {
+        public :
+            friend std::ostream & operator << (std::ostream &, const TransformElement &);
+
+        private :
+            TransformTypes m_type;
+            std::string    m_from;
+            std::string    m_to;
+
+        public :
+            TransformElement (TransformTypes, std::string, std::string);
+
+            TransformTypes type() const;
+
+            const std::string & from() const;
+            const std::string & to() const;
+    };
+
+}
+
+/******************************************************************************/
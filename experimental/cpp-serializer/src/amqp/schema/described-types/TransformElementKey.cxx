@@ -0,0 +1,49 @@
+#include "TransformElementKey.h"
+
+#include <iostream>
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    std::ostream &
+    operator << (std::ostream & stream_, TransformTypes type_) {
+        switch (type_) {
+            case TransformTypes::enum_default_t : stream_ << "EnumDefault"; break;
+            case TransformTypes::rename_t : stream_ << "Rename"; break;
+            default : stream_ << "Unknown";
+        }
+
+        return stream_;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::schema::TransformElementKey
+ *
+ ******************************************************************************/
+
+/**
+ * Anything written by a newer version of Corda that we don't understand
+ * is treated as unknown and, like the JVM does, ignored
+ */
+amqp::internal::schema::
+TransformElementKey::TransformElementKey (int ordinal_)
+    : m_type (
+        (ordinal_ == static_cast<int>(TransformTypes::enum_default_t)
+            || ordinal_ == static_cast<int>(TransformTypes::rename_t))
+        ? static_cast<TransformTypes>(ordinal_)
+        : TransformTypes::unknown_t)
+{ }
+
+/******************************************************************************/
+
+amqp::internal::schema::TransformTypes
+amqp::internal::schema::
+TransformElementKey::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
@@ -0,0 +1,47 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <iosfwd>
+
+#include "amqp/AMQPDescribed.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * The kinds of transform Corda knows about, the values are the ordinals
+     * the JVM writes to identify them so must not be reordered
+     */
+    enum class TransformTypes {
+        unknown_t = 0,
+        enum_default_t = 1,
+        rename_t = 2
+    };
+
+    std::ostream & operator << (std::ostream &, TransformTypes);
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * The key of each entry in a type's map of transforms, identifying
+     * the kind of the transforms held in the list it maps to
+     */
+    class TransformElementKey : public AMQPDescribed {
+        private :
+            TransformTypes m_type;
+
+        public :
+            explicit TransformElementKey (int);
+
+            TransformTypes type() const;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,55 @@
+#include "TransformSchema.h"
+
+#include <iostream>
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    std::ostream &
+    operator << (std::ostream & stream_, const TransformSchema & schema_) {
+        for (const auto & type : schema_.m_transforms) {
+            stream_ << "transforms: " << type.first << std::endl;
+            for (const auto & transform : type.second) {
+                stream_ << "  " << *transform << std::endl;
+            }
+        }
+
+        return stream_;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::schema::TransformSchema
+ *
+ ******************************************************************************/
+
+amqp::internal::schema::
+TransformSchema::TransformSchema (
+    std::map<std::string, Transforms> transforms_
+) : m_transforms (std::move (transforms_))
+{ }
+
+/******************************************************************************/
+
+const amqp::internal::schema::TransformSchema::Transforms &
+amqp::internal::schema::
+TransformSchema::transforms (const std::string & type_) const {
+    static const Transforms none;
+
+    auto it = m_transforms.find (type_);
+
+    return it == m_transforms.end() ? none : it->second;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::schema::
+TransformSchema::empty() const {
+    return m_transforms.empty();
+}
+
+/******************************************************************************/
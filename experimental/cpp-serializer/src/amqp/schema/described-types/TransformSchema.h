@@ -0,0 +1,50 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <vector>
+#include <iosfwd>
+#include <string>
+
+#include "types.h"
+#include "TransformElement.h"
+
+#include "amqp/AMQPDescribed.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * The third element of an envelope, for every type that has evolved
+     * the transforms the writer knew had been applied to it. Keyed by
+     * the class name, not the fingerprint, as the transforms span every
+     * version of the class.
+     */
+    class TransformSchema : public AMQPDescribed {
+        public :
+            friend std::ostream & operator << (std::ostream &, const TransformSchema &);
+
+            using Transforms = std::vector<uPtr<TransformElement>>;
+
+        private :
+            std::map<std::string, Transforms> m_transforms;
+
+        public :
+            TransformSchema() = default;
+
+            explicit TransformSchema (std::map<std::string, Transforms>);
+
+            /**
+             * @return the transforms for type [type_], empty if there
+             * aren't any
+             */
+            const Transforms & transforms (const std::string & type_) const;
+
+            bool empty() const;
+    };
+
+}
+
+/******************************************************************************/
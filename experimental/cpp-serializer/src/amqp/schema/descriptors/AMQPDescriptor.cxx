@@ -1,10 +1,9 @@
 #include "AMQPDescriptor.h"
 
 #include <sstream>
-#include <amqp/schema/descriptors/corda-descriptors/EnvelopeDescriptor.h>
+#include <algorithm>
 
-#include "proton/proton_wrapper.h"
-#include "AMQPDescriptorRegistory.h"
+#include "Grammar.h"
 
 /******************************************************************************/
 
@@ -12,7 +11,15 @@ namespace amqp::internal::schema::descriptors {
 
     std::ostream &
     operator<<(std::ostream &stream_, const AutoIndent &ai_) {
-        stream_ << ai_.indent;
+        static const std::string spaces (128, ' ');
+
+        for (auto n = 2 * ai_.m_depth ; n ; ) {
+            auto chunk = std::min (n, spaces.size());
+
+            stream_.write (spaces.data(), chunk);
+            n -= chunk;
+        }
+
         return stream_;
     }
 
@@ -47,6 +54,9 @@ AMQPDescriptor::read (
 
 /******************************************************************************/
 
+/**
+ * Every descriptor is dumped the same way, by walking the grammar
+ */
 void
 amqp::internal::schema::descriptors::
 AMQPDescriptor::read (
@@ -54,49 +64,7 @@ AMQPDescriptor::read (
         std::stringstream & ss_,
         const AutoIndent & ai_
 ) const {
-    switch (pn_data_type (data_)) {
-        case PN_DESCRIBED : {
-            ss_ << ai_ << "DESCRIBED: " << std::endl;
-            {
-                AutoIndent ai { ai_ } ; // NOLINT
-                proton::auto_enter p (data_);
-
-                switch (pn_data_type (data_)) {
-                    case PN_ULONG : {
-                        auto key = proton::readAndNext<u_long>(data_);
-
-                        ss_ << ai << "key  : "
-                            << key << " :: " << amqp::stripCorda(key)
-                            << " -> "
-                            <<  amqp::describedToString ((uint64_t )key)
-                            << std::endl;
-
-                        proton::is_list (data_);
-                        ss_ << ai << "list : entries: "
-                            << pn_data_get_list(data_)
-                            << std::endl;
-
-                        AMQPDescriptorRegistory[key]->read (data_, ss_, ai);
-                        break;
-                    }
-                    case PN_SYMBOL : {
-                        ss_ << ai << "blob: bytes: "
-                            << pn_data_get_symbol(data_).size
-                            << std::endl;
-                        break;
-                    }
-                    default : {
-                        throw std::runtime_error (
-                            "Described type should only contain long or blob");
-                    }
-                }
-            }
-            break;
-        }
-        default : {
-            throw std::runtime_error ("Can only dispatch described objects");
-        }
-    }
+    grammar::dump (data_, ss_, ai_);
 }
 
 /******************************************************************************/
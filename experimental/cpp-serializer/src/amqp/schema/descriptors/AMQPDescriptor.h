@@ -25,19 +25,25 @@ struct pn_data_t;
 
 namespace amqp::internal::schema::descriptors {
 
+    /**
+     * The indentation for one level of nesting, copying one gives the
+     * next level in. Only the depth is held, the spaces themselves are
+     * written from a shared run of them so nesting costs nothing.
+     */
     class AutoIndent {
         private :
-            std::string indent;
+            size_t m_depth;
+
         public :
-            AutoIndent() : indent { "" } { }
+            AutoIndent() : m_depth { 0 } { }
 
             AutoIndent (const AutoIndent & ai_)
-                : indent { ai_.indent + "  "}
+                : m_depth { ai_.m_depth + 1 }
             { }
 
             friend std::ostream &
             operator << (std::ostream & stream_, const AutoIndent & ai_);
-        };
+    };
 }
 
 /******************************************************************************
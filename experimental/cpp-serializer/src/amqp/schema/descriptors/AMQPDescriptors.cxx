@@ -13,6 +13,9 @@
 #include "amqp/schema/described-types/Schema.h"
 #include "amqp/schema/described-types/Envelope.h"
 #include "amqp/schema/described-types/Composite.h"
+#include "amqp/schema/described-types/TransformSchema.h"
+#include "amqp/schema/described-types/TransformElement.h"
+#include "amqp/schema/described-types/TransformElementKey.h"
 #include "amqp/schema/restricted-types/Restricted.h"
 #include "amqp/schema/OrderedTypeNotations.h"
 #include "amqp/AMQPDescribed.h"
@@ -56,6 +59,12 @@ ReferencedObjectDescriptor::build (pn_data_t * data_) const {
 
 /******************************************************************************/
 
+/**
+ * The transforms schema is a map of class name to a map of transform
+ * kind to the list of transforms of that kind
+ *
+ *   { name : { key : [ element, ... ], ... }, ... }
+ */
 uPtr<amqp::AMQPDescribed>
 amqp::internal::schema::descriptors::
 TransformSchemaDescriptor::build (pn_data_t * data_) const {
@@ -63,11 +72,46 @@ TransformSchemaDescriptor::build (pn_data_t * data_) const {
 
     DBG ("TRANSFORM SCHEMA " << data_ << std::endl); // NOLINT
 
-    return uPtr<amqp::AMQPDescribed> (nullptr);
+    std::map<std::string, schema::TransformSchema::Transforms> transforms;
+
+    {
+        proton::auto_map_enter ame (data_);
+
+        while (pn_data_next (data_)) {
+            auto & type = transforms[proton::get_string (data_)];
+
+            pn_data_next (data_);
+            proton::auto_map_enter ame2 (data_);
+
+            while (pn_data_next (data_)) {
+                auto key = dispatchDescribed<schema::TransformElementKey> (data_);
+
+                pn_data_next (data_);
+                proton::auto_list_enter ale (data_);
+
+                while (pn_data_next (data_)) {
+                    auto element = dispatchDescribed<schema::TransformElement> (data_);
+
+                    if (element->type() != key->type()) {
+                        throw std::runtime_error (
+                            "Transform doesn't match the kind it's keyed by");
+                    }
+
+                    type.emplace_back (std::move (element));
+                }
+            }
+        }
+    }
+
+    return std::make_unique<schema::TransformSchema> (std::move (transforms));
 }
 
 /******************************************************************************/
 
+/**
+ * Each element is a list of the name of the transform's kind followed by
+ * the two constants it relates
+ */
 uPtr<amqp::AMQPDescribed>
 amqp::internal::schema::descriptors::
 TransformElementDescriptor::build (pn_data_t * data_) const {
@@ -75,7 +119,30 @@ TransformElementDescriptor::build (pn_data_t * data_) const {
 
     DBG ("TRANSFORM ELEMENT " << data_ << std::endl); // NOLINT
 
-    return uPtr<amqp::AMQPDescribed> (nullptr);
+    proton::auto_enter ae (data_);
+
+    auto name = proton::get_string ((pn_data_t *)proton::auto_next (data_));
+
+    if (name == "EnumDefault") {
+        auto old = proton::get_string ((pn_data_t *)proton::auto_next (data_));
+        auto added = proton::get_string (data_);
+
+        return std::make_unique<schema::TransformElement> (
+            schema::TransformTypes::enum_default_t,
+            std::move (added),
+            std::move (old));
+    } else if (name == "Rename") {
+        auto from = proton::get_string ((pn_data_t *)proton::auto_next (data_));
+        auto to = proton::get_string (data_);
+
+        return std::make_unique<schema::TransformElement> (
+            schema::TransformTypes::rename_t,
+            std::move (from),
+            std::move (to));
+    }
+
+    return std::make_unique<schema::TransformElement> (
+        schema::TransformTypes::unknown_t, "", "");
 }
 
 /******************************************************************************/
@@ -87,8 +154,12 @@ TransformElementKeyDescriptor::build (pn_data_t * data_) const {
 
     DBG ("TRANSFORM ELEMENT KEY" << data_ << std::endl); // NOLINT
 
-    return uPtr<amqp::AMQPDescribed> (nullptr);
+    if (pn_data_type (data_) != PN_INT) {
+        throw std::runtime_error ("Transform keys should be an ordinal");
+    }
+
+    return std::make_unique<schema::TransformElementKey> (
+        pn_data_get_int (data_));
 }
 
 /******************************************************************************/
-
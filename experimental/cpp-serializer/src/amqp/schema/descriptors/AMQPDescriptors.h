@@ -11,6 +11,7 @@
 #include "types.h"
 #include "amqp/AMQPDescribed.h"
 #include "AMQPDescriptor.h"
+#include "Grammar.h"
 #include "amqp/schema/described-types/Descriptor.h"
 #include "proton/proton_wrapper.h"
 #include "AMQPDescriptorRegistory.h"
@@ -24,23 +25,15 @@ struct pn_data_t;
 namespace amqp::internal::schema::descriptors {
 
     /**
-     * Look up a described type by its ID in the AMQPDescriptorRegistry and
-     * return the corresponding schema type. Specialised below to avoid
-     * the cast and re-owning of the unigue pointer when we're happy
-     * with a simple uPtr<AMQPDescribed>
+     * Build the described type [data_] is at and return it as the
+     * corresponding schema type. Sections of the schema grammar are
+     * built from it directly, anything else is looked up by its ID in
+     * the AMQPDescriptorRegistry
      */
     template<class T>
     uPtr <T>
     dispatchDescribed(pn_data_t *data_) {
-        proton::is_described(data_);
-        proton::auto_enter p(data_);
-        proton::is_ulong(data_);
-
-        auto id = pn_data_get_ulong(data_);
-
-        return uPtr<T>(
-            static_cast<T *>(
-                AMQPDescriptorRegistory[id]->build(data_).release()));
+        return uPtr<T>(static_cast<T *>(grammar::build(data_).release()));
     }
 }
 
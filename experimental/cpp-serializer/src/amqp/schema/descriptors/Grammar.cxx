@@ -0,0 +1,360 @@
+#include "Grammar.h"
+
+#include <sstream>
+#include <stdexcept>
+
+#include <proton/codec.h>
+
+#include "proton/proton_wrapper.h"
+
+#include "amqp/schema/Descriptors.h"
+#include "AMQPDescriptorRegistory.h"
+
+#include "corda-descriptors/FieldDescriptor.h"
+#include "corda-descriptors/ChoiceDescriptor.h"
+#include "corda-descriptors/ObjectDescriptor.h"
+#include "corda-descriptors/SchemaDescriptor.h"
+#include "corda-descriptors/EnvelopeDescriptor.h"
+#include "corda-descriptors/CompositeDescriptor.h"
+#include "corda-descriptors/RestrictedDescriptor.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::schema::descriptors;
+
+/******************************************************************************/
+
+namespace {
+
+    using Make = uPtr<amqp::AMQPDescribed> (*)(grammar::Values &);
+
+    struct Entry {
+        const grammar::Section * section;
+        Make                     make;
+    };
+
+    /**
+     * Indexed by the low 32 bits of a section's descriptor so finding
+     * the one a nested value is needs no lookup at all
+     */
+    const Entry SECTIONS[] {
+        { nullptr,               nullptr },
+        { &grammar::ENVELOPE,    &EnvelopeDescriptor::make },
+        { &grammar::SCHEMA,      &SchemaDescriptor::make },
+        { &grammar::OBJECT,      &ObjectDescriptor::make },
+        { &grammar::FIELD,       &FieldDescriptor::make },
+        { &grammar::COMPOSITE,   &CompositeDescriptor::make },
+        { &grammar::RESTRICTED,  &RestrictedDescriptor::make },
+        { &grammar::CHOICE,      &ChoiceDescriptor::make }
+    };
+
+    constexpr bool
+    fits (const grammar::Section & section_) {
+        return section_.size <= grammar::MAX_ELEMENTS;
+    }
+
+    static_assert (
+        fits (grammar::ENVELOPE) && fits (grammar::SCHEMA) && fits (grammar::OBJECT)
+            && fits (grammar::FIELD) && fits (grammar::COMPOSITE)
+            && fits (grammar::RESTRICTED) && fits (grammar::CHOICE),
+        "A section has more elements than Values holds");
+
+    const Entry *
+    entry (uint64_t descriptor_) {
+        if ((descriptor_ & ~0xffffffffULL) != amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS) {
+            return nullptr;
+        }
+
+        auto id = amqp::stripCorda (descriptor_);
+
+        if (id == 0 || id >= std::size (SECTIONS)) return nullptr;
+
+        return &SECTIONS[id];
+    }
+
+    bool
+    isNull (pn_data_t * data_) {
+        return pn_data_type (data_) == PN_NULL;
+    }
+
+    /**
+     * The described value [data_] is at, which if [section_] is set must
+     * be one of those
+     */
+    uPtr<amqp::AMQPDescribed>
+    build (pn_data_t * data_, const grammar::Section * section_) {
+        proton::is_described (data_);
+        proton::auto_enter ae (data_);
+        proton::is_ulong (data_);
+
+        auto descriptor = pn_data_get_ulong (data_);
+        const auto * e = entry (descriptor);
+
+        if (section_ && (!e || e->section != section_)) {
+            throw std::runtime_error (
+                std::string ("Expected a ") + section_->name + " but found a "
+                    + amqp::describedToString (descriptor));
+        }
+
+        if (!e) {
+            auto it = amqp::internal::AMQPDescriptorRegistory.find (descriptor);
+
+            if (it == amqp::internal::AMQPDescriptorRegistory.end()) {
+                throw std::runtime_error ("Unknown descriptor");
+            }
+
+            return it->second->build (data_);
+        }
+
+        pn_data_next (data_);
+
+        auto values = grammar::parse (data_, *e->section);
+
+        return e->make (values);
+    }
+
+    void
+    read (pn_data_t * data_, const grammar::Element & element_, grammar::Value & value_) {
+        switch (element_.type) {
+            case grammar::Type::string :
+                value_.string = proton::get_string (data_, element_.nullable);
+                break;
+            case grammar::Type::symbol :
+                value_.string = proton::get_symbol<std::string> (data_);
+                break;
+            case grammar::Type::boolean :
+                value_.boolean = proton::get_boolean (data_);
+                break;
+            case grammar::Type::ulong :
+                if (!isNull (data_)) proton::is_ulong (data_);
+                break;
+            case grammar::Type::strings : {
+                proton::is_list (data_);
+                proton::auto_list_enter ale (data_);
+
+                value_.strings.reserve (ale.elements());
+
+                while (pn_data_next (data_)) {
+                    value_.strings.push_back (proton::get_string (data_));
+                }
+                break;
+            }
+            case grammar::Type::payload : {
+                proton::is_described (data_);
+                proton::auto_enter ae (data_);
+
+                value_.string = proton::get_symbol<std::string> (data_);
+                break;
+            }
+            case grammar::Type::described :
+                value_.described.push_back (build (data_, element_.section));
+                break;
+            case grammar::Type::describedList : {
+                proton::is_list (data_);
+                proton::auto_list_enter ale (data_);
+
+                value_.described.reserve (ale.elements());
+
+                while (pn_data_next (data_)) {
+                    value_.described.push_back (build (data_, element_.section));
+                }
+                break;
+            }
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::descriptors::grammar::Values
+amqp::internal::schema::descriptors::
+grammar::parse (pn_data_t * data_, const Section & section_) {
+    proton::is_list (data_);
+
+    Values values;
+
+    proton::auto_list_enter ale (data_);
+
+    for (size_t i { 0 } ; i < section_.size ; ++i) {
+        const auto & element = section_.elements[i];
+
+        if (!pn_data_next (data_)) {
+            if (element.nullable) break;
+
+            throw std::runtime_error (
+                std::string (section_.name) + " is missing its " + element.label);
+        }
+
+        if (element.nullable && element.type != Type::string && isNull (data_)) {
+            continue;
+        }
+
+        read (data_, element, values[i]);
+    }
+
+    return values;
+}
+
+/******************************************************************************/
+
+uPtr<amqp::AMQPDescribed>
+amqp::internal::schema::descriptors::
+grammar::build (pn_data_t * data_) {
+    return ::build (data_, nullptr);
+}
+
+/******************************************************************************
+ *
+ * Dumping
+ *
+ ******************************************************************************/
+
+namespace {
+
+    void dump (pn_data_t *, const grammar::Section &, std::stringstream &, const AutoIndent &);
+
+    void
+    dump (
+        pn_data_t * data_,
+        const grammar::Element & element_,
+        std::stringstream & ss_,
+        const AutoIndent & ai_
+    ) {
+        switch (element_.type) {
+            case grammar::Type::string :
+                ss_ << "String: " << element_.label << ": "
+                    << proton::get_string (data_, element_.nullable) << '\n';
+                break;
+            case grammar::Type::symbol :
+                ss_ << "Symbol: " << element_.label << ": "
+                    << proton::get_symbol<std::string> (data_) << '\n';
+                break;
+            case grammar::Type::boolean :
+                ss_ << "Boolean: " << element_.label << ": "
+                    << proton::get_boolean (data_) << '\n';
+                break;
+            case grammar::Type::ulong :
+                ss_ << "ULong: " << element_.label << ": ";
+
+                if (isNull (data_)) {
+                    ss_ << "null\n";
+                } else {
+                    proton::is_ulong (data_);
+                    ss_ << pn_data_get_ulong (data_) << '\n';
+                }
+                break;
+            case grammar::Type::strings : {
+                proton::is_list (data_);
+                proton::auto_list_enter ale (data_);
+
+                ss_ << "List: " << element_.label << ": elements "
+                    << ale.elements() << '\n';
+
+                AutoIndent ai { ai_ };
+
+                while (pn_data_next (data_)) {
+                    ss_ << ai << proton::get_string (data_) << '\n';
+                }
+                break;
+            }
+            case grammar::Type::payload : {
+                proton::is_described (data_);
+                proton::auto_enter ae (data_);
+
+                ss_ << element_.label << ": "
+                    << proton::get_symbol<std::string> (data_) << '\n';
+                break;
+            }
+            case grammar::Type::described :
+                ss_ << element_.label << ":\n";
+
+                if (isNull (data_)) {
+                    ss_ << AutoIndent { ai_ } << "null\n";
+                } else {
+                    grammar::dump (data_, ss_, AutoIndent { ai_ });
+                }
+                break;
+            case grammar::Type::describedList : {
+                proton::is_list (data_);
+                proton::auto_list_enter ale (data_);
+
+                ss_ << "List: " << element_.label << ": elements "
+                    << ale.elements() << '\n';
+
+                AutoIndent ai { ai_ };
+
+                for (size_t i { 1 } ; pn_data_next (data_) ; ++i) {
+                    ss_ << ai << i << "/" << ale.elements() << "]\n";
+
+                    grammar::dump (data_, ss_, AutoIndent { ai });
+                }
+                break;
+            }
+        }
+    }
+
+    void
+    dump (
+        pn_data_t * data_,
+        const grammar::Section & section_,
+        std::stringstream & ss_,
+        const AutoIndent & ai_
+    ) {
+        proton::auto_list_enter ale (data_);
+
+        for (size_t i { 0 } ; i < section_.size && pn_data_next (data_) ; ++i) {
+            ss_ << ai_ << (i + 1) << "/" << section_.size << "] ";
+
+            dump (data_, section_.elements[i], ss_, ai_);
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::schema::descriptors::
+grammar::dump (pn_data_t * data_, std::stringstream & ss_, const AutoIndent & ai_) {
+    proton::is_described (data_);
+
+    ss_ << ai_ << "DESCRIBED: \n";
+
+    AutoIndent ai { ai_ };
+    proton::auto_enter ae (data_);
+
+    switch (pn_data_type (data_)) {
+        case PN_ULONG : {
+            auto descriptor = proton::readAndNext<u_long> (data_);
+
+            ss_ << ai << "key  : "
+                << descriptor << " :: " << amqp::stripCorda (descriptor)
+                << " -> " << amqp::describedToString ((uint64_t)descriptor)
+                << '\n';
+
+            const auto * e = entry (descriptor);
+
+            // anything else, transforms for one, isn't a list so all we
+            // can say is what it is
+            if (!e) break;
+
+            proton::is_list (data_);
+            ss_ << ai << "list : entries: " << pn_data_get_list (data_) << '\n';
+
+            ::dump (data_, *e->section, ss_, AutoIndent { ai });
+            break;
+        }
+        case PN_SYMBOL : {
+            ss_ << ai << "blob: bytes: "
+                << pn_data_get_symbol (data_).size << '\n';
+            break;
+        }
+        default : {
+            throw std::runtime_error (
+                "Described type should only contain long or blob");
+        }
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,251 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iterator>
+
+#include "types.h"
+#include "amqp/AMQPDescribed.h"
+#include "AMQPDescriptor.h"
+
+/******************************************************************************/
+
+struct pn_data_t;
+
+/******************************************************************************
+ *
+ * The Corda schema grammar
+ *
+ ******************************************************************************/
+
+/**
+ * Every section of a Corda schema is a described list whose elements
+ * always come in the same order with the same types. They're declared
+ * once, here, and both building a schema and dumping one walk these
+ * tables rather than spelling the lists out again.
+ *
+ * Elements past the end of a table are ignored so newer writers can add
+ * to a section; nullable elements may also be missing from the end.
+ */
+namespace amqp::internal::schema::descriptors::grammar {
+
+    enum class Type : uint8_t {
+        string,
+        symbol,
+        boolean,
+        ulong,
+        strings,        // List<String>
+        payload,        // a described value, only its symbol is kept
+        described,      // a nested section
+        describedList   // List of nested sections
+    };
+
+    struct Section;
+
+    struct Element {
+        const char *    label;
+        Type            type;
+        bool            nullable;
+
+        /**
+         * The section a described element must be, null if it can be
+         * any of them
+         */
+        const Section * section;
+    };
+
+    struct Section {
+        const char *    name;
+
+        /**
+         * The low 32 bits of the section's descriptor
+         */
+        uint32_t        id;
+        const Element * elements;
+        size_t          size;
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::schema::descriptors::grammar {
+
+    namespace object { enum : size_t { name, code }; }
+
+    inline constexpr Element OBJECT_ELEMENTS[] {
+        { "Name", Type::symbol, false, nullptr },
+        { "Code", Type::ulong,  true,  nullptr }
+    };
+
+    inline constexpr Section OBJECT {
+        "OBJECT_DESCRIPTOR", 3, OBJECT_ELEMENTS, std::size (OBJECT_ELEMENTS)
+    };
+
+    /**
+     * mandatory copes with the Kotlin concept of nullability, if a field
+     * is mandatory it cannot be null
+     */
+    namespace field {
+        enum : size_t { name, type, requires, def, label, mandatory, multiple };
+    }
+
+    inline constexpr Element FIELD_ELEMENTS[] {
+        { "Name",      Type::string,  false, nullptr },
+        { "Type",      Type::string,  false, nullptr },
+        { "Requires",  Type::strings, false, nullptr },
+        { "Default",   Type::string,  true,  nullptr },
+        { "Label",     Type::string,  true,  nullptr },
+        { "Mandatory", Type::boolean, false, nullptr },
+        { "Multiple",  Type::boolean, false, nullptr }
+    };
+
+    inline constexpr Section FIELD {
+        "FIELD", 4, FIELD_ELEMENTS, std::size (FIELD_ELEMENTS)
+    };
+
+    namespace choice { enum : size_t { name }; }
+
+    inline constexpr Element CHOICE_ELEMENTS[] {
+        { "Name", Type::string, false, nullptr }
+    };
+
+    inline constexpr Section CHOICE {
+        "CHOICE", 7, CHOICE_ELEMENTS, std::size (CHOICE_ELEMENTS)
+    };
+
+    namespace composite {
+        enum : size_t { name, label, provides, descriptor, fields };
+    }
+
+    inline constexpr Element COMPOSITE_ELEMENTS[] {
+        { "ClassName",  Type::string,        false, nullptr },
+        { "Label",      Type::string,        true,  nullptr },
+        { "Provides",   Type::strings,       false, nullptr },
+        { "Descriptor", Type::described,     false, &OBJECT },
+        { "Fields",     Type::describedList, false, &FIELD }
+    };
+
+    inline constexpr Section COMPOSITE {
+        "COMPOSITE_TYPE", 5, COMPOSITE_ELEMENTS, std::size (COMPOSITE_ELEMENTS)
+    };
+
+    /**
+     * Lists and maps, the choices are only there for enums
+     */
+    namespace restricted {
+        enum : size_t { name, label, provides, source, descriptor, choices };
+    }
+
+    inline constexpr Element RESTRICTED_ELEMENTS[] {
+        { "Name",       Type::string,        false, nullptr },
+        { "Label",      Type::string,        true,  nullptr },
+        { "Provides",   Type::strings,       false, nullptr },
+        { "Source",     Type::string,        false, nullptr },
+        { "Descriptor", Type::described,     false, &OBJECT },
+        { "Choices",    Type::describedList, false, &CHOICE }
+    };
+
+    inline constexpr Section RESTRICTED {
+        "RESTRICTED_TYPE", 6, RESTRICTED_ELEMENTS, std::size (RESTRICTED_ELEMENTS)
+    };
+
+    /**
+     * Composite and restricted types, in any order
+     */
+    namespace notations { enum : size_t { types }; }
+
+    inline constexpr Element SCHEMA_ELEMENTS[] {
+        { "Types", Type::describedList, false, nullptr }
+    };
+
+    inline constexpr Section SCHEMA {
+        "SCHEMA", 2, SCHEMA_ELEMENTS, std::size (SCHEMA_ELEMENTS)
+    };
+
+    /**
+     * Blobs written before transforms were added to Corda don't have
+     * them, they have no section of their own here as they're a map
+     */
+    namespace envelope { enum : size_t { payload, schema, transforms }; }
+
+    inline constexpr Element ENVELOPE_ELEMENTS[] {
+        { "Payload",    Type::payload,   false, nullptr },
+        { "Schema",     Type::described, false, &SCHEMA },
+        { "Transforms", Type::described, true,  nullptr }
+    };
+
+    inline constexpr Section ENVELOPE {
+        "ENVELOPE", 1, ENVELOPE_ELEMENTS, std::size (ENVELOPE_ELEMENTS)
+    };
+
+    constexpr size_t MAX_ELEMENTS { 7 };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::schema::descriptors::grammar {
+
+    /**
+     * What an element was read as, only the member matching its type is
+     * set. Single described elements are the one entry in [described],
+     * or none if they were null.
+     */
+    struct Value {
+        std::string                      string;
+        std::vector<std::string>         strings;
+        bool                             boolean { false };
+        std::vector<uPtr<AMQPDescribed>> described;
+    };
+
+    using Values = std::array<Value, MAX_ELEMENTS>;
+
+    /**
+     * Read the elements of the list [data_] is at as [section_] declares
+     * them, building any sections nested within it
+     *
+     * @throws std::runtime_error if the list doesn't match
+     */
+    Values parse (pn_data_t * data_, const Section & section_);
+
+    /**
+     * Build the described value [data_] is at. Sections in the grammar
+     * are built straight from it, anything else is handed to the
+     * descriptor registered for it.
+     */
+    uPtr<AMQPDescribed> build (pn_data_t * data_);
+
+    /**
+     * Print the described value [data_] is at, element by element
+     */
+    void dump (pn_data_t * data_, std::stringstream & ss_, const AutoIndent & ai_);
+
+    template<class T>
+    uPtr<T>
+    take (Value & value_) {
+        if (value_.described.empty()) return nullptr;
+
+        return uPtr<T> (static_cast<T *>(value_.described.front().release()));
+    }
+
+    template<class T>
+    std::vector<uPtr<T>>
+    takeAll (Value & value_) {
+        std::vector<uPtr<T>> rtn;
+        rtn.reserve (value_.described.size());
+
+        for (auto & described : value_.described) {
+            rtn.emplace_back (static_cast<T *>(described.release()));
+        }
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
@@ -20,11 +20,19 @@ std::unique_ptr<amqp::AMQPDescribed>
 amqp::internal::schema::descriptors::
 ChoiceDescriptor::build (pn_data_t * data_) const  {
     validateAndNext (data_);
-    proton::auto_enter ae (data_);
 
-    auto name = proton::get_string (data_);
+    auto values = grammar::parse (data_, grammar::CHOICE);
 
-    return std::make_unique<schema::Choice> (name);
+    return make (values);
+}
+
+/******************************************************************************/
+
+std::unique_ptr<amqp::AMQPDescribed>
+amqp::internal::schema::descriptors::
+ChoiceDescriptor::make (grammar::Values & values_) {
+    return std::make_unique<schema::Choice> (
+        std::move (values_[grammar::choice::name].string));
 }
 
 /******************************************************************************/
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "amqp/schema/descriptors/AMQPDescriptor.h"
+#include "amqp/schema/descriptors/Grammar.h"
 
 /******************************************************************************
  *
@@ -19,6 +20,8 @@ namespace amqp::internal::schema::descriptors {
             ~ChoiceDescriptor() final = default;
 
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
+
+            static std::unique_ptr<AMQPDescribed> make (grammar::Values &);
     };
 
 }
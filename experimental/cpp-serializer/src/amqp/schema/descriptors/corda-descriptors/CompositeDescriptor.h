@@ -1,6 +1,7 @@
 #pragma once
 
 #include "amqp/schema/descriptors/AMQPDescriptor.h"
+#include "amqp/schema/descriptors/Grammar.h"
 
 /******************************************************************************/
 
@@ -15,10 +16,7 @@ namespace amqp::internal::schema::descriptors {
 
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
 
-            void read (
-                pn_data_t *,
-                std::stringstream &,
-                const AutoIndent &) const override;
+            static std::unique_ptr<AMQPDescribed> make (grammar::Values &);
     };
 
 }
@@ -4,6 +4,7 @@
 #include <string>
 
 #include "AMQPDescriptors.h"
+#include "amqp/schema/descriptors/Grammar.h"
 
 /******************************************************************************
  *
@@ -30,10 +31,7 @@ namespace amqp::internal::schema::descriptors {
 
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
 
-            void read (
-                    pn_data_t *,
-                    std::stringstream &,
-                    const AutoIndent &) const override;
+            static std::unique_ptr<AMQPDescribed> make (grammar::Values &);
     };
 
 }
@@ -6,7 +6,6 @@
 #include "proton/proton_wrapper.h"
 #include "amqp/schema/described-types/Descriptor.h"
 
-#include <sstream>
 
 /******************************************************************************
  *
@@ -23,9 +22,6 @@ ObjectDescriptor::ObjectDescriptor (
 
 /******************************************************************************/
 
-/**
- *
- */
 uPtr<amqp::AMQPDescribed>
 amqp::internal::schema::descriptors::
 ObjectDescriptor::build (pn_data_t * data_) const {
@@ -33,36 +29,18 @@ ObjectDescriptor::build (pn_data_t * data_) const {
 
     validateAndNext (data_);
 
-    proton::auto_enter p (data_);
-
-    auto symbol = proton::get_symbol<std::string> (data_);
+    auto values = grammar::parse (data_, grammar::OBJECT);
 
-    return std::make_unique<schema::Descriptor> (symbol);
+    return make (values);
 }
 
 /******************************************************************************/
 
-void
+uPtr<amqp::AMQPDescribed>
 amqp::internal::schema::descriptors::
-ObjectDescriptor::read (
-        pn_data_t * data_,
-        std::stringstream & ss_,
-        const AutoIndent & ai_
-) const  {
-    proton::is_list (data_);
-
-    {
-        AutoIndent ai { ai_ };
-        proton::auto_list_enter ale (data_);
-        pn_data_next(data_);
-
-        ss_ << ai << "1/2] "
-            << proton::get_symbol<std::string>(
-                          (pn_data_t *)proton::auto_next (data_))
-            << std::endl;
-
-        ss_ << ai << "2/2] " << data_ << std::endl;
-    }
+ObjectDescriptor::make (grammar::Values & values_) {
+    return std::make_unique<schema::Descriptor> (
+        std::move (values_[grammar::object::name].string));
 }
 
 /******************************************************************************/
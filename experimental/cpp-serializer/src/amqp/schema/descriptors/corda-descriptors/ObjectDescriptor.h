@@ -3,6 +3,7 @@
 /******************************************************************************/
 
 #include "amqp/schema/descriptors/AMQPDescriptor.h"
+#include "amqp/schema/descriptors/Grammar.h"
 
 /******************************************************************************/
 
@@ -22,10 +23,7 @@ namespace amqp::internal::schema::descriptors {
 
         std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
 
-        void read (
-                pn_data_t *,
-                std::stringstream &,
-                const AutoIndent &) const override;
+        static std::unique_ptr<AMQPDescribed> make (grammar::Values &);
     };
 
 }
@@ -12,7 +12,6 @@
 #include "amqp/schema/OrderedTypeNotations.h"
 #include "amqp/schema/AMQPTypeNotation.h"
 
-#include <sstream>
 
 /******************************************************************************/
 
@@ -32,65 +31,27 @@ SchemaDescriptor::build (pn_data_t * data_) const {
 
     validateAndNext(data_);
 
-    schema::OrderedTypeNotations<schema::AMQPTypeNotation> schemas;
-
-    /*
-     * The Schema is stored as a list of lists of described objects
-     */
-    {
-        proton::auto_list_enter ale (data_);
-
-        for (int i { 1 } ; pn_data_next(data_) ; ++i) {
-            DBG ("  " << i << "/" << ale.elements() << std::endl); // NOLINT
-            proton::auto_list_enter ale2 (data_);
-            while (pn_data_next(data_)) {
-                schemas.insert (
-                    descriptors::dispatchDescribed<schema::AMQPTypeNotation> (
-                        data_));
-
-                DBG("=======" << std::endl << schemas << "======" << std::endl);
-            }
-        }
-    }
+    auto values = grammar::parse (data_, grammar::SCHEMA);
 
-    return std::make_unique<schema::Schema> (std::move (schemas));
+    return make (values);
 }
 
 /******************************************************************************/
 
-
-void
+uPtr<amqp::AMQPDescribed>
 amqp::internal::schema::descriptors::
-SchemaDescriptor::read (
-        pn_data_t * data_,
-        std::stringstream & ss_,
-        const AutoIndent & ai_
-) const {
-    proton::is_list (data_);
+SchemaDescriptor::make (grammar::Values & values_) {
+    schema::OrderedTypeNotations<schema::AMQPTypeNotation> schemas;
 
+    for (auto & type : grammar::takeAll<schema::AMQPTypeNotation> (
+            values_[grammar::notations::types]))
     {
-        AutoIndent ai { ai_ };
-        proton::auto_list_enter ale (data_);
-
-        for (int i { 1 } ; pn_data_next (data_) ; ++i) {
-            proton::is_list (data_);
-            ss_ << ai << i << "/" << ale.elements() <<"]";
-
-            AutoIndent ai2 { ai };
-
-            proton::auto_list_enter ale2 (data_);
-            ss_ << " list: entries: " << ale2.elements() << std::endl;
+        schemas.insert (std::move (type));
 
-            for (int j { 1 } ; pn_data_next (data_) ; ++j) {
-                ss_ << ai2 << i << ":" << j << "/" << ale2.elements()
-                        << "] " << std::endl;
-
-                AMQPDescriptorRegistory[pn_data_type(data_)]->read (
-                        data_, ss_,
-                        AutoIndent { ai2 });
-            }
-        }
+        DBG("=======" << std::endl << schemas << "======" << std::endl);
     }
+
+    return std::make_unique<schema::Schema> (std::move (schemas));
 }
 
 /******************************************************************************/
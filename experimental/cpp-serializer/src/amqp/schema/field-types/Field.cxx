@@ -122,7 +122,8 @@ Field::typeIsPrimitive (const std::string & type_) {
             type_ == "long" ||
             type_ == "boolean" ||
             type_ == "int" ||
-            type_ == "double");
+            type_ == "double" ||
+            type_ == "binary");
 }
 
 /******************************************************************************/
@@ -151,3 +152,19 @@ Field::requires() const {
 
 /******************************************************************************/
 
+const std::string &
+amqp::internal::schema::
+Field::defaultValue() const {
+    return m_default;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::schema::
+Field::mandatory() const {
+    return m_mandatory;
+}
+
+/******************************************************************************/
+
@@ -53,6 +53,8 @@ namespace amqp::internal::schema {
             const std::string & name() const;
             const std::string & type() const;
             const std::list<std::string> & requires() const;
+            const std::string & defaultValue() const;
+            bool mandatory() const;
 
             virtual bool primitive() const = 0;
             virtual const std::string & fieldType() const = 0;
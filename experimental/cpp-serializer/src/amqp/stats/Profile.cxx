@@ -0,0 +1,530 @@
+#include "Profile.h"
+
+#include <algorithm>
+
+#include "wire/Blob.h"
+#include "amqp/json/Json.h"
+#include "proton/utf8.h"
+
+/******************************************************************************/
+
+using amqp::internal::wire::Cursor;
+using amqp::internal::wire::Type;
+
+namespace codes = amqp::internal::wire::codes;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * The bytes of a number, for hashing
+     */
+    template<typename T>
+    std::string_view
+    bytesOf (const T & value_) {
+        return { reinterpret_cast<const char *>(&value_), sizeof (value_) };
+    }
+
+    bool
+    numeric (Type::Kind kind_) {
+        return kind_ == Type::Kind::int_t
+            || kind_ == Type::Kind::long_t
+            || kind_ == Type::Kind::double_t;
+    }
+
+    /**
+     * Values rather than structures of them
+     */
+    bool
+    leaf (Type::Kind kind_) {
+        return kind_ < Type::Kind::composite_t || kind_ == Type::Kind::enum_t;
+    }
+
+    bool
+    counted (Type::Kind kind_) {
+        return kind_ == Type::Kind::string_t
+            || kind_ == Type::Kind::bool_t
+            || kind_ == Type::Kind::enum_t;
+    }
+
+    bool
+    collection (Type::Kind kind_) {
+        return kind_ == Type::Kind::list_t
+            || kind_ == Type::Kind::array_t
+            || kind_ == Type::Kind::map_t;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::stats::Field
+ *
+ ******************************************************************************/
+
+void
+amqp::internal::stats::
+Field::number (double value_) {
+    min = std::min (min, value_);
+    max = std::max (max, value_);
+    sum += value_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+Field::merge (const Field & other_) {
+    count += other_.count;
+    nulls += other_.nulls;
+    min = std::min (min, other_.min);
+    max = std::max (max, other_.max);
+    sum += other_.sum;
+
+    distinct.merge (other_.distinct);
+    top.merge (other_.top);
+    lengths.merge (other_.lengths);
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::stats::Profile
+ *
+ ******************************************************************************/
+
+/**
+ * A path as reached through one schema. A field typed as an interface
+ * holds values of whatever implements it, those are read through a
+ * [concrete] node per implementation, at the same path and sharing
+ * its [Field].
+ */
+struct amqp::internal::stats::Profile::Node {
+    const Type &            type;
+    Field &                 field;
+    std::string             path;
+
+    std::vector<uPtr<Node>> children;
+    std::vector<uPtr<Node>> concrete;
+};
+
+/******************************************************************************/
+
+amqp::internal::stats::
+Profile::Profile (std::string type_)
+    : m_type (std::move (type_))
+{ }
+
+/******************************************************************************/
+
+amqp::internal::stats::
+Profile::~Profile() = default;
+
+/******************************************************************************/
+
+amqp::internal::stats::Field &
+amqp::internal::stats::
+Profile::field (const std::string & path_, const Type & type_) {
+    auto [it, inserted] = m_fields.try_emplace (path_);
+
+    if (inserted) {
+        it->second.type = type_.name;
+        it->second.kind = type_.kind;
+    }
+
+    return it->second;
+}
+
+/******************************************************************************/
+
+amqp::internal::stats::Profile::Node &
+amqp::internal::stats::
+Profile::child (Node & node_, size_t i_) {
+    if (node_.children.empty()) {
+        node_.children.resize (node_.type.children.size());
+    }
+
+    auto & child = node_.children[i_];
+
+    if (!child) {
+        std::string path;
+
+        switch (node_.type.kind) {
+            case Type::Kind::composite_t :
+                path = node_.path.empty()
+                    ? node_.type.fields[i_]
+                    : node_.path + "." + node_.type.fields[i_];
+                break;
+            case Type::Kind::map_t :
+                path = node_.path + (i_ == 0 ? "{}" : "[]");
+                break;
+            default :
+                path = node_.path + "[]";
+                break;
+        }
+
+        const auto & type = *node_.type.children[i_];
+        auto & field = this->field (path, type);
+
+        child.reset (new Node { type, field, std::move (path), { }, { } });
+    }
+
+    return *child;
+}
+
+/******************************************************************************/
+
+amqp::internal::stats::Profile::Node &
+amqp::internal::stats::
+Profile::concrete (Node & node_, const Type & type_) {
+    for (auto & c : node_.concrete) {
+        if (&c->type == &type_) {
+            return *c;
+        }
+    }
+
+    node_.concrete.emplace_back (new Node { type_, node_.field, node_.path, { }, { } });
+
+    return *node_.concrete.back();
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::stats::
+Profile::add (const char * blob_, size_t size_) {
+    wire::Blob blob (blob_, size_);
+
+    auto [types, type] = m_types.root (blob);
+
+    if (!m_type.empty() && m_type != type->descriptor && m_type != type->name) {
+        return false;
+    }
+
+    auto & root = m_roots[type];
+
+    if (!root) {
+        root.reset (new Node { *type, field ("", *type), "", { }, { } });
+    }
+
+    ++m_blobs;
+
+    auto cursor = blob.object();
+
+    value (cursor, *root, *types, cursor.code());
+
+    return true;
+}
+
+/******************************************************************************/
+
+/**
+ * Count the value of [node_]'s type whose constructor, [code_], has
+ * already been read, leaving [cursor_] after it
+ */
+void
+amqp::internal::stats::
+Profile::value (
+    Cursor & cursor_,
+    Node & node_,
+    const wire::TypeTable & types_,
+    uint8_t code_
+) {
+    auto & field = node_.field;
+
+    ++field.count;
+
+    if (code_ == codes::NULL_) {
+        ++field.nulls;
+        return;
+    }
+
+    switch (node_.type.kind) {
+        case Type::Kind::int_t :
+        case Type::Kind::long_t : {
+            auto value = cursor_.integer (code_);
+            field.number (static_cast<double>(value));
+            field.distinct.add (hash (bytesOf (value)));
+            return;
+        }
+        case Type::Kind::double_t : {
+            auto value = cursor_.real (code_);
+            field.number (value);
+            field.distinct.add (hash (bytesOf (value)));
+            return;
+        }
+        case Type::Kind::bool_t : {
+            std::string_view value = json::boolean (cursor_.boolean (code_));
+            field.top.add (value);
+            field.distinct.add (hash (value));
+            return;
+        }
+        case Type::Kind::string_t : {
+            auto at = cursor_.offset() - 1;
+            auto value = cursor_.bytes (code_);
+
+            if (!proton::utf8::valid (value.data(), value.size())) {
+                throw wire::Error ("String is not valid UTF-8", at);
+            }
+
+            field.top.add (value);
+            field.distinct.add (hash (value));
+            return;
+        }
+        case Type::Kind::binary_t :
+            field.distinct.add (hash (cursor_.bytes (code_)));
+            return;
+        default :
+            break;
+    }
+
+    if (code_ != codes::DESCRIBED) {
+        cursor_.fail ("Expected a described value");
+    }
+
+    auto descriptor = cursor_.code();
+
+    if (Cursor::isSymbol (descriptor)) {
+        auto fingerprint = cursor_.bytes (descriptor);
+
+        if (fingerprint != node_.type.descriptor) {
+            auto type = types_.byDescriptor (fingerprint);
+
+            if (!type) {
+                cursor_.fail ("Fingerprint not found in the schema");
+            }
+
+            body (cursor_, concrete (node_, *type), types_, cursor_.code());
+            return;
+        }
+    } else if (Cursor::isULong (descriptor) && wire::isReference (cursor_.ulong (descriptor))) {
+        // counted where the object it refers to was
+        cursor_.skip();
+        return;
+    } else {
+        cursor_.fail ("Expected a fingerprint");
+    }
+
+    body (cursor_, node_, types_, cursor_.code());
+}
+
+/******************************************************************************/
+
+/**
+ * The described part of a composite or restricted value
+ */
+void
+amqp::internal::stats::
+Profile::body (
+    Cursor & cursor_,
+    Node & node_,
+    const wire::TypeTable & types_,
+    uint8_t code_
+) {
+    switch (node_.type.kind) {
+        case Type::Kind::composite_t : {
+            if (!Cursor::isList (code_)) {
+                cursor_.fail ("Expected a list of fields");
+            }
+
+            auto list = cursor_.compound (code_);
+
+            if (list.count > node_.type.children.size()) {
+                cursor_.fail ("More values than fields");
+            }
+
+            for (uint32_t i { 0 } ; i < list.count ; ++i) {
+                value (cursor_, child (node_, i), types_, cursor_.code());
+            }
+
+            return;
+        }
+        case Type::Kind::list_t :
+        case Type::Kind::array_t : {
+            auto collection = cursor_.compound (code_);
+            auto & element = child (node_, 0);
+
+            node_.field.lengths.add (collection.count);
+
+            if (Cursor::isList (code_)) {
+                for (uint32_t i { 0 } ; i < collection.count ; ++i) {
+                    value (cursor_, element, types_, cursor_.code());
+                }
+
+                return;
+            }
+
+            // an array shares one constructor between its elements
+            auto code = cursor_.code();
+
+            if (code == codes::DESCRIBED) {
+                cursor_.skip();
+                code = cursor_.code();
+
+                for (uint32_t i { 0 } ; i < collection.count ; ++i) {
+                    ++element.field.count;
+                    body (cursor_, element, types_, code);
+                }
+            } else {
+                for (uint32_t i { 0 } ; i < collection.count ; ++i) {
+                    value (cursor_, element, types_, code);
+                }
+            }
+
+            return;
+        }
+        case Type::Kind::map_t : {
+            if (!Cursor::isMap (code_)) {
+                cursor_.fail ("Expected a map");
+            }
+
+            auto map = cursor_.compound (code_);
+
+            node_.field.lengths.add (map.count / 2);
+
+            auto & key = child (node_, 0);
+            auto & val = child (node_, 1);
+
+            for (uint32_t i { 0 } ; i < map.count ; i += 2) {
+                value (cursor_, key, types_, cursor_.code());
+                value (cursor_, val, types_, cursor_.code());
+            }
+
+            return;
+        }
+        case Type::Kind::enum_t : {
+            auto list = cursor_.compound (code_);
+
+            if (list.count != 2) {
+                cursor_.fail ("Expected an enum's name and ordinal");
+            }
+
+            cursor_.skip();
+
+            auto ordinal = cursor_.integer (cursor_.code());
+
+            if (ordinal < 0 || static_cast<size_t>(ordinal) >= node_.type.constants.size()) {
+                cursor_.fail ("Enum ordinal out of range");
+            }
+
+            const auto & constant = node_.type.constants[ordinal];
+
+            node_.field.top.add (constant);
+            node_.field.distinct.add (hash (constant));
+
+            return;
+        }
+        default :
+            cursor_.fail ("Primitive types aren't described");
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+Profile::merge (const Profile & other_) {
+    m_blobs += other_.m_blobs;
+
+    for (const auto & f : other_.m_fields) {
+        auto it = m_fields.find (f.first);
+
+        if (it == m_fields.end()) {
+            m_fields.emplace (f);
+        } else {
+            it->second.merge (f.second);
+        }
+    }
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::stats::
+Profile::dump (size_t top_) const {
+    std::string rtn;
+
+    rtn += "{ \"blobs\" : ";
+    json::number (static_cast<int64_t>(m_blobs), rtn);
+    rtn += ", \"fields\" : {";
+
+    bool first { true };
+
+    for (const auto & [path, field] : m_fields) {
+        rtn += first ? "\n" : ",\n";
+        first = false;
+
+        json::quote (path, rtn);
+        rtn += " : { \"type\" : ";
+        json::quote (field.type, rtn);
+        rtn += ", \"count\" : ";
+        json::number (static_cast<int64_t>(field.count), rtn);
+        rtn += ", \"nulls\" : ";
+        json::number (static_cast<int64_t>(field.nulls), rtn);
+
+        if (numeric (field.kind) && field.count > field.nulls) {
+            rtn += ", \"min\" : ";
+            json::number (field.min, rtn);
+            rtn += ", \"max\" : ";
+            json::number (field.max, rtn);
+            rtn += ", \"sum\" : ";
+            json::number (field.sum, rtn);
+        }
+
+        if (leaf (field.kind)) {
+            rtn += ", \"distinct\" : ";
+            json::number (static_cast<int64_t>(field.distinct.estimate()), rtn);
+        }
+
+        if (counted (field.kind)) {
+            rtn += ", \"top\" : [";
+
+            bool firstValue { true };
+
+            for (const auto & e : field.top.top (top_)) {
+                rtn += firstValue ? " " : ", ";
+                firstValue = false;
+
+                rtn += "{ \"value\" : ";
+                json::quote (e.value, rtn);
+                rtn += ", \"count\" : ";
+                json::number (static_cast<int64_t>(e.count), rtn);
+                rtn += " }";
+            }
+
+            rtn += " ]";
+        }
+
+        if (collection (field.kind)) {
+            rtn += ", \"lengths\" : {";
+
+            bool firstBucket { true };
+
+            for (size_t i { 0 } ; i < Histogram::BUCKETS ; ++i) {
+                if (!field.lengths[i]) {
+                    continue;
+                }
+
+                rtn += firstBucket ? " " : ", ";
+                firstBucket = false;
+
+                auto lower = std::to_string (Histogram::lower (i));
+                auto upper = std::to_string (Histogram::upper (i));
+
+                json::quote (lower == upper ? lower : lower + "-" + upper, rtn);
+                rtn += " : ";
+                json::number (static_cast<int64_t>(field.lengths[i]), rtn);
+            }
+
+            rtn += " }";
+        }
+
+        rtn += " }";
+    }
+
+    rtn += "\n} }";
+
+    return rtn;
+}
+
+/******************************************************************************/
@@ -0,0 +1,159 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+#include "types.h"
+
+#include "Sketch.h"
+
+#include "wire/Cursor.h"
+#include "wire/TypeTable.h"
+#include "wire/TypeCache.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::stats {
+
+    /**
+     * What's been seen at one path through the payloads profiled. Paths
+     * are written as the diff writes them, fields separated by dots, with
+     * the elements of a list or array, and the values of a map, under
+     * "[]" and the keys of a map under "{}", e.g. "amount.tokens[].issuer".
+     * The payload itself is the empty path.
+     */
+    struct Field {
+        /**
+         * The schema's name for the type first seen here
+         */
+        std::string      type;
+        wire::Type::Kind kind;
+
+        /**
+         * Every value, null or otherwise
+         */
+        uint64_t count { 0 };
+        uint64_t nulls { 0 };
+
+        /**
+         * Ints, longs and doubles, held as doubles so longs beyond 2^53
+         * are approximate
+         */
+        double min { std::numeric_limits<double>::infinity() };
+        double max { -std::numeric_limits<double>::infinity() };
+        double sum { 0.0 };
+
+        /**
+         * Primitives and enums
+         */
+        HyperLogLog distinct;
+
+        /**
+         * Strings, booleans and enums
+         */
+        TopK top;
+
+        /**
+         * The number of elements of lists and arrays, and entries of maps
+         */
+        Histogram lengths;
+
+        void number (double value_);
+
+        void merge (const Field &);
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::stats {
+
+    /**
+     * Statistics for every field path of a type, gathered by walking the
+     * payloads of its blobs once each, in place, with nothing decoded
+     * beyond the values being counted.
+     *
+     * The walk is driven by each blob's schema compiled down to a
+     * [wire::TypeTable], the same one the filter and diff walk with, and
+     * cached across blobs. Alongside each payload type is kept a tree of
+     * the paths reached through it, each node holding a pointer to its
+     * [Field], so counting a value never builds or looks up its path.
+     *
+     * A profile isn't thread safe, profile with one per thread and merge
+     * them at the end.
+     */
+    class Profile {
+        private :
+            struct Node;
+
+            /**
+             * The fingerprint or name of the type being profiled, empty
+             * for every type
+             */
+            std::string m_type;
+
+            uint64_t m_blobs { 0 };
+
+            std::map<std::string, Field> m_fields;
+
+            wire::TypeCache m_types;
+
+            /**
+             * The root of the paths of each payload type seen, the types
+             * belong to [m_types]
+             */
+            std::map<const wire::Type *, uPtr<Node>> m_roots;
+
+            Field & field (const std::string &, const wire::Type &);
+
+            Node & child (Node &, size_t);
+            Node & concrete (Node &, const wire::Type &);
+
+            void value (wire::Cursor &, Node &, const wire::TypeTable &, uint8_t);
+            void body (wire::Cursor &, Node &, const wire::TypeTable &, uint8_t);
+
+        public :
+            explicit Profile (std::string type_ = "");
+
+            Profile (const Profile &) = delete;
+
+            ~Profile();
+
+            /**
+             * Count the values of a complete Corda blob
+             *
+             * @return false, having counted nothing, if the blob holds
+             * some other type than the one being profiled
+             * @throws wire::Error if the blob is malformed, anything read
+             * before the problem was found will have been counted
+             */
+            bool add (const char * blob_, size_t size_);
+
+            /**
+             * Fold the counts of [other_] into ours
+             */
+            void merge (const Profile & other_);
+
+            uint64_t blobs() const { return m_blobs; }
+
+            const std::map<std::string, Field> & fields() const { return m_fields; }
+
+            /**
+             * The statistics as a JSON object holding one per path, each on
+             * its own line, and at most [top_] of the most frequent values
+             * of each
+             */
+            std::string dump (size_t top_ = 10) const;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,245 @@
+#include "Sketch.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+/******************************************************************************/
+
+uint64_t
+amqp::internal::stats::
+hash (std::string_view bytes_) {
+    uint64_t h { 0xcbf29ce484222325ULL };
+
+    for (auto c : bytes_) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 0x100000001b3ULL;
+    }
+
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+
+    return h;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::stats::HyperLogLog
+ *
+ ******************************************************************************/
+
+/**
+ * The top bits of the hash pick a register which keeps the longest run
+ * of leading zeros seen in the rest of it
+ */
+void
+amqp::internal::stats::
+HyperLogLog::add (uint64_t hash_) {
+    if (m_registers.empty()) {
+        m_registers.resize (REGISTERS);
+    }
+
+    auto index = hash_ >> (64 - PRECISION);
+
+    // the guard bit bounds the run should the rest be all zeros
+    auto rest = (hash_ << PRECISION) | (1ULL << (PRECISION - 1));
+    auto rank = static_cast<uint8_t>(__builtin_clzll (rest) + 1);
+
+    m_registers[index] = std::max (m_registers[index], rank);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+HyperLogLog::merge (const HyperLogLog & other_) {
+    if (other_.m_registers.empty()) {
+        return;
+    }
+
+    if (m_registers.empty()) {
+        m_registers = other_.m_registers;
+        return;
+    }
+
+    for (size_t i { 0 } ; i < REGISTERS ; ++i) {
+        m_registers[i] = std::max (m_registers[i], other_.m_registers[i]);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * The raw estimate is biased upwards while most registers are empty,
+ * there linear counting on the empty ones does better
+ */
+uint64_t
+amqp::internal::stats::
+HyperLogLog::estimate() const {
+    if (m_registers.empty()) {
+        return 0;
+    }
+
+    constexpr double m = REGISTERS;
+    constexpr double alpha = 0.7213 / (1.0 + 1.079 / m);
+
+    double sum { 0.0 };
+    size_t zeros { 0 };
+
+    for (auto r : m_registers) {
+        sum += std::ldexp (1.0, -r);
+
+        if (r == 0) {
+            ++zeros;
+        }
+    }
+
+    auto estimate = alpha * m * m / sum;
+
+    if (estimate <= 2.5 * m && zeros) {
+        estimate = m * std::log (m / static_cast<double>(zeros));
+    }
+
+    return static_cast<uint64_t>(std::llround (estimate));
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::stats::TopK
+ *
+ ******************************************************************************/
+
+amqp::internal::stats::
+TopK::TopK (size_t capacity_)
+    : m_capacity (capacity_)
+{ }
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+TopK::add (std::string_view value_) {
+    auto it = m_index.find (value_);
+
+    if (it != m_index.end()) {
+        ++m_entries[it->second].count;
+        return;
+    }
+
+    if (m_entries.size() < m_capacity) {
+        m_index.emplace (value_, m_entries.size());
+        m_entries.push_back ({ std::string (value_), 1, 0 });
+        return;
+    }
+
+    auto least = std::min_element (
+        m_entries.begin(),
+        m_entries.end(),
+        [](const Entry & a_, const Entry & b_) { return a_.count < b_.count; });
+
+    m_index.erase (least->value);
+    m_index.emplace (value_, least - m_entries.begin());
+
+    least->value = value_;
+    least->error = least->count;
+    ++least->count;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+TopK::merge (const TopK & other_) {
+    for (const auto & e : other_.m_entries) {
+        auto it = m_index.find (e.value);
+
+        if (it == m_index.end()) {
+            m_index.emplace (e.value, m_entries.size());
+            m_entries.push_back (e);
+        } else {
+            m_entries[it->second].count += e.count;
+            m_entries[it->second].error += e.error;
+        }
+    }
+
+    if (m_entries.size() <= m_capacity) {
+        return;
+    }
+
+    std::sort (m_entries.begin(), m_entries.end(), [](const Entry & a_, const Entry & b_) {
+        return a_.count > b_.count;
+    });
+
+    m_entries.resize (m_capacity);
+    m_index.clear();
+
+    for (size_t i { 0 } ; i < m_entries.size() ; ++i) {
+        m_index.emplace (m_entries[i].value, i);
+    }
+}
+
+/******************************************************************************/
+
+std::vector<amqp::internal::stats::TopK::Entry>
+amqp::internal::stats::
+TopK::top (size_t k_) const {
+    auto rtn = m_entries;
+
+    // ties go to the value that sorts first so output is stable
+    std::sort (rtn.begin(), rtn.end(), [](const Entry & a_, const Entry & b_) {
+        return a_.count != b_.count ? a_.count > b_.count : a_.value < b_.value;
+    });
+
+    if (rtn.size() > k_) {
+        rtn.resize (k_);
+    }
+
+    return rtn;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::stats::Histogram
+ *
+ ******************************************************************************/
+
+void
+amqp::internal::stats::
+Histogram::add (uint64_t value_) {
+    ++m_buckets[value_ ? 64 - __builtin_clzll (value_) : 0];
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+Histogram::merge (const Histogram & other_) {
+    for (size_t i { 0 } ; i < BUCKETS ; ++i) {
+        m_buckets[i] += other_.m_buckets[i];
+    }
+}
+
+/******************************************************************************/
+
+uint64_t
+amqp::internal::stats::
+Histogram::lower (size_t bucket_) {
+    return bucket_ ? 1ULL << (bucket_ - 1) : 0;
+}
+
+/******************************************************************************/
+
+uint64_t
+amqp::internal::stats::
+Histogram::upper (size_t bucket_) {
+    if (bucket_ == BUCKETS - 1) {
+        return std::numeric_limits<uint64_t>::max();
+    }
+
+    return bucket_ ? (1ULL << bucket_) - 1 : 0;
+}
+
+/******************************************************************************/
@@ -0,0 +1,132 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************/
+
+namespace amqp::internal::stats {
+
+    /**
+     * A 64 bit hash of [bytes_], FNV-1a finished with MurmurHash3's mixer
+     * so every bit of the input reaches every bit of the output, which
+     * the register selection of [HyperLogLog] depends on
+     */
+    uint64_t hash (std::string_view bytes_);
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::stats {
+
+    /**
+     * An estimate of how many distinct values have been seen, within
+     * about 1.6% for any number of them, in 4KiB. The registers are only
+     * allocated once something is added so a field that's always null
+     * costs nothing.
+     */
+    class HyperLogLog {
+        public :
+            static constexpr unsigned PRECISION { 12 };
+            static constexpr size_t   REGISTERS { 1U << PRECISION };
+
+        private :
+            std::vector<uint8_t> m_registers;
+
+        public :
+            void add (uint64_t hash_);
+
+            void merge (const HyperLogLog &);
+
+            uint64_t estimate() const;
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::stats {
+
+    /**
+     * The most frequent values seen, found with the Space-Saving algorithm
+     * in a fixed number of counters. Once they're all taken a new value
+     * replaces the least counted and inherits its count, which is then
+     * carried as that entry's possible overcount. Any value seen more than
+     * 1 / capacity of the time is guaranteed to be held.
+     */
+    class TopK {
+        public :
+            struct Entry {
+                std::string value;
+                uint64_t    count;
+
+                /**
+                 * How much of [count] may belong to values evicted before
+                 */
+                uint64_t    error;
+            };
+
+        private :
+            size_t m_capacity;
+
+            std::vector<Entry> m_entries;
+            std::map<std::string, size_t, std::less<>> m_index;
+
+        public :
+            explicit TopK (size_t capacity_ = 64);
+
+            void add (std::string_view value_);
+
+            /**
+             * Sum the counts of values held by both and keep the most
+             * frequent, the result is as approximate as its inputs
+             */
+            void merge (const TopK &);
+
+            /**
+             * Up to [k_] values, most frequent first
+             */
+            std::vector<Entry> top (size_t k_) const;
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::stats {
+
+    /**
+     * Counts of values in power of two buckets, the first for zero and
+     * bucket n > 0 for [2^(n-1), 2^n)
+     */
+    class Histogram {
+        public :
+            static constexpr size_t BUCKETS { 65 };
+
+        private :
+            std::array<uint64_t, BUCKETS> m_buckets { };
+
+        public :
+            void add (uint64_t value_);
+
+            void merge (const Histogram &);
+
+            uint64_t operator[] (size_t bucket_) const { return m_buckets[bucket_]; }
+
+            /**
+             * The smallest and largest value counted in [bucket_]
+             */
+            static uint64_t lower (size_t bucket_);
+            static uint64_t upper (size_t bucket_);
+    };
+
+}
+
+/******************************************************************************/
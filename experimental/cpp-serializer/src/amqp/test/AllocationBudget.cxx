@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <proton/codec.h>
+
+#include "TestUtils.h"
+
+#include "test-utils/BlobBuilder.h"
+#include "test-utils/AllocationScope.h"
+
+/******************************************************************************
+ *
+ * Allocation budgets for the readers. Each test decodes a synthetic blob
+ * large enough that the per element cost dominates and fails if the number
+ * of allocations made per element grows beyond what we've currently got.
+ * When an improvement lowers the cost the budget should be lowered with it.
+ *
+ ******************************************************************************/
+
+namespace {
+
+    const int elements { 10000 };
+
+    /**
+     * Allowance for the fixed cost of a decode, building the schema,
+     * the readers and the outer composite, so the per element budgets
+     * aren't skewed by it
+     */
+    const size_t fixedAllocations { 500 };
+    const size_t fixedBytes { 64 * 1024 };
+
+    struct Cost {
+        std::string json;
+        size_t allocations;
+        size_t bytes;
+    };
+
+    /**
+     * Decode [blob_] the same way the blob inspector does, counting
+     * only the work done by the amqp library, not proton decoding the
+     * bytes into its own tree
+     */
+    Cost
+    decode (const std::vector<char> & blob_) {
+        test::Blob blob (blob_);
+        test::AllocationScope scope;
+
+        auto json = blob.dump();
+
+        return { json, scope.allocations(), scope.bytes() };
+    }
+
+    void
+    check (const Cost & cost_, size_t allocations_, size_t bytes_) {
+        EXPECT_LE (cost_.allocations, fixedAllocations + elements * allocations_)
+            << "allocations per element exceeded the budget of " << allocations_;
+        EXPECT_LE (cost_.bytes, fixedBytes + elements * bytes_)
+            << "bytes per element exceeded the budget of " << bytes_;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (AllocationScope, counts) { // NOLINT
+    test::AllocationScope scope;
+
+    auto i = std::make_unique<int> (1);
+    auto v = std::make_unique<char []> (100);
+
+    EXPECT_EQ (2, scope.allocations());
+    EXPECT_LE (sizeof (int) + 100, scope.bytes());
+
+    v.reset();
+
+    EXPECT_EQ (1, scope.deallocations());
+
+    scope.reset();
+
+    EXPECT_EQ (0, scope.allocations());
+    EXPECT_EQ (0, scope.bytes());
+}
+
+/******************************************************************************/
+
+/**
+ * A class with a single property holding a list of ints
+ */
+TEST (AllocationBudget, listOfInts) { // NOLINT
+    test::BlobBuilder bb;
+
+    bb.composite ("net.corda.A", "net.corda:A", {
+        { "a", "*", { "java.util.List<int>" } } });
+    bb.restricted ("java.util.List<int>", "net.corda:LA", "list");
+
+    auto blob = bb.build ("net.corda:A", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t * data_) {
+            test::putDescribed (data_, "net.corda:LA", [](pn_data_t * data_) {
+                test::putList (data_, [](pn_data_t * data_) {
+                    for (int i { 0 } ; i < elements ; ++i) {
+                        pn_data_put_int (data_, i);
+                    }
+                });
+            });
+        });
+    });
+
+    check (decode (blob), 3, 128);
+}
+
+/******************************************************************************/
+
+/**
+ * A class with a single property holding a map of ints to strings
+ */
+TEST (AllocationBudget, mapOfIntToString) { // NOLINT
+    test::BlobBuilder bb;
+
+    bb.composite ("net.corda.A", "net.corda:A", {
+        { "a", "*", { "java.util.Map<int, string>" } } });
+    bb.restricted ("java.util.Map<int, string>", "net.corda:MA", "map");
+
+    auto blob = bb.build ("net.corda:A", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t * data_) {
+            test::putDescribed (data_, "net.corda:MA", [](pn_data_t * data_) {
+                test::putMap (data_, [](pn_data_t * data_) {
+                    for (int i { 0 } ; i < elements ; ++i) {
+                        pn_data_put_int (data_, i);
+                        test::putString (data_, "value " + std::to_string (i));
+                    }
+                });
+            });
+        });
+    });
+
+    // entries are stored flat and the strings fit in the small string
+    // buffer so the only allocations are for the arrays themselves
+    check (decode (blob), 0, 310);
+}
+
+/******************************************************************************/
+
+/**
+ * A list of composites each with an int and a string property
+ */
+TEST (AllocationBudget, listOfComposites) { // NOLINT
+    test::BlobBuilder bb;
+
+    bb.composite ("net.corda.A", "net.corda:A", {
+        { "a", "*", { "java.util.List<net.corda.B>" } } });
+    bb.restricted ("java.util.List<net.corda.B>", "net.corda:LB", "list");
+    bb.composite ("net.corda.B", "net.corda:B", {
+        { "a", "int" }, { "b", "string" } });
+
+    auto blob = bb.build ("net.corda:A", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t * data_) {
+            test::putDescribed (data_, "net.corda:LB", [](pn_data_t * data_) {
+                test::putList (data_, [](pn_data_t * data_) {
+                    for (int i { 0 } ; i < elements ; ++i) {
+                        test::putDescribed (data_, "net.corda:B", [i](pn_data_t * data_) {
+                            test::putList (data_, [i](pn_data_t * data_) {
+                                pn_data_put_int (data_, i);
+                                test::putString (data_, "b");
+                            });
+                        });
+                    }
+                });
+            });
+        });
+    });
+
+    check (decode (blob), 9, 1150);
+}
+
+/******************************************************************************/
+
+/**
+ * A list of enums
+ */
+TEST (AllocationBudget, listOfEnums) { // NOLINT
+    test::BlobBuilder bb;
+
+    bb.composite ("net.corda.A", "net.corda:A", {
+        { "a", "*", { "java.util.List<net.corda.E>" } } });
+    bb.restricted ("java.util.List<net.corda.E>", "net.corda:LE", "list");
+    bb.restricted ("net.corda.E", "net.corda:E", "list", { "A", "B", "C" });
+
+    auto blob = bb.build ("net.corda:A", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t * data_) {
+            test::putDescribed (data_, "net.corda:LE", [](pn_data_t * data_) {
+                test::putList (data_, [](pn_data_t * data_) {
+                    for (int i { 0 } ; i < elements ; ++i) {
+                        test::putEnum (data_, "net.corda:E", "B", 1);
+                    }
+                });
+            });
+        });
+    });
+
+    auto cost = decode (blob);
+
+    EXPECT_EQ (0, cost.json.find (R"(Parsed : { "a" : [ "B", "B", "B")"));
+
+    // each constant is written as a quoted JSON string, two more bytes
+    // of output per element than when they were bare
+    check (cost, 2, 125);
+}
+
+/******************************************************************************/
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <proton/codec.h>
+
+#include "TestUtils.h"
+
+#include "diff/Diff.h"
+#include "wire/Verifier.h"
+#include "reader/BinaryValue.h"
+#include "reader/PropertyReader.h"
+
+#include "test-utils/BlobBuilder.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::reader;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * A component, a C, serialised on its own
+     */
+    std::vector<char>
+    component (const std::string & s_) {
+        test::BlobBuilder bb;
+
+        bb.composite ("net.corda.C", "net.corda:C", { { "s", "string" } });
+
+        return bb.build ("net.corda:C", [&](pn_data_t * data_) {
+            test::putList (data_, [&](pn_data_t * data_) {
+                test::putString (data_, s_);
+            });
+        });
+    }
+
+    /**
+     * An A holding an int and some bytes, alongside a C of its own so
+     * it shares a type with the component
+     */
+    std::vector<char>
+    blob (const std::vector<char> & bytes_) {
+        test::BlobBuilder bb;
+
+        bb.composite ("net.corda.C", "net.corda:C", { { "s", "string" } });
+        bb.composite ("net.corda.A", "net.corda:A", {
+            { "a", "int" },
+            { "b", "binary" },
+            { "c", "net.corda.C" } });
+
+        return bb.build ("net.corda:A", [&](pn_data_t * data_) {
+            test::putList (data_, [&](pn_data_t * data_) {
+                pn_data_put_int (data_, 1);
+                pn_data_put_binary (data_, pn_bytes (bytes_.size(), bytes_.data()));
+                test::putDescribed (data_, "net.corda:C", [](pn_data_t * data_) {
+                    test::putList (data_, [](pn_data_t * data_) {
+                        test::putString (data_, "outer");
+                    });
+                });
+            });
+        });
+    }
+
+    const BinaryValue &
+    binary (const amqp::reader::IValue & value_) {
+        const auto & fields = dynamic_cast<
+            const TypedPair<sVec<uPtr<amqp::reader::IValue>>> &> (value_).value();
+
+        return dynamic_cast<const BinaryValue &> (*fields[1]);
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Binary, dump) { // NOLINT
+    auto b = blob ({ '\x00', '\x01', '\xab', '\xff' });
+
+    EXPECT_EQ (
+        R"(Parsed : { "a" : 1, "b" : "0001ABFF", "c" : { "s" : "outer" } })",
+        test::Blob (b).dump());
+
+    EXPECT_TRUE (amqp::internal::wire::verify (b.data(), b.size()));
+}
+
+/******************************************************************************/
+
+/**
+ * The wire based tools print bytes just as the readers do
+ */
+TEST (Binary, diff) { // NOLINT
+    auto from = blob ({ '\x00' });
+    auto to = blob ({ '\x0f', '\xf0' });
+
+    auto differences = amqp::internal::diff::diff (
+        from.data(), from.size(), to.data(), to.size());
+
+    ASSERT_EQ (1, differences.size());
+    EXPECT_EQ ("b", differences[0].path);
+    EXPECT_EQ ("\"00\"", differences[0].from.value_or (""));
+    EXPECT_EQ ("\"0FF0\"", differences[0].to.value_or (""));
+}
+
+/******************************************************************************/
+
+/**
+ * A nested blob is only decoded when asked, once, by the same readers
+ * as the blob around it
+ */
+TEST (Binary, nested) { // NOLINT
+    auto inner = component ("inner");
+    auto b = blob (inner);
+
+    amqp::internal::CompositeFactory cf;
+    test::Blob outer (b);
+
+    auto value = outer.read (cf);
+    const auto & bytes = binary (*value);
+
+    EXPECT_TRUE (bytes.blob());
+    EXPECT_EQ (inner.size(), bytes.bytes().size());
+
+    auto c = cf.byType ("net.corda.C");
+
+    const auto & decoded = bytes.decode();
+
+    EXPECT_EQ (R"({ "s" : "inner" })", decoded.dump());
+    EXPECT_EQ (&decoded, &bytes.decode());
+    EXPECT_EQ (c, cf.byType ("net.corda.C"));
+}
+
+/******************************************************************************/
+
+TEST (Binary, notABlob) { // NOLINT
+    auto b = blob ({ 'c', 'o', 'r', 'd' });
+
+    amqp::internal::CompositeFactory cf;
+    test::Blob outer (b);
+
+    auto value = outer.read (cf);
+
+    EXPECT_FALSE (binary (*value).blob());
+    EXPECT_THROW (binary (*value).decode(), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Binary, unknownPrimitive) { // NOLINT
+    EXPECT_THROW ( // NOLINT
+        PropertyReader::make (std::string ("char")),
+        std::runtime_error);
+}
+
+/******************************************************************************/
@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <proton/codec.h>
+
+#include "amqp/CDecoder.h"
+
+#include "test-utils/BlobBuilder.h"
+
+/******************************************************************************/
+
+namespace {
+
+    std::vector<char>
+    blob (int a_) {
+        test::BlobBuilder bb;
+        bb.composite ("net.corda.A", "net.corda:A", { { "a", "int" } });
+
+        return bb.build ("net.corda:A", [&](pn_data_t * data_) {
+            test::putList (data_, [&](pn_data_t * data_) {
+                pn_data_put_int (data_, a_);
+            });
+        });
+    }
+
+    amqp_blob_t
+    view (const std::vector<char> & bytes_) {
+        return { bytes_.data(), bytes_.size() };
+    }
+
+    std::string
+    result (const std::vector<char> & out_, const amqp_result_t & result_) {
+        return std::string (out_.data() + result_.offset, result_.size);
+    }
+
+    /**
+     * Frees the decoder however the test ends
+     */
+    struct Decoder {
+        amqp_decoder_t * decoder { amqp_decoder_new() };
+
+        Decoder() = default;
+        Decoder (const Decoder &) = delete;
+
+        ~Decoder() { amqp_decoder_free (decoder); }
+    };
+
+}
+
+/******************************************************************************/
+
+/**
+ * A bad blob in the middle of a batch doesn't stop the rest of it
+ */
+TEST (CDecoder, batch) { // NOLINT
+    auto one = blob (1);
+    auto two = blob (2);
+    std::vector<char> bad (one.begin(), one.begin() + 20);
+
+    amqp_blob_t blobs[] { view (one), view (bad), view (two) };
+    amqp_result_t results[3];
+    std::vector<char> out (1024);
+
+    Decoder d;
+
+    ASSERT_EQ (3U, amqp_decode (
+        d.decoder, blobs, 3, AMQP_FORMAT_JSON, out.data(), out.size(), results));
+
+    EXPECT_EQ (AMQP_OK, results[0].status);
+    EXPECT_EQ ("{ \"a\" : 1 }", result (out, results[0]));
+
+    EXPECT_EQ (AMQP_MALFORMED, results[1].status);
+    EXPECT_NE (0U, results[1].size);
+    EXPECT_EQ (results[0].offset + results[0].size, results[1].offset);
+
+    EXPECT_EQ (AMQP_OK, results[2].status);
+    EXPECT_EQ ("{ \"a\" : 2 }", result (out, results[2]));
+}
+
+/******************************************************************************/
+
+/**
+ * The batch stops at the first result that doesn't fit, saying how much
+ * space it needs
+ */
+TEST (CDecoder, noSpace) { // NOLINT
+    auto one = blob (1);
+    auto two = blob (2);
+
+    amqp_blob_t blobs[] { view (one), view (two) };
+    amqp_result_t results[2];
+    std::vector<char> out (15);
+
+    Decoder d;
+
+    ASSERT_EQ (1U, amqp_decode (
+        d.decoder, blobs, 2, AMQP_FORMAT_JSON, out.data(), out.size(), results));
+
+    EXPECT_EQ (AMQP_OK, results[0].status);
+    EXPECT_EQ (AMQP_NO_SPACE, results[1].status);
+    EXPECT_EQ (11U, results[1].size);
+
+    ASSERT_EQ (1U, amqp_decode (
+        d.decoder, blobs + 1, 1, AMQP_FORMAT_JSON, out.data(), out.size(), results + 1));
+
+    EXPECT_EQ ("{ \"a\" : 2 }", result (out, results[1]));
+}
+
+/******************************************************************************/
+
+/**
+ * The binary form is the payload as it was encoded in the blob
+ */
+TEST (CDecoder, binary) { // NOLINT
+    auto one = blob (1);
+
+    amqp_blob_t blobs[] { view (one) };
+    amqp_result_t results[1];
+    std::vector<char> out (1024);
+
+    Decoder d;
+
+    ASSERT_EQ (1U, amqp_decode (
+        d.decoder, blobs, 1, AMQP_FORMAT_BINARY, out.data(), out.size(), results));
+
+    ASSERT_EQ (AMQP_OK, results[0].status);
+
+    auto payload = result (out, results[0]);
+
+    EXPECT_NE (std::string::npos, std::string (one.begin(), one.end()).find (payload));
+    EXPECT_EQ ('\x00', payload[0]);
+    EXPECT_NE (std::string::npos, payload.find ("net.corda:A"));
+}
+
+/******************************************************************************/
+
+/**
+ * Enums as their ordinal, the constants of their type given once however
+ * many values of it there are
+ */
+TEST (CDecoder, enumCodes) { // NOLINT
+    test::BlobBuilder bb;
+    bb.restricted ("net.corda.E", "net.corda:E", "list", { "X", "Y", "Z" });
+    bb.composite ("net.corda.A", "net.corda:A", { { "e", "net.corda.E" }, { "f", "net.corda.E" } });
+
+    auto bytes = bb.build ("net.corda:A", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t * data_) {
+            test::putEnum (data_, "net.corda:E", "Y", 1);
+            test::putEnum (data_, "net.corda:E", "Z", 2);
+        });
+    });
+
+    amqp_blob_t blobs[] { view (bytes) };
+    amqp_result_t results[1];
+    std::vector<char> out (1024);
+
+    Decoder d;
+
+    ASSERT_EQ (1U, amqp_decode (
+        d.decoder, blobs, 1, AMQP_FORMAT_JSON_ENUM_CODES, out.data(), out.size(), results));
+
+    ASSERT_EQ (AMQP_OK, results[0].status);
+    EXPECT_EQ (
+        "{ \"value\" : { \"e\" : 1, \"f\" : 2 }, "
+            "\"enums\" : { \"net.corda.E\" : [ \"X\", \"Y\", \"Z\" ] } }",
+        result (out, results[0]));
+}
+
+/******************************************************************************/
+
+/**
+ * Keys are quoted by their type, a string key starting with a quote is
+ * escaped and a numeric one quoted
+ */
+TEST (CDecoder, mapKeys) { // NOLINT
+    test::BlobBuilder bb;
+    bb.restricted ("java.util.Map<string, int>", "net.corda:S", "map");
+    bb.restricted ("java.util.Map<int, int>", "net.corda:I", "map");
+    bb.composite ("net.corda.A", "net.corda:A", {
+        { "s", "*", { "java.util.Map<string, int>" } },
+        { "i", "*", { "java.util.Map<int, int>" } } });
+
+    auto bytes = bb.build ("net.corda:A", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t * data_) {
+            test::putDescribed (data_, "net.corda:S", [](pn_data_t * data_) {
+                test::putMap (data_, [](pn_data_t * data_) {
+                    test::putString (data_, "\"a");
+                    pn_data_put_int (data_, 1);
+                });
+            });
+            test::putDescribed (data_, "net.corda:I", [](pn_data_t * data_) {
+                test::putMap (data_, [](pn_data_t * data_) {
+                    pn_data_put_int (data_, 2);
+                    pn_data_put_int (data_, 3);
+                });
+            });
+        });
+    });
+
+    amqp_blob_t blobs[] { view (bytes) };
+    amqp_result_t results[1];
+    std::vector<char> out (1024);
+
+    Decoder d;
+
+    ASSERT_EQ (1U, amqp_decode (
+        d.decoder, blobs, 1, AMQP_FORMAT_JSON, out.data(), out.size(), results));
+
+    ASSERT_EQ (AMQP_OK, results[0].status);
+    EXPECT_EQ (
+        R"({ "s" : { "\"a" : 1 }, "i" : { "2" : 3 } })",
+        result (out, results[0]));
+}
+
+/******************************************************************************/
+
+/**
+ * A field typed as an interface, or as "*", is written as whichever
+ * implementation it holds
+ */
+TEST (CDecoder, interface) { // NOLINT
+    test::BlobBuilder bb;
+    bb.composite ("net.corda.Alice", "net.corda:Alice", { { "name", "string" } });
+    bb.composite ("net.corda.A", "net.corda:A", {
+        { "a", "net.corda.Party" },
+        { "s", "*", { "net.corda.Party" } } });
+
+    auto bytes = bb.build ("net.corda:A", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t * data_) {
+            for (const char * name : { "Alice", "Carol" }) {
+                test::putDescribed (data_, "net.corda:Alice", [&](pn_data_t * data_) {
+                    test::putList (data_, [&](pn_data_t * data_) {
+                        test::putString (data_, name);
+                    });
+                });
+            }
+        });
+    });
+
+    amqp_blob_t blobs[] { view (bytes) };
+    amqp_result_t results[1];
+    std::vector<char> out (1024);
+
+    Decoder d;
+
+    ASSERT_EQ (1U, amqp_decode (
+        d.decoder, blobs, 1, AMQP_FORMAT_JSON, out.data(), out.size(), results));
+
+    ASSERT_EQ (AMQP_OK, results[0].status);
+    EXPECT_EQ (
+        R"({ "a" : { "name" : "Alice" }, "s" : { "name" : "Carol" } })",
+        result (out, results[0]));
+
+    ASSERT_EQ (1U, amqp_decode (
+        d.decoder, blobs, 1, AMQP_FORMAT_BINARY, out.data(), out.size(), results));
+
+    EXPECT_EQ (AMQP_OK, results[0].status);
+}
+
+/******************************************************************************/
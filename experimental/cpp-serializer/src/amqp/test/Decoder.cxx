@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <proton/codec.h>
+
+#include "amqp/AMQPHeader.h"
+
+#include "wire/Decoder.h"
+
+#include "test-utils/BlobBuilder.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::wire;
+
+/******************************************************************************/
+
+namespace {
+
+    std::vector<char>
+    blob (int a_, const std::string & b_) {
+        test::BlobBuilder bb;
+        bb.composite ("net.corda.A", "net.corda:A", { { "a", "int" }, { "b", "string" } });
+
+        return bb.build ("net.corda:A", [&](pn_data_t * data_) {
+            test::putList (data_, [&](pn_data_t * data_) {
+                pn_data_put_int (data_, a_);
+                test::putString (data_, b_);
+            });
+        });
+    }
+
+    /**
+     * Feed [bytes_] to a decoder [chunk_] bytes at a time, writing down
+     * every event as it comes
+     */
+    std::vector<std::string>
+    decode (const std::vector<char> & bytes_, size_t chunk_) {
+        std::vector<std::string> events;
+
+        Decoder decoder ([&events](const Event & event_) {
+            events.push_back (
+                std::to_string (static_cast<int>(event_.kind)) + " "
+                    + std::to_string (event_.offset) + " "
+                    + std::to_string (event_.code) + " "
+                    + std::to_string (event_.count) + " "
+                    + std::string (event_.field) + " "
+                    + std::string (event_.encoded));
+        });
+
+        for (size_t i { 0 } ; i < bytes_.size() ; i += chunk_) {
+            decoder.feed (bytes_.data() + i, std::min (chunk_, bytes_.size() - i));
+        }
+
+        decoder.finish();
+
+        return events;
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Where the chunks split the blob makes no difference to what's decoded
+ */
+TEST (Decoder, chunks) { // NOLINT
+    auto bytes = blob (1, "hello");
+    auto whole = decode (bytes, bytes.size());
+
+    ASSERT_FALSE (whole.empty());
+    EXPECT_EQ (whole, decode (bytes, 1));
+    EXPECT_EQ (whole, decode (bytes, 3));
+    EXPECT_EQ (whole, decode (bytes, 7));
+}
+
+/******************************************************************************/
+
+/**
+ * The payload comes before the schema, so field names are only known
+ * for the blobs after the first
+ */
+TEST (Decoder, backToBack) { // NOLINT
+    auto first = blob (1, "one");
+    auto second = blob (2, "two");
+    auto bytes = first;
+    bytes.insert (bytes.end(), second.begin(), second.end());
+
+    size_t blobs { 0 }, schemas { 0 };
+    std::vector<std::string> fields;
+    std::vector<size_t> offsets;
+
+    Decoder decoder ([&](const Event & event_) {
+        switch (event_.kind) {
+            case Event::Kind::blob :
+                ++blobs;
+                offsets.push_back (event_.offset);
+                break;
+            case Event::Kind::schema :
+                ++schemas;
+                break;
+            case Event::Kind::value :
+                fields.emplace_back (event_.field);
+                break;
+            default :
+                break;
+        }
+    });
+
+    for (size_t i { 0 } ; i < bytes.size() ; i += 5) {
+        decoder.feed (bytes.data() + i, std::min<size_t> (5, bytes.size() - i));
+    }
+
+    decoder.finish();
+
+    EXPECT_EQ (2U, blobs);
+    EXPECT_EQ (2U, schemas);
+    ASSERT_EQ (2U, offsets.size());
+    EXPECT_EQ (first.size(), offsets[0]);
+    EXPECT_EQ (second.size(), offsets[1]);
+    EXPECT_EQ ((std::vector<std::string> { "", "", "a", "b" }), fields);
+
+    ASSERT_NE (nullptr, decoder.types());
+    EXPECT_NE (nullptr, decoder.types()->byDescriptor ("net.corda:A"));
+}
+
+/******************************************************************************/
+
+TEST (Decoder, truncated) { // NOLINT
+    auto bytes = blob (1, "hello");
+
+    Decoder decoder ([](const Event &) { });
+    decoder.feed (bytes.data(), bytes.size() - 1);
+
+    EXPECT_THROW (decoder.finish(), Error); // NOLINT
+
+    Decoder empty ([](const Event &) { });
+
+    EXPECT_NO_THROW (empty.finish()); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Decoder, notAnEnvelope) { // NOLINT
+    auto bytes = blob (1, "hello");
+
+    // the low byte of the envelope's descriptor
+    bytes[amqp::AMQP_HEADER.size() + 10] = '\x09';
+
+    Decoder decoder ([](const Event &) { });
+
+    try {
+        decoder.feed (bytes.data(), bytes.size());
+        FAIL() << "accepted a blob that isn't an envelope";
+    } catch (const Error & e) {
+        EXPECT_EQ (amqp::AMQP_HEADER.size() + 2, e.offset());
+    }
+}
+
+/******************************************************************************/
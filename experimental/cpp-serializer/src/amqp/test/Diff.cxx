@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include <proton/codec.h>
+
+#include "diff/Diff.h"
+
+#include "test-utils/BlobBuilder.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::diff;
+
+/******************************************************************************/
+
+namespace {
+
+    struct Values {
+        int a { 1 };
+        std::string s { "hello" };
+        long l { 10 };
+        std::vector<int> list { 1, 2, 3 };
+        std::map<std::string, int> map { { "x", 1 }, { "y", 2 } };
+    };
+
+    /**
+     * An A holding an int, a string, a nested B, a list and a map
+     */
+    std::vector<char>
+    blob (const Values & v_) {
+        test::BlobBuilder bb;
+
+        bb.composite ("net.corda.B", "net.corda:B", { { "l", "long" } });
+        bb.restricted ("java.util.List<int>", "net.corda:L", "list");
+        bb.restricted ("java.util.Map<string, int>", "net.corda:M", "map");
+        bb.composite ("net.corda.A", "net.corda:A", {
+            { "a", "int" },
+            { "s", "string" },
+            { "b", "net.corda.B" },
+            { "l", "*", { "java.util.List<int>" } },
+            { "m", "*", { "java.util.Map<string, int>" } } });
+
+        return bb.build ("net.corda:A", [&](pn_data_t * data_) {
+            test::putList (data_, [&](pn_data_t * data_) {
+                pn_data_put_int (data_, v_.a);
+                test::putString (data_, v_.s);
+                test::putDescribed (data_, "net.corda:B", [&](pn_data_t * data_) {
+                    test::putList (data_, [&](pn_data_t * data_) {
+                        pn_data_put_long (data_, v_.l);
+                    });
+                });
+                test::putDescribed (data_, "net.corda:L", [&](pn_data_t * data_) {
+                    test::putList (data_, [&](pn_data_t * data_) {
+                        for (auto i : v_.list) pn_data_put_int (data_, i);
+                    });
+                });
+                test::putDescribed (data_, "net.corda:M", [&](pn_data_t * data_) {
+                    test::putMap (data_, [&](pn_data_t * data_) {
+                        for (const auto & e : v_.map) {
+                            test::putString (data_, e.first);
+                            pn_data_put_int (data_, e.second);
+                        }
+                    });
+                });
+            });
+        });
+    }
+
+    std::vector<Difference>
+    compare (const std::vector<char> & from_, const std::vector<char> & to_) {
+        return diff (from_.data(), from_.size(), to_.data(), to_.size());
+    }
+
+    std::string
+    str (const std::vector<Difference> & differences_) {
+        std::string rtn;
+
+        for (const auto & d : differences_) {
+            rtn += d.path + " : " + d.from.value_or ("-")
+                + " -> " + d.to.value_or ("-") + "\n";
+        }
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Diff, identical) { // NOLINT
+    Values v;
+
+    EXPECT_TRUE (compare (blob (v), blob (v)).empty());
+}
+
+/******************************************************************************/
+
+TEST (Diff, primitives) { // NOLINT
+    Values v1, v2;
+    v2.a = 2;
+    v2.s = "world";
+
+    EXPECT_EQ ("a : 1 -> 2\ns : \"hello\" -> \"world\"\n", str (compare (blob (v1), blob (v2))));
+}
+
+/******************************************************************************/
+
+TEST (Diff, nested) { // NOLINT
+    Values v1, v2;
+    v2.l = 11;
+
+    EXPECT_EQ ("b.l : 10 -> 11\n", str (compare (blob (v1), blob (v2))));
+}
+
+/******************************************************************************/
+
+TEST (Diff, lists) { // NOLINT
+    Values v1, v2;
+    v2.list = { 1, 5, 3, 4 };
+
+    EXPECT_EQ ("l[1] : 2 -> 5\nl[3] : - -> 4\n", str (compare (blob (v1), blob (v2))));
+    EXPECT_EQ ("l[1] : 5 -> 2\nl[3] : 4 -> -\n", str (compare (blob (v2), blob (v1))));
+}
+
+/******************************************************************************/
+
+/**
+ * Entries are matched on their keys, not their position
+ */
+TEST (Diff, maps) { // NOLINT
+    Values v1, v2;
+    v2.map = { { "y", 3 }, { "z", 4 } };
+
+    EXPECT_EQ (
+        "m[\"x\"] : 1 -> -\nm[\"y\"] : 2 -> 3\nm[\"z\"] : - -> 4\n",
+        str (compare (blob (v1), blob (v2))));
+}
+
+/******************************************************************************/
+
+/**
+ * Between two versions of a type fields are matched by name
+ */
+TEST (Diff, versions) { // NOLINT
+    test::BlobBuilder bb1, bb2;
+
+    bb1.composite ("net.corda.A", "net.corda:A1", {
+        { "a", "int" },
+        { "b", "string" } });
+
+    bb2.composite ("net.corda.A", "net.corda:A2", {
+        { "c", "long" },
+        { "a", "int" } });
+
+    auto b1 = bb1.build ("net.corda:A1", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t * data_) {
+            pn_data_put_int (data_, 1);
+            test::putString (data_, "gone");
+        });
+    });
+
+    auto b2 = bb2.build ("net.corda:A2", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t * data_) {
+            pn_data_put_long (data_, 7);
+            pn_data_put_int (data_, 2);
+        });
+    });
+
+    EXPECT_EQ (
+        "a : 1 -> 2\nb : \"gone\" -> -\nc : - -> 7\n",
+        str (compare (b1, b2)));
+}
+
+/******************************************************************************/
+
+TEST (Diff, malformed) { // NOLINT
+    Values v;
+    auto b = blob (v);
+    auto truncated = std::vector<char> (b.begin(), b.begin() + b.size() / 2);
+
+    EXPECT_THROW (compare (b, truncated), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * Fields typed as an interface, or as "*", are compared as whichever
+ * implementation each side holds, different ones matching their fields
+ * by name just as different versions of a type do
+ */
+TEST (Diff, interface) { // NOLINT
+    test::BlobBuilder bb;
+    bb.composite ("net.corda.Alice", "net.corda:Alice", { { "name", "string" } });
+    bb.composite ("net.corda.Bob", "net.corda:Bob", { { "age", "int" } });
+    bb.composite ("net.corda.A", "net.corda:A", {
+        { "a", "net.corda.Party" },
+        { "s", "*", { "net.corda.Party" } } });
+
+    auto build = [&](const std::string & name_, bool bob_) {
+        return bb.build ("net.corda:A", [&](pn_data_t * data_) {
+            test::putList (data_, [&](pn_data_t * data_) {
+                test::putDescribed (data_, "net.corda:Alice", [&](pn_data_t * data_) {
+                    test::putList (data_, [&](pn_data_t * data_) {
+                        test::putString (data_, name_);
+                    });
+                });
+
+                if (bob_) {
+                    test::putDescribed (data_, "net.corda:Bob", [](pn_data_t * data_) {
+                        test::putList (data_, [](pn_data_t * data_) {
+                            pn_data_put_int (data_, 42);
+                        });
+                    });
+                } else {
+                    test::putDescribed (data_, "net.corda:Alice", [](pn_data_t * data_) {
+                        test::putList (data_, [](pn_data_t * data_) {
+                            test::putString (data_, "Carol");
+                        });
+                    });
+                }
+            });
+        });
+    };
+
+    EXPECT_TRUE (compare (build ("Alice", true), build ("Alice", true)).empty());
+
+    EXPECT_EQ (
+        "a.name : \"Alice\" -> \"Dave\"\n",
+        str (compare (build ("Alice", true), build ("Dave", true))));
+
+    EXPECT_EQ (
+        "s.age : 42 -> -\ns.name : - -> \"Carol\"\n",
+        str (compare (build ("Alice", true), build ("Alice", false))));
+}
+
+/******************************************************************************/
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <proton/codec.h>
+
+#include "TestUtils.h"
+
+#include "test-utils/BlobBuilder.h"
+
+/******************************************************************************
+ *
+ * Fields whose type is an interface, or "*", are read as whatever the
+ * descriptor written with each value says they are
+ *
+ ******************************************************************************/
+
+namespace {
+
+    const std::vector<std::string> parties {
+        "Alice", "Bob", "Carol", "Dave", "Eve", "Frank" };
+
+    /**
+     * Each party is its own implementation of net.corda.Party, more of
+     * them than a field site will cache
+     */
+    test::BlobBuilder
+    builder() {
+        test::BlobBuilder bb;
+
+        for (const auto & party : parties) {
+            bb.composite (
+                "net.corda." + party,
+                "net.corda:" + party,
+                { { "name", "string" } },
+                { "net.corda.Party" });
+        }
+
+        bb.restricted (
+            "java.util.List<net.corda.Party>",
+            "net.corda:LP",
+            "list");
+
+        bb.composite ("net.corda.A", "net.corda:A", {
+            { "a", "net.corda.Party" },
+            { "b", "*", { "net.corda.Party" } },
+            { "c", "java.util.List<net.corda.Party>" } });
+
+        return bb;
+    }
+
+    void
+    putParty (pn_data_t * data_, const std::string & party_) {
+        test::putDescribed (data_, "net.corda:" + party_, [&](pn_data_t * data_) {
+            test::putList (data_, [&](pn_data_t * data_) {
+                test::putString (data_, party_);
+            });
+        });
+    }
+
+    std::string
+    party (const std::string & party_) {
+        return "{ \"name\" : \"" + party_ + "\" }";
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Dispatch, fields) { // NOLINT
+    auto blob = builder().build ("net.corda:A", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t * data_) {
+            putParty (data_, "Alice");
+            putParty (data_, "Bob");
+            test::putDescribed (data_, "net.corda:LP", [](pn_data_t * data_) {
+                test::putList (data_, [](pn_data_t *) { });
+            });
+        });
+    });
+
+    EXPECT_EQ (
+        "Parsed : { \"a\" : " + party ("Alice")
+            + ", \"b\" : " + party ("Bob")
+            + ", \"c\" : [  ] }",
+        test::Blob (blob).dump());
+}
+
+/******************************************************************************/
+
+/**
+ * A list of parties sees every one of them, the first few from the
+ * site's cache and the rest from the factory's table
+ */
+TEST (Dispatch, megamorphic) { // NOLINT
+    auto blob = builder().build ("net.corda:A", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t * data_) {
+            putParty (data_, "Alice");
+            putParty (data_, "Alice");
+            test::putDescribed (data_, "net.corda:LP", [](pn_data_t * data_) {
+                test::putList (data_, [](pn_data_t * data_) {
+                    for (int i { 0 } ; i < 2 ; ++i) {
+                        for (const auto & p : parties) putParty (data_, p);
+                    }
+                });
+            });
+        });
+    });
+
+    std::string list;
+
+    for (int i { 0 } ; i < 2 ; ++i) {
+        for (const auto & p : parties) {
+            list += (list.empty() ? "" : ", ") + party (p);
+        }
+    }
+
+    EXPECT_EQ (
+        "Parsed : { \"a\" : " + party ("Alice")
+            + ", \"b\" : " + party ("Alice")
+            + ", \"c\" : [ " + list + " ] }",
+        test::Blob (blob).dump());
+}
+
+/******************************************************************************/
+
+TEST (Dispatch, unknown) { // NOLINT
+    auto blob = builder().build ("net.corda:A", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t * data_) {
+            putParty (data_, "Mallory");
+            putParty (data_, "Bob");
+            test::putDescribed (data_, "net.corda:LP", [](pn_data_t * data_) {
+                test::putList (data_, [](pn_data_t *) { });
+            });
+        });
+    });
+
+    EXPECT_THROW (test::Blob (blob).dump(), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
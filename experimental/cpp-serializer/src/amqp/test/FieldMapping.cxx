@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+
+#include <proton/codec.h>
+
+#include "TestUtils.h"
+
+#include "amqp/Mappings.h"
+#include "amqp/CompositeFactory.h"
+
+#include "test-utils/BlobBuilder.h"
+
+/******************************************************************************
+ *
+ * Reading composites written by one version of a class as another
+ *
+ ******************************************************************************/
+
+namespace {
+
+    /**
+     * A class net.corda.A whose fields are [fields_] and values, all
+     * ints, are [values_]
+     */
+    std::vector<char>
+    blob (
+        const std::string & fingerprint_,
+        const std::vector<test::FieldDef> & fields_,
+        const std::vector<int> & values_
+    ) {
+        test::BlobBuilder bb;
+
+        bb.composite ("net.corda.A", fingerprint_, fields_);
+
+        return bb.build (fingerprint_, [&values_](pn_data_t * data_) {
+            test::putList (data_, [&values_](pn_data_t * data_) {
+                for (auto v : values_) {
+                    pn_data_put_int (data_, v);
+                }
+            });
+        });
+    }
+
+    std::string
+    dumpAs (const std::vector<char> & blob_, const std::vector<char> & expected_) {
+        test::Blob expected (expected_);
+        test::Blob blob (blob_);
+
+        amqp::internal::CompositeFactory cf;
+        cf.expect (expected.envelope().schema(), expected.envelope().transforms());
+
+        return blob.dump (cf);
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (FieldMapping, unchanged) { // NOLINT
+    auto v1 = blob ("net.corda:1", { { "a", "int" }, { "b", "int" } }, { 1, 2 });
+
+    EXPECT_EQ (R"(Parsed : { "a" : 1, "b" : 2 })", dumpAs (v1, v1));
+}
+
+/******************************************************************************/
+
+TEST (FieldMapping, reordered) { // NOLINT
+    auto v1 = blob ("net.corda:1", { { "a", "int" }, { "b", "int" } }, { 1, 2 });
+    auto v2 = blob ("net.corda:2", { { "b", "int" }, { "a", "int" } }, { });
+
+    EXPECT_EQ (R"(Parsed : { "b" : 2, "a" : 1 })", dumpAs (v1, v2));
+}
+
+/******************************************************************************/
+
+/**
+ * The newer version added a nullable c and a primitive d
+ */
+TEST (FieldMapping, added) { // NOLINT
+    test::BlobBuilder bb;
+    bb.composite ("net.corda.A", "net.corda:2", {
+        { "a", "int" },
+        { "c", "string", { }, false },
+        { "d", "int" } });
+
+    auto v1 = blob ("net.corda:1", { { "a", "int" } }, { 1 });
+    auto v2 = bb.build ("net.corda:2", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t *) { });
+    });
+
+    EXPECT_THROW (dumpAs (v1, v2), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (FieldMapping, addedNullable) { // NOLINT
+    test::BlobBuilder bb;
+    bb.composite ("net.corda.A", "net.corda:2", {
+        { "a", "int" },
+        { "c", "string", { }, false } });
+
+    auto v1 = blob ("net.corda:1", { { "a", "int" } }, { 1 });
+    auto v2 = bb.build ("net.corda:2", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t *) { });
+    });
+
+    EXPECT_EQ (R"(Parsed : { "a" : 1, "c" : null })", dumpAs (v1, v2));
+}
+
+/******************************************************************************/
+
+/**
+ * Reading something newer, b has since been removed
+ */
+TEST (FieldMapping, removed) { // NOLINT
+    auto v2 = blob ("net.corda:2", { { "a", "int" }, { "b", "int" }, { "c", "int" } }, { 1, 2, 3 });
+    auto v1 = blob ("net.corda:1", { { "a", "int" }, { "c", "int" } }, { });
+
+    EXPECT_EQ (R"(Parsed : { "a" : 1, "c" : 3 })", dumpAs (v2, v1));
+}
+
+/******************************************************************************/
+
+TEST (FieldMapping, typeChanged) { // NOLINT
+    auto v1 = blob ("net.corda:1", { { "a", "int" } }, { 1 });
+    auto v2 = blob ("net.corda:2", { { "a", "long" } }, { });
+
+    EXPECT_THROW (dumpAs (v1, v2), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * An evolved class nested in a list inside an unchanged one, the same
+ * mapping serves every element
+ */
+TEST (FieldMapping, nested) { // NOLINT
+    auto make = [](
+        const std::string & fingerprint_,
+        const std::vector<test::FieldDef> & fields_,
+        const std::vector<std::vector<int>> & values_
+    ) {
+        test::BlobBuilder bb;
+
+        bb.composite ("net.corda.O", "net.corda:O", {
+            { "l", "*", { "java.util.List<net.corda.A>" } } });
+        bb.restricted ("java.util.List<net.corda.A>", "net.corda:LA", "list");
+        bb.composite ("net.corda.A", fingerprint_, fields_);
+
+        return bb.build ("net.corda:O", [&](pn_data_t * data_) {
+            test::putList (data_, [&](pn_data_t * data_) {
+                test::putDescribed (data_, "net.corda:LA", [&](pn_data_t * data_) {
+                    test::putList (data_, [&](pn_data_t * data_) {
+                        for (const auto & v : values_) {
+                            test::putDescribed (data_, fingerprint_, [&v](pn_data_t * data_) {
+                                test::putList (data_, [&v](pn_data_t * data_) {
+                                    for (auto i : v) pn_data_put_int (data_, i);
+                                });
+                            });
+                        }
+                    });
+                });
+            });
+        });
+    };
+
+    auto v1 = make ("net.corda:1", { { "a", "int" }, { "b", "int" } }, { { 1, 2 }, { 3, 4 } });
+    auto v2 = make ("net.corda:2", { { "b", "int" } }, { });
+
+    EXPECT_EQ (R"(Parsed : { "l" : [ { "b" : 2 }, { "b" : 4 } ] })", dumpAs (v1, v2));
+}
+
+/******************************************************************************/
+
+/**
+ * Factories sharing their mappings compile one per pair of versions, the
+ * blobs after the first reusing it
+ */
+TEST (FieldMapping, shared) { // NOLINT
+    auto v2 = blob ("net.corda:2", { { "b", "int" } }, { });
+    auto v3 = blob ("net.corda:3", { { "b", "int" }, { "a", "int" } }, { });
+
+    test::Blob expected2 (v2);
+    test::Blob expected3 (v3);
+
+    auto mappings = std::make_shared<amqp::internal::Mappings>();
+
+    auto dump = [&](int a_, test::Blob & expected_) {
+        test::Blob b (blob ("net.corda:1", { { "a", "int" }, { "b", "int" } }, { a_, 2 }));
+
+        amqp::internal::CompositeFactory cf;
+        cf.share (mappings);
+        cf.expect (expected_.envelope().schema(), expected_.envelope().transforms());
+
+        return b.dump (cf);
+    };
+
+    EXPECT_EQ (R"(Parsed : { "b" : 2 })", dump (1, expected2));
+
+    auto mapping = mappings->fieldMapping ("net.corda:1", "net.corda:2");
+    ASSERT_TRUE (mapping);
+
+    EXPECT_EQ (R"(Parsed : { "b" : 2 })", dump (5, expected2));
+    EXPECT_EQ (mapping, mappings->fieldMapping ("net.corda:1", "net.corda:2"));
+    EXPECT_EQ (1U, mappings->size());
+
+    // another version read as gets a mapping of its own
+    EXPECT_EQ (R"(Parsed : { "b" : 2, "a" : 7 })", dump (7, expected3));
+    EXPECT_EQ (2U, mappings->size());
+}
+
+/******************************************************************************/
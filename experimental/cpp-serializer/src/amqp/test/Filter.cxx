@@ -0,0 +1,339 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include <proton/codec.h>
+
+#include "filter/Query.h"
+#include "filter/Expression.h"
+
+#include "test-utils/BlobBuilder.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::filter;
+
+/******************************************************************************
+ *
+ * Parsing Tests
+ *
+ ******************************************************************************/
+
+TEST (Filter, parseComparison) { // NOLINT
+    auto e = Expression::parse ("amount.quantity >= 10");
+
+    ASSERT_TRUE (e->comparison());
+    EXPECT_EQ (Expression::Op::ge_t, e->op());
+    EXPECT_EQ ((std::vector<std::string> { "amount", "quantity" }), e->path());
+    ASSERT_EQ (1, e->literals().size());
+    EXPECT_EQ (Literal::Kind::int_t, e->literals()[0].kind);
+    EXPECT_EQ (10, e->literals()[0].i);
+}
+
+/******************************************************************************/
+
+/**
+ * && binds tighter than ||
+ */
+TEST (Filter, parsePrecedence) { // NOLINT
+    auto e = Expression::parse ("a == 1 || b == 2 && !c");
+
+    ASSERT_EQ (Expression::Op::or_t, e->op());
+    ASSERT_EQ (2, e->children().size());
+    EXPECT_EQ (Expression::Op::eq_t, e->children()[0]->op());
+
+    const auto & rhs = *e->children()[1];
+
+    ASSERT_EQ (Expression::Op::and_t, rhs.op());
+    EXPECT_EQ (Expression::Op::not_t, rhs.children()[1]->op());
+
+    // a bare path is a test for true
+    const auto & c = *rhs.children()[1]->children()[0];
+
+    EXPECT_EQ (Expression::Op::eq_t, c.op());
+    EXPECT_EQ (Literal::Kind::bool_t, c.literals()[0].kind);
+    EXPECT_TRUE (c.literals()[0].b);
+}
+
+/******************************************************************************/
+
+TEST (Filter, parseLiterals) { // NOLINT
+    auto e = Expression::parse ("s in ['a\\'b', \"c\", -1.5, null, false]");
+
+    ASSERT_EQ (Expression::Op::in_t, e->op());
+
+    const auto & l = e->literals();
+
+    ASSERT_EQ (5, l.size());
+    EXPECT_EQ ("a'b", l[0].s);
+    EXPECT_EQ ("c", l[1].s);
+    EXPECT_EQ (Literal::Kind::double_t, l[2].kind);
+    EXPECT_DOUBLE_EQ (-1.5, l[2].d);
+    EXPECT_EQ (Literal::Kind::null_t, l[3].kind);
+    EXPECT_EQ (Literal::Kind::bool_t, l[4].kind);
+    EXPECT_FALSE (l[4].b);
+}
+
+/******************************************************************************/
+
+TEST (Filter, parseErrors) { // NOLINT
+    for (const auto & bad : {
+        "", "a ==", "a == 'x", "(a == 1", "a == 1 b", "a in [1, ]", "== 1", "a.", "a andb" })
+    {
+        EXPECT_THROW (Expression::parse (bad), std::runtime_error) << bad; // NOLINT
+    }
+
+    EXPECT_NO_THROW (Expression::parse ("a and b or not c")); // NOLINT
+}
+
+/******************************************************************************
+ *
+ * Matching Tests
+ *
+ ******************************************************************************/
+
+namespace {
+
+    /**
+     * An A with an int, a nullable string, a B and an enum, a B being a
+     * long and a double
+     */
+    std::vector<char>
+    blob (int a_, const char * s_, bool b_ = true) {
+        test::BlobBuilder bb;
+
+        bb.composite ("net.corda.B", "net.corda:B", {
+            { "l", "long" },
+            { "d", "double" } });
+        bb.restricted ("net.corda.E", "net.corda:E", "list", { "X", "Y", "Z" });
+        bb.composite ("net.corda.A", "net.corda:A", {
+            { "a", "int" },
+            { "s", "string", { }, false },
+            { "b", "net.corda.B", { }, false },
+            { "e", "net.corda.E" } });
+
+        return bb.build ("net.corda:A", [=](pn_data_t * data_) {
+            test::putList (data_, [=](pn_data_t * data_) {
+                pn_data_put_int (data_, a_);
+
+                if (s_) {
+                    test::putString (data_, s_);
+                } else {
+                    pn_data_put_null (data_);
+                }
+
+                if (b_) {
+                    test::putDescribed (data_, "net.corda:B", [](pn_data_t * data_) {
+                        test::putList (data_, [](pn_data_t * data_) {
+                            pn_data_put_long (data_, 1000000000000L);
+                            pn_data_put_double (data_, 2.5);
+                        });
+                    });
+                } else {
+                    pn_data_put_null (data_);
+                }
+
+                test::putEnum (data_, "net.corda:E", "Y", 1);
+            });
+        });
+    }
+
+    bool
+    matches (const std::string & expression_, const std::vector<char> & blob_) {
+        std::vector<uPtr<Expression>> e;
+        e.push_back (Expression::parse (expression_));
+
+        return match (e, blob_.data(), blob_.size())[0];
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Filter, primitives) { // NOLINT
+    auto b = blob (10, "hello");
+
+    EXPECT_TRUE (matches ("a == 10", b));
+    EXPECT_TRUE (matches ("a != 11", b));
+    EXPECT_TRUE (matches ("a > 9.5", b));
+    EXPECT_FALSE (matches ("a < 10", b));
+    EXPECT_TRUE (matches ("s == 'hello'", b));
+    EXPECT_TRUE (matches ("s > 'hell'", b));
+    EXPECT_FALSE (matches ("s == 10", b));
+}
+
+/******************************************************************************/
+
+TEST (Filter, nested) { // NOLINT
+    auto b = blob (10, "hello");
+
+    EXPECT_TRUE (matches ("b.l > 999999999999", b));
+    EXPECT_TRUE (matches ("b.d == 2.5 && b.l >= 1", b));
+    EXPECT_FALSE (matches ("b.d > 3", b));
+}
+
+/******************************************************************************/
+
+TEST (Filter, enums) { // NOLINT
+    auto b = blob (10, "hello");
+
+    EXPECT_TRUE (matches ("e == 'Y'", b));
+    EXPECT_TRUE (matches ("e in ['X', 'Y']", b));
+    EXPECT_FALSE (matches ("e in ['X', 'Z']", b));
+}
+
+/******************************************************************************/
+
+TEST (Filter, nulls) { // NOLINT
+    auto b = blob (10, nullptr, false);
+
+    EXPECT_TRUE (matches ("s == null", b));
+    EXPECT_FALSE (matches ("s == 'hello'", b));
+    EXPECT_TRUE (matches ("s != 'hello'", b));
+    EXPECT_FALSE (matches ("s > 'a'", b));
+    EXPECT_TRUE (matches ("b.l == null", b));
+    EXPECT_TRUE (matches ("!(b.d > 1)", b));
+}
+
+/******************************************************************************/
+
+/**
+ * Paths the schema doesn't have behave as nulls
+ */
+TEST (Filter, missing) { // NOLINT
+    auto b = blob (10, "hello");
+
+    EXPECT_TRUE (matches ("nope == null", b));
+    EXPECT_FALSE (matches ("nope == 1", b));
+    EXPECT_FALSE (matches ("a.b == 1", b));
+    EXPECT_FALSE (matches ("b == 1", b));
+    EXPECT_TRUE (matches ("nope == 1 || a == 10", b));
+}
+
+/******************************************************************************/
+
+TEST (Filter, several) { // NOLINT
+    std::vector<uPtr<Expression>> e;
+    e.push_back (Expression::parse ("a == 10"));
+    e.push_back (Expression::parse ("a == 11"));
+    e.push_back (Expression::parse ("b.d == 2.5 && e == 'Y'"));
+
+    auto b = blob (10, "hello");
+
+    EXPECT_EQ ((std::vector<bool> { true, false, true }), match (e, b.data(), b.size()));
+}
+
+/******************************************************************************/
+
+/**
+ * Once a is known to be 10 the rest of the blob is never looked at, so
+ * garbage where the enum should be goes unnoticed
+ */
+TEST (Filter, earlyExit) { // NOLINT
+    auto b = blob (10, "hello");
+
+    // the enum's ordinal follows its name, give it an invalid constructor
+    const char name[] { '\xa1', '\x01', 'Y' };
+
+    auto payload = std::search (b.begin(), b.end(), name, name + sizeof (name));
+    ASSERT_NE (b.end(), payload);
+    *(payload + sizeof (name)) = '\xff';
+
+    EXPECT_TRUE (matches ("a == 10 || e == 'X'", b));
+    EXPECT_THROW (matches ("a == 11 || e == 'X'", b), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * Blobs sharing a schema share the expressions compiled against it
+ */
+TEST (Filter, matcher) { // NOLINT
+    std::vector<uPtr<Expression>> e;
+    e.push_back (Expression::parse ("a == 10"));
+
+    amqp::internal::filter::Matcher m (e);
+
+    auto b1 = blob (10, "hello");
+    auto b2 = blob (11, "hello");
+
+    EXPECT_EQ ((std::vector<bool> { true }), m (b1.data(), b1.size()));
+    EXPECT_EQ ((std::vector<bool> { false }), m (b2.data(), b2.size()));
+    EXPECT_EQ ((std::vector<bool> { true }), m (b1.data(), b1.size()));
+    EXPECT_EQ (1U, m.compiled());
+}
+
+/******************************************************************************/
+
+/**
+ * Binary fields compare against literals of hex, in either case
+ */
+TEST (Filter, binary) { // NOLINT
+    test::BlobBuilder bb;
+    bb.composite ("net.corda.A", "net.corda:A", { { "b", "binary" } });
+
+    std::string bytes (64, '\xab');
+
+    auto b = bb.build ("net.corda:A", [&](pn_data_t * data_) {
+        test::putList (data_, [&](pn_data_t * data_) {
+            pn_data_put_binary (data_, pn_bytes (bytes.size(), bytes.data()));
+        });
+    });
+
+    std::string upper, lower;
+
+    for (int i { 0 } ; i < 64 ; ++i) {
+        upper += "AB";
+        lower += "ab";
+    }
+
+    EXPECT_TRUE (matches ("b == \"" + upper + "\"", b));
+    EXPECT_FALSE (matches ("b != \"" + upper + "\"", b));
+    EXPECT_TRUE (matches ("b == \"" + lower + "\"", b));
+    EXPECT_FALSE (matches ("b == \"" + upper.substr (2) + "\"", b));
+    EXPECT_FALSE (matches ("b == \"not hex\"", b));
+    EXPECT_TRUE (matches ("b > \"AB\"", b));
+}
+
+/******************************************************************************/
+
+/**
+ * Paths through a field typed as an interface, or as "*", are followed
+ * into whichever implementation the value turns out to be
+ */
+TEST (Filter, interface) { // NOLINT
+    test::BlobBuilder bb;
+    bb.composite ("net.corda.Alice", "net.corda:Alice", { { "name", "string" } });
+    bb.composite ("net.corda.Bob", "net.corda:Bob", { { "age", "int" } });
+    bb.composite ("net.corda.A", "net.corda:A", {
+        { "a", "net.corda.Party" },
+        { "s", "*", { "net.corda.Party" } } });
+
+    auto b = bb.build ("net.corda:A", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t * data_) {
+            test::putDescribed (data_, "net.corda:Alice", [](pn_data_t * data_) {
+                test::putList (data_, [](pn_data_t * data_) {
+                    test::putString (data_, "Alice");
+                });
+            });
+            test::putDescribed (data_, "net.corda:Bob", [](pn_data_t * data_) {
+                test::putList (data_, [](pn_data_t * data_) {
+                    pn_data_put_int (data_, 42);
+                });
+            });
+        });
+    });
+
+    EXPECT_TRUE (matches ("a.name == 'Alice'", b));
+    EXPECT_FALSE (matches ("a.name == 'Bob'", b));
+    EXPECT_TRUE (matches ("s.age > 40", b));
+    EXPECT_TRUE (matches ("a.name == 'Alice' && s.age == 42", b));
+
+    // a field only some other implementation has is null in this one
+    EXPECT_TRUE (matches ("a.age == null", b));
+    EXPECT_TRUE (matches ("s.name == null", b));
+    EXPECT_FALSE (matches ("s.name == 'Alice'", b));
+    EXPECT_TRUE (matches ("a.nope == null", b));
+}
+
+/******************************************************************************/
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <functional>
+
+#include <proton/codec.h>
+
+#include "amqp/schema/Descriptors.h"
+#include "amqp/schema/descriptors/Grammar.h"
+#include "amqp/schema/field-types/Field.h"
+#include "amqp/schema/described-types/Composite.h"
+
+#include "test-utils/BlobBuilder.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::schema;
+
+/******************************************************************************/
+
+namespace {
+
+    using Writer = std::function<void (pn_data_t *)>;
+
+    void
+    section (pn_data_t * data_, uint64_t id_, const Writer & f_) {
+        pn_data_put_described (data_);
+        pn_data_enter (data_);
+        pn_data_put_ulong (data_, id_ | amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS);
+        test::putList (data_, f_);
+        pn_data_exit (data_);
+    }
+
+    void
+    object (pn_data_t * data_, const std::string & name_) {
+        section (data_, 3, [&](pn_data_t * data_) {
+            test::putSymbol (data_, name_);
+            pn_data_put_null (data_);
+        });
+    }
+
+    void
+    field (pn_data_t * data_, const std::string & name_) {
+        section (data_, 4, [&](pn_data_t * data_) {
+            test::putString (data_, name_);
+            test::putString (data_, "int");
+            test::putList (data_, [](pn_data_t *) { });
+            pn_data_put_null (data_);
+            pn_data_put_null (data_);
+            pn_data_put_bool (data_, true);
+            pn_data_put_bool (data_, false);
+        });
+    }
+
+    /**
+     * A composite written by [f_], with the data rewound to it
+     */
+    struct Data {
+        pn_data_t * data;
+
+        explicit Data (const Writer & f_) : data (pn_data (0)) {
+            f_ (data);
+            pn_data_rewind (data);
+            pn_data_next (data);
+        }
+
+        Data (const Data &) = delete;
+
+        ~Data() { pn_data_free (data); }
+    };
+
+    Writer
+    composite (const Writer & descriptor_) {
+        return [descriptor_](pn_data_t * data_) {
+            section (data_, 5, [&](pn_data_t * data_) {
+                test::putString (data_, "net.corda.A");
+                pn_data_put_null (data_);
+                test::putList (data_, [](pn_data_t *) { });
+                descriptor_ (data_);
+                test::putList (data_, [](pn_data_t * data_) {
+                    field (data_, "a");
+                    field (data_, "b");
+                });
+            });
+        };
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Grammar, build) { // NOLINT
+    Data d (composite ([](pn_data_t * data_) { object (data_, "net.corda:A"); }));
+
+    auto built = descriptors::grammar::build (d.data);
+    auto * c = dynamic_cast<Composite *>(built.get());
+
+    ASSERT_NE (nullptr, c);
+    EXPECT_EQ ("net.corda.A", c->name());
+    EXPECT_EQ ("net.corda:A", c->descriptor());
+    ASSERT_EQ (2U, c->fields().size());
+    EXPECT_EQ ("a", c->fields()[0]->name());
+    EXPECT_EQ ("b", c->fields()[1]->name());
+    EXPECT_TRUE (c->fields()[1]->mandatory());
+}
+
+/******************************************************************************/
+
+/**
+ * A nested section has to be the one the grammar says goes there
+ */
+TEST (Grammar, wrongSection) { // NOLINT
+    Data d (composite ([](pn_data_t * data_) { field (data_, "x"); }));
+
+    EXPECT_THROW (descriptors::grammar::build (d.data), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * Only nullable elements can be left off the end of a section and
+ * anything added after those we know about is ignored
+ */
+TEST (Grammar, shortAndLong) { // NOLINT
+    Data shortObject ([](pn_data_t * data_) {
+        section (data_, 3, [](pn_data_t * data_) {
+            test::putSymbol (data_, "net.corda:A");
+        });
+    });
+
+    EXPECT_NO_THROW (descriptors::grammar::build (shortObject.data)); // NOLINT
+
+    Data shortField ([](pn_data_t * data_) {
+        section (data_, 4, [](pn_data_t * data_) {
+            test::putString (data_, "a");
+            test::putString (data_, "int");
+        });
+    });
+
+    EXPECT_THROW (descriptors::grammar::build (shortField.data), std::runtime_error); // NOLINT
+
+    Data longChoice ([](pn_data_t * data_) {
+        section (data_, 7, [](pn_data_t * data_) {
+            test::putString (data_, "A");
+            test::putString (data_, "something newer");
+        });
+    });
+
+    EXPECT_NO_THROW (descriptors::grammar::build (longChoice.data)); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Grammar, dump) { // NOLINT
+    Data d (composite ([](pn_data_t * data_) { object (data_, "net.corda:A"); }));
+
+    std::stringstream ss;
+    descriptors::grammar::dump (d.data, ss, descriptors::AutoIndent());
+
+    auto dump = ss.str();
+
+    EXPECT_NE (std::string::npos, dump.find ("1/5] String: ClassName: net.corda.A\n")) << dump;
+    EXPECT_NE (std::string::npos, dump.find ("1/2] Symbol: Name: net.corda:A\n")) << dump;
+    EXPECT_NE (std::string::npos, dump.find ("5/5] List: Fields: elements 2\n")) << dump;
+    EXPECT_NE (std::string::npos, dump.find ("6/7] Boolean: Mandatory: 1\n")) << dump;
+}
+
+/******************************************************************************/
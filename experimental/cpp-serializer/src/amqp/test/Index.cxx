@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <cmath>
+
+#include <proton/codec.h>
+
+#include "index/Keys.h"
+#include "index/Extractor.h"
+
+#include "test-utils/BlobBuilder.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::index;
+using amqp::internal::filter::Expression;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * An A holding an int, a nullable double, an enum, a nested B and an
+     * interface typed owner
+     */
+    std::vector<char>
+    blob (int a_, std::optional<double> d_, const std::string & owner_) {
+        test::BlobBuilder bb;
+
+        bb.restricted ("net.corda.E", "net.corda:E", "list", { "X", "Y" });
+        bb.composite ("net.corda.B", "net.corda:B", { { "id", "string" } });
+        bb.composite (
+            "net.corda.Alice", "net.corda:Alice", { { "name", "string" } }, { "net.corda.Party" });
+        bb.composite ("net.corda.A", "net.corda:A", {
+            { "a", "int" },
+            { "d", "double", { }, false },
+            { "e", "net.corda.E" },
+            { "inner", "net.corda.B" },
+            { "owner", "*", { "net.corda.Party" } } });
+
+        return bb.build ("net.corda:A", [&](pn_data_t * data_) {
+            test::putList (data_, [&](pn_data_t * data_) {
+                pn_data_put_int (data_, a_);
+
+                if (d_) {
+                    pn_data_put_double (data_, *d_);
+                } else {
+                    pn_data_put_null (data_);
+                }
+
+                test::putEnum (data_, "net.corda:E", "Y", 1);
+                test::putDescribed (data_, "net.corda:B", [](pn_data_t * data_) {
+                    test::putList (data_, [](pn_data_t * data_) {
+                        test::putString (data_, "linear-1");
+                    });
+                });
+                test::putDescribed (data_, "net.corda:Alice", [&](pn_data_t * data_) {
+                    test::putList (data_, [&](pn_data_t * data_) {
+                        test::putString (data_, owner_);
+                    });
+                });
+            });
+        });
+    }
+
+    std::map<size_t, std::string>
+    extract (Extractor & extractor_, const std::vector<char> & blob_) {
+        std::map<size_t, std::string> rtn;
+
+        extractor_.extract (blob_.data(), blob_.size(), [&rtn](size_t path_, const std::string & key_) {
+            rtn[path_] = key_;
+        });
+
+        return rtn;
+    }
+
+    /**
+     * Whether [key_] falls in any of [ranges_]
+     */
+    bool
+    within (const std::vector<Range> & ranges_, const std::string & key_) {
+        for (const auto & r : ranges_) {
+            if ((r.fromInclusive ? key_ >= r.from : key_ > r.from)
+                && (r.toInclusive ? key_ <= r.to : key_ < r.to))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    std::vector<Range>
+    ranges (const std::string & expression_, const std::string & path_ = "a") {
+        auto [path, rtn] = amqp::internal::index::ranges (*Expression::parse (expression_));
+
+        EXPECT_EQ (path_, path);
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Keys compare as bytes in the order of the values they hold
+ */
+TEST (Keys, order) { // NOLINT
+    std::vector<int64_t> integers {
+        INT64_MIN, -1000000, -1, 0, 1, 255, 256, 1LL << 40, INT64_MAX };
+
+    for (size_t i { 1 } ; i < integers.size() ; ++i) {
+        EXPECT_LT (integer (integers[i - 1]), integer (integers[i]));
+    }
+
+    std::vector<double> reals {
+        -INFINITY, -1e300, -2.5, -1e-300, 0.0, 1e-300, 2.5, 1e300, INFINITY };
+
+    for (size_t i { 1 } ; i < reals.size() ; ++i) {
+        EXPECT_LT (real (reals[i - 1]), real (reals[i]));
+    }
+
+    EXPECT_EQ (real (0.0), real (-0.0));
+
+    EXPECT_LT (string ("a"), string ("ab"));
+    EXPECT_LT (string ("ab"), string ("b"));
+    EXPECT_LT (string ("z"), string ("\xc3\xa9"));
+    EXPECT_LT (boolean (false), boolean (true));
+
+    // kinds sort apart
+    EXPECT_NE (integer (1), real (1.0));
+    EXPECT_LT (integer (INT64_MAX), string (""));
+}
+
+/******************************************************************************/
+
+TEST (Keys, ranges) { // NOLINT
+    auto r = ranges ("a > 3 && a <= 10");
+
+    EXPECT_FALSE (within (r, integer (3)));
+    EXPECT_TRUE (within (r, integer (4)));
+    EXPECT_TRUE (within (r, integer (10)));
+    EXPECT_FALSE (within (r, integer (11)));
+    EXPECT_TRUE (within (r, real (3.5)));
+    EXPECT_FALSE (within (r, real (10.5)));
+    EXPECT_FALSE (within (r, string ("5")));
+
+    r = ranges ("a == 2");
+    EXPECT_TRUE (within (r, integer (2)));
+    EXPECT_TRUE (within (r, real (2.0)));
+    EXPECT_FALSE (within (r, integer (3)));
+
+    // no integer is 2.5, but plenty are below it
+    r = ranges ("a == 2.5");
+    EXPECT_EQ (1U, r.size());
+
+    r = ranges ("a < 2.5");
+    EXPECT_TRUE (within (r, integer (2)));
+    EXPECT_FALSE (within (r, integer (3)));
+    EXPECT_TRUE (within (r, integer (INT64_MIN)));
+
+    r = ranges ("x.y in ['p', 'q'] && x.y >= 'q'", "x.y");
+    EXPECT_FALSE (within (r, string ("p")));
+    EXPECT_TRUE (within (r, string ("q")));
+
+    r = ranges ("flagged", "flagged");
+    EXPECT_TRUE (within (r, boolean (true)));
+    EXPECT_FALSE (within (r, boolean (false)));
+
+    EXPECT_TRUE (ranges ("a > 3 && a < 2").empty());
+
+    for (auto e : { "a != 1", "a == null", "a > 1 || a < 0", "a > 1 && b < 2", "!a" }) {
+        EXPECT_THROW (amqp::internal::index::ranges (*Expression::parse (e)), std::runtime_error); // NOLINT
+    }
+}
+
+/******************************************************************************/
+
+TEST (Extractor, extract) { // NOLINT
+    Extractor extractor ({ "a", "d", "e", "inner.id", "owner.name", "missing", "a.b", "owner" });
+
+    auto keys = extract (extractor, blob (42, 1.5, "Alice"));
+
+    EXPECT_EQ (integer (42), keys[0]);
+    EXPECT_EQ (real (1.5), keys[1]);
+    EXPECT_EQ (string ("Y"), keys[2]);
+    EXPECT_EQ (string ("linear-1"), keys[3]);
+    EXPECT_EQ (string ("Alice"), keys[4]);
+    EXPECT_EQ (0U, keys.count (5));
+    EXPECT_EQ (0U, keys.count (6));
+
+    // anything else is keyed as its text
+    ASSERT_EQ (1U, keys.count (7));
+    EXPECT_NE (std::string::npos, keys[7].find ("\"Alice\""));
+
+    // nulls aren't indexed
+    keys = extract (extractor, blob (-1, std::nullopt, "Bob"));
+    EXPECT_EQ (0U, keys.count (1));
+    EXPECT_EQ (string ("Bob"), keys[4]);
+
+    EXPECT_THROW (Extractor ({ "a..b" }), std::runtime_error); // NOLINT
+    EXPECT_THROW (Extractor ({ "" }), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Extractor, malformed) { // NOLINT
+    auto b = blob (1, 1.0, "Alice");
+    b.resize (b.size() - 4);
+
+    Extractor extractor ({ "a" });
+
+    EXPECT_THROW (extract (extractor, b), amqp::internal::wire::Error); // NOLINT
+}
+
+/******************************************************************************/
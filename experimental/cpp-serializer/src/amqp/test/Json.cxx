@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <cstdlib>
+
+#include "json/Json.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+
+/******************************************************************************/
+
+TEST (Json, quote) { // NOLINT
+    EXPECT_EQ (R"("")", json::quote (""));
+    EXPECT_EQ (R"("plain")", json::quote ("plain"));
+    EXPECT_EQ (R"("a\"b\\c")", json::quote ("a\"b\\c"));
+    EXPECT_EQ (R"("\n\r\t\b\f")", json::quote ("\n\r\t\b\f"));
+    EXPECT_EQ (R"("\u0001\u001f")", json::quote (std::string ("\x01\x1f")));
+    EXPECT_EQ (R"("\u0000")", json::quote (std::string (1, '\0')));
+}
+
+/******************************************************************************/
+
+/**
+ * Long enough strings are scanned in blocks, make sure escapes are found
+ * wherever they fall relative to a block boundary and that bytes with
+ * the top bit set, the rest of a UTF-8 sequence, are left alone
+ */
+TEST (Json, quoteBlocks) { // NOLINT
+    for (size_t i { 0 } ; i < 40 ; ++i) {
+        std::string s (40, 'x');
+        s[i] = '"';
+
+        auto expected = "\"" + s.substr (0, i) + "\\\"" + s.substr (i + 1) + "\"";
+
+        EXPECT_EQ (expected, json::quote (s)) << i;
+    }
+
+    std::string utf8 { "\xc2\xa3\xe2\x82\xac 0123456789 \xf0\x9f\x98\x80" };
+
+    EXPECT_EQ ("\"" + utf8 + "\"", json::quote (utf8));
+}
+
+/******************************************************************************/
+
+TEST (Json, integers) { // NOLINT
+    EXPECT_EQ ("0", json::number (int64_t { 0 }));
+    EXPECT_EQ ("-42", json::number (-42));
+    EXPECT_EQ (
+        "-9223372036854775808",
+        json::number (std::numeric_limits<int64_t>::min()));
+}
+
+/******************************************************************************/
+
+/**
+ * Doubles are written as briefly as possible while still reading back
+ * as exactly the same value
+ */
+TEST (Json, doubles) { // NOLINT
+    EXPECT_EQ ("10", json::number (10.0));
+    EXPECT_EQ ("10.1", json::number (10.1));
+    EXPECT_EQ ("0.1", json::number (0.1));
+    EXPECT_EQ ("1e+100", json::number (1e100));
+
+    for (double d : { 0.1 + 0.2, 1.0 / 3.0, 5e-324, 1.7976931348623157e308 }) {
+        EXPECT_EQ (d, std::strtod (json::number (d).c_str(), nullptr));
+    }
+
+    EXPECT_EQ ("null", json::number (std::numeric_limits<double>::quiet_NaN()));
+    EXPECT_EQ ("null", json::number (std::numeric_limits<double>::infinity()));
+}
+
+/******************************************************************************/
+
+TEST (Json, keys) { // NOLINT
+    EXPECT_EQ (R"("a")", json::key (R"("a")", true));
+    EXPECT_EQ (R"("1")", json::key ("1", false));
+    EXPECT_EQ (R"("\"a")", json::key (R"("a)", false));
+    EXPECT_EQ ("true", json::arithmetic (true));
+    EXPECT_EQ ("2.5", json::arithmetic (2.5f));
+}
+
+/******************************************************************************/
@@ -1,7 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <proton/codec.h>
+
 #include "TestUtils.h"
 
+#include "test-utils/BlobBuilder.h"
+
+#include "reader/Reader.h"
+#include "reader/FlatMap.h"
+
 #include "amqp/schema/described-types/Descriptor.h"
 #include "restricted-types/Map.h"
 #include "restricted-types/List.h"
@@ -210,3 +217,106 @@ TEST (Map, dependsOn2) {
 
 /******************************************************************************/
 
+
+/******************************************************************************
+ *
+ * Decoding Tests
+ *
+ ******************************************************************************/
+
+namespace {
+
+    /**
+     * A class with a single property, a map of string to long
+     */
+    std::vector<char>
+    balances (const std::vector<std::pair<std::string, long>> & entries_) {
+        test::BlobBuilder bb;
+
+        bb.composite ("net.corda.A", "net.corda:A", {
+            { "a", "*", { "java.util.Map<string, long>" } } });
+        bb.restricted ("java.util.Map<string, long>", "net.corda:M", "map");
+
+        return bb.build ("net.corda:A", [&entries_](pn_data_t * data_) {
+            test::putList (data_, [&entries_](pn_data_t * data_) {
+                test::putDescribed (data_, "net.corda:M", [&entries_](pn_data_t * data_) {
+                    test::putMap (data_, [&entries_](pn_data_t * data_) {
+                        for (const auto & e : entries_) {
+                            test::putString (data_, e.first);
+                            pn_data_put_long (data_, e.second);
+                        }
+                    });
+                });
+            });
+        });
+    }
+
+    const amqp::internal::reader::FlatMap &
+    flatMap (const uPtr<amqp::reader::IValue> & value_) {
+        using Composite = amqp::internal::reader::TypedPair<sVec<uPtr<amqp::reader::IValue>>>;
+
+        const auto & composite = dynamic_cast<const Composite &> (*value_);
+
+        return dynamic_cast<const amqp::internal::reader::FlatMap &> (
+            *composite.value()[0]);
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Map, flatDump) { // NOLINT
+    test::Blob blob (balances ({ { "GBP", 100 }, { "USD", 20 } }));
+
+    EXPECT_EQ (
+        R"(Parsed : { "a" : { "GBP" : 100, "USD" : 20 } })",
+        blob.dump());
+}
+
+/******************************************************************************/
+
+TEST (Map, flatEmpty) { // NOLINT
+    test::Blob blob (balances ({ }));
+
+    EXPECT_EQ (R"(Parsed : { "a" : {  } })", blob.dump());
+}
+
+/******************************************************************************/
+
+TEST (Map, flatFind) { // NOLINT
+    using amqp::internal::reader::Scalar;
+
+    test::Blob blob (balances ({ { "GBP", 100 }, { "USD", 20 }, { "EUR", 7 } }));
+
+    amqp::internal::CompositeFactory cf;
+    auto value = blob.read (cf);
+
+    const auto & map = flatMap (value);
+
+    ASSERT_EQ (3, map.size());
+
+    // entries stay in wire order
+    EXPECT_EQ (Scalar { std::string ("USD") }, map.key (1));
+    EXPECT_EQ (Scalar { int64_t { 20 } }, map.value (1));
+
+    auto eur = map.find (std::string ("EUR"));
+    ASSERT_NE (nullptr, eur);
+    EXPECT_EQ (7, std::get<int64_t> (*eur));
+
+    EXPECT_EQ (nullptr, map.find (std::string ("JPY")));
+}
+
+/******************************************************************************/
+
+/**
+ * A string key that itself starts with a quote is still escaped
+ */
+TEST (Map, quotedKey) { // NOLINT
+    test::Blob blob (balances ({ { "\"GBP", 100 } }));
+
+    EXPECT_EQ (
+        R"(Parsed : { "a" : { "\"GBP" : 100 } })",
+        blob.dump());
+}
+
+/******************************************************************************/
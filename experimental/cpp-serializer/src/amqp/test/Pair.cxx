@@ -2,7 +2,14 @@
 #include <memory>
 #include <string>
 
+#include <proton/codec.h>
+
+#include "TestUtils.h"
+
+#include "test-utils/BlobBuilder.h"
+
 #include "Reader.h"
+#include "amqp/CompositeFactory.h"
 
 /******************************************************************************/
 
@@ -31,7 +38,7 @@ TEST (Pair, UP1) { // NOLINT
     std::unique_ptr<TypedPair<double>> test =
         std::make_unique<TypedPair<double>> ("property", 10.0);
 
-    EXPECT_EQ("property : 10.000000", test->dump());
+    EXPECT_EQ("property : 10", test->dump());
 }
 
 /******************************************************************************/
@@ -59,3 +66,62 @@ TEST (Pair, UP2) { // NOLINT
 
 /******************************************************************************/
 
+
+/******************************************************************************
+ *
+ * Decoding Tests
+ *
+ ******************************************************************************/
+
+namespace {
+
+    /**
+     * A class with a primitive field of each kind, all of them null
+     */
+    std::vector<char>
+    nulls (bool mandatory_) {
+        test::BlobBuilder bb;
+
+        bb.composite ("net.corda.A", "net.corda:A", {
+            { "i", "int", { }, mandatory_ },
+            { "l", "long", { }, mandatory_ },
+            { "d", "double", { }, mandatory_ } });
+
+        return bb.build ("net.corda:A", [](pn_data_t * data_) {
+            test::putList (data_, [](pn_data_t * data_) {
+                for (int i { 0 } ; i < 3 ; ++i) {
+                    pn_data_put_null (data_);
+                }
+            });
+        });
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Pair, nullOptional) { // NOLINT
+    test::Blob blob (nulls (false));
+
+    EXPECT_EQ (
+        R"(Parsed : { "i" : null, "l" : null, "d" : null })",
+        blob.dump());
+
+    // and the same when not checking
+    amqp::internal::CompositeFactory cf;
+    cf.trust();
+
+    EXPECT_EQ (
+        R"(Parsed : { "i" : null, "l" : null, "d" : null })",
+        test::Blob (nulls (false)).dump (cf));
+}
+
+/******************************************************************************/
+
+TEST (Pair, nullMandatory) { // NOLINT
+    test::Blob blob (nulls (true));
+
+    EXPECT_THROW (blob.dump(), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
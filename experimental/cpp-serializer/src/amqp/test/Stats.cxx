@@ -0,0 +1,311 @@
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include <proton/codec.h>
+
+#include "stats/Sketch.h"
+#include "stats/Profile.h"
+
+#include "test-utils/BlobBuilder.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::stats;
+
+/******************************************************************************/
+
+namespace {
+
+    struct Values {
+        int a { 1 };
+        std::optional<std::string> s { "hello" };
+        int ordinal { 0 };
+        std::vector<int> list { 1, 2, 3 };
+        std::map<std::string, int> map { { "x", 1 }, { "y", 2 } };
+    };
+
+    /**
+     * An A holding an int, a nullable string, an enum, a list and a map
+     */
+    std::vector<char>
+    blob (const Values & v_) {
+        test::BlobBuilder bb;
+
+        bb.restricted ("net.corda.E", "net.corda:E", "list", { "X", "Y" });
+        bb.restricted ("java.util.List<int>", "net.corda:L", "list");
+        bb.restricted ("java.util.Map<string, int>", "net.corda:M", "map");
+        bb.composite ("net.corda.A", "net.corda:A", {
+            { "a", "int" },
+            { "s", "string", { }, false },
+            { "e", "net.corda.E" },
+            { "l", "*", { "java.util.List<int>" } },
+            { "m", "*", { "java.util.Map<string, int>" } } });
+
+        return bb.build ("net.corda:A", [&](pn_data_t * data_) {
+            test::putList (data_, [&](pn_data_t * data_) {
+                pn_data_put_int (data_, v_.a);
+
+                if (v_.s) {
+                    test::putString (data_, *v_.s);
+                } else {
+                    pn_data_put_null (data_);
+                }
+
+                test::putEnum (
+                    data_, "net.corda:E", v_.ordinal ? "Y" : "X", v_.ordinal);
+                test::putDescribed (data_, "net.corda:L", [&](pn_data_t * data_) {
+                    test::putList (data_, [&](pn_data_t * data_) {
+                        for (auto i : v_.list) pn_data_put_int (data_, i);
+                    });
+                });
+                test::putDescribed (data_, "net.corda:M", [&](pn_data_t * data_) {
+                    test::putMap (data_, [&](pn_data_t * data_) {
+                        for (const auto & e : v_.map) {
+                            test::putString (data_, e.first);
+                            pn_data_put_int (data_, e.second);
+                        }
+                    });
+                });
+            });
+        });
+    }
+
+    /**
+     * Three As, the second with a null string and an empty list
+     */
+    std::vector<std::vector<char>>
+    corpus() {
+        Values second;
+        second.a = -4;
+        second.s.reset();
+        second.ordinal = 1;
+        second.list.clear();
+
+        Values third;
+        third.a = 10;
+        third.list = { 5, 6, 7, 8, 9 };
+
+        return { blob ({ }), blob (second), blob (third) };
+    }
+
+    const Field &
+    field (const Profile & profile_, const std::string & path_) {
+        return profile_.fields().at (path_);
+    }
+
+}
+
+/******************************************************************************
+ *
+ * Sketch Tests
+ *
+ ******************************************************************************/
+
+TEST (HyperLogLog, estimate) { // NOLINT
+    HyperLogLog a, b;
+
+    EXPECT_EQ (0U, a.estimate());
+
+    for (int i { 0 } ; i < 20000 ; ++i) {
+        auto h = hash (std::to_string (i));
+        (i < 12000 ? a : b).add (h);
+
+        // duplicates change nothing
+        a.add (h);
+    }
+
+    EXPECT_NEAR (20000.0, static_cast<double> (a.estimate()), 1000.0);
+
+    a.merge (b);
+    EXPECT_NEAR (20000.0, static_cast<double> (a.estimate()), 1000.0);
+
+    HyperLogLog small;
+    for (auto s : { "a", "b", "c", "a" }) small.add (hash (s));
+    EXPECT_EQ (3U, small.estimate());
+}
+
+/******************************************************************************/
+
+/**
+ * Frequent values survive a stream of one-offs far larger than the
+ * number of counters
+ */
+TEST (TopK, heavyHitters) { // NOLINT
+    TopK a (8), b (8);
+
+    for (int i { 0 } ; i < 1000 ; ++i) {
+        a.add ("once" + std::to_string (i));
+
+        if (i % 4 == 0) a.add ("often");
+        if (i % 2 == 0) b.add ("elsewhere");
+    }
+
+    auto top = a.top (1);
+    ASSERT_EQ (1U, top.size());
+    EXPECT_EQ ("often", top[0].value);
+    EXPECT_GE (top[0].count, 250U);
+
+    a.merge (b);
+    top = a.top (2);
+    ASSERT_EQ (2U, top.size());
+    EXPECT_EQ ("elsewhere", top[0].value);
+    EXPECT_EQ ("often", top[1].value);
+}
+
+/******************************************************************************/
+
+TEST (Histogram, buckets) { // NOLINT
+    Histogram h;
+
+    for (uint64_t v : { 0, 1, 2, 3, 4, 1000 }) h.add (v);
+
+    EXPECT_EQ (1U, h[0]);
+    EXPECT_EQ (1U, h[1]);
+    EXPECT_EQ (2U, h[2]);
+    EXPECT_EQ (1U, h[3]);
+    EXPECT_EQ (1U, h[10]);
+
+    EXPECT_EQ (512U, Histogram::lower (10));
+    EXPECT_EQ (1023U, Histogram::upper (10));
+    EXPECT_EQ (0U, Histogram::upper (0));
+}
+
+/******************************************************************************
+ *
+ * Profile Tests
+ *
+ ******************************************************************************/
+
+TEST (Profile, fields) { // NOLINT
+    Profile profile;
+
+    for (const auto & b : corpus()) {
+        EXPECT_TRUE (profile.add (b.data(), b.size()));
+    }
+
+    EXPECT_EQ (3U, profile.blobs());
+
+    std::vector<std::string> paths;
+    for (const auto & f : profile.fields()) paths.push_back (f.first);
+
+    EXPECT_EQ (
+        (std::vector<std::string> { "", "a", "e", "l", "l[]", "m", "m[]", "m{}", "s" }),
+        paths);
+
+    const auto & a = field (profile, "a");
+    EXPECT_EQ ("int", a.type);
+    EXPECT_EQ (3U, a.count);
+    EXPECT_EQ (-4.0, a.min);
+    EXPECT_EQ (10.0, a.max);
+    EXPECT_EQ (7.0, a.sum);
+    EXPECT_EQ (3U, a.distinct.estimate());
+
+    const auto & s = field (profile, "s");
+    EXPECT_EQ (3U, s.count);
+    EXPECT_EQ (1U, s.nulls);
+    ASSERT_EQ (1U, s.top.top (10).size());
+    EXPECT_EQ ("hello", s.top.top (10)[0].value);
+    EXPECT_EQ (2U, s.top.top (10)[0].count);
+
+    const auto & e = field (profile, "e");
+    EXPECT_EQ ("net.corda.E", e.type);
+    EXPECT_EQ ("X", e.top.top (1)[0].value);
+    EXPECT_EQ (2U, e.distinct.estimate());
+
+    const auto & l = field (profile, "l");
+    EXPECT_EQ (1U, l.lengths[0]);
+    EXPECT_EQ (1U, l.lengths[2]);
+    EXPECT_EQ (1U, l.lengths[3]);
+
+    const auto & elements = field (profile, "l[]");
+    EXPECT_EQ (8U, elements.count);
+    EXPECT_EQ (1.0, elements.min);
+    EXPECT_EQ (9.0, elements.max);
+
+    EXPECT_EQ (3U, field (profile, "m").lengths[2]);
+    EXPECT_EQ (6U, field (profile, "m{}").count);
+    EXPECT_EQ (2U, field (profile, "m{}").distinct.estimate());
+    EXPECT_EQ (9.0, field (profile, "m[]").sum);
+}
+
+/******************************************************************************/
+
+/**
+ * Only blobs of the type asked for, by name or fingerprint, are counted
+ */
+TEST (Profile, type) { // NOLINT
+    auto b = blob ({ });
+
+    Profile byName ("net.corda.A"), byFingerprint ("net.corda:A"), other ("net.corda.B");
+
+    EXPECT_TRUE (byName.add (b.data(), b.size()));
+    EXPECT_TRUE (byFingerprint.add (b.data(), b.size()));
+    EXPECT_FALSE (other.add (b.data(), b.size()));
+
+    EXPECT_EQ (0U, other.blobs());
+    EXPECT_TRUE (other.fields().empty());
+}
+
+/******************************************************************************/
+
+/**
+ * Profiles gathered apart and merged match one gathered over everything
+ */
+TEST (Profile, merge) { // NOLINT
+    auto blobs = corpus();
+
+    Profile all, first, rest;
+
+    for (size_t i { 0 } ; i < blobs.size() ; ++i) {
+        all.add (blobs[i].data(), blobs[i].size());
+        (i ? rest : first).add (blobs[i].data(), blobs[i].size());
+    }
+
+    Profile merged;
+    merged.merge (first);
+    merged.merge (rest);
+
+    EXPECT_EQ (all.dump(), merged.dump());
+}
+
+/******************************************************************************/
+
+TEST (Profile, dump) { // NOLINT
+    Profile profile;
+
+    for (const auto & b : corpus()) {
+        profile.add (b.data(), b.size());
+    }
+
+    auto dump = profile.dump();
+
+    EXPECT_EQ (0U, dump.find ("{ \"blobs\" : 3, \"fields\" : {\n"));
+
+    EXPECT_NE (std::string::npos, dump.find (
+        "\n\"a\" : { \"type\" : \"int\", \"count\" : 3, \"nulls\" : 0,"
+        " \"min\" : -4, \"max\" : 10, \"sum\" : 7, \"distinct\" : 3 },\n")) << dump;
+
+    EXPECT_NE (std::string::npos, dump.find (
+        "\n\"e\" : { \"type\" : \"net.corda.E\", \"count\" : 3, \"nulls\" : 0,"
+        " \"distinct\" : 2, \"top\" : [ { \"value\" : \"X\", \"count\" : 2 },"
+        " { \"value\" : \"Y\", \"count\" : 1 } ] },\n")) << dump;
+
+    EXPECT_NE (std::string::npos, dump.find (
+        "\n\"l\" : { \"type\" : \"java.util.List<int>\", \"count\" : 3,"
+        " \"nulls\" : 0, \"lengths\" : { \"0\" : 1, \"2-3\" : 1, \"4-7\" : 1 } },\n"))
+        << dump;
+}
+
+/******************************************************************************/
+
+TEST (Profile, malformed) { // NOLINT
+    auto b = blob ({ });
+    b.resize (b.size() - 4);
+
+    Profile profile;
+
+    EXPECT_THROW (profile.add (b.data(), b.size()), amqp::internal::wire::Error); // NOLINT
+}
+
+/******************************************************************************/
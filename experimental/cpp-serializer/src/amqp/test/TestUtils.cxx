@@ -8,6 +8,11 @@
 #include "restricted-types/List.h"
 #include "restricted-types/Enum.h"
 
+#include "proton/proton_wrapper.h"
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
+
 /******************************************************************************/
 
 using namespace amqp::internal::schema;
@@ -124,3 +129,80 @@ comp (
 }
 
 /******************************************************************************/
+
+test::
+Blob::Blob (const std::vector<char> & blob_)
+    : m_data (pn_data (0))
+{
+    auto header = amqp::AMQP_HEADER.size() + 1;
+
+    pn_data_decode (m_data, blob_.data() + header, blob_.size() - header);
+}
+
+/******************************************************************************/
+
+test::
+Blob::~Blob() {
+    pn_data_free (m_data);
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::Envelope &
+test::
+Blob::envelope() {
+    if (!m_envelope) {
+        pn_data_rewind (m_data);
+        pn_data_next (m_data);
+
+        proton::auto_enter p (m_data);
+
+        m_envelope.reset (
+            dynamic_cast<amqp::internal::schema::Envelope *> (
+                amqp::internal::AMQPDescriptorRegistory[
+                    pn_data_get_ulong (m_data)]->build (m_data).release()));
+    }
+
+    return *m_envelope;
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+test::
+Blob::read (amqp::internal::CompositeFactory & cf_) {
+    const auto & envelope = this->envelope();
+
+    cf_.process (envelope.schema(), envelope.transforms());
+
+    auto reader = cf_.byDescriptor (envelope.descriptor());
+
+    pn_data_rewind (m_data);
+    pn_data_next (m_data);
+
+    proton::auto_enter p (m_data);
+    pn_data_next (m_data);
+    proton::auto_enter p2 (m_data);
+
+    return reader->dump ("Parsed", m_data, envelope.schema());
+}
+
+/******************************************************************************/
+
+std::string
+test::
+Blob::dump (amqp::internal::CompositeFactory & cf_) {
+    return read (cf_)->dump();
+}
+
+/******************************************************************************/
+
+std::string
+test::
+Blob::dump() {
+    amqp::internal::CompositeFactory cf;
+
+    return dump (cf);
+}
+
+/******************************************************************************/
@@ -1,9 +1,15 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "restricted-types/List.h"
 #include "restricted-types/Map.h"
 
+#include "amqp/CompositeFactory.h"
+#include "amqp/schema/described-types/Envelope.h"
+
+struct pn_data_t;
+
 /******************************************************************************/
 
 namespace test {
@@ -18,6 +24,36 @@ namespace test {
 
     uPtr <amqp::internal::schema::Composite>
     comp (const std::string & name_, const std::vector<std::string> &);
+
+    /**
+     * A blob, as produced by a BlobBuilder, decoded by proton. The
+     * envelope is only built when first asked for so tests can measure
+     * our cost separately from proton's
+     */
+    class Blob {
+        private :
+            pn_data_t * m_data;
+            uPtr<amqp::internal::schema::Envelope> m_envelope;
+
+        public :
+            explicit Blob (const std::vector<char> &);
+            Blob (const Blob &) = delete;
+            ~Blob();
+
+            const amqp::internal::schema::Envelope & envelope();
+
+            /**
+             * Process the blob's schema with [cf_] and read the payload
+             */
+            uPtr<amqp::reader::IValue> read (amqp::internal::CompositeFactory & cf_);
+
+            /**
+             * Process the blob's schema with [cf_] and dump the payload
+             */
+            std::string dump (amqp::internal::CompositeFactory & cf_);
+
+            std::string dump();
+    };
 }
 
 /******************************************************************************/
@@ -0,0 +1,357 @@
+#include <gtest/gtest.h>
+
+#include <proton/codec.h>
+
+#include "TestUtils.h"
+
+#include "amqp/Mappings.h"
+#include "amqp/CompositeFactory.h"
+#include "amqp/schema/EnumTransforms.h"
+#include "amqp/schema/described-types/TransformElement.h"
+#include "amqp/reader/restricted-readers/EnumReader.h"
+
+#include "test-utils/BlobBuilder.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::schema;
+
+/******************************************************************************
+ *
+ * compileEnumTransforms Tests
+ *
+ ******************************************************************************/
+
+TEST (EnumTransforms, identity) { // NOLINT
+    auto table = compileEnumTransforms ({ "A", "B", "C" }, { "A", "B", "C" }, { });
+
+    EXPECT_EQ ((EnumTransforms { 0, 1, 2 }), table);
+}
+
+/******************************************************************************/
+
+TEST (EnumTransforms, reordered) { // NOLINT
+    auto table = compileEnumTransforms ({ "A", "B", "C" }, { "C", "A", "B" }, { });
+
+    EXPECT_EQ ((EnumTransforms { 1, 2, 0 }), table);
+}
+
+/******************************************************************************/
+
+TEST (EnumTransforms, missing) { // NOLINT
+    auto table = compileEnumTransforms ({ "A", "B", "C" }, { "A", "B" }, { });
+
+    EXPECT_EQ ((EnumTransforms { 0, 1, ENUM_TRANSFORM_MISSING }), table);
+}
+
+/******************************************************************************/
+
+/**
+ * C was added with a default of B, a reader who doesn't know C reads B
+ */
+TEST (EnumTransforms, enumDefault) { // NOLINT
+    TransformElement d (TransformTypes::enum_default_t, "C", "B");
+
+    auto table = compileEnumTransforms ({ "A", "B", "C" }, { "A", "B" }, { &d });
+
+    EXPECT_EQ ((EnumTransforms { 0, 1, 1 }), table);
+}
+
+/******************************************************************************/
+
+/**
+ * D defaults to C which defaults to A
+ */
+TEST (EnumTransforms, chainedDefaults) { // NOLINT
+    TransformElement d1 (TransformTypes::enum_default_t, "C", "A");
+    TransformElement d2 (TransformTypes::enum_default_t, "D", "C");
+
+    auto table = compileEnumTransforms (
+        { "A", "B", "C", "D" }, { "A", "B" }, { &d1, &d2 });
+
+    EXPECT_EQ ((EnumTransforms { 0, 1, 0, 0 }), table);
+}
+
+/******************************************************************************/
+
+/**
+ * Reading an old value, B was renamed to C and then to D
+ */
+TEST (EnumTransforms, renamedForward) { // NOLINT
+    TransformElement r1 (TransformTypes::rename_t, "B", "C");
+    TransformElement r2 (TransformTypes::rename_t, "C", "D");
+
+    auto table = compileEnumTransforms ({ "A", "B" }, { "A", "D" }, { &r1, &r2 });
+
+    EXPECT_EQ ((EnumTransforms { 0, 1 }), table);
+}
+
+/******************************************************************************/
+
+/**
+ * Reading a value written after B was renamed to C as the version
+ * before the rename
+ */
+TEST (EnumTransforms, renamedBackward) { // NOLINT
+    TransformElement r (TransformTypes::rename_t, "B", "C");
+
+    auto table = compileEnumTransforms ({ "A", "C" }, { "B", "A" }, { &r });
+
+    EXPECT_EQ ((EnumTransforms { 1, 0 }), table);
+}
+
+/******************************************************************************/
+
+/**
+ * Transforms that lead nowhere mustn't loop forever
+ */
+TEST (EnumTransforms, cycle) { // NOLINT
+    TransformElement r1 (TransformTypes::rename_t, "B", "C");
+    TransformElement r2 (TransformTypes::rename_t, "C", "B");
+
+    auto table = compileEnumTransforms ({ "B" }, { "A" }, { &r1, &r2 });
+
+    EXPECT_EQ ((EnumTransforms { ENUM_TRANSFORM_MISSING }), table);
+}
+
+/******************************************************************************
+ *
+ * Decoding Tests
+ *
+ ******************************************************************************/
+
+namespace {
+
+    /**
+     * A class holding a list of enum E whose constants are [choices_]
+     */
+    test::BlobBuilder
+    enumBlob (
+        const std::vector<std::string> & choices_,
+        const std::string & fingerprint_ = "net.corda:E"
+    ) {
+        test::BlobBuilder bb;
+
+        bb.composite ("net.corda.A", "net.corda:A", {
+            { "a", "*", { "java.util.List<net.corda.E>" } } });
+        bb.restricted ("java.util.List<net.corda.E>", "net.corda:LE", "list");
+        bb.restricted ("net.corda.E", fingerprint_, "list", choices_);
+
+        return bb;
+    }
+
+    std::vector<char>
+    build (
+        const test::BlobBuilder & bb_,
+        const std::vector<std::pair<std::string, int>> & values_,
+        const std::string & fingerprint_ = "net.corda:E"
+    ) {
+        return bb_.build ("net.corda:A", [&](pn_data_t * data_) {
+            test::putList (data_, [&](pn_data_t * data_) {
+                test::putDescribed (data_, "net.corda:LE", [&](pn_data_t * data_) {
+                    test::putList (data_, [&](pn_data_t * data_) {
+                        for (const auto & v : values_) {
+                            test::putEnum (data_, fingerprint_, v.first, v.second);
+                        }
+                    });
+                });
+            });
+        });
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Transforms, parsed) { // NOLINT
+    auto bb = enumBlob ({ "A", "B", "C" });
+    bb.enumDefault ("net.corda.E", "B", "C");
+    bb.rename ("net.corda.E", "X", "A");
+
+    test::Blob blob (build (bb, { }));
+
+    const auto & transforms = blob.envelope().transforms().transforms ("net.corda.E");
+
+    ASSERT_EQ (2, transforms.size());
+
+    EXPECT_EQ (TransformTypes::enum_default_t, transforms[0]->type());
+    EXPECT_EQ ("C", transforms[0]->from());
+    EXPECT_EQ ("B", transforms[0]->to());
+
+    EXPECT_EQ (TransformTypes::rename_t, transforms[1]->type());
+    EXPECT_EQ ("X", transforms[1]->from());
+    EXPECT_EQ ("A", transforms[1]->to());
+
+    EXPECT_TRUE (blob.envelope().transforms().transforms ("net.corda.F").empty());
+}
+
+/******************************************************************************/
+
+/**
+ * Without an expected schema values read as they were written
+ */
+TEST (Transforms, unexpected) { // NOLINT
+    auto bb = enumBlob ({ "A", "B", "C" });
+    bb.enumDefault ("net.corda.E", "B", "C");
+
+    test::Blob blob (build (bb, { { "A", 0 }, { "C", 2 } }));
+
+    EXPECT_EQ (R"(Parsed : { "a" : [ "A", "C" ] })", blob.dump());
+}
+
+/******************************************************************************/
+
+/**
+ * A newer writer added C defaulting to B, our version of E predates that
+ */
+TEST (Transforms, newerWriter) { // NOLINT
+    auto bb = enumBlob ({ "A", "B", "C" });
+    bb.enumDefault ("net.corda.E", "B", "C");
+
+    test::Blob local (build (enumBlob ({ "A", "B" }), { }));
+    test::Blob blob (build (bb, { { "A", 0 }, { "C", 2 }, { "B", 1 } }));
+
+    amqp::internal::CompositeFactory cf;
+    cf.expect (local.envelope().schema(), local.envelope().transforms());
+
+    EXPECT_EQ (R"(Parsed : { "a" : [ "A", "B", "B" ] })", blob.dump (cf));
+}
+
+/******************************************************************************/
+
+/**
+ * An older writer used B, our version of E renamed it to Z
+ */
+TEST (Transforms, olderWriter) { // NOLINT
+    auto local = enumBlob ({ "A", "Z" });
+    local.rename ("net.corda.E", "B", "Z");
+
+    test::Blob expected (build (local, { }));
+    test::Blob blob (build (enumBlob ({ "A", "B" }), { { "B", 1 }, { "A", 0 } }));
+
+    amqp::internal::CompositeFactory cf;
+    cf.expect (expected.envelope().schema(), expected.envelope().transforms());
+
+    EXPECT_EQ (R"(Parsed : { "a" : [ "Z", "A" ] })", blob.dump (cf));
+}
+
+/******************************************************************************/
+
+/**
+ * Nothing says what C should become
+ */
+TEST (Transforms, unmappable) { // NOLINT
+    test::Blob local (build (enumBlob ({ "A", "B" }), { }));
+    test::Blob blob (build (enumBlob ({ "A", "B", "C" }), { { "C", 2 } }));
+
+    amqp::internal::CompositeFactory cf;
+    cf.expect (local.envelope().schema(), local.envelope().transforms());
+
+    EXPECT_THROW (blob.dump (cf), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * Factories sharing their mappings compile the table for a pair of
+ * versions of an enum once, for the first blob that needs it
+ */
+TEST (Transforms, shared) { // NOLINT
+    auto bb = enumBlob ({ "A", "B", "C" }, "net.corda:E3");
+    bb.enumDefault ("net.corda.E", "B", "C");
+
+    test::Blob local (build (enumBlob ({ "A", "B" }, "net.corda:E2"), { }, "net.corda:E2"));
+
+    auto mappings = std::make_shared<amqp::internal::Mappings>();
+    std::shared_ptr<const EnumTransforms> table;
+
+    for (int i { 0 } ; i < 2 ; ++i) {
+        test::Blob blob (build (bb, { { "C", 2 }, { "A", 0 } }, "net.corda:E3"));
+
+        amqp::internal::CompositeFactory cf;
+        cf.share (mappings);
+        cf.expect (local.envelope().schema(), local.envelope().transforms());
+
+        EXPECT_EQ (R"(Parsed : { "a" : [ "B", "A" ] })", blob.dump (cf));
+
+        if (!table) {
+            table = mappings->enumTransforms ("net.corda:E3", "net.corda:E2");
+        }
+    }
+
+    ASSERT_TRUE (table);
+    EXPECT_EQ (table, mappings->enumTransforms ("net.corda:E3", "net.corda:E2"));
+    EXPECT_EQ (1U, mappings->size());
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * Ordinal Decoding Tests
+ *
+ ******************************************************************************/
+
+/**
+ * Values are decoded by ordinal, the name written alongside it is
+ * redundant and by default isn't even looked at
+ */
+TEST (EnumOrdinals, ordinalWins) { // NOLINT
+    test::Blob blob (build (enumBlob ({ "A", "B", "C" }), { { "X", 2 }, { "Y", 0 } }));
+
+    EXPECT_EQ (R"(Parsed : { "a" : [ "C", "A" ] })", blob.dump());
+}
+
+/******************************************************************************/
+
+TEST (EnumOrdinals, validated) { // NOLINT
+    test::Blob good (build (enumBlob ({ "A", "B", "C" }), { { "C", 2 }, { "A", 0 } }));
+    test::Blob bad (build (enumBlob ({ "A", "B", "C" }), { { "B", 2 } }));
+
+    amqp::internal::CompositeFactory cf1;
+    cf1.validate (true);
+
+    EXPECT_EQ (R"(Parsed : { "a" : [ "C", "A" ] })", good.dump (cf1));
+
+    amqp::internal::CompositeFactory cf2;
+    cf2.validate (true);
+
+    EXPECT_THROW (bad.dump (cf2), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (EnumOrdinals, outOfRange) { // NOLINT
+    test::Blob blob (build (enumBlob ({ "A", "B" }), { { "C", 2 } }));
+
+    EXPECT_THROW (blob.dump(), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * Every value read by an enum reader shares its dictionary, as a scalar
+ * the value is just the index into it
+ */
+TEST (EnumOrdinals, dictionary) { // NOLINT
+    test::Blob blob (build (enumBlob ({ "A", "B", "C" }), { }));
+
+    amqp::internal::CompositeFactory cf;
+    cf.process (blob.envelope().schema());
+
+    auto reader = std::dynamic_pointer_cast<amqp::internal::reader::EnumReader> (
+        cf.byDescriptor ("net.corda:E"));
+
+    ASSERT_NE (nullptr, reader);
+    EXPECT_EQ ((amqp::internal::reader::EnumDictionary { "A", "B", "C" }), *reader->dictionary());
+    EXPECT_EQ (R"("C")", reader->dumpScalar (int32_t { 2 }));
+
+    amqp::internal::reader::EnumValue v1 (1, reader->dictionary());
+    amqp::internal::reader::EnumValue v2 ("e", 2, reader->dictionary());
+
+    EXPECT_EQ (&v1.dictionary(), &v2.dictionary());
+    EXPECT_EQ (R"("B")", v1.dump());
+    EXPECT_EQ (R"(e : "C")", v2.dump());
+}
+
+/******************************************************************************/
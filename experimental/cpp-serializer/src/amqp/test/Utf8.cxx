@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <proton/codec.h>
+
+#include "TestUtils.h"
+
+#include "proton/utf8.h"
+#include "wire/Verifier.h"
+
+#include "test-utils/BlobBuilder.h"
+
+/******************************************************************************/
+
+namespace {
+
+    bool
+    valid (const std::string & str_) {
+        std::string copy;
+
+        bool rtn = proton::utf8::valid (str_.data(), str_.size());
+
+        // both routes must always agree
+        EXPECT_EQ (rtn, proton::utf8::assign (copy, str_.data(), str_.size()));
+
+        if (rtn) {
+            EXPECT_EQ (str_, copy);
+        }
+
+        return rtn;
+    }
+
+    std::vector<char>
+    blob (const std::string & str_) {
+        test::BlobBuilder bb;
+
+        bb.composite ("net.corda.A", "net.corda:A", { { "s", "string" } });
+
+        return bb.build ("net.corda:A", [&](pn_data_t * data_) {
+            test::putList (data_, [&](pn_data_t * data_) {
+                test::putString (data_, str_);
+            });
+        });
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Utf8, valid) { // NOLINT
+    EXPECT_TRUE (valid (""));
+    EXPECT_TRUE (valid ("plain ascii"));
+    EXPECT_TRUE (valid ("\xc2\xa3"));                 // £
+    EXPECT_TRUE (valid ("\xe2\x82\xac"));             // €
+    EXPECT_TRUE (valid ("\xf0\x9f\x98\x80"));         // U+1F600
+    EXPECT_TRUE (valid ("\xef\xbf\xbf"));             // U+FFFF
+    EXPECT_TRUE (valid ("\xf4\x8f\xbf\xbf"));         // U+10FFFF
+}
+
+/******************************************************************************/
+
+TEST (Utf8, invalid) { // NOLINT
+    EXPECT_FALSE (valid ("\x80"));                    // lone continuation
+    EXPECT_FALSE (valid ("\xc0\xaf"));                // overlong '/'
+    EXPECT_FALSE (valid ("\xe0\x80\xaf"));            // overlong '/'
+    EXPECT_FALSE (valid ("\xf0\x80\x80\xaf"));        // overlong '/'
+    EXPECT_FALSE (valid ("\xed\xa0\x80"));            // surrogate U+D800
+    EXPECT_FALSE (valid ("\xf4\x90\x80\x80"));        // past U+10FFFF
+    EXPECT_FALSE (valid ("\xf5\x80\x80\x80"));
+    EXPECT_FALSE (valid ("\xff"));
+    EXPECT_FALSE (valid ("\xe2\x82"));                // truncated
+    EXPECT_FALSE (valid ("\xc2\x41"));                // not a continuation
+}
+
+/******************************************************************************/
+
+/**
+ * ASCII is checked in blocks so put a bad byte everywhere relative to
+ * their boundaries
+ */
+TEST (Utf8, blocks) { // NOLINT
+    for (size_t i { 0 } ; i < 48 ; ++i) {
+        std::string s (48, 'x');
+
+        s[i] = '\xff';
+        EXPECT_FALSE (valid (s)) << i;
+
+        if (i + 1 < s.size()) {
+            s[i] = '\xc2';
+            s[i + 1] = '\xa3';
+            EXPECT_TRUE (valid (s)) << i;
+        }
+    }
+}
+
+/******************************************************************************/
+
+TEST (Utf8, decode) { // NOLINT
+    EXPECT_EQ (
+        "Parsed : { \"s\" : \"\xc2\xa3\" }",
+        test::Blob (blob ("\xc2\xa3")).dump());
+
+    EXPECT_THROW (test::Blob (blob ("a\xff")).dump(), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Utf8, verify) { // NOLINT
+    auto good = blob ("\xc2\xa3");
+    auto bad = blob ("a\xff");
+
+    EXPECT_TRUE (amqp::internal::wire::verify (good.data(), good.size()));
+
+    auto verdict = amqp::internal::wire::verify (bad.data(), bad.size());
+
+    EXPECT_FALSE (verdict);
+    EXPECT_EQ ("String is not valid UTF-8", verdict.error);
+}
+
+/******************************************************************************/
+
+/**
+ * A trusting factory builds readers that take strings as they are
+ */
+TEST (Utf8, trusted) { // NOLINT
+    amqp::internal::CompositeFactory cf;
+    cf.trust();
+
+    EXPECT_EQ (
+        "Parsed : { \"s\" : \"a\xff\" }",
+        test::Blob (blob ("a\xff")).dump (cf));
+}
+
+/******************************************************************************/
@@ -0,0 +1,502 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+
+#include <proton/codec.h>
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+
+#include "wire/Blob.h"
+#include "wire/Cursor.h"
+#include "wire/Verifier.h"
+#include "wire/Classifier.h"
+
+#include "test-utils/BlobBuilder.h"
+#include "test-utils/AllocationScope.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::wire;
+
+/******************************************************************************
+ *
+ * Cursor Tests
+ *
+ ******************************************************************************/
+
+TEST (Cursor, primitives) { // NOLINT
+    const char bytes[] {
+        '\x54', '\xff',                               // smallint -1
+        '\x71', '\x00', '\x00', '\x01', '\x00',       // int 256
+        '\x43',                                       // uint0
+        '\xa1', '\x02', 'h', 'i',                     // str8 "hi"
+        '\x41'                                        // true
+    };
+
+    Cursor c (bytes, sizeof (bytes));
+
+    EXPECT_EQ (-1, c.integer (c.code()));
+    EXPECT_EQ (256, c.integer (c.code()));
+    EXPECT_EQ (0U, c.ulong (c.code()));
+    EXPECT_EQ ("hi", c.bytes (c.code()));
+    EXPECT_TRUE (c.boolean (c.code()));
+    EXPECT_TRUE (c.atEnd());
+}
+
+/******************************************************************************/
+
+TEST (Cursor, skip) { // NOLINT
+    const char bytes[] {
+        '\x00', '\x53', '\x01',                       // described, smallulong 1
+        '\xc0', '\x04', '\x02', '\x40', '\x55', '\x07', // list8 [ null, 7L ]
+        '\x82', 0, 0, 0, 0, 0, 0, 0, 0                // double
+    };
+
+    Cursor c (bytes, sizeof (bytes));
+
+    c.skip();
+    EXPECT_EQ (9U, c.offset());
+    c.skip();
+    EXPECT_TRUE (c.atEnd());
+}
+
+/******************************************************************************/
+
+TEST (Cursor, overrun) { // NOLINT
+    const char bytes[] { '\xa1', '\x10', 'a', 'b' };
+
+    Cursor c (bytes, sizeof (bytes), 100);
+
+    try {
+        c.skip();
+        FAIL() << "read past the end";
+    } catch (const Error & e) {
+        EXPECT_EQ (102U, e.offset());
+    }
+}
+
+/******************************************************************************
+ *
+ * Verify Tests
+ *
+ ******************************************************************************/
+
+namespace {
+
+    /**
+     * A class with an int, a nullable string and a list of enum E
+     */
+    test::BlobBuilder
+    schema() {
+        test::BlobBuilder bb;
+
+        bb.composite ("net.corda.A", "net.corda:A", {
+            { "a", "int" },
+            { "b", "string", { }, false },
+            { "c", "*", { "java.util.List<net.corda.E>" } } });
+        bb.restricted ("java.util.List<net.corda.E>", "net.corda:LE", "list");
+        bb.restricted ("net.corda.E", "net.corda:E", "list", { "X", "Y" });
+
+        return bb;
+    }
+
+    std::vector<char>
+    blob (
+        const std::function<void (pn_data_t *)> & a_,
+        int elements_ = 3,
+        int ordinal_ = 1,
+        const std::string & fingerprint_ = "net.corda:LE"
+    ) {
+        return schema().build ("net.corda:A", [&](pn_data_t * data_) {
+            test::putList (data_, [&](pn_data_t * data_) {
+                a_ (data_);
+                pn_data_put_null (data_);
+                test::putDescribed (data_, fingerprint_, [&](pn_data_t * data_) {
+                    test::putList (data_, [&](pn_data_t * data_) {
+                        for (int i { 0 } ; i < elements_ ; ++i) {
+                            test::putEnum (data_, "net.corda:E", "Y", ordinal_);
+                        }
+                    });
+                });
+            });
+        });
+    }
+
+    void
+    anInt (pn_data_t * data_) {
+        pn_data_put_int (data_, 1);
+    }
+
+    /**
+     * The failure should be reported at the first byte of [code_] found
+     * in the blob after the schema's header
+     */
+    void
+    failsAt (const std::vector<char> & blob_, char code_, const std::string & why_) {
+        auto verdict = verify (blob_.data(), blob_.size());
+
+        ASSERT_FALSE (verdict);
+        EXPECT_EQ (why_, verdict.error);
+        ASSERT_LT (verdict.offset, blob_.size());
+        EXPECT_EQ (code_, blob_[verdict.offset]);
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Verify, good) { // NOLINT
+    auto b = blob (anInt);
+
+    auto verdict = verify (b.data(), b.size());
+
+    EXPECT_TRUE (verdict) << verdict.offset << " " << verdict.error;
+}
+
+/******************************************************************************/
+
+/**
+ * A field typed as an interface, or as "*", holds a value described as
+ * whatever implements it, so its fields are checked against the
+ * implementation's
+ */
+TEST (Verify, interface) { // NOLINT
+    test::BlobBuilder bb;
+    bb.composite ("net.corda.Alice", "net.corda:Alice", { { "name", "string" } });
+    bb.composite ("net.corda.A", "net.corda:A", {
+        { "a", "net.corda.Party" },
+        { "s", "*", { "net.corda.Party" } } });
+
+    auto build = [&](const std::string & fingerprint_, bool string_) {
+        return bb.build ("net.corda:A", [&](pn_data_t * data_) {
+            test::putList (data_, [&](pn_data_t * data_) {
+                for (int i { 0 } ; i < 2 ; ++i) {
+                    test::putDescribed (data_, fingerprint_, [&](pn_data_t * data_) {
+                        test::putList (data_, [&](pn_data_t * data_) {
+                            if (string_) {
+                                test::putString (data_, "Alice");
+                            } else {
+                                pn_data_put_int (data_, 1);
+                            }
+                        });
+                    });
+                }
+            });
+        });
+    };
+
+    auto good = build ("net.corda:Alice", true);
+    auto verdict = verify (good.data(), good.size());
+
+    EXPECT_TRUE (verdict) << verdict.offset << " " << verdict.error;
+
+    auto bad = build ("net.corda:Alice", false);
+    failsAt (bad, '\x71', "Value encoded as the wrong type");
+
+    auto unknown = build ("net.corda:Bob", true);
+    verdict = verify (unknown.data(), unknown.size());
+
+    ASSERT_FALSE (verdict);
+    EXPECT_EQ ("Fingerprint doesn't match the expected type", verdict.error);
+}
+
+/******************************************************************************/
+
+TEST (Verify, header) { // NOLINT
+    auto b = blob (anInt);
+
+    b[0] = 'C';
+    EXPECT_EQ (0U, verify (b.data(), b.size()).offset);
+
+    b[0] = 'c';
+    b[7] = 2;
+    EXPECT_EQ (7U, verify (b.data(), b.size()).offset);
+}
+
+/******************************************************************************/
+
+TEST (Verify, truncated) { // NOLINT
+    auto b = blob (anInt);
+
+    for (size_t size : { b.size() - 1, b.size() / 2, size_t { 9 } }) {
+        auto verdict = verify (b.data(), size);
+
+        EXPECT_FALSE (verdict);
+        EXPECT_LE (verdict.offset, size);
+    }
+}
+
+/******************************************************************************/
+
+TEST (Verify, wrongType) { // NOLINT
+    failsAt (
+        blob ([](pn_data_t * data_) { pn_data_put_long (data_, 1); }),
+        '\x81',
+        "Value encoded as the wrong type");
+}
+
+/******************************************************************************/
+
+TEST (Verify, unexpectedNull) { // NOLINT
+    failsAt (
+        blob ([](pn_data_t * data_) { pn_data_put_null (data_); }),
+        '\x40',
+        "Unexpected null");
+}
+
+/******************************************************************************/
+
+TEST (Verify, fieldCount) { // NOLINT
+    auto b = blob ([](pn_data_t * data_) {
+        pn_data_put_int (data_, 1);
+        pn_data_put_int (data_, 2);
+    });
+
+    auto verdict = verify (b.data(), b.size());
+
+    EXPECT_FALSE (verdict);
+    EXPECT_EQ ("List has 4 elements for 3 fields", verdict.error);
+}
+
+/******************************************************************************/
+
+TEST (Verify, fingerprint) { // NOLINT
+    auto verdict = [](const std::vector<char> & b_) {
+        return verify (b_.data(), b_.size());
+    } (blob (anInt, 3, 1, "net.corda:LX"));
+
+    EXPECT_FALSE (verdict);
+    EXPECT_EQ ("Fingerprint doesn't match the expected type", verdict.error);
+}
+
+/******************************************************************************/
+
+TEST (Verify, ordinal) { // NOLINT
+    auto b = blob (anInt, 3, 2);
+
+    auto verdict = verify (b.data(), b.size());
+
+    EXPECT_FALSE (verdict);
+    EXPECT_EQ ("Enum ordinal out of range", verdict.error);
+}
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * A chain of [depth_] N's, each holding the next
+     */
+    std::vector<char>
+    nested (int depth_) {
+        test::BlobBuilder bb;
+        bb.composite ("net.corda.N", "net.corda:N", { { "next", "net.corda.N", { }, false } });
+
+        std::function<void (pn_data_t *, int)> n = [&](pn_data_t * data_, int depth_) {
+            test::putDescribed (data_, "net.corda:N", [&](pn_data_t * data_) {
+                test::putList (data_, [&](pn_data_t * data_) {
+                    if (depth_ > 1) {
+                        n (data_, depth_ - 1);
+                    } else {
+                        pn_data_put_null (data_);
+                    }
+                });
+            });
+        };
+
+        return bb.build ("net.corda:N", [&](pn_data_t * data_) {
+            test::putList (data_, [&](pn_data_t * data_) {
+                n (data_, depth_ - 1);
+            });
+        });
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * However deeply a corrupt blob nests its values it's reported as bad
+ * rather than running the verifier out of stack
+ */
+TEST (Verify, deepNesting) { // NOLINT
+    auto shallow = nested (100);
+    EXPECT_TRUE (verify (shallow.data(), shallow.size()));
+
+    auto deep = nested (MAX_DEPTH + 1);
+    auto verdict = verify (deep.data(), deep.size());
+
+    EXPECT_FALSE (verdict);
+    EXPECT_EQ ("Values nested too deeply", verdict.error);
+}
+
+/******************************************************************************/
+
+/**
+ * An envelope of nothing but DESCRIBED codes, each the descriptor of the
+ * one before, is skipped a value at a time rather than recursed into
+ */
+TEST (Verify, describedChain) { // NOLINT
+    const size_t chain { 2000000 };
+
+    std::vector<char> b (amqp::AMQP_HEADER.begin(), amqp::AMQP_HEADER.end());
+    b.push_back (amqp::DATA_AND_STOP);
+
+    // described, ulong envelope descriptor, list32 of three elements
+    for (int c : { 0x00, 0x80, 0xc5, 0x62, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xd0 }) {
+        b.push_back (static_cast<char>(c));
+    }
+
+    for (size_t v : { chain + 4, size_t { 3 } }) {
+        for (int shift : { 24, 16, 8, 0 }) {
+            b.push_back (static_cast<char>((v >> shift) & 0xff));
+        }
+    }
+
+    b.resize (b.size() + chain, '\0');
+
+    auto verdict = verify (b.data(), b.size());
+
+    EXPECT_FALSE (verdict);
+    EXPECT_EQ ("Unexpected end of data", verdict.error);
+}
+
+/******************************************************************************/
+
+/**
+ * Verifying does no per value work beyond walking the bytes
+ */
+TEST (Verify, allocations) { // NOLINT
+    auto small = blob (anInt, 10);
+    auto large = blob (anInt, 10000);
+
+    test::AllocationScope s1;
+    ASSERT_TRUE (verify (small.data(), small.size()));
+    auto a1 = s1.allocations();
+
+    test::AllocationScope s2;
+    ASSERT_TRUE (verify (large.data(), large.size()));
+    auto a2 = s2.allocations();
+
+    EXPECT_EQ (a1, a2);
+}
+
+/******************************************************************************/
+
+/**
+ * Every type in the schema is listed, composite and restricted alike,
+ * without the payload being touched
+ */
+TEST (Blob, fingerprints) { // NOLINT
+    auto b = blob (anInt);
+
+    amqp::internal::wire::Blob blob (b.data(), b.size());
+
+    std::vector<std::string_view> fingerprints { "stale" };
+    blob.fingerprints (fingerprints);
+
+    std::vector<std::string_view> expected {
+        "net.corda:A", "net.corda:LE", "net.corda:E" };
+
+    EXPECT_EQ (expected, fingerprints);
+    EXPECT_LT (blob.schemaStart(), blob.schemaEnd());
+    EXPECT_LE (blob.schemaEnd(), b.size());
+}
+
+/******************************************************************************/
+
+/**
+ * The extent of a blob is known as soon as its envelope's list header
+ * has been seen, however much follows it
+ */
+TEST (Blob, extent) { // NOLINT
+    auto b = blob (anInt);
+
+    std::optional<size_t> found;
+
+    for (size_t size { 0 } ; size <= b.size() && !found ; ++size) {
+        found = extent (b.data(), size);
+    }
+
+    ASSERT_TRUE (found);
+    EXPECT_EQ (b.size(), *found);
+
+    // followed by the start of another
+    auto two = b;
+    two.insert (two.end(), b.begin(), b.end());
+    EXPECT_EQ (b.size(), extent (two.data(), two.size()));
+
+    auto bad = b;
+    bad[2] = 'x';
+    EXPECT_THROW (extent (bad.data(), 3), Error); // NOLINT
+    EXPECT_THROW (extent (bad.data(), bad.size()), Error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * A type's name is found without the rest of the schema being decoded
+ */
+TEST (Blob, name) { // NOLINT
+    auto b = blob (anInt);
+
+    amqp::internal::wire::Blob blob (b.data(), b.size());
+
+    EXPECT_EQ ("net.corda.A", blob.name ("net.corda:A"));
+    EXPECT_EQ ("net.corda.E", blob.name ("net.corda:E"));
+    EXPECT_EQ ("", blob.name ("net.corda:B"));
+}
+
+/******************************************************************************
+ *
+ * Classifier Tests
+ *
+ ******************************************************************************/
+
+/**
+ * Only the first blob holding a type has its schema scanned, the rest
+ * are answered from the cache
+ */
+TEST (Classifier, classify) { // NOLINT
+    Classifier classifier;
+
+    auto b = blob (anInt);
+
+    for (int i { 0 } ; i < 3 ; ++i) {
+        auto c = classifier.classify (b.data(), b.size());
+
+        EXPECT_EQ ("net.corda:A", c.fingerprint);
+        EXPECT_EQ ("net.corda.A", c.name);
+        EXPECT_EQ (1U, classifier.size());
+    }
+
+    // a payload corrupted past its fingerprint isn't noticed
+    auto bad = blob (anInt, 3, 7);
+    EXPECT_EQ ("net.corda.A", classifier.classify (bad.data(), bad.size()).name);
+
+    // a broken header is
+    bad[0] = 'x';
+    EXPECT_THROW (classifier.classify (bad.data(), bad.size()), Error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * A blob whose schema doesn't describe its own payload still has a
+ * fingerprint, just no name
+ */
+TEST (Classifier, unnamed) { // NOLINT
+    auto b = schema().build ("net.corda:B", [](pn_data_t * data_) {
+        test::putList (data_, [](pn_data_t *) { });
+    });
+
+    Classifier classifier;
+
+    auto c = classifier.classify (b.data(), b.size());
+
+    EXPECT_EQ ("net.corda:B", c.fingerprint);
+    EXPECT_EQ ("", c.name);
+}
+
+/******************************************************************************/
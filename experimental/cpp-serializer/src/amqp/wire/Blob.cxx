@@ -0,0 +1,433 @@
+#include "Blob.h"
+
+#include <algorithm>
+
+#include <proton/codec.h>
+
+#include "TypeTable.h"
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+#include "amqp/schema/Descriptors.h"
+
+#include "schema/described-types/Schema.h"
+#include "schema/descriptors/AMQPDescriptors.h"
+
+/******************************************************************************/
+
+namespace {
+
+    uint64_t
+    corda (int id_) {
+        return static_cast<uint64_t>(id_)
+            | amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS;
+    }
+
+    /**
+     * Read the descriptor of a described value we expect to be one of
+     * Corda's own types
+     */
+    void
+    expectDescribed (amqp::internal::wire::Cursor & cursor_, int id_, const char * what_) {
+        using namespace amqp::internal::wire;
+
+        if (cursor_.code() != codes::DESCRIBED) {
+            cursor_.fail (std::string ("Expected a described ") + what_);
+        }
+
+        auto code = cursor_.code();
+
+        if (!Cursor::isULong (code) || cursor_.ulong (code) != corda (id_)) {
+            cursor_.fail (std::string ("Expected the ") + what_ + " descriptor");
+        }
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::wire::Blob
+ *
+ ******************************************************************************/
+
+amqp::internal::wire::
+Blob::Blob (const char * bytes_, size_t size_)
+    : m_bytes (bytes_)
+    , m_size (size_)
+{
+    const size_t header = amqp::AMQP_HEADER.size() + 1;
+
+    if (size_ < header
+        || !std::equal (amqp::AMQP_HEADER.begin(), amqp::AMQP_HEADER.end(), bytes_))
+    {
+        throw Error ("Not a Corda blob", 0);
+    }
+
+    if (bytes_[header - 1] != amqp::DATA_AND_STOP) {
+        throw Error ("Unsupported encoding", header - 1);
+    }
+
+    Cursor cursor (bytes_ + header, size_ - header, header);
+
+    expectDescribed (cursor, amqp::schema::descriptors::ENVELOPE, "envelope");
+
+    auto code = cursor.code();
+
+    if (!Cursor::isList (code)) {
+        cursor.fail ("Expected the envelope's list");
+    }
+
+    auto envelope = cursor.compound (code);
+
+    if (envelope.count != 2 && envelope.count != 3) {
+        cursor.fail ("Envelope should hold an object, schema and transforms");
+    }
+
+    m_object = cursor.offset();
+    cursor.skip();
+
+    m_schema = cursor.offset();
+    expectDescribed (cursor, amqp::schema::descriptors::SCHEMA, "schema");
+    cursor.skip();
+    m_schemaEnd = cursor.offset();
+
+    if (envelope.count == 3) {
+        expectDescribed (
+            cursor, amqp::schema::descriptors::TRANSFORM_SCHEMA, "transform schema");
+
+        if (!Cursor::isMap (cursor.peek())) {
+            cursor.fail ("Expected a map of transforms");
+        }
+
+        cursor.skip();
+    }
+
+    if (cursor.offset() != envelope.end) {
+        cursor.fail ("Envelope size doesn't match its contents");
+    }
+
+    if (!cursor.atEnd()) {
+        cursor.fail ("Trailing bytes after the envelope");
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::wire::Cursor
+amqp::internal::wire::
+Blob::object() const {
+    return Cursor (m_bytes + m_object, m_schema - m_object, m_object);
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::wire::
+Blob::descriptor() const {
+    auto cursor = object();
+
+    if (cursor.code() != codes::DESCRIBED) {
+        cursor.fail ("Expected a described object");
+    }
+
+    auto code = cursor.code();
+
+    if (!Cursor::isSymbol (code)) {
+        cursor.fail ("Expected a fingerprint");
+    }
+
+    return cursor.bytes (code);
+}
+
+/******************************************************************************/
+
+/**
+ * The schema is the only part of the blob we need in memory, decode
+ * just its bytes with proton and build it the same way the envelope
+ * would
+ */
+std::unique_ptr<amqp::internal::schema::Schema>
+amqp::internal::wire::
+Blob::schema() const {
+    return decodeSchema (m_bytes + m_schema, m_schemaEnd - m_schema, m_schema);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::wire::
+Blob::fingerprints (std::vector<std::string_view> & out_) const {
+    out_.clear();
+
+    walk ([&out_](std::string_view, std::string_view fingerprint_) {
+        out_.push_back (fingerprint_);
+        return true;
+    });
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::wire::
+Blob::name (std::string_view fingerprint_) const {
+    std::string_view rtn;
+
+    walk ([&](std::string_view name_, std::string_view fingerprint) {
+        if (fingerprint != fingerprint_) {
+            return true;
+        }
+
+        rtn = name_;
+        return false;
+    });
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+/**
+ * Every type notation is a described list, its name heads the list and
+ * the fingerprint is the symbol heading the list that describes the type,
+ * which for a composite follows its name, label and provides and for a
+ * restricted type its source as well. Everything else is skipped by size.
+ */
+void
+amqp::internal::wire::
+Blob::walk (
+    const std::function<bool (std::string_view, std::string_view)> & f_
+) const {
+    Cursor cursor (m_bytes + m_schema, m_schemaEnd - m_schema, m_schema);
+
+    expectDescribed (cursor, amqp::schema::descriptors::SCHEMA, "schema");
+
+    auto code = cursor.code();
+
+    if (!Cursor::isList (code) || cursor.compound (code).count != 1) {
+        cursor.fail ("Expected the schema's list");
+    }
+
+    code = cursor.code();
+
+    if (!Cursor::isList (code)) {
+        cursor.fail ("Expected a list of types");
+    }
+
+    auto types = cursor.compound (code);
+
+    for (uint32_t i { 0 } ; i < types.count ; ++i) {
+        if (cursor.code() != codes::DESCRIBED) {
+            cursor.fail ("Expected a type notation");
+        }
+
+        code = cursor.code();
+
+        if (!Cursor::isULong (code)) {
+            cursor.fail ("Expected a type notation's descriptor");
+        }
+
+        auto id = cursor.ulong (code);
+        uint32_t at;
+
+        if (id == corda (amqp::schema::descriptors::COMPOSITE_TYPE)) {
+            at = 3;
+        } else if (id == corda (amqp::schema::descriptors::RESTRICTED_TYPE)) {
+            at = 4;
+        } else {
+            cursor.fail ("Unknown type notation");
+        }
+
+        code = cursor.code();
+
+        if (!Cursor::isList (code)) {
+            cursor.fail ("Expected a type notation's list");
+        }
+
+        auto type = cursor.compound (code);
+
+        if (type.count <= at) {
+            cursor.fail ("Type notation is missing its descriptor");
+        }
+
+        code = cursor.code();
+
+        if (!Cursor::isString (code) && !Cursor::isSymbol (code)) {
+            cursor.fail ("Expected a type's name");
+        }
+
+        auto name = cursor.bytes (code);
+
+        for (uint32_t j { 1 } ; j < at ; ++j) {
+            cursor.skip();
+        }
+
+        expectDescribed (cursor, amqp::schema::descriptors::OBJECT, "type's descriptor");
+
+        code = cursor.code();
+
+        if (!Cursor::isList (code) || cursor.compound (code).count == 0) {
+            cursor.fail ("Expected a type's descriptor list");
+        }
+
+        code = cursor.code();
+
+        if (!Cursor::isSymbol (code)) {
+            cursor.fail ("Expected a fingerprint");
+        }
+
+        if (!f_ (name, cursor.bytes (code))) {
+            return;
+        }
+
+        cursor.seek (type.end);
+    }
+}
+
+/******************************************************************************/
+
+std::unique_ptr<amqp::internal::wire::TypeTable>
+amqp::internal::wire::
+Blob::types() const {
+    auto schema = this->schema();
+
+    try {
+        return std::make_unique<TypeTable> (*schema);
+    } catch (const std::runtime_error & e) {
+        throw Error (e.what(), m_schema);
+    }
+}
+
+/******************************************************************************/
+
+std::unique_ptr<amqp::internal::schema::Schema>
+amqp::internal::wire::
+decodeSchema (const char * bytes_, size_t size_, size_t offset_) {
+    std::unique_ptr<pn_data_t, decltype (&pn_data_free)> data {
+        pn_data (0), &pn_data_free };
+
+    auto size = static_cast<ssize_t>(size_);
+
+    if (pn_data_decode (data.get(), bytes_, size) != size) {
+        throw Error ("Malformed schema", offset_);
+    }
+
+    pn_data_rewind (data.get());
+    pn_data_next (data.get());
+
+    try {
+        return amqp::internal::schema::descriptors::dispatchDescribed<
+            amqp::internal::schema::Schema> (data.get());
+    } catch (const std::runtime_error & e) {
+        throw Error (e.what(), offset_);
+    }
+}
+
+/******************************************************************************/
+
+std::optional<size_t>
+amqp::internal::wire::
+extent (const char * bytes_, size_t size_) {
+    const size_t header = amqp::AMQP_HEADER.size() + 1;
+
+    auto magic = std::min (size_, amqp::AMQP_HEADER.size());
+
+    if (!std::equal (amqp::AMQP_HEADER.begin(), amqp::AMQP_HEADER.begin() + magic, bytes_)) {
+        throw Error ("Not a Corda blob", 0);
+    }
+
+    if (size_ < header) {
+        return std::nullopt;
+    }
+
+    if (bytes_[header - 1] != amqp::DATA_AND_STOP) {
+        throw Error ("Unsupported encoding", header - 1);
+    }
+
+    const auto * p = reinterpret_cast<const uint8_t *>(bytes_);
+    size_t at { header };
+
+    // the big endian number at [at], or nothing if it's not all there
+    auto number = [&](size_t width_) -> std::optional<size_t> {
+        if (at + width_ > size_) {
+            return std::nullopt;
+        }
+
+        size_t rtn { 0 };
+
+        for (size_t i { 0 } ; i < width_ ; ++i) {
+            rtn = (rtn << 8) | p[at + i];
+        }
+
+        at += width_;
+
+        return rtn;
+    };
+
+    if (at + 2 > size_) {
+        return std::nullopt;
+    }
+
+    if (p[at++] != codes::DESCRIBED) {
+        throw Error ("Expected a described envelope", at - 1);
+    }
+
+    switch (auto code = p[at++]) {
+        case codes::ULONG0 :
+            break;
+        case codes::SMALLULONG :
+            at += 1;
+            break;
+        case codes::ULONG :
+            at += 8;
+            break;
+        case codes::SYM8 :
+        case codes::SYM32 : {
+            auto length = number (code == codes::SYM8 ? 1 : 4);
+
+            if (!length) {
+                return std::nullopt;
+            }
+
+            at += *length;
+            break;
+        }
+        default :
+            throw Error ("Expected the envelope descriptor", at - 1);
+    }
+
+    if (at >= size_) {
+        return std::nullopt;
+    }
+
+    std::optional<size_t> body;
+
+    switch (p[at++]) {
+        case codes::LIST0 :
+            body = 0;
+            break;
+        case codes::LIST8 :
+            body = number (1);
+            break;
+        case codes::LIST32 :
+            body = number (4);
+            break;
+        default :
+            throw Error ("Expected the envelope's list", at - 1);
+    }
+
+    if (!body) {
+        return std::nullopt;
+    }
+
+    return at + *body;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::wire::
+isReference (uint64_t descriptor_) {
+    return descriptor_ == corda (amqp::schema::descriptors::REFERENCED_OBJECT);
+}
+
+/******************************************************************************/
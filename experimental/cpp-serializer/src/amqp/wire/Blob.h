@@ -0,0 +1,128 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <memory>
+#include <vector>
+#include <optional>
+#include <functional>
+#include <string_view>
+
+#include "Cursor.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    class Schema;
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::wire {
+
+    class TypeTable;
+
+    /**
+     * A complete Corda blob, header and all, split into its sections
+     * without decoding any of them. Construction checks the header and
+     * the shape of the envelope, throwing an [Error] if either is wrong.
+     * All offsets are from the start of the blob.
+     */
+    class Blob {
+        private :
+            const char * m_bytes;
+            size_t       m_size;
+
+            size_t m_object;
+            size_t m_schema;
+            size_t m_schemaEnd;
+
+            /**
+             * Call [f_] with the name and fingerprint of each type in the
+             * schema, in order, until it returns false
+             */
+            void walk (
+                const std::function<bool (std::string_view, std::string_view)> & f_) const;
+
+        public :
+            Blob (const char *, size_t);
+
+            /**
+             * A cursor positioned at the payload
+             */
+            Cursor object() const;
+
+            /**
+             * The offset of the payload and the offset of the first byte
+             * after it
+             */
+            size_t objectStart() const { return m_object; }
+            size_t objectEnd() const { return m_schema; }
+
+            /**
+             * The fingerprint of the payload's outermost type, a view into
+             * the blob
+             */
+            std::string_view descriptor() const;
+
+            size_t schemaStart() const { return m_schema; }
+            size_t schemaEnd() const { return m_schemaEnd; }
+
+            /**
+             * Replace the contents of [out_] with the fingerprint of every
+             * type in the schema, in the order they're listed, by walking
+             * the bytes rather than decoding them. The views point into
+             * the blob.
+             */
+            void fingerprints (std::vector<std::string_view> & out_) const;
+
+            /**
+             * The name of the type in the schema with [fingerprint_],
+             * found the same way as above and stopping as soon as it is,
+             * or empty if there's no such type. A view into the blob.
+             */
+            std::string_view name (std::string_view fingerprint_) const;
+
+            /**
+             * Decode just the schema section, an [Error] at the start of
+             * the schema if it's malformed
+             */
+            std::unique_ptr<schema::Schema> schema() const;
+
+            /**
+             * The schema compiled down for walking the payload
+             */
+            std::unique_ptr<TypeTable> types() const;
+
+            const char * bytes() const { return m_bytes; }
+            size_t size() const { return m_size; }
+    };
+
+    /**
+     * Decode a schema section on its own, [offset_] being where it sits
+     * in its blob so an [Error] thrown if it's malformed can say so
+     */
+    std::unique_ptr<schema::Schema> decodeSchema (
+        const char * bytes_, size_t size_, size_t offset_);
+
+    /**
+     * How many bytes the blob starting at [bytes_] occupies, header and
+     * all, worked out from the size of its envelope's list. Used to find
+     * where one blob ends and the next begins when they're written back
+     * to back. Returns nullopt if [size_] bytes aren't enough to tell and
+     * throws an [Error] if they can't be the start of a blob.
+     */
+    std::optional<size_t> extent (const char * bytes_, size_t size_);
+
+    /**
+     * Whether [descriptor_], read from a described value, marks it as a
+     * reference to an object written earlier in the stream rather than
+     * an object in its own right
+     */
+    bool isReference (uint64_t descriptor_);
+
+}
+
+/******************************************************************************/
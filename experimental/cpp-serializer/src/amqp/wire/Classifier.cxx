@@ -0,0 +1,28 @@
+#include "Classifier.h"
+
+#include "Blob.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::wire::Classifier
+ *
+ ******************************************************************************/
+
+amqp::internal::wire::Classification
+amqp::internal::wire::
+Classifier::classify (const char * blob_, size_t size_) {
+    Blob blob (blob_, size_);
+
+    auto fingerprint = blob.descriptor();
+    auto it = m_names.find (fingerprint);
+
+    if (it == m_names.end()) {
+        it = m_names.emplace (
+            std::string (fingerprint),
+            std::string (blob.name (fingerprint))).first;
+    }
+
+    return { fingerprint, it->second };
+}
+
+/******************************************************************************/
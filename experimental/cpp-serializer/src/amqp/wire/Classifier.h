@@ -0,0 +1,57 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <string>
+#include <string_view>
+
+/******************************************************************************/
+
+namespace amqp::internal::wire {
+
+    /**
+     * What a blob holds, the fingerprint and name of its outermost type
+     */
+    struct Classification {
+        /**
+         * A view into the blob
+         */
+        std::string_view fingerprint;
+
+        /**
+         * A view into the classifier's cache, empty if the blob's schema
+         * doesn't list its own outer type
+         */
+        std::string_view name;
+    };
+
+    /**
+     * Says what type a blob holds without decoding its schema or payload.
+     * The envelope is walked by size to the payload's fingerprint which
+     * is looked up in a cache of those seen before. Only a fingerprint
+     * new to the cache costs a scan of the schema, and then only as far
+     * as the matching type. Classifying a corpus thus touches little
+     * more than the first few dozen bytes of most blobs.
+     *
+     * Not thread safe, use one per thread.
+     */
+    class Classifier {
+        private :
+            std::map<std::string, std::string, std::less<>> m_names;
+
+        public :
+            /**
+             * @throws Error if the blob is malformed
+             */
+            Classification classify (const char * blob_, size_t size_);
+
+            /**
+             * How many distinct types have been seen
+             */
+            size_t size() const { return m_names.size(); }
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,391 @@
+#include "Cursor.h"
+
+#include <cstring>
+
+/******************************************************************************
+ *
+ * amqp::internal::wire::Error
+ *
+ ******************************************************************************/
+
+amqp::internal::wire::
+Error::Error (const std::string & what_, size_t offset_)
+    : std::runtime_error (what_)
+    , m_offset (offset_)
+{ }
+
+/******************************************************************************
+ *
+ * amqp::internal::wire::Cursor
+ *
+ ******************************************************************************/
+
+amqp::internal::wire::
+Cursor::Cursor (const char * bytes_, size_t size_, size_t base_)
+    : m_start (reinterpret_cast<const uint8_t *>(bytes_))
+    , m_pos (m_start)
+    , m_end (m_start + size_)
+    , m_base (base_)
+{ }
+
+/******************************************************************************/
+
+size_t
+amqp::internal::wire::
+Cursor::offset() const {
+    return m_base + (m_pos - m_start);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::wire::
+Cursor::seek (size_t offset_) {
+    if (offset_ < m_base || offset_ - m_base > static_cast<size_t>(m_end - m_start)) {
+        fail ("Seek outside of the buffer");
+    }
+
+    m_pos = m_start + (offset_ - m_base);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::wire::
+Cursor::fail (const std::string & what_) const {
+    throw Error (what_, offset());
+}
+
+/******************************************************************************/
+
+const uint8_t *
+amqp::internal::wire::
+Cursor::take (size_t size_) {
+    if (static_cast<size_t>(m_end - m_pos) < size_) {
+        fail ("Unexpected end of data");
+    }
+
+    auto rtn = m_pos;
+    m_pos += size_;
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+template<typename T>
+T
+amqp::internal::wire::
+Cursor::bigEndian() {
+    auto p = take (sizeof (T));
+
+    T rtn { 0 };
+
+    for (size_t i { 0 } ; i < sizeof (T) ; ++i) {
+        rtn = static_cast<T>((rtn << 8U) | p[i]);
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+uint8_t
+amqp::internal::wire::
+Cursor::peek() const {
+    if (m_pos == m_end) {
+        fail ("Unexpected end of data");
+    }
+
+    return *m_pos;
+}
+
+/******************************************************************************/
+
+uint8_t
+amqp::internal::wire::
+Cursor::code() {
+    return *take (1);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::wire::
+Cursor::skip (uint8_t code_) {
+    /*
+     * A described value is two more values, its descriptor and the value
+     * itself, and a descriptor can be described in turn. Rather than
+     * recurse into them, which a chain of DESCRIBED codes in a corrupt
+     * blob would turn into a stack overflow, we count off the values
+     * still to be skipped.
+     */
+    for (size_t remaining { 1 } ; ; code_ = code()) {
+        --remaining;
+
+        if (code_ == codes::DESCRIBED) {
+            remaining += 2;
+            continue;
+        }
+
+        /*
+         * The top nibble of a format code gives the width of what follows,
+         * fixed width for 0x4 to 0x9, a one or four byte size for the
+         * variable and compound categories
+         */
+        switch (code_ >> 4U) {
+            case 0x4 : break;
+            case 0x5 : take (1); break;
+            case 0x6 : take (2); break;
+            case 0x7 : take (4); break;
+            case 0x8 : take (8); break;
+            case 0x9 : take (16); break;
+            case 0xa :
+            case 0xc :
+            case 0xe : take (bigEndian<uint8_t>()); break;
+            case 0xb :
+            case 0xd :
+            case 0xf : take (bigEndian<uint32_t>()); break;
+            default  :
+                m_pos -= 1;
+                fail ("Invalid format code " + std::to_string (code_));
+        }
+
+        if (!remaining) return;
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::wire::
+Cursor::skip() {
+    skip (code());
+}
+
+/******************************************************************************/
+
+amqp::internal::wire::Compound
+amqp::internal::wire::
+Cursor::compound (uint8_t code_) {
+    uint32_t size, count;
+
+    switch (code_) {
+        case codes::LIST0 :
+            return { 0, offset() };
+        case codes::LIST8 :
+        case codes::MAP8 :
+        case codes::ARRAY8 :
+            size = bigEndian<uint8_t>();
+            if (size < 1) fail ("Compound too small for its count");
+            count = bigEndian<uint8_t>();
+            size -= 1;
+            break;
+        case codes::LIST32 :
+        case codes::MAP32 :
+        case codes::ARRAY32 :
+            size = bigEndian<uint32_t>();
+            if (size < 4) fail ("Compound too small for its count");
+            count = bigEndian<uint32_t>();
+            size -= 4;
+            break;
+        default :
+            fail ("Expected a list, map or array");
+    }
+
+    if (static_cast<size_t>(m_end - m_pos) < size) {
+        fail ("Compound overruns the data");
+    }
+
+    if (isMap (code_) && count % 2 != 0) {
+        fail ("Map with an odd number of elements");
+    }
+
+    return { count, offset() + size };
+}
+
+/******************************************************************************/
+
+uint64_t
+amqp::internal::wire::
+Cursor::ulong (uint8_t code_) {
+    switch (code_) {
+        case codes::ULONG0 : return 0;
+        case codes::SMALLULONG : return bigEndian<uint8_t>();
+        case codes::ULONG : return bigEndian<uint64_t>();
+        case codes::UINT0 : return 0;
+        case codes::SMALLUINT : return bigEndian<uint8_t>();
+        case codes::UINT : return bigEndian<uint32_t>();
+        default : fail ("Expected an unsigned integer");
+    }
+}
+
+/******************************************************************************/
+
+int64_t
+amqp::internal::wire::
+Cursor::integer (uint8_t code_) {
+    switch (code_) {
+        case codes::SMALLINT : return static_cast<int8_t>(bigEndian<uint8_t>());
+        case codes::INT : return static_cast<int32_t>(bigEndian<uint32_t>());
+        case codes::SMALLLONG : return static_cast<int8_t>(bigEndian<uint8_t>());
+        case codes::LONG : return static_cast<int64_t>(bigEndian<uint64_t>());
+        default : fail ("Expected a signed integer");
+    }
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::wire::
+Cursor::boolean (uint8_t code_) {
+    switch (code_) {
+        case codes::TRUE_ : return true;
+        case codes::FALSE_ : return false;
+        case codes::BOOLEAN : {
+            auto b = bigEndian<uint8_t>();
+            if (b > 1) fail ("Invalid boolean");
+            return b == 1;
+        }
+        default : fail ("Expected a boolean");
+    }
+}
+
+/******************************************************************************/
+
+double
+amqp::internal::wire::
+Cursor::real (uint8_t code_) {
+    switch (code_) {
+        case codes::FLOAT : {
+            auto bits = bigEndian<uint32_t>();
+            float f;
+            std::memcpy (&f, &bits, sizeof (f));
+            return f;
+        }
+        case codes::DOUBLE : {
+            auto bits = bigEndian<uint64_t>();
+            double d;
+            std::memcpy (&d, &bits, sizeof (d));
+            return d;
+        }
+        default : fail ("Expected a floating point number");
+    }
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::wire::
+Cursor::bytes (uint8_t code_) {
+    size_t size;
+
+    switch (code_) {
+        case codes::VBIN8 :
+        case codes::STR8 :
+        case codes::SYM8 :
+            size = bigEndian<uint8_t>();
+            break;
+        case codes::VBIN32 :
+        case codes::STR32 :
+        case codes::SYM32 :
+            size = bigEndian<uint32_t>();
+            break;
+        default :
+            fail ("Expected a string, symbol or binary");
+    }
+
+    auto p = take (size);
+
+    return { reinterpret_cast<const char *>(p), size };
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::wire::
+Cursor::isList (uint8_t code_) {
+    return code_ == codes::LIST0 || code_ == codes::LIST8 || code_ == codes::LIST32;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::wire::
+Cursor::isMap (uint8_t code_) {
+    return code_ == codes::MAP8 || code_ == codes::MAP32;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::wire::
+Cursor::isArray (uint8_t code_) {
+    return code_ == codes::ARRAY8 || code_ == codes::ARRAY32;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::wire::
+Cursor::isString (uint8_t code_) {
+    return code_ == codes::STR8 || code_ == codes::STR32;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::wire::
+Cursor::isSymbol (uint8_t code_) {
+    return code_ == codes::SYM8 || code_ == codes::SYM32;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::wire::
+Cursor::isBinary (uint8_t code_) {
+    return code_ == codes::VBIN8 || code_ == codes::VBIN32;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::wire::
+Cursor::isUInt (uint8_t code_) {
+    return code_ == codes::UINT0 || code_ == codes::SMALLUINT || code_ == codes::UINT;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::wire::
+Cursor::isULong (uint8_t code_) {
+    return code_ == codes::ULONG0 || code_ == codes::SMALLULONG || code_ == codes::ULONG;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::wire::
+Cursor::isInt (uint8_t code_) {
+    return code_ == codes::SMALLINT || code_ == codes::INT;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::wire::
+Cursor::isLong (uint8_t code_) {
+    return code_ == codes::SMALLLONG || code_ == codes::LONG;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::wire::
+Cursor::isBoolean (uint8_t code_) {
+    return code_ == codes::TRUE_ || code_ == codes::FALSE_ || code_ == codes::BOOLEAN;
+}
+
+/******************************************************************************/
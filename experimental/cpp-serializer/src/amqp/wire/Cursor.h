@@ -0,0 +1,197 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+
+/******************************************************************************/
+
+/**
+ * AMQP 1.0 format codes, see section 1.6 of the type system spec
+ */
+namespace amqp::internal::wire::codes {
+
+    constexpr uint8_t DESCRIBED   = 0x00;
+    constexpr uint8_t NULL_       = 0x40;
+    constexpr uint8_t TRUE_       = 0x41;
+    constexpr uint8_t FALSE_      = 0x42;
+    constexpr uint8_t UINT0       = 0x43;
+    constexpr uint8_t ULONG0      = 0x44;
+    constexpr uint8_t LIST0       = 0x45;
+    constexpr uint8_t UBYTE       = 0x50;
+    constexpr uint8_t BYTE        = 0x51;
+    constexpr uint8_t SMALLUINT   = 0x52;
+    constexpr uint8_t SMALLULONG  = 0x53;
+    constexpr uint8_t SMALLINT    = 0x54;
+    constexpr uint8_t SMALLLONG   = 0x55;
+    constexpr uint8_t BOOLEAN     = 0x56;
+    constexpr uint8_t USHORT      = 0x60;
+    constexpr uint8_t SHORT       = 0x61;
+    constexpr uint8_t UINT        = 0x70;
+    constexpr uint8_t INT         = 0x71;
+    constexpr uint8_t FLOAT       = 0x72;
+    constexpr uint8_t CHAR        = 0x73;
+    constexpr uint8_t DECIMAL32   = 0x74;
+    constexpr uint8_t ULONG       = 0x80;
+    constexpr uint8_t LONG        = 0x81;
+    constexpr uint8_t DOUBLE      = 0x82;
+    constexpr uint8_t TIMESTAMP   = 0x83;
+    constexpr uint8_t DECIMAL64   = 0x84;
+    constexpr uint8_t DECIMAL128  = 0x94;
+    constexpr uint8_t UUID        = 0x98;
+    constexpr uint8_t VBIN8       = 0xa0;
+    constexpr uint8_t STR8        = 0xa1;
+    constexpr uint8_t SYM8        = 0xa3;
+    constexpr uint8_t VBIN32      = 0xb0;
+    constexpr uint8_t STR32       = 0xb1;
+    constexpr uint8_t SYM32       = 0xb3;
+    constexpr uint8_t LIST8       = 0xc0;
+    constexpr uint8_t MAP8        = 0xc1;
+    constexpr uint8_t LIST32      = 0xd0;
+    constexpr uint8_t MAP32       = 0xd1;
+    constexpr uint8_t ARRAY8      = 0xe0;
+    constexpr uint8_t ARRAY32     = 0xf0;
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::wire {
+
+    /**
+     * Thrown when the bytes under a [Cursor] aren't what they should be,
+     * carries the offset of the offending byte
+     */
+    class Error : public std::runtime_error {
+        private :
+            size_t m_offset;
+
+        public :
+            Error (const std::string &, size_t);
+
+            size_t offset() const { return m_offset; }
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::wire {
+
+    /**
+     * How deeply values may nest before a walk over them gives up. Blobs
+     * come from outside so a corrupt one mustn't be able to run a
+     * recursive walk out of stack.
+     */
+    constexpr size_t MAX_DEPTH { 256 };
+
+    /**
+     * The header of a list, map or array, [count] elements encoded in the
+     * bytes up to [end]
+     */
+    struct Compound {
+        uint32_t count;
+        size_t   end;
+    };
+
+    /**
+     * Walks AMQP encoded bytes in place. Nothing is decoded into a tree
+     * and nothing is copied, values are either skipped or handed back as
+     * views of the underlying buffer, so the cost of a walk is a single
+     * pass over the bytes.
+     *
+     * Reads take the format code of the value as a parameter so the same
+     * calls can read both a value and the elements of an array, where
+     * one constructor is shared by every element. Arrays of described
+     * types put the descriptor in that shared constructor, between the
+     * DESCRIBED code and the code of the elements.
+     */
+    class Cursor {
+        private :
+            const uint8_t * m_start;
+            const uint8_t * m_pos;
+            const uint8_t * m_end;
+
+            /**
+             * Offset of [m_start] within whatever we are a window onto,
+             * used only so errors report an offset a user can find
+             */
+            size_t m_base;
+
+            const uint8_t * take (size_t);
+
+            template<typename T>
+            T bigEndian();
+
+        public :
+            Cursor (const char *, size_t, size_t base_ = 0);
+
+            /**
+             * Offset of the next byte to be read
+             */
+            size_t offset() const;
+
+            bool atEnd() const { return m_pos == m_end; }
+
+            /**
+             * The next byte to be read, for comparing raw encodings
+             */
+            const char * data() const { return reinterpret_cast<const char *>(m_pos); }
+
+            /**
+             * Continue from [offset_], as returned by [offset]
+             */
+            void seek (size_t offset_);
+
+            [[noreturn]] void fail (const std::string &) const;
+
+            /**
+             * The next format code without consuming it
+             */
+            uint8_t peek() const;
+
+            uint8_t code();
+
+            /**
+             * Skip the body of a value whose format code has already been
+             * read
+             */
+            void skip (uint8_t code_);
+
+            /**
+             * Skip an entire value, constructor and all
+             */
+            void skip();
+
+            Compound compound (uint8_t code_);
+
+            uint64_t ulong (uint8_t code_);
+            int64_t integer (uint8_t code_);
+            bool boolean (uint8_t code_);
+            double real (uint8_t code_);
+
+            /**
+             * The bytes of a string, symbol or binary value
+             */
+            std::string_view bytes (uint8_t code_);
+
+            static bool isList (uint8_t code_);
+            static bool isMap (uint8_t code_);
+            static bool isArray (uint8_t code_);
+            static bool isString (uint8_t code_);
+            static bool isSymbol (uint8_t code_);
+            static bool isBinary (uint8_t code_);
+            static bool isUInt (uint8_t code_);
+            static bool isULong (uint8_t code_);
+            static bool isInt (uint8_t code_);
+            static bool isLong (uint8_t code_);
+            static bool isBoolean (uint8_t code_);
+    };
+
+}
+
+/******************************************************************************/
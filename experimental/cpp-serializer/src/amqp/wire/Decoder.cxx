@@ -0,0 +1,386 @@
+#include "Decoder.h"
+
+#include <algorithm>
+
+#include "Blob.h"
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+#include "amqp/schema/Descriptors.h"
+
+#include "schema/described-types/Schema.h"
+
+/******************************************************************************/
+
+namespace {
+
+    constexpr size_t HEADER { amqp::AMQP_HEADER.size() + 1 };
+
+    uint64_t
+    corda (int id_) {
+        return static_cast<uint64_t>(id_)
+            | amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS;
+    }
+
+    uint32_t
+    bigEndian (const uint8_t * p_) {
+        return (uint32_t { p_[0] } << 24U) | (uint32_t { p_[1] } << 16U)
+            | (uint32_t { p_[2] } << 8U) | uint32_t { p_[3] };
+    }
+
+    /**
+     * The header of the list or map at [p_], [offset_] into the blob
+     */
+    amqp::internal::wire::Compound
+    compound (uint8_t code_, const uint8_t * p_, size_t offset_) {
+        using namespace amqp::internal::wire;
+
+        uint32_t size, count;
+        size_t width;
+
+        switch (code_) {
+            case codes::LIST0 :
+                return { 0, offset_ + 1 };
+            case codes::LIST8 :
+            case codes::MAP8 :
+                size = p_[1];
+                count = p_[2];
+                width = 1;
+                break;
+            default :
+                size = bigEndian (p_ + 1);
+                count = bigEndian (p_ + 5);
+                width = 4;
+                break;
+        }
+
+        if (size < width) {
+            throw Error ("Compound too small for its count", offset_);
+        }
+
+        if (Cursor::isMap (code_) && count % 2 != 0) {
+            throw Error ("Map with an odd number of elements", offset_);
+        }
+
+        return { count, offset_ + 1 + width + size };
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::wire::Decoder
+ *
+ ******************************************************************************/
+
+amqp::internal::wire::
+Decoder::Decoder (Handler handler_)
+    : m_handler (std::move (handler_))
+    , m_header (true)
+    , m_offset (0)
+    , m_schemaStart (0)
+{ }
+
+/******************************************************************************/
+
+amqp::internal::wire::
+Decoder::~Decoder() = default;
+
+/******************************************************************************/
+
+void
+amqp::internal::wire::
+Decoder::feed (const char * bytes_, size_t size_) {
+    const auto * p = reinterpret_cast<const uint8_t *>(bytes_);
+    size_t at { 0 };
+
+    // finish off whatever the last chunk ended part way through, a byte
+    // at a time until we know how long it is and then in one go
+    while (!m_partial.empty() && at < size_) {
+        auto size = need (
+            reinterpret_cast<const uint8_t *>(m_partial.data()), m_partial.size());
+
+        auto take = size ? std::min (size - m_partial.size(), size_ - at) : 1;
+
+        m_partial.append (bytes_ + at, take);
+        at += take;
+
+        if (size && m_partial.size() == size) {
+            process (reinterpret_cast<const uint8_t *>(m_partial.data()), size);
+            m_partial.clear();
+        }
+    }
+
+    while (at < size_) {
+        auto size = need (p + at, size_ - at);
+
+        if (!size || size > size_ - at) {
+            m_partial.assign (bytes_ + at, size_ - at);
+            break;
+        }
+
+        process (p + at, size);
+        at += size;
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::wire::
+Decoder::finish() const {
+    if (!m_header || m_offset != 0 || !m_partial.empty()) {
+        throw Error ("Truncated blob", m_offset + m_partial.size());
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * How many bytes make up what starts at [p_], given [size_] of them, or
+ * zero if that's not enough to tell. Variable width values are taken
+ * whole, lists and maps just their size and count as their elements are
+ * taken one by one.
+ */
+size_t
+amqp::internal::wire::
+Decoder::need (const uint8_t * p_, size_t size_) const {
+    if (m_header) {
+        return HEADER;
+    }
+
+    auto code = p_[0];
+
+    switch (code >> 4U) {
+        case 0x4 : return 1;
+        case 0x5 : return 2;
+        case 0x6 : return 3;
+        case 0x7 : return 5;
+        case 0x8 : return 9;
+        case 0x9 : return 17;
+        case 0xa :
+        case 0xe : return size_ < 2 ? 0 : 2 + p_[1];
+        case 0xb :
+        case 0xf : return size_ < 5 ? 0 : 5 + size_t { bigEndian (p_ + 1) };
+        case 0xc : return 3;
+        case 0xd : return 9;
+        default  : break;
+    }
+
+    if (code == codes::DESCRIBED) {
+        return 1;
+    }
+
+    throw Error ("Invalid format code " + std::to_string (code), m_offset);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::wire::
+Decoder::process (const uint8_t * p_, size_t size_) {
+    auto offset = m_offset;
+    m_offset += size_;
+
+    if (m_header) {
+        if (!std::equal (amqp::AMQP_HEADER.begin(), amqp::AMQP_HEADER.end(), p_)) {
+            throw Error ("Not a Corda blob", 0);
+        }
+
+        if (p_[HEADER - 1] != amqp::DATA_AND_STOP) {
+            throw Error ("Unsupported encoding", HEADER - 1);
+        }
+
+        m_header = false;
+        return;
+    }
+
+    auto code = p_[0];
+    std::string_view encoded { reinterpret_cast<const char *>(p_ + 1), size_ - 1 };
+
+    if (m_stack.size() < 2) {
+        envelope (code, encoded, offset);
+        return;
+    }
+
+    auto & top = m_stack.back();
+    auto mode = top.mode;
+
+    // the payload, the schema and then any transforms
+    if (m_stack.size() == 2) {
+        mode = top.index == 0 ? Mode::emit : top.index == 1 ? Mode::collect : Mode::skip;
+    }
+
+    if (mode == Mode::collect) {
+        if (m_schemaBytes.empty()) {
+            m_schemaStart = offset;
+        }
+
+        m_schemaBytes.append (reinterpret_cast<const char *>(p_), size_);
+    }
+
+    if (top.described && top.index == 0) {
+        if (!Cursor::isULong (code) && !Cursor::isSymbol (code)) {
+            throw Error ("Expected a descriptor", offset);
+        }
+
+        if (m_types && mode == Mode::emit && Cursor::isSymbol (code)) {
+            Cursor cursor (encoded.data(), encoded.size(), offset + 1);
+            top.type = m_types->byDescriptor (cursor.bytes (code));
+        }
+
+        emit (mode, Event {
+            Event::Kind::described, offset, code, encoded, 0, top.field, top.type });
+
+        complete();
+        return;
+    }
+
+    std::string_view field;
+
+    if (!top.described && top.type && top.index < top.type->fields.size()) {
+        field = top.type->fields[top.index];
+    }
+
+    if (code == codes::DESCRIBED) {
+        m_stack.push_back (Frame { true, 2, 0, 0, mode, nullptr, field });
+        return;
+    }
+
+    if (Cursor::isList (code) || Cursor::isMap (code)) {
+        const Type * type = top.described ? top.type : nullptr;
+        auto header = compound (code, p_, offset);
+
+        emit (mode, Event {
+            Event::Kind::begin, offset, code, encoded, header.count, field, type });
+
+        if (header.count == 0) {
+            if (header.end != m_offset) {
+                throw Error ("Compound size doesn't match its contents", offset);
+            }
+
+            emit (mode, Event { Event::Kind::end, m_offset, code, { }, 0, { }, type });
+            complete();
+            return;
+        }
+
+        if (type && type->kind != Type::Kind::composite_t) {
+            type = nullptr;
+        }
+
+        m_stack.push_back (Frame { false, header.count, 0, header.end, mode, type, { } });
+        return;
+    }
+
+    emit (mode, Event { Event::Kind::value, offset, code, encoded, 0, field, nullptr });
+    complete();
+}
+
+/******************************************************************************/
+
+/**
+ * The envelope's descriptor and the list it describes, which holds the
+ * payload, the schema and possibly the transforms
+ */
+void
+amqp::internal::wire::
+Decoder::envelope (uint8_t code_, std::string_view encoded_, size_t offset_) {
+    if (m_stack.empty()) {
+        if (code_ != codes::DESCRIBED) {
+            throw Error ("Expected a described envelope", offset_);
+        }
+
+        m_stack.push_back (Frame { true, 2, 0, 0, Mode::skip, nullptr, { } });
+        return;
+    }
+
+    if (m_stack.back().index == 0) {
+        Cursor cursor (encoded_.data(), encoded_.size(), offset_ + 1);
+
+        if (!Cursor::isULong (code_) || cursor.ulong (code_) != corda (
+                amqp::schema::descriptors::ENVELOPE))
+        {
+            throw Error ("Expected the envelope descriptor", offset_);
+        }
+
+        complete();
+        return;
+    }
+
+    if (code_ != codes::LIST8 && code_ != codes::LIST32) {
+        throw Error ("Expected the envelope's list", offset_);
+    }
+
+    auto header = compound (
+        code_, reinterpret_cast<const uint8_t *>(encoded_.data()) - 1, offset_);
+
+    if (header.count != 2 && header.count != 3) {
+        throw Error ("Envelope should hold an object, schema and transforms", offset_);
+    }
+
+    m_stack.push_back (Frame { false, header.count, 0, header.end, Mode::skip, nullptr, { } });
+
+    m_handler (Event {
+        Event::Kind::envelope, offset_, code_, encoded_, header.count, { }, nullptr });
+}
+
+/******************************************************************************/
+
+/**
+ * Count off an element of the innermost list, map or described value,
+ * and of those enclosing it that it completes
+ */
+void
+amqp::internal::wire::
+Decoder::complete() {
+    while (!m_stack.empty()) {
+        auto & top = m_stack.back();
+
+        ++top.index;
+
+        if (m_stack.size() == 2 && top.index == 2) {
+            finishSchema();
+        }
+
+        if (--top.remaining > 0) {
+            return;
+        }
+
+        if (!top.described) {
+            if (top.end != m_offset) {
+                throw Error ("Compound size doesn't match its contents", m_offset);
+            }
+
+            emit (top.mode, Event { Event::Kind::end, m_offset, 0, { }, 0, { }, top.type });
+        }
+
+        m_stack.pop_back();
+    }
+
+    // that was the envelope
+    auto size = m_offset;
+
+    m_header = true;
+    m_offset = 0;
+
+    m_handler (Event { Event::Kind::blob, size, 0, { }, 0, { }, nullptr });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::wire::
+Decoder::finishSchema() {
+    m_schema = decodeSchema (m_schemaBytes.data(), m_schemaBytes.size(), m_schemaStart);
+    m_schemaBytes.clear();
+
+    try {
+        m_types = std::make_unique<TypeTable> (*m_schema);
+    } catch (const std::runtime_error & e) {
+        throw Error (e.what(), m_schemaStart);
+    }
+
+    m_handler (Event { Event::Kind::schema, m_schemaStart, 0, { }, 0, { }, nullptr });
+}
+
+/******************************************************************************/
@@ -0,0 +1,197 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+#include "Cursor.h"
+#include "TypeTable.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    class Schema;
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::wire {
+
+    /**
+     * Something a [Decoder] has finished reading. Offsets are from the
+     * start of the blob, header included, and views are only valid for
+     * the duration of the callback they're passed to.
+     */
+    struct Event {
+        enum class Kind {
+            envelope,   // the header and envelope have been read
+            described,  // the descriptor of a described value
+            begin,      // the start of a list or map
+            value,      // anything else, arrays included
+            end,        // the end of the list or map last begun
+            schema,     // the schema has been decoded
+            blob        // the whole blob has been read
+        };
+
+        Kind             kind;
+        size_t           offset;
+
+        /**
+         * The format code of the descriptor, compound or value and the
+         * bytes that followed it, what a [Cursor] reads given that code
+         */
+        uint8_t          code;
+        std::string_view encoded;
+
+        /**
+         * The number of elements of a list or map, twice the number of
+         * entries for a map
+         */
+        uint32_t         count;
+
+        /**
+         * The field of a composite this is the value of, for a described
+         * value given with its descriptor, if the composite's type is known
+         */
+        std::string_view field;
+
+        /**
+         * The type with the fingerprint a described value carries, and the
+         * begin and end of that type's composite, if known
+         */
+        const Type *     type;
+
+        Cursor cursor() const { return Cursor (encoded.data(), encoded.size(), offset + 1); }
+    };
+
+    /**
+     * Decodes Corda blobs pushed to it a chunk at a time, calling back
+     * with each event as soon as the bytes completing it arrive. Chunks
+     * can split a blob anywhere, only a value cut in two by the end of a
+     * chunk is copied, so memory is bounded by the largest single value
+     * and the schema rather than by the blob. Blobs can follow each other
+     * back to back.
+     *
+     * The payload comes before the schema that describes it, so types are
+     * only known when the fingerprints the payload carries were in an
+     * earlier blob's schema, as they typically are in a stream of blobs
+     * of the same kind. Until then composites come without field names.
+     *
+     * The schema is collected as it arrives and decoded once complete,
+     * any transforms are skipped. After an [Error] there's no way of
+     * knowing where the next blob starts, the decoder is of no further
+     * use.
+     *
+     * e.g.
+     *
+     *      Decoder decoder ([](const Event & event_) { ... });
+     *
+     *      for (auto chunk = stream.next() ; !chunk.empty() ; chunk = stream.next()) {
+     *          decoder.feed (chunk.data(), chunk.size());
+     *      }
+     *
+     *      decoder.finish();
+     */
+    class Decoder {
+        public :
+            using Handler = std::function<void (const Event &)>;
+
+        private :
+            enum class Mode : uint8_t { emit, collect, skip };
+
+            /**
+             * A described value, list or map we're inside. Described
+             * values have two elements, their descriptor then the value.
+             */
+            struct Frame {
+                bool             described;
+                uint32_t         remaining;
+                uint32_t         index;
+
+                /**
+                 * Offset of the first byte after a list or map
+                 */
+                size_t           end;
+
+                /**
+                 * What to do with the frame's elements
+                 */
+                Mode             mode;
+
+                /**
+                 * The type of a described value or the composite a list is
+                 */
+                const Type *     type;
+
+                /**
+                 * The field a described value is the value of
+                 */
+                std::string_view field;
+            };
+
+            Handler            m_handler;
+
+            bool               m_header;
+            size_t             m_offset;
+            std::vector<Frame> m_stack;
+
+            /**
+             * The start of a value the last chunk ended part way through
+             */
+            std::string        m_partial;
+
+            std::string        m_schemaBytes;
+            size_t             m_schemaStart;
+
+            std::unique_ptr<schema::Schema> m_schema;
+            std::unique_ptr<TypeTable>      m_types;
+
+            size_t need (const uint8_t *, size_t) const;
+            void process (const uint8_t *, size_t);
+            void envelope (uint8_t, std::string_view, size_t);
+            void complete();
+            void finishSchema();
+
+            void emit (Mode mode_, const Event & event_) const {
+                if (mode_ == Mode::emit) m_handler (event_);
+            }
+
+        public :
+            explicit Decoder (Handler);
+
+            Decoder (const Decoder &) = delete;
+
+            ~Decoder();
+
+            /**
+             * Decode as much as [bytes_] completes
+             *
+             * @throws Error if they can't be part of a blob
+             */
+            void feed (const char * bytes_, size_t size_);
+
+            /**
+             * Check the input ended between blobs
+             *
+             * @throws Error if it didn't
+             */
+            void finish() const;
+
+            /**
+             * The schema and types of the last blob whose schema has been
+             * read, null before then. Replaced by each schema event.
+             */
+            const schema::Schema * schema() const { return m_schema.get(); }
+            const TypeTable * types() const { return m_types.get(); }
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,322 @@
+#include "Text.h"
+
+#include <algorithm>
+
+#include "Blob.h"
+
+#include "amqp/json/Json.h"
+#include "proton/utf8.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::wire;
+
+    namespace json = amqp::internal::json;
+
+    void body (Cursor &, const Type &, uint8_t, std::string &, const Style &);
+
+    /**
+     * Whether the value of [type_] starting with [code_] is written as a
+     * JSON string, an enum is unless it's an ordinal or a reference
+     */
+    bool
+    quoted (const Cursor & cursor_, const Type & type_, uint8_t code_, const Style & style_) {
+        switch (type_.kind) {
+            case Type::Kind::string_t :
+            case Type::Kind::binary_t :
+                return code_ != codes::NULL_;
+            case Type::Kind::enum_t :
+                return code_ == codes::DESCRIBED
+                    && !style_.enums
+                    && Cursor::isSymbol (cursor_.peek());
+            default :
+                return false;
+        }
+    }
+
+    /**
+     * Elements of a list or array, all of [type_]
+     */
+    void
+    elements (
+        Cursor & cursor_,
+        const Type & type_,
+        uint8_t code_,
+        std::string & out_,
+        const Style & style_
+    ) {
+        auto collection = cursor_.compound (code_);
+
+        out_ += "[ ";
+
+        if (Cursor::isList (code_)) {
+            for (uint32_t i { 0 } ; i < collection.count ; ++i) {
+                if (i) out_ += ", ";
+                text (cursor_, type_, cursor_.code(), out_, style_);
+            }
+        } else {
+            auto code = cursor_.code();
+
+            if (code == codes::DESCRIBED) {
+                // the elements share a descriptor, for an array of an
+                // interface that of the implementation they all are
+                auto type = &type_;
+                auto descriptor = cursor_.code();
+
+                if (!Cursor::isSymbol (descriptor)) {
+                    cursor_.skip (descriptor);
+                } else if (!(type = type_.instance (cursor_.bytes (descriptor)))) {
+                    cursor_.fail ("Fingerprint doesn't match the expected type");
+                }
+
+                code = cursor_.code();
+
+                for (uint32_t i { 0 } ; i < collection.count ; ++i) {
+                    if (i) out_ += ", ";
+                    body (cursor_, *type, code, out_, style_);
+                }
+            } else {
+                for (uint32_t i { 0 } ; i < collection.count ; ++i) {
+                    if (i) out_ += ", ";
+                    text (cursor_, type_, code, out_, style_);
+                }
+            }
+        }
+
+        out_ += " ]";
+    }
+
+    /**
+     * The described part of a composite or restricted value
+     */
+    void
+    body (
+        Cursor & cursor_,
+        const Type & type_,
+        uint8_t code_,
+        std::string & out_,
+        const Style & style_
+    ) {
+        switch (type_.kind) {
+            case Type::Kind::composite_t : {
+                if (!Cursor::isList (code_)) {
+                    cursor_.fail ("Expected a list of fields");
+                }
+
+                auto list = cursor_.compound (code_);
+
+                out_ += "{ ";
+
+                for (uint32_t i { 0 } ; i < list.count ; ++i) {
+                    if (i >= type_.children.size()) {
+                        cursor_.fail ("More values than fields");
+                    }
+
+                    if (i) out_ += ", ";
+
+                    json::quote (type_.fields[i], out_);
+                    out_ += " : ";
+                    text (cursor_, *type_.children[i], cursor_.code(), out_, style_);
+                }
+
+                out_ += " }";
+
+                break;
+            }
+            case Type::Kind::list_t :
+            case Type::Kind::array_t : {
+                elements (cursor_, *type_.children[0], code_, out_, style_);
+                break;
+            }
+            case Type::Kind::map_t : {
+                if (!Cursor::isMap (code_)) {
+                    cursor_.fail ("Expected a map");
+                }
+
+                auto map = cursor_.compound (code_);
+
+                out_ += "{ ";
+
+                std::string key;
+
+                for (uint32_t i { 0 } ; i < map.count ; i += 2) {
+                    if (i) out_ += ", ";
+
+                    auto code = cursor_.code();
+                    auto quotes = quoted (cursor_, *type_.children[0], code, style_);
+
+                    key.clear();
+                    text (cursor_, *type_.children[0], code, key, style_);
+                    out_ += json::key (std::move (key), quotes);
+                    out_ += " : ";
+                    text (cursor_, *type_.children[1], cursor_.code(), out_, style_);
+                }
+
+                out_ += " }";
+
+                break;
+            }
+            case Type::Kind::enum_t : {
+                auto list = cursor_.compound (code_);
+
+                if (list.count != 2) {
+                    cursor_.fail ("Expected an enum's name and ordinal");
+                }
+
+                cursor_.skip();
+
+                auto ordinal = cursor_.integer (cursor_.code());
+
+                if (ordinal < 0 || static_cast<size_t>(ordinal) >= type_.constants.size()) {
+                    cursor_.fail ("Enum ordinal out of range");
+                }
+
+                if (style_.enums) {
+                    auto & enums = *style_.enums;
+
+                    if (std::find (enums.begin(), enums.end(), &type_) == enums.end()) {
+                        enums.push_back (&type_);
+                    }
+
+                    json::number (ordinal, out_);
+                } else {
+                    json::quote (type_.constants[ordinal], out_);
+                }
+
+                break;
+            }
+            default : {
+                cursor_.fail ("Primitive types aren't described");
+            }
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::wire::
+text (Cursor & cursor_, const Type & type_, const Style & style_) {
+    std::string rtn;
+
+    text (cursor_, type_, cursor_.code(), rtn, style_);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::wire::
+text (
+    Cursor & cursor_,
+    const Type & type_,
+    uint8_t code_,
+    std::string & out_,
+    const Style & style_
+) {
+    if (code_ == codes::NULL_) {
+        out_ += "null";
+        return;
+    }
+
+    switch (type_.kind) {
+        case Type::Kind::int_t :
+        case Type::Kind::long_t :
+            json::number (cursor_.integer (code_), out_);
+            return;
+        case Type::Kind::double_t :
+            json::number (cursor_.real (code_), out_);
+            return;
+        case Type::Kind::bool_t :
+            out_ += json::boolean (cursor_.boolean (code_));
+            return;
+        case Type::Kind::string_t : {
+            auto at = cursor_.offset() - 1;
+            auto str = cursor_.bytes (code_);
+
+            if (!proton::utf8::valid (str.data(), str.size())) {
+                throw Error ("String is not valid UTF-8", at);
+            }
+
+            json::quote (str, out_);
+            return;
+        }
+        case Type::Kind::binary_t :
+            json::hex (cursor_.bytes (code_), out_);
+            return;
+        default :
+            break;
+    }
+
+    if (code_ != codes::DESCRIBED) {
+        cursor_.fail ("Expected a described value");
+    }
+
+    auto descriptor = cursor_.code();
+    auto type = &type_;
+
+    if (Cursor::isSymbol (descriptor)) {
+        if (!(type = type_.instance (cursor_.bytes (descriptor)))) {
+            cursor_.fail ("Fingerprint doesn't match the expected type");
+        }
+    } else if (Cursor::isULong (descriptor) && isReference (cursor_.ulong (descriptor))) {
+        auto ref = std::to_string (cursor_.ulong (cursor_.code()));
+
+        if (style_.json) {
+            out_ += "{ \"$ref\" : ";
+            out_ += ref;
+            out_ += " }";
+        } else {
+            out_ += "<reference ";
+            out_ += ref;
+            out_ += ">";
+        }
+
+        return;
+    } else {
+        cursor_.fail ("Expected a fingerprint");
+    }
+
+    body (cursor_, *type, cursor_.code(), out_, style_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::wire::
+enumCodes (
+    Cursor & cursor_,
+    const Type & type_,
+    std::string & out_,
+    std::vector<const Type *> & enums_
+) {
+    enums_.clear();
+
+    out_ += "{ \"value\" : ";
+    text (cursor_, type_, cursor_.code(), out_, Style { true, &enums_ });
+    out_ += ", \"enums\" : { ";
+
+    for (size_t i { 0 } ; i < enums_.size() ; ++i) {
+        if (i) out_ += ", ";
+
+        json::quote (enums_[i]->name, out_);
+        out_ += " : [ ";
+
+        const auto & constants = enums_[i]->constants;
+
+        for (size_t j { 0 } ; j < constants.size() ; ++j) {
+            if (j) out_ += ", ";
+            json::quote (constants[j], out_);
+        }
+
+        out_ += " ]";
+    }
+
+    out_ += " } }";
+}
+
+/******************************************************************************/
@@ -0,0 +1,65 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+
+#include "Cursor.h"
+#include "TypeTable.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::wire {
+
+    /**
+     * How [text] writes what the blob inspector has no JSON for
+     */
+    struct Style {
+        /**
+         * If set a reference to an object written earlier in the blob is
+         * written as valid JSON, { "$ref" : N }, rather than as the
+         * <reference N> a diff shows
+         */
+        bool json { false };
+
+        /**
+         * If set enums are written as their ordinal rather than their
+         * constant and the type of each is added here, once, for the
+         * caller to write the constants out as a dictionary
+         */
+        std::vector<const Type *> * enums { nullptr };
+    };
+
+    /**
+     * Render the value of [type_] at [cursor_] the way the blob inspector
+     * would dump it, leaving the cursor after it
+     */
+    std::string text (Cursor & cursor_, const Type & type_, const Style & style_ = { });
+
+    /**
+     * As above for a value whose constructor, [code_], has already been
+     * read
+     */
+    void text (
+        Cursor & cursor_,
+        const Type & type_,
+        uint8_t code_,
+        std::string & out_,
+        const Style & style_ = { });
+
+    /**
+     * The value of [type_] at [cursor_] as JSON with every enum written
+     * as its ordinal, { "value" : ..., "enums" : { ... } }, the constants
+     * of each enum type it held following once, by type name. [enums_]
+     * is scratch space, kept by the caller so it's reused between values.
+     */
+    void enumCodes (
+        Cursor & cursor_,
+        const Type & type_,
+        std::string & out_,
+        std::vector<const Type *> & enums_);
+
+}
+
+/******************************************************************************/
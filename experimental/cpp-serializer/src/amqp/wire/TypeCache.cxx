@@ -0,0 +1,47 @@
+#include "TypeCache.h"
+
+#include "Blob.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::wire::TypeCache
+ *
+ ******************************************************************************/
+
+const amqp::internal::wire::TypeTable &
+amqp::internal::wire::
+TypeCache::operator() (const Blob & blob_) {
+    blob_.fingerprints (m_fingerprints);
+
+    m_key.clear();
+
+    for (const auto & fingerprint : m_fingerprints) {
+        m_key += fingerprint;
+        m_key += ' ';
+    }
+
+    auto it = m_tables.find (m_key);
+
+    if (it == m_tables.end()) {
+        it = m_tables.emplace (m_key, blob_.types()).first;
+    }
+
+    return *it->second;
+}
+
+/******************************************************************************/
+
+std::pair<const amqp::internal::wire::TypeTable *, const amqp::internal::wire::Type *>
+amqp::internal::wire::
+TypeCache::root (const Blob & blob_) {
+    const auto & types = (*this) (blob_);
+    auto type = types.byDescriptor (blob_.descriptor());
+
+    if (!type) {
+        throw Error ("Fingerprint not found in the schema", blob_.objectStart());
+    }
+
+    return { &types, type };
+}
+
+/******************************************************************************/
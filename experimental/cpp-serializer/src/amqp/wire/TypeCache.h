@@ -0,0 +1,52 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <string_view>
+
+#include "TypeTable.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::wire {
+
+    class Blob;
+
+    /**
+     * The [TypeTable]s of blobs seen before. Blobs of a type almost always
+     * share a schema so rather than decode every blob's, each table is
+     * kept and found again by the fingerprints of the schema, which are
+     * walked by size rather than decoded.
+     *
+     * Tables live as long as the cache, not thread safe.
+     */
+    class TypeCache {
+        private :
+            std::map<std::string, std::unique_ptr<TypeTable>> m_tables;
+
+            std::vector<std::string_view> m_fingerprints;
+            std::string m_key;
+
+        public :
+            /**
+             * @throws Error if the blob's schema is malformed
+             */
+            const TypeTable & operator() (const Blob &);
+
+            /**
+             * The table for [blob_] and the type of its payload
+             *
+             * @throws Error if the payload's type isn't in the schema
+             */
+            std::pair<const TypeTable *, const Type *> root (const Blob & blob_);
+
+            size_t size() const { return m_tables.size(); }
+    };
+
+}
+
+/******************************************************************************/
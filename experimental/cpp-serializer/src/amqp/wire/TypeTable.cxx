@@ -0,0 +1,153 @@
+#include "TypeTable.h"
+
+#include "schema/described-types/Schema.h"
+#include "schema/described-types/Composite.h"
+#include "schema/restricted-types/Restricted.h"
+#include "schema/restricted-types/List.h"
+#include "schema/restricted-types/Map.h"
+#include "schema/restricted-types/Enum.h"
+#include "schema/restricted-types/Array.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::wire::Type
+ *
+ ******************************************************************************/
+
+const amqp::internal::wire::Type *
+amqp::internal::wire::
+Type::instance (std::string_view descriptor_) const {
+    if (implementations) {
+        return implementations->byDescriptor (descriptor_);
+    }
+
+    return descriptor_ == descriptor ? this : nullptr;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::wire::TypeTable
+ *
+ ******************************************************************************/
+
+amqp::internal::wire::
+TypeTable::TypeTable (const schema::Schema & schema_) {
+    using Kind = Type::Kind;
+
+    for (const auto & p : std::initializer_list<std::pair<const char *, Kind>> {
+        { "int",     Kind::int_t },
+        { "long",    Kind::long_t },
+        { "double",  Kind::double_t },
+        { "boolean", Kind::bool_t },
+        { "string",  Kind::string_t },
+        { "binary",  Kind::binary_t } })
+    {
+        m_types[p.first].kind = p.second;
+        m_types[p.first].name = p.first;
+    }
+
+    /*
+     * Build every type before linking any of them so we don't depend on
+     * the order they appear in the schema
+     */
+    std::map<std::string, std::vector<std::string>> links;
+
+    for (const auto & i : schema_) {
+        for (const auto & j : i) {
+            auto & type = m_types[j->name()];
+            auto & link = links[j->name()];
+
+            type.name = j->name();
+            type.descriptor = j->descriptor();
+
+            if (j->type() == schema::AMQPTypeNotation::composite_t) {
+                type.kind = Kind::composite_t;
+
+                for (const auto & f : dynamic_cast<const schema::Composite &> (*j).fields()) {
+                    link.push_back (f->resolvedType());
+                    type.fields.push_back (f->name());
+                    type.nullable.push_back (!f->mandatory());
+                }
+
+                continue;
+            }
+
+            const auto & restricted = dynamic_cast<const schema::Restricted &> (*j);
+
+            switch (restricted.restrictedType()) {
+                case schema::Restricted::RestrictedTypes::list_t : {
+                    type.kind = Kind::list_t;
+                    link.push_back (dynamic_cast<const schema::List &> (restricted).listOf());
+                    break;
+                }
+                case schema::Restricted::RestrictedTypes::map_t : {
+                    type.kind = Kind::map_t;
+                    auto types = dynamic_cast<const schema::Map &> (restricted).mapOf();
+                    link.push_back (types.first.get());
+                    link.push_back (types.second.get());
+                    break;
+                }
+                case schema::Restricted::RestrictedTypes::array_t : {
+                    type.kind = Kind::array_t;
+                    link.push_back (dynamic_cast<const schema::Array &> (restricted).arrayOf());
+                    break;
+                }
+                case schema::Restricted::RestrictedTypes::enum_t : {
+                    type.kind = Kind::enum_t;
+                    type.constants = dynamic_cast<const schema::Enum &> (
+                        restricted).makeChoices();
+                    break;
+                }
+            }
+        }
+    }
+
+    /*
+     * Interfaces aren't in the schema, only the types implementing them,
+     * so a field naming a type we don't have holds one of those. Values
+     * of it carry the descriptor of their implementation.
+     */
+    for (const auto & link : links) {
+        for (const auto & name : link.second) {
+            if (m_types.find (name) == m_types.end()) {
+                auto & type = m_types[name];
+
+                type.kind = Kind::composite_t;
+                type.name = name;
+                type.implementations = this;
+            }
+        }
+    }
+
+    for (const auto & link : links) {
+        auto & type = m_types[link.first];
+
+        for (const auto & name : link.second) {
+            type.children.push_back (&m_types.at (name));
+        }
+
+        m_byDescriptor[type.descriptor] = &type;
+    }
+}
+
+/******************************************************************************/
+
+const amqp::internal::wire::Type *
+amqp::internal::wire::
+TypeTable::byDescriptor (std::string_view descriptor_) const {
+    auto it = m_byDescriptor.find (descriptor_);
+
+    return it == m_byDescriptor.end() ? nullptr : it->second;
+}
+
+/******************************************************************************/
+
+const amqp::internal::wire::Type *
+amqp::internal::wire::
+TypeTable::byName (const std::string & name_) const {
+    auto it = m_types.find (name_);
+
+    return it == m_types.end() ? nullptr : &it->second;
+}
+
+/******************************************************************************/
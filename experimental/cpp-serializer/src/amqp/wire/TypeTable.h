@@ -0,0 +1,105 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <string>
+#include <vector>
+#include <functional>
+#include <string_view>
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    class Schema;
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::wire {
+
+    class TypeTable;
+
+    /**
+     * A type from a blob's schema reduced to what's needed to walk values
+     * of it on the wire. Interfaces aren't in the schema, one named by a
+     * field is a composite with no descriptor and no fields, its values
+     * described as whatever implements it.
+     */
+    struct Type {
+        enum class Kind {
+            int_t, long_t, double_t, bool_t, string_t, binary_t,
+            composite_t, list_t, map_t, array_t, enum_t
+        };
+
+        Kind                      kind;
+        std::string               name;
+        std::string               descriptor;
+
+        /**
+         * The types of a composite's fields, a collection's elements or
+         * a map's key and value
+         */
+        std::vector<const Type *> children;
+
+        /**
+         * For composites, the name of each field and whether it may be null
+         */
+        std::vector<std::string>  fields;
+        std::vector<bool>         nullable;
+
+        /**
+         * For enums, the constants in ordinal order
+         */
+        std::vector<std::string>  constants;
+
+        /**
+         * For interfaces, the table their implementations are found in
+         */
+        const TypeTable *         implementations { nullptr };
+
+        bool primitive() const { return kind < Kind::composite_t; }
+
+        /**
+         * The type of a value described by [descriptor_] found where one
+         * of this type is expected. This type if the fingerprints match,
+         * for an interface the implementation with that fingerprint, and
+         * otherwise nullptr.
+         */
+        const Type * instance (std::string_view descriptor_) const;
+    };
+
+    /**
+     * Every type in a schema, plus the primitives, linked together
+     */
+    class TypeTable {
+        private :
+            std::map<std::string, Type> m_types;
+            std::map<std::string, const Type *, std::less<>> m_byDescriptor;
+
+        public :
+            explicit TypeTable (const schema::Schema &);
+
+            TypeTable (const TypeTable &) = delete;
+
+            /**
+             * @return the type with fingerprint [descriptor_] or nullptr
+             */
+            const Type * byDescriptor (std::string_view descriptor_) const;
+
+            /**
+             * @return the type called [name_] or nullptr
+             */
+            const Type * byName (const std::string & name_) const;
+
+            /**
+             * Every type by name
+             */
+            const std::map<std::string, Type> & types() const { return m_types; }
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,341 @@
+#include "Verifier.h"
+
+#include "Blob.h"
+
+#include "proton/utf8.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::wire::Verifier
+ *
+ ******************************************************************************/
+
+amqp::internal::wire::
+Verifier::Verifier (const TypeTable & types_)
+    : m_types (types_)
+    , m_depth (0)
+{ }
+
+/******************************************************************************/
+
+void
+amqp::internal::wire::
+Verifier::verify (Cursor & cursor_) const {
+    // anything left over from a walk that failed part way through
+    m_depth = 0;
+
+    if (cursor_.code() != codes::DESCRIBED) {
+        cursor_.fail ("Expected a described object");
+    }
+
+    auto code = cursor_.code();
+
+    if (!Cursor::isSymbol (code)) {
+        cursor_.fail ("Expected a fingerprint");
+    }
+
+    auto type = m_types.byDescriptor (cursor_.bytes (code));
+
+    if (!type) {
+        cursor_.fail ("Fingerprint not found in the schema");
+    }
+
+    body (cursor_, *type, cursor_.code());
+}
+
+/******************************************************************************/
+
+/**
+ * A value of type [type_], whose constructor [code_] has already
+ * been read
+ */
+void
+amqp::internal::wire::
+Verifier::value (
+    Cursor & cursor_,
+    const Type & type_,
+    uint8_t code_,
+    bool nullable_
+) const {
+    // errors point at the constructor we've already read
+    auto at = cursor_.offset() - 1;
+
+    if (code_ == codes::NULL_) {
+        if (!nullable_) {
+            throw Error ("Unexpected null", at);
+        }
+
+        return;
+    }
+
+    bool ok;
+
+    switch (type_.kind) {
+        case Type::Kind::int_t :    ok = Cursor::isInt (code_); break;
+        case Type::Kind::long_t :   ok = Cursor::isLong (code_); break;
+        case Type::Kind::double_t : ok = code_ == codes::DOUBLE; break;
+        case Type::Kind::bool_t :   ok = Cursor::isBoolean (code_); break;
+        case Type::Kind::string_t : ok = Cursor::isString (code_); break;
+        case Type::Kind::binary_t : ok = Cursor::isBinary (code_); break;
+        default : {
+            if (code_ != codes::DESCRIBED) {
+                throw Error ("Expected a described value", at);
+            }
+
+            if (auto type = descriptor (cursor_, type_)) {
+                body (cursor_, *type, cursor_.code());
+            }
+
+            return;
+        }
+    }
+
+    if (!ok) {
+        throw Error ("Value encoded as the wrong type", at);
+    }
+
+    if (type_.kind == Type::Kind::string_t) {
+        auto str = cursor_.bytes (code_);
+
+        if (!proton::utf8::valid (str.data(), str.size())) {
+            throw Error ("String is not valid UTF-8", at);
+        }
+
+        return;
+    }
+
+    cursor_.skip (code_);
+}
+
+/******************************************************************************/
+
+/**
+ * Check the descriptor of a described value of type [type_].
+ *
+ * @return the type the value is an instance of, [type_] or for an
+ * interface its implementation, or nullptr if the value was a reference
+ * to an object written earlier in the stream, in which case we've
+ * consumed it already
+ */
+const amqp::internal::wire::Type *
+amqp::internal::wire::
+Verifier::descriptor (Cursor & cursor_, const Type & type_) const {
+    auto code = cursor_.code();
+
+    if (Cursor::isSymbol (code)) {
+        auto type = type_.instance (cursor_.bytes (code));
+
+        if (!type) {
+            cursor_.fail ("Fingerprint doesn't match the expected type");
+        }
+
+        return type;
+    }
+
+    if (Cursor::isULong (code) && isReference (cursor_.ulong (code))) {
+        auto ref = cursor_.code();
+
+        if (!Cursor::isUInt (ref) && !Cursor::isULong (ref)) {
+            cursor_.fail ("Expected an object reference");
+        }
+
+        cursor_.skip (ref);
+
+        return nullptr;
+    }
+
+    cursor_.fail ("Expected a fingerprint");
+}
+
+/******************************************************************************/
+
+/**
+ * The described part of a composite or restricted value, [code_] is its
+ * format code. Every described value nested within a payload passes
+ * through here so this is where how deeply they nest is limited.
+ */
+void
+amqp::internal::wire::
+Verifier::body (Cursor & cursor_, const Type & type_, uint8_t code_) const {
+    if (m_depth == MAX_DEPTH) {
+        throw Error ("Values nested too deeply", cursor_.offset() - 1);
+    }
+
+    ++m_depth;
+
+    switch (type_.kind) {
+        case Type::Kind::composite_t : {
+            if (!Cursor::isList (code_)) {
+                cursor_.fail ("Expected a list of fields");
+            }
+
+            auto list = cursor_.compound (code_);
+
+            if (list.count != type_.children.size()) {
+                cursor_.fail ("List has "+ std::to_string (list.count)
+                    + " elements for " + std::to_string (type_.children.size())
+                    + " fields");
+            }
+
+            for (size_t i { 0 } ; i < list.count ; ++i) {
+                value (cursor_, *type_.children[i], cursor_.code(), type_.nullable[i]);
+            }
+
+            if (cursor_.offset() != list.end) {
+                cursor_.fail ("List size doesn't match its contents");
+            }
+
+            break;
+        }
+        case Type::Kind::list_t :
+        case Type::Kind::array_t : {
+            elements (cursor_, *type_.children[0], code_);
+            break;
+        }
+        case Type::Kind::map_t : {
+            if (!Cursor::isMap (code_)) {
+                cursor_.fail ("Expected a map");
+            }
+
+            auto map = cursor_.compound (code_);
+
+            for (size_t i { 0 } ; i < map.count ; i += 2) {
+                value (cursor_, *type_.children[0], cursor_.code(), true);
+                value (cursor_, *type_.children[1], cursor_.code(), true);
+            }
+
+            if (cursor_.offset() != map.end) {
+                cursor_.fail ("Map size doesn't match its contents");
+            }
+
+            break;
+        }
+        case Type::Kind::enum_t : {
+            if (!Cursor::isList (code_)) {
+                cursor_.fail ("Expected an enum constant");
+            }
+
+            auto list = cursor_.compound (code_);
+
+            if (list.count != 2) {
+                cursor_.fail ("Expected an enum's name and ordinal");
+            }
+
+            auto name = cursor_.code();
+
+            if (!Cursor::isString (name)) {
+                cursor_.fail ("Expected an enum's name");
+            }
+
+            cursor_.skip (name);
+
+            auto ordinal = cursor_.code();
+
+            if (!Cursor::isInt (ordinal)) {
+                cursor_.fail ("Expected an enum's ordinal");
+            }
+
+            auto i = cursor_.integer (ordinal);
+
+            if (i < 0 || static_cast<size_t>(i) >= type_.constants.size()) {
+                cursor_.fail ("Enum ordinal out of range");
+            }
+
+            if (cursor_.offset() != list.end) {
+                cursor_.fail ("List size doesn't match its contents");
+            }
+
+            break;
+        }
+        default : {
+            cursor_.fail ("Primitive types aren't described");
+        }
+    }
+
+    --m_depth;
+}
+
+/******************************************************************************/
+
+/**
+ * The contents of a collection of [type_], Corda writes both lists and
+ * arrays as AMQP lists but an AMQP array is just as valid
+ */
+void
+amqp::internal::wire::
+Verifier::elements (Cursor & cursor_, const Type & type_, uint8_t code_) const {
+    if (Cursor::isList (code_)) {
+        auto list = cursor_.compound (code_);
+
+        for (size_t i { 0 } ; i < list.count ; ++i) {
+            value (cursor_, type_, cursor_.code(), true);
+        }
+
+        if (cursor_.offset() != list.end) {
+            cursor_.fail ("List size doesn't match its contents");
+        }
+
+        return;
+    }
+
+    if (!Cursor::isArray (code_)) {
+        cursor_.fail ("Expected a list or array");
+    }
+
+    auto array = cursor_.compound (code_);
+    auto code = cursor_.code();
+
+    if (code == codes::DESCRIBED) {
+        if (auto type = descriptor (cursor_, type_)) {
+            code = cursor_.code();
+
+            for (size_t i { 0 } ; i < array.count ; ++i) {
+                body (cursor_, *type, code);
+            }
+        } else {
+            // an array of references, every element is a bare integer
+            code = cursor_.code();
+
+            for (size_t i { 0 } ; i < array.count ; ++i) {
+                cursor_.skip (code);
+            }
+        }
+    } else {
+        for (size_t i { 0 } ; i < array.count ; ++i) {
+            value (cursor_, type_, code, false);
+        }
+    }
+
+    if (cursor_.offset() != array.end) {
+        cursor_.fail ("Array size doesn't match its contents");
+    }
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::wire::verify
+ *
+ ******************************************************************************/
+
+amqp::internal::wire::Verdict
+amqp::internal::wire::
+verify (const char * blob_, size_t size_) {
+    try {
+        Blob blob (blob_, size_);
+
+        auto types = blob.types();
+        auto cursor = blob.object();
+
+        Verifier (*types).verify (cursor);
+
+        if (!cursor.atEnd()) {
+            cursor.fail ("Payload size doesn't match its contents");
+        }
+    } catch (const Error & e) {
+        return { false, e.offset(), e.what() };
+    }
+
+    return { true, 0, { } };
+}
+
+/******************************************************************************/
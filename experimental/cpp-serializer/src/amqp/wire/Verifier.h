@@ -0,0 +1,75 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+
+#include "Cursor.h"
+#include "TypeTable.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::wire {
+
+    /**
+     * The outcome of verifying a blob, on failure the offset into the
+     * blob, header included, of the first byte found to be wrong and a
+     * short description of what was wrong with it
+     */
+    struct Verdict {
+        bool        ok;
+        size_t      offset;
+        std::string error;
+
+        explicit operator bool() const { return ok; }
+    };
+
+    /**
+     * Check a complete Corda blob, header and all, is well formed. The
+     * envelope, schema and transforms must be present and correctly
+     * encoded and the payload must match the schema: every described
+     * value carries the fingerprint of the type expected at that point,
+     * every composite has exactly as many elements as its type has fields
+     * and every primitive is encoded as its field's type.
+     *
+     * Only the schema is decoded into memory, the payload is walked in
+     * place so the cost of verifying is independent of what it holds.
+     */
+    Verdict verify (const char * blob_, size_t size_);
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::wire {
+
+    /**
+     * Checks payloads against the types of their blob's schema
+     */
+    class Verifier {
+        private :
+            const TypeTable & m_types;
+
+            /**
+             * How many described values deep we are
+             */
+            mutable size_t m_depth;
+
+            void value (Cursor &, const Type &, uint8_t, bool) const;
+            const Type * descriptor (Cursor &, const Type &) const;
+            void body (Cursor &, const Type &, uint8_t) const;
+            void elements (Cursor &, const Type &, uint8_t) const;
+
+        public :
+            explicit Verifier (const TypeTable &);
+
+            /**
+             * Check the described value at [cursor_] is an instance of a
+             * type in the schema, leaving the cursor after it
+             */
+            void verify (Cursor & cursor_) const;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,19 @@
+#include "BatchReader.h"
+
+#include "PreadReader.h"
+#include "UringReader.h"
+
+/******************************************************************************/
+
+uPtr<io::BatchReader>
+io::batchReader (const Options & options_) {
+    if (options_.uring) {
+        if (auto reader = UringReader::make (options_)) {
+            return reader;
+        }
+    }
+
+    return std::make_unique<PreadReader> (options_);
+}
+
+/******************************************************************************/
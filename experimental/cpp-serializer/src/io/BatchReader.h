@@ -0,0 +1,105 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "types.h"
+
+/******************************************************************************/
+
+/**
+ * Reading a large number of small blobs one at a time with a stat, an
+ * open and a read each leaves the decoder idle for most of every
+ * syscall's round trip. A [BatchReader] instead keeps many reads in
+ * flight, lands them in a pool of reusable buffers and hands each one, as
+ * it completes, to one of a number of decode workers.
+ *
+ * e.g.
+ *
+ *      auto reader = io::batchReader();
+ *
+ *      reader->read (paths, [](const io::Completion & c_) {
+ *          if (c_.error) ... strerror (c_.error) ...
+ *          else amqp::internal::wire::verify (c_.data, c_.size);
+ *      });
+ *
+ * The consumer is called concurrently from every worker, completions
+ * arrive in whatever order the reads finish and the data is only valid
+ * until the consumer returns, after which its buffer is reused.
+ */
+namespace io {
+
+    struct Completion {
+        /**
+         * Position of the file in the list being read
+         */
+        size_t              index;
+        const std::string & path;
+
+        /**
+         * The whole file, or if it couldn't be read nullptr and the
+         * errno explaining why
+         */
+        const char *        data;
+        size_t              size;
+        int                 error;
+    };
+
+    using Consumer = std::function<void (const Completion &)>;
+
+    struct Options {
+        /**
+         * How many files may be in flight at once
+         */
+        unsigned depth { 64 };
+
+        /**
+         * Decode workers, zero for one per hardware thread
+         */
+        unsigned workers { 0 };
+
+        /**
+         * Initial size of each pooled buffer, they grow to fit any larger
+         * file and stay grown
+         */
+        size_t bufferSize { 64 * 1024 };
+
+        /**
+         * Set to false to skip io_uring even where it's available
+         */
+        bool uring { true };
+    };
+
+    class BatchReader {
+        public :
+            virtual ~BatchReader() = default;
+
+            /**
+             * Read every file in [paths_], calling [consumer_] exactly
+             * once for each, and return once they've all been consumed.
+             * If the consumer throws no more files are started and the
+             * first exception is rethrown here once those already in
+             * flight have drained.
+             */
+            virtual void read (
+                const std::vector<std::string> & paths_,
+                const Consumer & consumer_) = 0;
+
+            /**
+             * @return which backend is in use, "io_uring" or "pread"
+             */
+            virtual const char * name() const = 0;
+    };
+
+    /**
+     * @return an io_uring backed reader if the kernel supports one,
+     * otherwise one that preads from a pool of threads
+     */
+    uPtr<BatchReader> batchReader (const Options & = { });
+
+}
+
+/******************************************************************************/
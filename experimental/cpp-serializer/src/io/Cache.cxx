@@ -0,0 +1,532 @@
+#include "Cache.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <filesystem>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/******************************************************************************/
+
+namespace {
+
+    constexpr char LOG_MAGIC[]   { 'C', 'O', 'R', 'D', 'A', 'L', 'O', 'G' };
+    constexpr char INDEX_MAGIC[] { 'C', 'O', 'R', 'D', 'A', 'C', 'I', 'X' };
+
+    template<typename T>
+    T
+    load (const char * p_) {
+        T rtn { 0 };
+
+        for (size_t i { 0 } ; i < sizeof (T) ; ++i) {
+            rtn |= static_cast<T>(static_cast<uint8_t>(p_[i])) << (8 * i);
+        }
+
+        return rtn;
+    }
+
+    template<typename T>
+    void
+    append (std::string & out_, T value_) {
+        for (size_t i { 0 } ; i < sizeof (T) ; ++i) {
+            out_ += static_cast<char>(value_ >> (8 * i));
+        }
+    }
+
+    std::string
+    header (const char * magic_) {
+        std::string rtn (magic_, 8);
+        append<uint32_t> (rtn, io::cache::VERSION);
+        append<uint32_t> (rtn, 0);
+
+        return rtn;
+    }
+
+    void
+    encode (std::string & out_, const io::CacheKey & key_) {
+        append<uint64_t> (out_, key_.hash.lo);
+        append<uint64_t> (out_, key_.hash.hi);
+        append<uint64_t> (out_, key_.tag);
+    }
+
+    uint32_t
+    check (std::string_view output_) {
+        return static_cast<uint32_t>(io::hash128 (output_.data(), output_.size()).lo);
+    }
+
+    /**
+     * All of [size_] bytes at [offset_], false if the file ends first
+     */
+    bool
+    read (int fd_, char * out_, size_t size_, uint64_t offset_) {
+        while (size_) {
+            auto n = ::pread (fd_, out_, size_, static_cast<off_t>(offset_));
+
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+
+            if (n < 0) {
+                throw std::runtime_error (std::string ("Reading cache: ") + std::strerror (errno));
+            }
+
+            if (n == 0) {
+                return false;
+            }
+
+            out_ += n;
+            size_ -= n;
+            offset_ += n;
+        }
+
+        return true;
+    }
+
+    void
+    write (int fd_, const char * bytes_, size_t size_) {
+        while (size_) {
+            auto n = ::write (fd_, bytes_, size_);
+
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+
+            if (n < 0) {
+                throw std::runtime_error (std::string ("Writing cache: ") + std::strerror (errno));
+            }
+
+            bytes_ += n;
+            size_ -= n;
+        }
+    }
+
+}
+
+/******************************************************************************
+ *
+ * io::CacheKey
+ *
+ ******************************************************************************/
+
+bool
+io::
+CacheKey::operator< (const CacheKey & other_) const {
+    if (hash.lo != other_.hash.lo) return hash.lo < other_.hash.lo;
+    if (hash.hi != other_.hash.hi) return hash.hi < other_.hash.hi;
+
+    return tag < other_.tag;
+}
+
+/******************************************************************************/
+
+bool
+io::
+CacheKey::operator== (const CacheKey & other_) const {
+    return hash == other_.hash && tag == other_.tag;
+}
+
+/******************************************************************************
+ *
+ * io::Cache
+ *
+ ******************************************************************************/
+
+io::
+Cache::Cache (const std::string & directory_)
+    : m_directory (directory_)
+    , m_log (-1)
+    , m_logSize (0)
+    , m_index (nullptr)
+    , m_indexSize (0)
+    , m_entries (0)
+    , m_replaced (0)
+{
+    std::error_code error;
+    std::filesystem::create_directories (m_directory, error);
+
+    auto path = m_directory + "/log";
+
+    m_log = ::open (path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0666);
+
+    if (m_log < 0) {
+        throw std::runtime_error (path + ": " + std::strerror (errno));
+    }
+
+    auto fail = [this, &path](const std::string & why_) {
+        ::close (m_log);
+        throw std::runtime_error (path + ": " + why_);
+    };
+
+    if (::flock (m_log, LOCK_EX) != 0) {
+        fail (std::strerror (errno));
+    }
+
+    struct stat results { };
+
+    if (::fstat (m_log, &results) != 0) {
+        fail (std::strerror (errno));
+    }
+
+    m_logSize = results.st_size;
+
+    auto expected = header (LOG_MAGIC);
+
+    if (m_logSize == 0) {
+        write (m_log, expected.data(), expected.size());
+        m_logSize = expected.size();
+    } else {
+        char actual[cache::HEADER_SIZE];
+
+        if (!read (m_log, actual, sizeof (actual), 0)
+            || std::memcmp (actual, expected.data(), sizeof (actual)) != 0)
+        {
+            fail ("Not a cache, or an unsupported version");
+        }
+    }
+
+    try {
+        recover (map());
+    } catch (const std::runtime_error &) {
+        unmap();
+        ::close (m_log);
+        throw;
+    }
+}
+
+/******************************************************************************/
+
+io::
+Cache::~Cache() {
+    try {
+        flush();
+    } catch (const std::exception &) {
+    }
+
+    unmap();
+    ::close (m_log);
+}
+
+/******************************************************************************/
+
+/**
+ * Map the index, if there's a usable one, returning how much of the log
+ * it covers. A damaged index is ignored, it's rebuilt from the log.
+ */
+uint64_t
+io::
+Cache::map() {
+    auto path = m_directory + "/index";
+
+    int fd = ::open (path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+        return cache::HEADER_SIZE;
+    }
+
+    struct stat results { };
+
+    if (::fstat (fd, &results) != 0
+        || static_cast<size_t>(results.st_size) < cache::HEADER_SIZE + cache::FOOTER_SIZE)
+    {
+        ::close (fd);
+        return cache::HEADER_SIZE;
+    }
+
+    auto size = static_cast<size_t>(results.st_size);
+    auto map = ::mmap (nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close (fd);
+
+    if (map == MAP_FAILED) {
+        return cache::HEADER_SIZE;
+    }
+
+    m_index = static_cast<const char *>(map);
+    m_indexSize = size;
+
+    auto footer = m_index + size - cache::FOOTER_SIZE;
+    auto covered = load<uint64_t> (footer);
+    auto entries = load<uint32_t> (footer + 8);
+
+    if (header (INDEX_MAGIC) != std::string_view (m_index, cache::HEADER_SIZE)
+        || std::memcmp (footer + 16, INDEX_MAGIC, sizeof (INDEX_MAGIC)) != 0
+        || load<uint32_t> (footer + 12) != cache::VERSION
+        || size != cache::HEADER_SIZE + entries * cache::ENTRY_SIZE + cache::FOOTER_SIZE
+        || covered < cache::HEADER_SIZE
+        || covered > m_logSize)
+    {
+        unmap();
+        return cache::HEADER_SIZE;
+    }
+
+    m_entries = entries;
+
+    return covered;
+}
+
+/******************************************************************************/
+
+void
+io::
+Cache::unmap() {
+    if (m_index) {
+        ::munmap (const_cast<char *>(m_index), m_indexSize);
+    }
+
+    m_index = nullptr;
+    m_indexSize = 0;
+    m_entries = 0;
+}
+
+/******************************************************************************/
+
+/**
+ * Add every record logged after [from_] to what's been added, cutting
+ * the log short at the first that's incomplete
+ */
+void
+io::
+Cache::recover (uint64_t from_) {
+    char record[cache::RECORD_SIZE];
+    std::string output;
+
+    while (from_ < m_logSize) {
+        if (!read (m_log, record, sizeof (record), from_)) {
+            break;
+        }
+
+        auto length = load<uint32_t> (record + 24);
+        auto end = from_ + cache::RECORD_SIZE + length;
+
+        output.resize (length);
+
+        if (end > m_logSize
+            || !read (m_log, output.data(), length, from_ + cache::RECORD_SIZE)
+            || check (output) != load<uint32_t> (record + 28))
+        {
+            break;
+        }
+
+        CacheKey key {
+            { load<uint64_t> (record), load<uint64_t> (record + 8) },
+            load<uint64_t> (record + 16) };
+
+        uint64_t ignored;
+
+        if (m_added.count (key) == 0 && find (key, ignored)) {
+            ++m_replaced;
+        }
+
+        m_added[key] = from_;
+        from_ = end;
+    }
+
+    if (from_ < m_logSize) {
+        if (::ftruncate (m_log, static_cast<off_t>(from_)) != 0) {
+            throw std::runtime_error (
+                m_directory + "/log: " + std::strerror (errno));
+        }
+
+        m_logSize = from_;
+    }
+}
+
+/******************************************************************************/
+
+io::CacheKey
+io::
+Cache::entry (size_t i_) const {
+    auto p = m_index + cache::HEADER_SIZE + i_ * cache::ENTRY_SIZE;
+
+    return { { load<uint64_t> (p), load<uint64_t> (p + 8) }, load<uint64_t> (p + 16) };
+}
+
+/******************************************************************************/
+
+bool
+io::
+Cache::find (const CacheKey & key_, uint64_t & offset_) const {
+    auto added = m_added.find (key_);
+
+    if (added != m_added.end()) {
+        offset_ = added->second;
+        return true;
+    }
+
+    size_t lo { 0 }, hi { m_entries };
+
+    while (lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        auto key = entry (mid);
+
+        if (key < key_) {
+            lo = mid + 1;
+        } else if (key_ < key) {
+            hi = mid;
+        } else {
+            offset_ = load<uint64_t> (
+                m_index + cache::HEADER_SIZE + mid * cache::ENTRY_SIZE + 24);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/******************************************************************************/
+
+io::CacheKey
+io::
+Cache::key (const char * blob_, size_t size_, std::string_view tag_) {
+    return { hash128 (blob_, size_), hash128 (tag_.data(), tag_.size()).lo };
+}
+
+/******************************************************************************/
+
+bool
+io::
+Cache::get (const CacheKey & key_, std::string & out_) const {
+    uint64_t offset;
+
+    if (!find (key_, offset)) {
+        return false;
+    }
+
+    char record[cache::RECORD_SIZE];
+
+    if (offset + cache::RECORD_SIZE > m_logSize
+        || !read (m_log, record, sizeof (record), offset))
+    {
+        return false;
+    }
+
+    CacheKey key {
+        { load<uint64_t> (record), load<uint64_t> (record + 8) },
+        load<uint64_t> (record + 16) };
+
+    auto length = load<uint32_t> (record + 24);
+
+    if (!(key == key_) || offset + cache::RECORD_SIZE + length > m_logSize) {
+        return false;
+    }
+
+    out_.resize (length);
+
+    return read (m_log, out_.data(), length, offset + cache::RECORD_SIZE)
+        && check (out_) == load<uint32_t> (record + 28);
+}
+
+/******************************************************************************/
+
+void
+io::
+Cache::put (const CacheKey & key_, std::string_view output_) {
+    if (output_.size() > UINT32_MAX) {
+        throw std::runtime_error ("Output too large to cache");
+    }
+
+    std::string record;
+    record.reserve (cache::RECORD_SIZE + output_.size());
+
+    encode (record, key_);
+    append<uint32_t> (record, static_cast<uint32_t>(output_.size()));
+    append<uint32_t> (record, check (output_));
+    record += output_;
+
+    write (m_log, record.data(), record.size());
+
+    uint64_t ignored;
+
+    if (m_added.count (key_) == 0 && find (key_, ignored)) {
+        ++m_replaced;
+    }
+
+    m_added[key_] = m_logSize;
+    m_logSize += record.size();
+}
+
+/******************************************************************************/
+
+/**
+ * The index is written beside the old one and renamed over it, merging
+ * what it held with what's been added
+ */
+void
+io::
+Cache::flush() {
+    if (m_added.empty()) {
+        return;
+    }
+
+    auto path = m_directory + "/index";
+    auto temporary = path + ".tmp";
+
+    auto file = std::fopen (temporary.c_str(), "wb");
+
+    if (!file) {
+        throw std::runtime_error (temporary + ": " + std::strerror (errno));
+    }
+
+    std::setvbuf (file, nullptr, _IOFBF, 1 << 20);
+
+    std::string buffer = header (INDEX_MAGIC);
+    size_t entries { 0 };
+    bool failed { false };
+
+    auto emit = [&](const CacheKey & key_, uint64_t offset_) {
+        encode (buffer, key_);
+        append<uint64_t> (buffer, offset_);
+        ++entries;
+
+        if (buffer.size() >= 1 << 16) {
+            failed |= std::fwrite (buffer.data(), 1, buffer.size(), file) != buffer.size();
+            buffer.clear();
+        }
+    };
+
+    auto added = m_added.begin();
+
+    for (size_t i { 0 } ; i < m_entries ; ++i) {
+        auto key = entry (i);
+
+        for ( ; added != m_added.end() && added->first < key ; ++added) {
+            emit (added->first, added->second);
+        }
+
+        if (added != m_added.end() && added->first == key) {
+            continue;
+        }
+
+        emit (key, load<uint64_t> (m_index + cache::HEADER_SIZE + i * cache::ENTRY_SIZE + 24));
+    }
+
+    for ( ; added != m_added.end() ; ++added) {
+        emit (added->first, added->second);
+    }
+
+    append<uint64_t> (buffer, m_logSize);
+    append<uint32_t> (buffer, static_cast<uint32_t>(entries));
+    append<uint32_t> (buffer, cache::VERSION);
+    buffer.append (INDEX_MAGIC, sizeof (INDEX_MAGIC));
+
+    failed |= std::fwrite (buffer.data(), 1, buffer.size(), file) != buffer.size();
+    failed |= std::fclose (file) != 0;
+
+    if (failed || std::rename (temporary.c_str(), path.c_str()) != 0) {
+        std::remove (temporary.c_str());
+        throw std::runtime_error (path + ": Failed writing cache index");
+    }
+
+    unmap();
+    m_added.clear();
+    m_replaced = 0;
+
+    recover (map());
+}
+
+/******************************************************************************/
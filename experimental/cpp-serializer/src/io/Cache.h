@@ -0,0 +1,133 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <string>
+#include <cstdint>
+#include <string_view>
+
+#include "Hash.h"
+
+/******************************************************************************/
+
+/**
+ * Output rendered from blobs, kept so the same bytes needn't be decoded
+ * again. A cache is a directory holding two files, everything little
+ * endian,
+ *
+ *      log     : "CORDALOG", u32 version, u32 reserved, then per entry
+ *                  u64 hash lo, u64 hash hi, u64 tag, u32 length,
+ *                  u32 check, the output
+ *      index   : "CORDACIX", u32 version, u32 reserved, then per entry
+ *                sorted by key, u64 hash lo, u64 hash hi, u64 tag,
+ *                u64 offset of its record in the log; footer: u64 size
+ *                of the log the index covers, u32 entries, u32 version,
+ *                "CORDACIX"
+ *
+ * The log is only ever appended to. The index is rewritten on [flush]
+ * so anything logged after it was last written is found again by
+ * reading the log from where the index stops; a record cut short by a
+ * crash is truncated away. Entries are never evicted, remove the
+ * directory to start again.
+ */
+namespace io::cache {
+
+    constexpr uint32_t VERSION { 1 };
+
+    constexpr size_t HEADER_SIZE { 16 };
+    constexpr size_t RECORD_SIZE { 32 };
+    constexpr size_t ENTRY_SIZE  { 32 };
+    constexpr size_t FOOTER_SIZE { 24 };
+
+}
+
+/******************************************************************************/
+
+namespace io {
+
+    /**
+     * What output is cached under, the hash of the blob it was rendered
+     * from and a tag naming what was rendered, which should change
+     * whenever the rendering does
+     */
+    struct CacheKey {
+        Hash128  hash;
+        uint64_t tag;
+
+        bool operator< (const CacheKey &) const;
+        bool operator== (const CacheKey &) const;
+    };
+
+    /**
+     * Opening a cache takes an exclusive lock on its log, so a second
+     * process using the same cache waits for the first to finish.
+     * Not thread safe.
+     */
+    class Cache {
+        private :
+            std::string m_directory;
+
+            int         m_log;
+            uint64_t    m_logSize;
+
+            /**
+             * The index as last written, mapped, and what has been added
+             * since
+             */
+            const char * m_index;
+            size_t       m_indexSize;
+            uint32_t     m_entries;
+
+            std::map<CacheKey, uint64_t> m_added;
+
+            /**
+             * How many of [m_added] replace entries in the index
+             */
+            size_t m_replaced;
+
+            uint64_t map();
+            void unmap();
+            void recover (uint64_t from_);
+
+            CacheKey entry (size_t i_) const;
+            bool find (const CacheKey &, uint64_t & offset_) const;
+
+        public :
+            /**
+             * Open the cache in [directory_], creating it if need be
+             *
+             * @throws std::runtime_error if it can't be opened or isn't a
+             * cache
+             */
+            explicit Cache (const std::string & directory_);
+
+            Cache (const Cache &) = delete;
+
+            /**
+             * Flushes, swallowing any failure, whatever the index then
+             * misses is found again in the log next time
+             */
+            ~Cache();
+
+            static CacheKey key (const char * blob_, size_t size_, std::string_view tag_);
+
+            /**
+             * Put the output cached under [key_] in [out_]. A record that
+             * fails its check is a miss.
+             */
+            bool get (const CacheKey & key_, std::string & out_) const;
+
+            void put (const CacheKey & key_, std::string_view output_);
+
+            size_t size() const { return m_entries + m_added.size() - m_replaced; }
+
+            /**
+             * Rewrite the index to cover everything logged so far
+             */
+            void flush();
+    };
+
+}
+
+/******************************************************************************/
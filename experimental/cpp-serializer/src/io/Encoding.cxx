@@ -0,0 +1,241 @@
+#include "Encoding.h"
+
+#include <cstdint>
+
+#if defined (__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    int
+    nibble (unsigned char c_) {
+        if (c_ >= '0' && c_ <= '9') return c_ - '0';
+        if (c_ >= 'a' && c_ <= 'f') return c_ - 'a' + 10;
+        if (c_ >= 'A' && c_ <= 'F') return c_ - 'A' + 10;
+
+        return -1;
+    }
+
+    int
+    sextet (unsigned char c_) {
+        if (c_ >= 'A' && c_ <= 'Z') return c_ - 'A';
+        if (c_ >= 'a' && c_ <= 'z') return c_ - 'a' + 26;
+        if (c_ >= '0' && c_ <= '9') return c_ - '0' + 52;
+        if (c_ == '+') return 62;
+        if (c_ == '/') return 63;
+
+        return -1;
+    }
+
+#if defined (__SSE2__)
+
+    /**
+     * Mask of the bytes of [v_] in [0, limit_), there's no unsigned byte
+     * compare but after subtracting the start of a range everything we
+     * care about fits in a signed byte
+     */
+    inline __m128i
+    range (__m128i v_, char limit_) {
+        return _mm_and_si128 (
+            _mm_cmpgt_epi8 (v_, _mm_set1_epi8 (-1)),
+            _mm_cmplt_epi8 (v_, _mm_set1_epi8 (limit_)));
+    }
+
+    /**
+     * Sixteen hex digits to eight bytes, false if any isn't a digit
+     */
+    inline bool
+    hex16 (const char * in_, char * out_) {
+        auto block = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(in_));
+
+        auto digit = _mm_sub_epi8 (block, _mm_set1_epi8 ('0'));
+        auto isDigit = range (digit, 10);
+
+        // folding to lower case leaves the digits alone
+        auto letter = _mm_sub_epi8 (
+            _mm_or_si128 (block, _mm_set1_epi8 (0x20)), _mm_set1_epi8 ('a'));
+        auto isLetter = range (letter, 6);
+
+        if (_mm_movemask_epi8 (_mm_or_si128 (isDigit, isLetter)) != 0xffff) {
+            return false;
+        }
+
+        auto nibbles = _mm_or_si128 (
+            _mm_and_si128 (isDigit, digit),
+            _mm_and_si128 (isLetter, _mm_add_epi8 (letter, _mm_set1_epi8 (10))));
+
+        // each 16 bit lane holds a high nibble in its low byte and a low
+        // nibble in its high byte
+        auto bytes = _mm_or_si128 (
+            _mm_slli_epi16 (_mm_and_si128 (nibbles, _mm_set1_epi16 (0x00ff)), 4),
+            _mm_srli_epi16 (nibbles, 8));
+
+        _mm_storel_epi64 (
+            reinterpret_cast<__m128i *>(out_), _mm_packus_epi16 (bytes, bytes));
+
+        return true;
+    }
+
+    /**
+     * Sixteen base64 characters to twelve bytes, false if any isn't in
+     * the alphabet, which includes padding
+     */
+    inline bool
+    base64x16 (const char * in_, char * out_) {
+        auto block = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(in_));
+
+        auto upper = _mm_sub_epi8 (block, _mm_set1_epi8 ('A'));
+        auto isUpper = range (upper, 26);
+
+        auto lower = _mm_sub_epi8 (block, _mm_set1_epi8 ('a'));
+        auto isLower = range (lower, 26);
+
+        auto digit = _mm_sub_epi8 (block, _mm_set1_epi8 ('0'));
+        auto isDigit = range (digit, 10);
+
+        auto isPlus = _mm_cmpeq_epi8 (block, _mm_set1_epi8 ('+'));
+        auto isSlash = _mm_cmpeq_epi8 (block, _mm_set1_epi8 ('/'));
+
+        auto valid = _mm_or_si128 (
+            _mm_or_si128 (_mm_or_si128 (isUpper, isLower), isDigit),
+            _mm_or_si128 (isPlus, isSlash));
+
+        if (_mm_movemask_epi8 (valid) != 0xffff) {
+            return false;
+        }
+
+        auto sextets = _mm_or_si128 (
+            _mm_or_si128 (
+                _mm_and_si128 (isUpper, upper),
+                _mm_and_si128 (isLower, _mm_add_epi8 (lower, _mm_set1_epi8 (26)))),
+            _mm_or_si128 (
+                _mm_and_si128 (isDigit, _mm_add_epi8 (digit, _mm_set1_epi8 (52))),
+                _mm_or_si128 (
+                    _mm_and_si128 (isPlus, _mm_set1_epi8 (62)),
+                    _mm_and_si128 (isSlash, _mm_set1_epi8 (63)))));
+
+        // pairs of sextets into 12 bits per 16 bit lane, then pairs of
+        // those into 24 bits per 32 bit lane
+        auto twelve = _mm_or_si128 (
+            _mm_slli_epi16 (_mm_and_si128 (sextets, _mm_set1_epi16 (0x00ff)), 6),
+            _mm_srli_epi16 (sextets, 8));
+
+        auto twentyFour = _mm_or_si128 (
+            _mm_slli_epi32 (_mm_and_si128 (twelve, _mm_set1_epi32 (0xffff)), 12),
+            _mm_srli_epi32 (twelve, 16));
+
+        // without SSSE3's shuffle the bytes are put in order one by one
+        alignas (16) uint32_t words[4];
+        _mm_store_si128 (reinterpret_cast<__m128i *>(words), twentyFour);
+
+        for (auto word : words) {
+            *out_++ = static_cast<char>(word >> 16);
+            *out_++ = static_cast<char>(word >> 8);
+            *out_++ = static_cast<char>(word);
+        }
+
+        return true;
+    }
+
+#endif
+
+}
+
+/******************************************************************************/
+
+bool
+io::hex::decode (const char * in_, size_t size_, std::vector<char> & out_) {
+    if (size_ % 2) {
+        return false;
+    }
+
+    out_.resize (size_ / 2);
+
+    size_t i { 0 };
+    char * out = out_.data();
+
+#if defined (__SSE2__)
+    for ( ; i + 16 <= size_ ; i += 16, out += 8) {
+        if (!hex16 (in_ + i, out)) {
+            return false;
+        }
+    }
+#endif
+
+    for ( ; i < size_ ; i += 2) {
+        auto high = nibble (in_[i]);
+        auto low = nibble (in_[i + 1]);
+
+        if (high < 0 || low < 0) {
+            return false;
+        }
+
+        *out++ = static_cast<char>((high << 4) | low);
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+
+bool
+io::base64::decode (const char * in_, size_t size_, std::vector<char> & out_) {
+    if (size_ % 4 == 0) {
+        for (int pad { 0 } ; pad < 2 && size_ && in_[size_ - 1] == '=' ; ++pad) {
+            --size_;
+        }
+    }
+
+    if (size_ % 4 == 1) {
+        return false;
+    }
+
+    out_.resize (size_ / 4 * 3 + (size_ % 4 ? size_ % 4 - 1 : 0));
+
+    size_t i { 0 };
+    char * out = out_.data();
+
+#if defined (__SSE2__)
+    for ( ; i + 16 <= size_ ; i += 16, out += 12) {
+        if (!base64x16 (in_ + i, out)) {
+            return false;
+        }
+    }
+#endif
+
+    uint32_t bits { 0 };
+    int count { 0 };
+
+    for ( ; i < size_ ; ++i) {
+        auto s = sextet (in_[i]);
+
+        if (s < 0) {
+            return false;
+        }
+
+        bits = (bits << 6) | s;
+
+        if (++count == 4) {
+            *out++ = static_cast<char>(bits >> 16);
+            *out++ = static_cast<char>(bits >> 8);
+            *out++ = static_cast<char>(bits);
+            bits = 0;
+            count = 0;
+        }
+    }
+
+    // two characters make one byte, three make two
+    if (count == 2) {
+        *out++ = static_cast<char>(bits >> 4);
+    } else if (count == 3) {
+        *out++ = static_cast<char>(bits >> 10);
+        *out++ = static_cast<char>(bits >> 2);
+    }
+
+    return true;
+}
+
+/******************************************************************************/
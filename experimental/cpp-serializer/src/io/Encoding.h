@@ -0,0 +1,39 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <vector>
+#include <cstddef>
+
+/******************************************************************************/
+
+/**
+ * Blobs pulled out of a database dump arrive as text, these turn it back
+ * into bytes. Both decode sixteen characters at a time where SSE2 is
+ * available and write into a caller owned buffer, resized to fit, so a
+ * loop over many blobs settles into reusing the same storage.
+ *
+ * Each returns false, leaving [out_] unspecified, if the text isn't
+ * valid.
+ */
+namespace io::hex {
+
+    /**
+     * Upper or lower case, no prefix and no separators
+     */
+    bool decode (const char *, size_t, std::vector<char> & out_);
+
+}
+
+/******************************************************************************/
+
+namespace io::base64 {
+
+    /**
+     * The standard alphabet of RFC 4648, with or without padding
+     */
+    bool decode (const char *, size_t, std::vector<char> & out_);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,155 @@
+#include "Hash.h"
+
+#include <cstring>
+
+#if defined (__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    constexpr size_t STRIPE { 64 };
+    constexpr size_t LANES { 8 };
+
+    constexpr uint64_t P1 { 0x9e3779b185ebca87ULL };
+    constexpr uint64_t P2 { 0xc2b2ae3d27d4eb4fULL };
+    constexpr uint64_t P3 { 0x165667b19e3779f9ULL };
+
+    constexpr uint64_t
+    fmix (uint64_t h_) {
+        h_ ^= h_ >> 33;
+        h_ *= 0xff51afd7ed558ccdULL;
+        h_ ^= h_ >> 33;
+        h_ *= 0xc4ceb9fe1a85ec53ULL;
+        h_ ^= h_ >> 33;
+
+        return h_;
+    }
+
+    /**
+     * The keys of the first stripe, each later stripe adds P3 to them
+     */
+    constexpr uint64_t KEYS[LANES] {
+        fmix (P1), fmix (P1 * 2), fmix (P1 * 3), fmix (P1 * 4),
+        fmix (P1 * 5), fmix (P1 * 6), fmix (P1 * 7), fmix (P1 * 8)
+    };
+
+    uint64_t
+    word (const char * p_) {
+        uint64_t rtn { 0 };
+
+        for (size_t i { 0 } ; i < sizeof (rtn) ; ++i) {
+            rtn |= static_cast<uint64_t>(static_cast<uint8_t>(p_[i])) << (8 * i);
+        }
+
+        return rtn;
+    }
+
+    void
+    stripe (uint64_t * acc_, uint64_t * keys_, const char * p_) {
+        uint64_t words[LANES];
+
+        for (size_t i { 0 } ; i < LANES ; ++i) {
+            words[i] = word (p_ + 8 * i);
+        }
+
+        for (size_t i { 0 } ; i < LANES ; ++i) {
+            auto k = words[i] ^ keys_[i];
+
+            acc_[i] += words[i ^ 1] + (k & 0xffffffff) * (k >> 32);
+            keys_[i] += P3;
+        }
+    }
+
+#if defined (__SSE2__)
+
+    /**
+     * Every whole stripe of [p_], returning how many bytes that was
+     */
+    size_t
+    stripes (uint64_t * acc_, uint64_t * keys_, const char * p_, size_t size_) {
+        __m128i acc[LANES / 2], keys[LANES / 2];
+
+        for (size_t i { 0 } ; i < LANES / 2 ; ++i) {
+            acc[i] = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(acc_ + 2 * i));
+            keys[i] = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(keys_ + 2 * i));
+        }
+
+        auto step = _mm_set1_epi64x (static_cast<long long>(P3));
+
+        size_t done { 0 };
+
+        for ( ; done + STRIPE <= size_ ; done += STRIPE) {
+            for (size_t i { 0 } ; i < LANES / 2 ; ++i) {
+                auto words = _mm_loadu_si128 (
+                    reinterpret_cast<const __m128i *>(p_ + done + 16 * i));
+
+                auto k = _mm_xor_si128 (words, keys[i]);
+
+                // the low half of each word times its high half
+                auto product = _mm_mul_epu32 (k, _mm_shuffle_epi32 (k, _MM_SHUFFLE (3, 3, 1, 1)));
+                auto swapped = _mm_shuffle_epi32 (words, _MM_SHUFFLE (1, 0, 3, 2));
+
+                acc[i] = _mm_add_epi64 (acc[i], _mm_add_epi64 (swapped, product));
+                keys[i] = _mm_add_epi64 (keys[i], step);
+            }
+        }
+
+        for (size_t i { 0 } ; i < LANES / 2 ; ++i) {
+            _mm_storeu_si128 (reinterpret_cast<__m128i *>(acc_ + 2 * i), acc[i]);
+            _mm_storeu_si128 (reinterpret_cast<__m128i *>(keys_ + 2 * i), keys[i]);
+        }
+
+        return done;
+    }
+
+#else
+
+    size_t
+    stripes (uint64_t * acc_, uint64_t * keys_, const char * p_, size_t size_) {
+        size_t done { 0 };
+
+        for ( ; done + STRIPE <= size_ ; done += STRIPE) {
+            stripe (acc_, keys_, p_ + done);
+        }
+
+        return done;
+    }
+
+#endif
+
+}
+
+/******************************************************************************/
+
+io::Hash128
+io::
+hash128 (const char * p_, size_t size_) {
+    uint64_t acc[LANES] { };
+    uint64_t keys[LANES];
+
+    std::memcpy (keys, KEYS, sizeof (keys));
+
+    auto done = stripes (acc, keys, p_, size_);
+
+    if (done < size_) {
+        char last[STRIPE] { };
+        std::memcpy (last, p_ + done, size_ - done);
+
+        stripe (acc, keys, last);
+    }
+
+    uint64_t lo { size_ * P1 + P3 };
+    uint64_t hi { size_ ^ P2 };
+
+    for (size_t i { 0 } ; i < LANES ; ++i) {
+        lo = fmix (lo ^ acc[i]);
+        hi = fmix (hi + acc[i] * P2);
+    }
+
+    return { lo, hi };
+}
+
+/******************************************************************************/
@@ -0,0 +1,40 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+
+/******************************************************************************/
+
+namespace io {
+
+    struct Hash128 {
+        uint64_t lo;
+        uint64_t hi;
+
+        bool operator== (const Hash128 & other_) const {
+            return lo == other_.lo && hi == other_.hi;
+        }
+
+        bool operator!= (const Hash128 & other_) const { return !(*this == other_); }
+    };
+
+    /**
+     * A fast, non cryptographic, 128 bit hash for recognising bytes seen
+     * before. The input is consumed in 64 byte stripes, eight 64 bit
+     * lanes at a time, each lane accumulating the product of the halves
+     * of its word mixed with a key plus its neighbour's word. The keys
+     * move on every stripe so reordering stripes changes the hash. A
+     * short final stripe is zero padded and the length mixed in when the
+     * lanes are folded down to 128 bits.
+     *
+     * Stripes are processed two lanes to a register where SSE2 is
+     * available, otherwise a lane at a time, with identical results
+     * either way, little endian.
+     */
+    Hash128 hash128 (const char *, size_t);
+
+}
+
+/******************************************************************************/
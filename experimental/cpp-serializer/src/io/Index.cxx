@@ -0,0 +1,674 @@
+#include "Index.h"
+
+#include <queue>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/******************************************************************************/
+
+namespace {
+
+    constexpr char MAGIC[] { 'C', 'O', 'R', 'D', 'A', 'I', 'D', 'X' };
+
+    constexpr size_t RECORD_HEADER { 12 };
+
+    template<typename T>
+    T
+    get (const char * p_) {
+        T rtn { 0 };
+
+        for (size_t i { 0 } ; i < sizeof (T) ; ++i) {
+            rtn |= static_cast<T>(static_cast<uint8_t>(p_[i])) << (8 * i);
+        }
+
+        return rtn;
+    }
+
+    template<typename T>
+    void
+    put (std::string & out_, T value_) {
+        for (size_t i { 0 } ; i < sizeof (T) ; ++i) {
+            out_ += static_cast<char>(value_ >> (8 * i));
+        }
+    }
+
+    uint32_t
+    narrow (size_t value_, const char * what_) {
+        if (value_ > UINT32_MAX) {
+            throw std::runtime_error (std::string ("Index ") + what_ + " too large");
+        }
+
+        return static_cast<uint32_t>(value_);
+    }
+
+    std::FILE *
+    temporary() {
+        auto rtn = std::tmpfile();
+
+        if (!rtn) {
+            throw std::runtime_error (
+                std::string ("Can't create temporary file: ") + std::strerror (errno));
+        }
+
+        std::setvbuf (rtn, nullptr, _IOFBF, 1 << 20);
+
+        return rtn;
+    }
+
+    void
+    store (std::FILE * file_, const void * bytes_, size_t size_) {
+        if (std::fwrite (bytes_, 1, size_, file_) != size_) {
+            throw std::runtime_error ("Failed writing index");
+        }
+    }
+
+    /**
+     * Reads back a sorted run, one record at a time
+     */
+    class Run {
+        private :
+            std::FILE * m_file;
+
+        public :
+            uint32_t    path { 0 };
+            uint32_t    blob { 0 };
+            std::string key;
+
+            explicit Run (std::FILE * file_) : m_file (file_) {
+                std::rewind (m_file);
+            }
+
+            /**
+             * Load the next record, false once there are none
+             */
+            bool
+            next() {
+                char header[RECORD_HEADER];
+
+                auto read = std::fread (header, 1, sizeof (header), m_file);
+
+                if (read == 0 && std::feof (m_file)) {
+                    return false;
+                }
+
+                if (read != sizeof (header)) {
+                    throw std::runtime_error ("Failed reading index run");
+                }
+
+                path = get<uint32_t> (header);
+                blob = get<uint32_t> (header + 4);
+                key.resize (get<uint32_t> (header + 8));
+
+                if (std::fread (key.data(), 1, key.size(), m_file) != key.size()) {
+                    throw std::runtime_error ("Failed reading index run");
+                }
+
+                return true;
+            }
+
+            bool
+            operator> (const Run & other_) const {
+                return std::tie (path, key, blob)
+                    > std::tie (other_.path, other_.key, other_.blob);
+            }
+    };
+
+}
+
+/******************************************************************************
+ *
+ * io::Index
+ *
+ ******************************************************************************/
+
+io::
+Index::Index (const std::string & path_)
+    : m_map (nullptr)
+    , m_size (0)
+{
+    int fd = ::open (path_.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+        throw std::runtime_error (path_ + ": " + std::strerror (errno));
+    }
+
+    struct stat results { };
+
+    if (::fstat (fd, &results) != 0) {
+        ::close (fd);
+        throw std::runtime_error (path_ + ": " + std::strerror (errno));
+    }
+
+    m_size = results.st_size;
+
+    if (m_size < index::HEADER_SIZE + index::FOOTER_SIZE) {
+        ::close (fd);
+        throw std::runtime_error (path_ + ": Not an index");
+    }
+
+    auto map = ::mmap (nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close (fd);
+
+    if (map == MAP_FAILED) {
+        throw std::runtime_error (path_ + ": " + std::strerror (errno));
+    }
+
+    m_map = static_cast<const char *>(map);
+
+    auto fail = [this, &path_](const char * why_) {
+        ::munmap (const_cast<char *>(m_map), m_size);
+        throw std::runtime_error (path_ + ": " + why_);
+    };
+
+    auto footer = m_map + m_size - index::FOOTER_SIZE;
+
+    if (std::memcmp (m_map, MAGIC, sizeof (MAGIC)) != 0
+        || std::memcmp (footer + 56, MAGIC, sizeof (MAGIC)) != 0)
+    {
+        fail ("Not an index");
+    }
+
+    if (get<uint32_t> (m_map + 8) != index::VERSION
+        || get<uint32_t> (footer + 48) != index::VERSION)
+    {
+        fail ("Unsupported index version");
+    }
+
+    auto offsets = get<uint64_t> (footer);
+    auto blobs = get<uint64_t> (footer + 8);
+    auto strings = get<uint64_t> (footer + 16);
+    auto tables = get<uint64_t> (footer + 24);
+
+    m_entries = get<uint32_t> (footer + 32);
+    m_blobCount = get<uint32_t> (footer + 36);
+
+    uint64_t sources = get<uint32_t> (footer + 40);
+    uint64_t paths = get<uint32_t> (footer + 44);
+
+    auto end = static_cast<uint64_t>(m_size - index::FOOTER_SIZE);
+
+    if (offsets < index::HEADER_SIZE
+        || blobs - offsets != uint64_t { m_entries } * 8
+        || strings - blobs != uint64_t { m_blobCount } * index::BLOB_SIZE
+        || strings > tables
+        || tables > end
+        || end - tables != (sources + paths) * 8)
+    {
+        fail ("Corrupt index tables");
+    }
+
+    m_offsets = m_map + offsets;
+    m_blobs = m_map + blobs;
+    m_strings = m_map + strings;
+    m_stringsSize = tables - strings;
+
+    try {
+        for (uint64_t i { 0 } ; i < sources ; ++i) {
+            m_sources.push_back (string (m_map + tables + i * 8));
+        }
+
+        for (uint64_t i { 0 } ; i < paths ; ++i) {
+            m_paths.push_back (string (m_map + tables + (sources + i) * 8));
+        }
+    } catch (const std::runtime_error & e) {
+        fail (e.what());
+    }
+}
+
+/******************************************************************************/
+
+io::
+Index::~Index() {
+    ::munmap (const_cast<char *>(m_map), m_size);
+}
+
+/******************************************************************************/
+
+std::string_view
+io::
+Index::string (const char * entry_) const {
+    auto offset = get<uint32_t> (entry_);
+    auto length = get<uint32_t> (entry_ + 4);
+
+    if (static_cast<uint64_t>(offset) + length > m_stringsSize) {
+        throw std::runtime_error ("Corrupt index string table");
+    }
+
+    return { m_strings + offset, length };
+}
+
+/******************************************************************************/
+
+std::tuple<uint32_t, uint32_t, std::string_view>
+io::
+Index::record (size_t i_) const {
+    auto offset = get<uint64_t> (m_offsets + i_ * 8);
+    auto limit = static_cast<uint64_t>(m_offsets - m_map);
+
+    if (offset < index::HEADER_SIZE || offset + RECORD_HEADER > limit) {
+        throw std::runtime_error ("Corrupt index record");
+    }
+
+    auto record = m_map + offset;
+    auto length = get<uint32_t> (record + 8);
+
+    if (offset + RECORD_HEADER + length > limit) {
+        throw std::runtime_error ("Corrupt index record");
+    }
+
+    return {
+        get<uint32_t> (record),
+        get<uint32_t> (record + 4),
+        std::string_view (record + RECORD_HEADER, length) };
+}
+
+/******************************************************************************/
+
+size_t
+io::
+Index::search (uint32_t path_, std::string_view key_, bool after_) const {
+    size_t lo { 0 }, hi { m_entries };
+
+    while (lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        auto [path, blob, key] = record (mid);
+
+        bool before = path < path_
+            || (path == path_ && (after_ ? key <= key_ : key < key_));
+
+        if (before) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+/******************************************************************************/
+
+std::pair<std::string_view, std::string_view>
+io::
+Index::blob (size_t i_) const {
+    if (i_ >= m_blobCount) {
+        throw std::runtime_error ("Corrupt index entry");
+    }
+
+    auto entry = m_blobs + i_ * index::BLOB_SIZE;
+    auto source = get<uint32_t> (entry);
+
+    if (source >= m_sources.size()) {
+        throw std::runtime_error ("Corrupt index entry");
+    }
+
+    return { m_sources[source], string (entry + 4) };
+}
+
+/******************************************************************************/
+
+void
+io::
+Index::range (
+    std::string_view path_,
+    const std::optional<Bound> & from_,
+    const std::optional<Bound> & to_,
+    const std::function<void (const IndexEntry &)> & f_
+) const {
+    auto it = std::find (m_paths.begin(), m_paths.end(), path_);
+
+    if (it == m_paths.end()) {
+        throw std::runtime_error ("Nothing indexed for " + std::string (path_));
+    }
+
+    auto path = static_cast<uint32_t>(it - m_paths.begin());
+
+    auto i = from_
+        ? search (path, from_->key, !from_->inclusive)
+        : search (path, { }, false);
+
+    for ( ; i < m_entries ; ++i) {
+        auto [p, b, key] = record (i);
+
+        if (p != path) {
+            break;
+        }
+
+        if (to_ && (to_->inclusive ? key > to_->key : key >= to_->key)) {
+            break;
+        }
+
+        auto [source, name] = blob (b);
+
+        f_ ({ key, b, source, name });
+    }
+}
+
+/******************************************************************************
+ *
+ * io::IndexWriter
+ *
+ ******************************************************************************/
+
+bool
+io::
+IndexWriter::Record::operator< (const Record & other_) const {
+    return std::tie (path, key, blob) < std::tie (other_.path, other_.key, other_.blob);
+}
+
+/******************************************************************************/
+
+io::
+IndexWriter::IndexWriter (
+    const std::string & path_,
+    std::vector<std::string> paths_,
+    size_t budget_
+) : m_file (nullptr)
+  , m_offset (0)
+  , m_paths (std::move (paths_))
+  , m_blobs (nullptr)
+  , m_names (nullptr)
+  , m_blobCount (0)
+  , m_namesSize (0)
+  , m_budget (budget_)
+  , m_used (0)
+{
+    m_blobs = temporary();
+
+    try {
+        m_names = temporary();
+    } catch (...) {
+        std::fclose (m_blobs);
+        throw;
+    }
+
+    m_file = std::fopen (path_.c_str(), "wb");
+
+    if (!m_file) {
+        std::fclose (m_blobs);
+        std::fclose (m_names);
+        throw std::runtime_error (path_ + ": " + std::strerror (errno));
+    }
+
+    std::setvbuf (m_file, nullptr, _IOFBF, 1 << 20);
+
+    std::string header (MAGIC, sizeof (MAGIC));
+    put<uint32_t> (header, index::VERSION);
+    put<uint32_t> (header, 0);
+
+    write (header.data(), header.size());
+}
+
+/******************************************************************************/
+
+io::
+IndexWriter::~IndexWriter() {
+    for (auto f : { m_file, m_blobs, m_names }) {
+        if (f) std::fclose (f);
+    }
+
+    for (auto run : m_runs) {
+        std::fclose (run);
+    }
+}
+
+/******************************************************************************/
+
+void
+io::
+IndexWriter::write (const void * bytes_, size_t size_) {
+    store (m_file, bytes_, size_);
+    m_offset += size_;
+}
+
+/******************************************************************************/
+
+/**
+ * Copy the whole of a temporary file to the end of the index
+ */
+void
+io::
+IndexWriter::append (std::FILE * file_) {
+    std::rewind (file_);
+
+    std::vector<char> buffer (1 << 20);
+
+    while (auto read = std::fread (buffer.data(), 1, buffer.size(), file_)) {
+        write (buffer.data(), read);
+    }
+
+    if (std::ferror (file_)) {
+        throw std::runtime_error ("Failed reading index temporary file");
+    }
+}
+
+/******************************************************************************/
+
+uint32_t
+io::
+IndexWriter::blob (std::string_view source_, std::string_view name_) {
+    auto source = m_sourceIds.find (source_);
+
+    if (source == m_sourceIds.end()) {
+        source = m_sourceIds.emplace (
+            std::string (source_),
+            narrow (m_sources.size(), "source count")).first;
+        m_sources.emplace_back (source_);
+    }
+
+    auto offset = m_namesSize;
+    m_namesSize = narrow (uint64_t { m_namesSize } + name_.size(), "string table");
+
+    std::string entry;
+    put<uint32_t> (entry, source->second);
+    put<uint32_t> (entry, offset);
+    put<uint32_t> (entry, static_cast<uint32_t>(name_.size()));
+
+    store (m_blobs, entry.data(), entry.size());
+    store (m_names, name_.data(), name_.size());
+
+    return m_blobCount++;
+}
+
+/******************************************************************************/
+
+void
+io::
+IndexWriter::add (uint32_t path_, uint32_t blob_, std::string_view key_) {
+    if (path_ >= m_paths.size() || blob_ >= m_blobCount) {
+        throw std::runtime_error ("Index entry for an unknown path or blob");
+    }
+
+    narrow (key_.size(), "key");
+
+    m_records.push_back ({ path_, blob_, std::string (key_) });
+    m_used += sizeof (Record) + key_.size();
+
+    if (m_used >= m_budget) {
+        spill();
+    }
+}
+
+/******************************************************************************/
+
+void
+io::
+IndexWriter::spill() {
+    std::sort (m_records.begin(), m_records.end());
+
+    auto run = temporary();
+    m_runs.push_back (run);
+
+    std::string header;
+
+    for (const auto & r : m_records) {
+        header.clear();
+        put<uint32_t> (header, r.path);
+        put<uint32_t> (header, r.blob);
+        put<uint32_t> (header, static_cast<uint32_t>(r.key.size()));
+
+        store (run, header.data(), header.size());
+        store (run, r.key.data(), r.key.size());
+    }
+
+    m_records.clear();
+    m_records.shrink_to_fit();
+    m_used = 0;
+}
+
+/******************************************************************************/
+
+/**
+ * Write [record_] to the index and its offset to [offsets_]
+ */
+void
+io::
+IndexWriter::emit (const Record & record_, std::FILE * offsets_) {
+    std::string bytes;
+    put<uint64_t> (bytes, m_offset);
+    store (offsets_, bytes.data(), bytes.size());
+
+    bytes.clear();
+    put<uint32_t> (bytes, record_.path);
+    put<uint32_t> (bytes, record_.blob);
+    put<uint32_t> (bytes, static_cast<uint32_t>(record_.key.size()));
+    bytes += record_.key;
+
+    write (bytes.data(), bytes.size());
+}
+
+/******************************************************************************/
+
+void
+io::
+IndexWriter::close() {
+    auto offsets = temporary();
+
+    uint64_t entries { 0 };
+
+    try {
+        Record last;
+
+        // the same value held twice by a blob is only worth one entry
+        auto emit = [&](const Record & r_) {
+            if (entries
+                && last.path == r_.path
+                && last.blob == r_.blob
+                && last.key == r_.key)
+            {
+                return;
+            }
+
+            this->emit (r_, offsets);
+            ++entries;
+
+            last = r_;
+        };
+
+        if (m_runs.empty()) {
+            std::sort (m_records.begin(), m_records.end());
+
+            for (const auto & r : m_records) {
+                emit (r);
+            }
+        } else {
+            if (!m_records.empty()) {
+                spill();
+            }
+
+            std::vector<Run> runs;
+            runs.reserve (m_runs.size());
+
+            for (auto file : m_runs) {
+                runs.emplace_back (file);
+            }
+
+            auto later = [&runs](size_t a_, size_t b_) { return runs[a_] > runs[b_]; };
+
+            std::priority_queue<size_t, std::vector<size_t>, decltype (later)> heap (later);
+
+            for (size_t i { 0 } ; i < runs.size() ; ++i) {
+                if (runs[i].next()) heap.push (i);
+            }
+
+            Record r;
+
+            while (!heap.empty()) {
+                auto i = heap.top();
+                heap.pop();
+
+                r.path = runs[i].path;
+                r.blob = runs[i].blob;
+                r.key.swap (runs[i].key);
+
+                emit (r);
+
+                if (runs[i].next()) heap.push (i);
+            }
+        }
+
+        narrow (entries, "entry count");
+
+        auto offsetsStart = m_offset;
+        append (offsets);
+
+        auto blobsStart = m_offset;
+        append (m_blobs);
+
+        auto stringsStart = m_offset;
+        append (m_names);
+
+        std::string tables, strings;
+        uint64_t offset { m_namesSize };
+
+        for (const auto & names : { std::cref (m_sources), std::cref (m_paths) }) {
+            for (const auto & name : names.get()) {
+                put<uint32_t> (tables, narrow (offset, "string table"));
+                put<uint32_t> (tables, narrow (name.size(), "string table"));
+                strings += name;
+                offset += name.size();
+            }
+        }
+
+        write (strings.data(), strings.size());
+
+        auto tablesStart = m_offset;
+        write (tables.data(), tables.size());
+
+        std::string footer;
+        put<uint64_t> (footer, offsetsStart);
+        put<uint64_t> (footer, blobsStart);
+        put<uint64_t> (footer, stringsStart);
+        put<uint64_t> (footer, tablesStart);
+        put<uint32_t> (footer, static_cast<uint32_t>(entries));
+        put<uint32_t> (footer, m_blobCount);
+        put<uint32_t> (footer, static_cast<uint32_t>(m_sources.size()));
+        put<uint32_t> (footer, static_cast<uint32_t>(m_paths.size()));
+        put<uint32_t> (footer, index::VERSION);
+        put<uint32_t> (footer, 0);
+        footer.append (MAGIC, sizeof (MAGIC));
+
+        write (footer.data(), footer.size());
+    } catch (...) {
+        std::fclose (offsets);
+        throw;
+    }
+
+    std::fclose (offsets);
+
+    auto file = m_file;
+    m_file = nullptr;
+
+    if (std::fclose (file) != 0) {
+        throw std::runtime_error ("Failed writing index");
+    }
+}
+
+/******************************************************************************/
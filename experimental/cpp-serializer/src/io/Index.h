@@ -0,0 +1,228 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <optional>
+#include <functional>
+#include <string_view>
+
+/******************************************************************************/
+
+/**
+ * A secondary index, each value some field held in some blob, sorted so
+ * a value or range of them is found by binary search. Keys are opaque
+ * bytes ordered as unsigned, whoever writes them encodes them so that
+ * order is the one wanted. Everything is little endian and laid out as
+ *
+ *      header  : "CORDAIDX", u32 version, u32 reserved
+ *      records : per entry, sorted by path, key and then blob,
+ *                  u32 path, u32 blob, u32 key length, the key
+ *      offsets : per entry, in the same order, u64 offset of its record
+ *      blobs   : per blob, u32 source, u32 offset and u32 length of its
+ *                name in the string table
+ *      strings : the names of blobs, then sources and paths
+ *      tables  : per source then per path, u32 offset and u32 length of
+ *                its name
+ *      footer  : u64 offset of the offsets, u64 offset of the blobs,
+ *                u64 offset of the strings, u64 offset of the tables,
+ *                u32 entries, u32 blobs, u32 sources, u32 paths,
+ *                u32 version, u32 reserved, "CORDAIDX"
+ *
+ * A blob is named within its source, a pack and its id or, for a blob
+ * in a file of its own, no source and its path.
+ */
+namespace io::index {
+
+    constexpr uint32_t VERSION { 1 };
+
+    constexpr size_t HEADER_SIZE { 16 };
+    constexpr size_t BLOB_SIZE   { 12 };
+    constexpr size_t FOOTER_SIZE { 64 };
+
+}
+
+/******************************************************************************/
+
+namespace io {
+
+    /**
+     * An entry in an index, every view points into the mapped file
+     */
+    struct IndexEntry {
+        std::string_view key;
+        uint32_t         blob;
+        std::string_view source;
+        std::string_view name;
+    };
+
+    /**
+     * One end of a range of keys
+     */
+    struct Bound {
+        std::string key;
+        bool        inclusive;
+    };
+
+    /**
+     * An index mapped read only. Construction validates the footer and
+     * the bounds of the tables, throwing std::runtime_error if they're
+     * wrong, records are checked as they're read.
+     */
+    class Index {
+        private :
+            const char * m_map;
+            size_t       m_size;
+
+            const char * m_offsets;
+            const char * m_blobs;
+            const char * m_strings;
+            size_t       m_stringsSize;
+
+            uint32_t     m_entries;
+            uint32_t     m_blobCount;
+
+            std::vector<std::string_view> m_sources;
+            std::vector<std::string_view> m_paths;
+
+            std::string_view string (const char *) const;
+
+            /**
+             * The path, blob and key of the [i_]th entry
+             */
+            std::tuple<uint32_t, uint32_t, std::string_view> record (size_t i_) const;
+
+            /**
+             * The first entry not before [key_] in [path_], or if
+             * [after_] the first after it
+             */
+            size_t search (uint32_t path_, std::string_view key_, bool after_) const;
+
+        public :
+            explicit Index (const std::string &);
+
+            Index (const Index &) = delete;
+            ~Index();
+
+            size_t size() const { return m_entries; }
+            size_t blobs() const { return m_blobCount; }
+
+            const std::vector<std::string_view> & paths() const { return m_paths; }
+
+            /**
+             * The source and name of the [i_]th blob
+             */
+            std::pair<std::string_view, std::string_view> blob (size_t i_) const;
+
+            /**
+             * Visit every entry of [path_] with a key between [from_] and
+             * [to_], in key order, either end missing being unbounded.
+             * Finding the first is a binary search, after that it's a
+             * walk of the records.
+             *
+             * @throws std::runtime_error if there's no such path
+             */
+            void range (
+                std::string_view path_,
+                const std::optional<Bound> & from_,
+                const std::optional<Bound> & to_,
+                const std::function<void (const IndexEntry &)> &) const;
+    };
+
+}
+
+/******************************************************************************/
+
+namespace io {
+
+    /**
+     * Writes an index in bounded memory. Entries are gathered until
+     * they'd take more than the budget given, then sorted and spilled to
+     * a temporary file as a run. Closing merges the runs straight into
+     * the index, the records as they come and their offsets to one more
+     * temporary file appended after them. The names of blobs are spilled
+     * as they're added, only those of sources and paths are held.
+     */
+    class IndexWriter {
+        private :
+            struct Record {
+                uint32_t    path;
+                uint32_t    blob;
+                std::string key;
+
+                bool operator< (const Record &) const;
+            };
+
+            std::FILE * m_file;
+            uint64_t     m_offset;
+
+            std::vector<std::string> m_paths;
+            std::vector<std::string> m_sources;
+            std::map<std::string, uint32_t, std::less<>> m_sourceIds;
+
+            /**
+             * Blob table and names, relative to the start of the strings
+             */
+            std::FILE * m_blobs;
+            std::FILE * m_names;
+            uint32_t     m_blobCount;
+            uint32_t     m_namesSize;
+
+            size_t              m_budget;
+            size_t              m_used;
+            std::vector<Record> m_records;
+
+            /**
+             * Sorted runs spilled so far, temporary files
+             */
+            std::vector<std::FILE *> m_runs;
+
+            void write (const void *, size_t);
+            void append (std::FILE *);
+            void spill();
+            void emit (const Record &, std::FILE *);
+
+        public :
+            /**
+             * @param paths_ the fields being indexed, entries refer to them
+             * by position
+             * @param budget_ roughly how many bytes of entries to hold in
+             * memory before spilling
+             */
+            IndexWriter (
+                const std::string &,
+                std::vector<std::string> paths_,
+                size_t budget_ = 64 << 20);
+
+            IndexWriter (const IndexWriter &) = delete;
+
+            /**
+             * Closes the files if [close] wasn't called, leaving an index
+             * that won't open
+             */
+            ~IndexWriter();
+
+            /**
+             * Register a blob, an empty [source_] for one in a file of its
+             * own named by its path
+             *
+             * @return its number, to [add] entries for it
+             */
+            uint32_t blob (std::string_view source_, std::string_view name_);
+
+            void add (uint32_t path_, uint32_t blob_, std::string_view key_);
+
+            /**
+             * Merge everything into the index and close it
+             */
+            void close();
+    };
+
+}
+
+/******************************************************************************/
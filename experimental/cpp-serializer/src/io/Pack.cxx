@@ -0,0 +1,381 @@
+#include "Pack.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/******************************************************************************/
+
+namespace {
+
+    constexpr char MAGIC[] { 'C', 'O', 'R', 'D', 'A', 'P', 'A', 'K' };
+
+    template<typename T>
+    T
+    get (const char * p_) {
+        T rtn { 0 };
+
+        for (size_t i { 0 } ; i < sizeof (T) ; ++i) {
+            rtn |= static_cast<T>(static_cast<uint8_t>(p_[i])) << (8 * i);
+        }
+
+        return rtn;
+    }
+
+    template<typename T>
+    void
+    put (std::string & out_, T value_) {
+        for (size_t i { 0 } ; i < sizeof (T) ; ++i) {
+            out_ += static_cast<char>(value_ >> (8 * i));
+        }
+    }
+
+    /**
+     * Entries and strings are indexed with 32 bits
+     */
+    uint32_t
+    narrow (size_t value_, const char * what_) {
+        if (value_ > UINT32_MAX) {
+            throw std::runtime_error (std::string ("Pack ") + what_ + " too large");
+        }
+
+        return static_cast<uint32_t>(value_);
+    }
+
+}
+
+/******************************************************************************
+ *
+ * io::Pack
+ *
+ ******************************************************************************/
+
+io::
+Pack::Pack (const std::string & path_)
+    : m_map (nullptr)
+    , m_size (0)
+{
+    int fd = ::open (path_.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+        throw std::runtime_error (path_ + ": " + std::strerror (errno));
+    }
+
+    struct stat results { };
+
+    if (::fstat (fd, &results) != 0) {
+        ::close (fd);
+        throw std::runtime_error (path_ + ": " + std::strerror (errno));
+    }
+
+    m_size = results.st_size;
+
+    if (m_size < pack::HEADER_SIZE + pack::FOOTER_SIZE) {
+        ::close (fd);
+        throw std::runtime_error (path_ + ": Not a pack");
+    }
+
+    auto map = ::mmap (nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close (fd);
+
+    if (map == MAP_FAILED) {
+        throw std::runtime_error (path_ + ": " + std::strerror (errno));
+    }
+
+    m_map = static_cast<const char *>(map);
+
+    auto fail = [this, &path_](const char * why_) {
+        ::munmap (const_cast<char *>(m_map), m_size);
+        throw std::runtime_error (path_ + ": " + why_);
+    };
+
+    auto footer = m_map + m_size - pack::FOOTER_SIZE;
+
+    if (std::memcmp (m_map, MAGIC, sizeof (MAGIC)) != 0
+        || std::memcmp (footer + 24, MAGIC, sizeof (MAGIC)) != 0)
+    {
+        fail ("Not a pack");
+    }
+
+    if (get<uint32_t> (m_map + 8) != pack::VERSION
+        || get<uint32_t> (footer + 20) != pack::VERSION)
+    {
+        fail ("Unsupported pack version");
+    }
+
+    auto entries = get<uint64_t> (footer);
+    auto strings = get<uint64_t> (footer + 8);
+    m_count = get<uint32_t> (footer + 16);
+
+    auto end = static_cast<uint64_t>(m_size - pack::FOOTER_SIZE);
+
+    if (entries < pack::HEADER_SIZE
+        || strings > end
+        || entries > strings
+        || (strings - entries) / (pack::ENTRY_SIZE + 4) < m_count)
+    {
+        fail ("Corrupt pack index");
+    }
+
+    m_entries = m_map + entries;
+    m_byId = m_entries + m_count * pack::ENTRY_SIZE;
+    m_strings = m_map + strings;
+    m_stringsSize = end - strings;
+}
+
+/******************************************************************************/
+
+io::
+Pack::~Pack() {
+    ::munmap (const_cast<char *>(m_map), m_size);
+}
+
+/******************************************************************************/
+
+bool
+io::
+Pack::is (const std::string & path_) {
+    int fd = ::open (path_.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+        return false;
+    }
+
+    char header[sizeof (MAGIC)];
+    auto n = ::read (fd, header, sizeof (header));
+    ::close (fd);
+
+    return n == static_cast<ssize_t>(sizeof (header))
+        && std::memcmp (header, MAGIC, sizeof (MAGIC)) == 0;
+}
+
+/******************************************************************************/
+
+std::string_view
+io::
+Pack::string (size_t entry_) const {
+    auto offset = get<uint32_t> (m_entries + entry_);
+    auto length = get<uint32_t> (m_entries + entry_ + 4);
+
+    if (static_cast<uint64_t>(offset) + length > m_stringsSize) {
+        throw std::runtime_error ("Corrupt pack string table");
+    }
+
+    return { m_strings + offset, length };
+}
+
+/******************************************************************************/
+
+io::PackEntry
+io::
+Pack::operator[] (size_t i_) const {
+    auto entry = i_ * pack::ENTRY_SIZE;
+
+    auto offset = get<uint64_t> (m_entries + entry);
+    auto length = get<uint32_t> (m_entries + entry + 8);
+
+    if (offset < pack::HEADER_SIZE
+        || offset + length > static_cast<uint64_t>(m_entries - m_map))
+    {
+        throw std::runtime_error ("Corrupt pack entry");
+    }
+
+    return { string (entry + 12), string (entry + 20), m_map + offset, length };
+}
+
+/******************************************************************************/
+
+std::optional<io::PackEntry>
+io::
+Pack::find (std::string_view id_) const {
+    size_t lo { 0 }, hi { m_count };
+
+    while (lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        auto i = get<uint32_t> (m_byId + mid * 4);
+
+        if (i >= m_count) {
+            throw std::runtime_error ("Corrupt pack index");
+        }
+
+        auto id = string (i * pack::ENTRY_SIZE + 12);
+
+        if (id < id_) {
+            lo = mid + 1;
+        } else if (id_ < id) {
+            hi = mid;
+        } else {
+            return (*this)[i];
+        }
+    }
+
+    return std::nullopt;
+}
+
+/******************************************************************************/
+
+void
+io::
+Pack::scan (const std::function<void (const PackEntry &)> & f_) const {
+    auto base = const_cast<char *>(m_map);
+
+    ::madvise (base, m_size, MADV_SEQUENTIAL);
+
+    try {
+        for (size_t i { 0 } ; i < m_count ; ++i) {
+            f_ ((*this)[i]);
+        }
+    } catch (...) {
+        ::madvise (base, m_size, MADV_NORMAL);
+        throw;
+    }
+
+    ::madvise (base, m_size, MADV_NORMAL);
+}
+
+/******************************************************************************
+ *
+ * io::PackWriter
+ *
+ ******************************************************************************/
+
+io::
+PackWriter::PackWriter (const std::string & path_)
+    : m_file (std::fopen (path_.c_str(), "wb"))
+    , m_offset (0)
+{
+    if (!m_file) {
+        throw std::runtime_error (path_ + ": " + std::strerror (errno));
+    }
+
+    // records are written a few bytes at a time, buffer them in bulk
+    std::setvbuf (m_file, nullptr, _IOFBF, 1 << 20);
+
+    std::string header (MAGIC, sizeof (MAGIC));
+    put<uint32_t> (header, pack::VERSION);
+    put<uint32_t> (header, 0);
+
+    write (header.data(), header.size());
+}
+
+/******************************************************************************/
+
+io::
+PackWriter::~PackWriter() {
+    if (m_file) {
+        std::fclose (m_file);
+    }
+}
+
+/******************************************************************************/
+
+void
+io::
+PackWriter::write (const void * bytes_, size_t size_) {
+    if (std::fwrite (bytes_, 1, size_, m_file) != size_) {
+        throw std::runtime_error ("Failed writing pack");
+    }
+
+    m_offset += size_;
+}
+
+/******************************************************************************/
+
+void
+io::
+PackWriter::add (
+    std::string_view id_,
+    std::string_view fingerprint_,
+    const char * blob_,
+    size_t size_
+) {
+    if (m_ids.find (id_) != m_ids.end()) {
+        throw std::runtime_error ("Duplicate pack id " + std::string (id_));
+    }
+
+    auto intern = [this](std::string_view s_) {
+        auto offset = narrow (m_strings.size(), "string table");
+        m_strings.append (s_);
+        return offset;
+    };
+
+    auto fingerprint = m_fingerprints.find (fingerprint_);
+
+    if (fingerprint == m_fingerprints.end()) {
+        fingerprint = m_fingerprints.emplace (
+            std::string (fingerprint_), intern (fingerprint_)).first;
+    }
+
+    auto index = narrow (m_entries.size(), "entry count");
+
+    m_ids.emplace (std::string (id_), index);
+
+    std::string length;
+    put<uint32_t> (length, narrow (size_, "blob"));
+    write (length.data(), length.size());
+
+    m_entries.push_back ({
+        m_offset,
+        static_cast<uint32_t>(size_),
+        intern (id_),
+        static_cast<uint32_t>(id_.size()),
+        fingerprint->second,
+        static_cast<uint32_t>(fingerprint_.size()) });
+
+    write (blob_, size_);
+}
+
+/******************************************************************************/
+
+void
+io::
+PackWriter::close() {
+    std::string index;
+    index.reserve (m_entries.size() * (pack::ENTRY_SIZE + 4));
+
+    auto entries = m_offset;
+
+    for (const auto & entry : m_entries) {
+        put<uint64_t> (index, entry.offset);
+        put<uint32_t> (index, entry.length);
+        put<uint32_t> (index, entry.id);
+        put<uint32_t> (index, entry.idLength);
+        put<uint32_t> (index, entry.fingerprint);
+        put<uint32_t> (index, entry.fingerprintLength);
+        put<uint32_t> (index, 0);
+    }
+
+    // std::map keeps the ids sorted for us
+    for (const auto & id : m_ids) {
+        put<uint32_t> (index, id.second);
+    }
+
+    write (index.data(), index.size());
+
+    auto strings = m_offset;
+
+    write (m_strings.data(), m_strings.size());
+
+    std::string footer;
+    put<uint64_t> (footer, entries);
+    put<uint64_t> (footer, strings);
+    put<uint32_t> (footer, static_cast<uint32_t>(m_entries.size()));
+    put<uint32_t> (footer, pack::VERSION);
+    footer.append (MAGIC, sizeof (MAGIC));
+
+    write (footer.data(), footer.size());
+
+    auto file = m_file;
+    m_file = nullptr;
+
+    if (std::fclose (file) != 0) {
+        throw std::runtime_error ("Failed writing pack");
+    }
+}
+
+/******************************************************************************/
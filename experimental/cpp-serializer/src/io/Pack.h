@@ -0,0 +1,171 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <optional>
+#include <functional>
+#include <string_view>
+
+/******************************************************************************/
+
+/**
+ * Millions of tiny blob files are far harder on a filesystem than the
+ * same bytes in one file, a pack concatenates them. Everything is little
+ * endian and laid out as
+ *
+ *      header  : "CORDAPAK", u32 version, u32 reserved
+ *      records : per blob a u32 length then the blob, header and all
+ *      entries : per blob, in the order they were written,
+ *                  u64 offset of the blob's bytes
+ *                  u32 length
+ *                  u32 offset and u32 length of its id
+ *                  u32 offset and u32 length of its outer type's
+ *                      fingerprint
+ *                  u32 reserved
+ *                offsets into the string table
+ *      by id   : per blob a u32 entry number, ordered by id
+ *      strings : ids and fingerprints, each fingerprint stored once
+ *      footer  : u64 offset of the entries, u64 offset of the strings,
+ *                u32 count, u32 version, "CORDAPAK"
+ *
+ * Scanning walks the entries, and so the records, in file order and
+ * finding a blob by id is a binary search of the by id table.
+ */
+namespace io::pack {
+
+    constexpr uint32_t VERSION { 1 };
+
+    constexpr size_t HEADER_SIZE { 16 };
+    constexpr size_t ENTRY_SIZE  { 32 };
+    constexpr size_t FOOTER_SIZE { 32 };
+
+}
+
+/******************************************************************************/
+
+namespace io {
+
+    /**
+     * A blob in a pack, every view points into the mapped file
+     */
+    struct PackEntry {
+        std::string_view id;
+        std::string_view fingerprint;
+        const char *     data;
+        size_t           size;
+    };
+
+    /**
+     * A pack mapped read only. Construction validates the footer and
+     * the bounds of the index, throwing std::runtime_error if they're
+     * wrong, but the blobs themselves are only looked at by whoever
+     * reads them.
+     */
+    class Pack {
+        private :
+            const char * m_map;
+            size_t       m_size;
+
+            const char * m_entries;
+            const char * m_byId;
+            const char * m_strings;
+            size_t       m_stringsSize;
+            uint32_t     m_count;
+
+            std::string_view string (size_t) const;
+
+        public :
+            explicit Pack (const std::string &);
+
+            Pack (const Pack &) = delete;
+            ~Pack();
+
+            /**
+             * Whether [path_] starts as a pack does, a cheap check that
+             * reads only its header
+             */
+            static bool is (const std::string & path_);
+
+            size_t size() const { return m_count; }
+
+            /**
+             * The [i_]th blob in the order it was written
+             */
+            PackEntry operator[] (size_t i_) const;
+
+            std::optional<PackEntry> find (std::string_view id_) const;
+
+            /**
+             * Visit every blob in file order, telling the kernel to read
+             * ahead as we go
+             */
+            void scan (const std::function<void (const PackEntry &)> &) const;
+    };
+
+}
+
+/******************************************************************************/
+
+namespace io {
+
+    /**
+     * Writes a pack. Blobs are streamed out as they're added, only the
+     * index is held in memory until [close]
+     */
+    class PackWriter {
+        private :
+            struct Entry {
+                uint64_t offset;
+                uint32_t length;
+                uint32_t id;
+                uint32_t idLength;
+                uint32_t fingerprint;
+                uint32_t fingerprintLength;
+            };
+
+            std::FILE * m_file;
+            uint64_t     m_offset;
+
+            std::vector<Entry> m_entries;
+            std::string        m_strings;
+
+            std::map<std::string, uint32_t, std::less<>> m_ids;
+            std::map<std::string, uint32_t, std::less<>> m_fingerprints;
+
+            void write (const void *, size_t);
+
+        public :
+            explicit PackWriter (const std::string &);
+
+            PackWriter (const PackWriter &) = delete;
+
+            /**
+             * Closes the file if [close] wasn't called, without writing
+             * the index, leaving a pack that won't open
+             */
+            ~PackWriter();
+
+            /**
+             * Append a blob, throwing std::runtime_error if [id_] has
+             * already been used
+             */
+            void add (
+                std::string_view id_,
+                std::string_view fingerprint_,
+                const char * blob_,
+                size_t size_);
+
+            /**
+             * Write the index and footer and close the file
+             */
+            void close();
+    };
+
+}
+
+/******************************************************************************/
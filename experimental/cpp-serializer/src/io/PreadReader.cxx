@@ -0,0 +1,132 @@
+#include "PreadReader.h"
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <exception>
+
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Read the whole of [path_] into [buffer_]
+     *
+     * @return zero or the errno of whatever went wrong
+     */
+    int
+    slurp (const std::string & path_, std::vector<char> & buffer_) {
+        int fd = ::open (path_.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fd < 0) {
+            return errno;
+        }
+
+        struct stat results { };
+        int error { 0 };
+
+        if (::fstat (fd, &results) != 0) {
+            error = errno;
+        } else {
+            buffer_.resize (results.st_size);
+
+            for (size_t done { 0 } ; done < buffer_.size() ; ) {
+                auto n = ::pread (
+                    fd, buffer_.data() + done, buffer_.size() - done, done);
+
+                if (n > 0) {
+                    done += n;
+                } else if (n == 0) {
+                    // the file shrank under us, take what there was
+                    buffer_.resize (done);
+                } else if (errno != EINTR) {
+                    error = errno;
+                    break;
+                }
+            }
+        }
+
+        ::close (fd);
+
+        return error;
+    }
+
+}
+
+/******************************************************************************/
+
+io::
+PreadReader::PreadReader (const Options & options_)
+    : m_options (options_)
+{ }
+
+/******************************************************************************/
+
+void
+io::
+PreadReader::read (
+    const std::vector<std::string> & paths_,
+    const Consumer & consumer_
+) {
+    std::atomic<size_t> next { 0 };
+    std::atomic<bool> failed { false };
+    std::exception_ptr failure;
+    std::mutex mutex;
+
+    auto work = [&]() {
+        std::vector<char> buffer;
+        buffer.reserve (m_options.bufferSize);
+
+        for (size_t i ; !failed && (i = next++) < paths_.size() ; ) {
+            int error = slurp (paths_[i], buffer);
+
+            try {
+                consumer_ ({
+                    i,
+                    paths_[i],
+                    error ? nullptr : buffer.data(),
+                    error ? 0 : buffer.size(),
+                    error });
+            } catch (...) {
+                std::lock_guard<std::mutex> lock (mutex);
+
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+
+                failed = true;
+            }
+        }
+    };
+
+    size_t workers = m_options.workers
+        ? m_options.workers
+        : std::max (std::thread::hardware_concurrency(), 1U);
+
+    workers = std::min (workers, std::max<size_t> (paths_.size(), 1));
+
+    // the calling thread makes up the numbers
+    std::vector<std::thread> threads;
+
+    for (size_t i { 1 } ; i < workers ; ++i) {
+        threads.emplace_back (work);
+    }
+
+    work();
+
+    for (auto & thread : threads) {
+        thread.join();
+    }
+
+    if (failure) {
+        std::rethrow_exception (failure);
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,32 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "BatchReader.h"
+
+/******************************************************************************/
+
+namespace io {
+
+    /**
+     * The portable fallback, each worker opens, reads and closes the
+     * next file itself before decoding it so there are as many reads in
+     * flight as there are workers
+     */
+    class PreadReader : public BatchReader {
+        private :
+            Options m_options;
+
+        public :
+            explicit PreadReader (const Options &);
+
+            void read (
+                const std::vector<std::string> &,
+                const Consumer &) override;
+
+            const char * name() const override { return "pread"; }
+    };
+
+}
+
+/******************************************************************************/
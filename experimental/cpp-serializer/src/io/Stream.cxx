@@ -0,0 +1,175 @@
+#include "Stream.h"
+
+#include <mutex>
+#include <array>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <system_error>
+#include <condition_variable>
+
+#include <poll.h>
+#include <unistd.h>
+
+/******************************************************************************/
+
+struct io::Stream::State {
+    int fd;
+
+    /**
+     * Written to when the stream is destroyed, waking the thread if it's
+     * waiting for the descriptor to become readable
+     */
+    int wake[2] { -1, -1 };
+
+    std::array<std::vector<char>, 2> buffers;
+    std::array<size_t, 2> filled { 0, 0 };
+    std::array<bool, 2> full { false, false };
+
+    /**
+     * The buffer the caller reads next and whether it's still holding
+     * the one before
+     */
+    unsigned next { 0 };
+    bool     holding { false };
+
+    bool ended { false };
+    bool stopping { false };
+    int  error { 0 };
+
+    std::mutex mutex;
+    std::condition_variable changed;
+
+    void read();
+};
+
+/******************************************************************************/
+
+void
+io::
+Stream::State::read() {
+    for (unsigned i { 0 } ; ; i ^= 1) {
+        {
+            std::unique_lock<std::mutex> lock (mutex);
+            changed.wait (lock, [this, i]() { return stopping || !full[i]; });
+
+            if (stopping) {
+                return;
+            }
+        }
+
+        // only read once there's something to, a read blocked on a quiet
+        // descriptor couldn't be stopped
+        std::array<pollfd, 2> fds {{ { fd, POLLIN, 0 }, { wake[0], POLLIN, 0 } }};
+
+        ssize_t n;
+
+        do {
+            n = ::poll (fds.data(), fds.size(), -1);
+        } while (n < 0 && errno == EINTR);
+
+        if (n >= 0) {
+            if (fds[1].revents & POLLIN) {
+                return;
+            }
+
+            do {
+                n = ::read (fd, buffers[i].data(), buffers[i].size());
+            } while (n < 0 && errno == EINTR);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock (mutex);
+
+            if (n > 0) {
+                filled[i] = n;
+                full[i] = true;
+            } else {
+                error = n < 0 ? errno : 0;
+                ended = true;
+            }
+        }
+
+        changed.notify_all();
+
+        if (n <= 0) {
+            return;
+        }
+    }
+}
+
+/******************************************************************************/
+
+io::
+Stream::Stream (int fd_, size_t bufferSize_)
+    : m_state (std::make_unique<State>())
+{
+    m_state->fd = fd_;
+
+    for (auto & buffer : m_state->buffers) {
+        buffer.resize (bufferSize_);
+    }
+
+    if (::pipe (m_state->wake) != 0) {
+        throw std::system_error (errno, std::generic_category(), "pipe");
+    }
+
+    m_reader = std::thread ([state = m_state.get()]() { state->read(); });
+}
+
+/******************************************************************************/
+
+io::
+Stream::~Stream() {
+    {
+        std::lock_guard<std::mutex> lock (m_state->mutex);
+        m_state->stopping = true;
+    }
+
+    m_state->changed.notify_all();
+
+    char stop { 0 };
+    [[maybe_unused]] auto n = ::write (m_state->wake[1], &stop, 1);
+
+    m_reader.join();
+
+    ::close (m_state->wake[0]);
+    ::close (m_state->wake[1]);
+}
+
+/******************************************************************************/
+
+std::string_view
+io::
+Stream::next() {
+    auto & state = *m_state;
+
+    std::unique_lock<std::mutex> lock (state.mutex);
+
+    if (state.holding) {
+        state.full[state.next ^ 1] = false;
+        state.holding = false;
+        state.changed.notify_all();
+    }
+
+    state.changed.wait (lock, [&state]() {
+        return state.full[state.next] || state.ended;
+    });
+
+    if (!state.full[state.next]) {
+        if (state.error) {
+            throw std::system_error (state.error, std::generic_category(), "read");
+        }
+
+        return { };
+    }
+
+    auto i = state.next;
+
+    state.next ^= 1;
+    state.holding = true;
+
+    return { state.buffers[i].data(), state.filled[i] };
+}
+
+/******************************************************************************/
@@ -0,0 +1,65 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <memory>
+#include <thread>
+#include <cstddef>
+#include <string_view>
+
+/******************************************************************************/
+
+namespace io {
+
+    /**
+     * Double buffered reading of a file descriptor, typically stdin or a
+     * FIFO. A thread reads into one buffer while the caller works through
+     * the other, so the next read is already under way, or done, by the
+     * time the caller wants its bytes.
+     *
+     * e.g.
+     *
+     *      io::Stream stream (STDIN_FILENO);
+     *
+     *      for (auto chunk = stream.next() ; !chunk.empty() ; chunk = stream.next()) {
+     *          ...
+     *      }
+     *
+     * Chunks are whatever a single read returned, up to the buffer size,
+     * so bytes reach the caller as soon as they arrive rather than once a
+     * buffer has filled.
+     *
+     * The thread only reads once the descriptor has something to read,
+     * so however quiet it is destroying the stream stops the thread and
+     * waits for it. Once the stream is gone the descriptor can be closed.
+     */
+    class Stream {
+        private :
+            struct State;
+
+            /**
+             * Shared with the reading thread
+             */
+            std::unique_ptr<State> m_state;
+
+            std::thread m_reader;
+
+        public :
+            explicit Stream (int fd_, size_t bufferSize_ = 1 << 20);
+
+            Stream (const Stream &) = delete;
+
+            ~Stream();
+
+            /**
+             * The next chunk of bytes, empty once the stream has ended.
+             * The chunk is valid until the following call, when its buffer
+             * is handed back to be refilled. Throws std::system_error if
+             * a read fails.
+             */
+            std::string_view next();
+    };
+
+}
+
+/******************************************************************************/
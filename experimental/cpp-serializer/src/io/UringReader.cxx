@@ -0,0 +1,577 @@
+#include "UringReader.h"
+
+/******************************************************************************/
+
+#if defined (__linux__) && __has_include (<linux/io_uring.h>)
+
+/******************************************************************************/
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <exception>
+#include <system_error>
+#include <condition_variable>
+
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+/******************************************************************************/
+
+namespace {
+
+    int
+    setup (unsigned entries_, io_uring_params * params_) {
+        return static_cast<int>(::syscall (__NR_io_uring_setup, entries_, params_));
+    }
+
+    int
+    enter (int fd_, unsigned submit_, unsigned wait_, unsigned flags_) {
+        return static_cast<int>(::syscall (
+            __NR_io_uring_enter, fd_, submit_, wait_, flags_, nullptr, 0));
+    }
+
+    int
+    enrol (int fd_, unsigned opcode_, void * arg_, unsigned count_) {
+        return static_cast<int>(::syscall (
+            __NR_io_uring_register, fd_, opcode_, arg_, count_));
+    }
+
+    /*
+     * The ring heads and tails are shared with the kernel
+     */
+    unsigned
+    acquire (const unsigned * p_) {
+        return __atomic_load_n (p_, __ATOMIC_ACQUIRE);
+    }
+
+    void
+    release (unsigned * p_, unsigned value_) {
+        __atomic_store_n (p_, value_, __ATOMIC_RELEASE);
+    }
+
+    template<typename T>
+    T *
+    at (void * base_, uint32_t offset_) {
+        return reinterpret_cast<T *>(static_cast<char *>(base_) + offset_);
+    }
+
+    /**
+     * A file between being opened and being closed
+     */
+    struct Slot {
+        enum State { Opening, Reading, Closing };
+
+        State               state;
+        size_t              index;
+        int                 fd;
+        std::vector<char> * buffer;
+
+        /**
+         * How much of the file has been read so far
+         */
+        size_t              size;
+    };
+
+    /**
+     * A buffer on its way to, or back from, the decode workers
+     */
+    struct Ready {
+        size_t              index;
+        std::vector<char> * buffer;
+        size_t              size;
+        int                 error;
+    };
+
+}
+
+/******************************************************************************/
+
+io::
+UringReader::UringReader (const Options & options_)
+    : m_options (options_)
+    , m_fd (-1)
+    , m_sq (nullptr)
+    , m_sqSize (0)
+    , m_cq (nullptr)
+    , m_cqSize (0)
+    , m_sqes (nullptr)
+    , m_sqesSize (0)
+    , m_sqHead (nullptr)
+    , m_sqTail (nullptr)
+    , m_sqMask (nullptr)
+    , m_sqArray (nullptr)
+    , m_sqEntries (0)
+    , m_cqHead (nullptr)
+    , m_cqTail (nullptr)
+    , m_cqMask (nullptr)
+    , m_cqes (nullptr)
+    , m_pending (0)
+{
+    m_options.depth = std::clamp (m_options.depth, 1U, 4096U);
+}
+
+/******************************************************************************/
+
+io::
+UringReader::~UringReader() {
+    if (m_sqes) {
+        ::munmap (m_sqes, m_sqesSize);
+    }
+
+    if (m_cq && m_cq != m_sq) {
+        ::munmap (m_cq, m_cqSize);
+    }
+
+    if (m_sq) {
+        ::munmap (m_sq, m_sqSize);
+    }
+
+    if (m_fd >= 0) {
+        ::close (m_fd);
+    }
+}
+
+/******************************************************************************/
+
+uPtr<io::UringReader>
+io::
+UringReader::make (const Options & options_) {
+    uPtr<UringReader> reader { new UringReader (options_) };
+
+    if (reader->setup() && reader->supported()) {
+        return reader;
+    }
+
+    return nullptr;
+}
+
+/******************************************************************************/
+
+bool
+io::
+UringReader::setup() {
+    io_uring_params params { };
+
+    // containers, seccomp profiles and older kernels all say no here
+    if ((m_fd = ::setup (m_options.depth, &params)) < 0) {
+        return false;
+    }
+
+    m_sqEntries = params.sq_entries;
+
+    m_sqSize = params.sq_off.array + params.sq_entries * sizeof (unsigned);
+    m_cqSize = params.cq_off.cqes + params.cq_entries * sizeof (io_uring_cqe);
+
+    bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+
+    if (single) {
+        m_sqSize = m_cqSize = std::max (m_sqSize, m_cqSize);
+    }
+
+    auto map = [this](size_t size_, off_t offset_) -> void * {
+        auto p = ::mmap (
+            nullptr, size_, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, m_fd, offset_);
+
+        return p == MAP_FAILED ? nullptr : p;
+    };
+
+    if (!(m_sq = map (m_sqSize, IORING_OFF_SQ_RING))) {
+        return false;
+    }
+
+    if (!(m_cq = single ? m_sq : map (m_cqSize, IORING_OFF_CQ_RING))) {
+        return false;
+    }
+
+    m_sqesSize = params.sq_entries * sizeof (io_uring_sqe);
+
+    if (!(m_sqes = static_cast<io_uring_sqe *>(map (m_sqesSize, IORING_OFF_SQES)))) {
+        return false;
+    }
+
+    m_sqHead  = at<unsigned> (m_sq, params.sq_off.head);
+    m_sqTail  = at<unsigned> (m_sq, params.sq_off.tail);
+    m_sqMask  = at<unsigned> (m_sq, params.sq_off.ring_mask);
+    m_sqArray = at<unsigned> (m_sq, params.sq_off.array);
+
+    m_cqHead  = at<unsigned> (m_cq, params.cq_off.head);
+    m_cqTail  = at<unsigned> (m_cq, params.cq_off.tail);
+    m_cqMask  = at<unsigned> (m_cq, params.cq_off.ring_mask);
+    m_cqes    = at<io_uring_cqe> (m_cq, params.cq_off.cqes);
+
+    return true;
+}
+
+/******************************************************************************/
+
+/**
+ * Opening files through the ring needs a 5.6 kernel, ask rather than
+ * finding out from the first completion
+ */
+bool
+io::
+UringReader::supported() const {
+    constexpr unsigned ops { 256 };
+
+    std::vector<char> storage (
+        sizeof (io_uring_probe) + ops * sizeof (io_uring_probe_op));
+
+    auto * probe = reinterpret_cast<io_uring_probe *>(storage.data());
+
+    if (enrol (m_fd, IORING_REGISTER_PROBE, probe, ops) < 0) {
+        return false;
+    }
+
+    for (unsigned op : { IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_CLOSE }) {
+        if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+
+/**
+ * The next free submission queue entry, cleared. Without SQPOLL the
+ * kernel only reads the queue from within io_uring_enter so the entry
+ * can be filled in after the tail has moved past it.
+ */
+io_uring_sqe *
+io::
+UringReader::sqe() {
+    unsigned tail = *m_sqTail;
+
+    if (tail - acquire (m_sqHead) >= m_sqEntries) {
+        submit (0);
+    }
+
+    unsigned i = tail & *m_sqMask;
+
+    auto * sqe = &m_sqes[i];
+    std::memset (sqe, 0, sizeof (*sqe));
+
+    m_sqArray[i] = i;
+    release (m_sqTail, tail + 1);
+
+    ++m_pending;
+
+    return sqe;
+}
+
+/******************************************************************************/
+
+/**
+ * Hand everything queued to the kernel and wait for at least [wait_]
+ * completions
+ */
+void
+io::
+UringReader::submit (unsigned wait_) {
+    do {
+        int n = enter (
+            m_fd, m_pending, wait_, wait_ ? IORING_ENTER_GETEVENTS : 0);
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            throw std::system_error (errno, std::generic_category(), "io_uring_enter");
+        }
+
+        m_pending -= n;
+    } while (m_pending);
+}
+
+/******************************************************************************/
+
+/**
+ * This thread keeps up to [depth] files moving through open, read and
+ * close while the workers decode whatever has landed. Every file holds a
+ * pooled buffer from being opened until its consumer returns so the pool
+ * is sized for a full ring plus one buffer per worker.
+ */
+void
+io::
+UringReader::read (
+    const std::vector<std::string> & paths_,
+    const Consumer & consumer_
+) {
+    size_t workers = m_options.workers
+        ? m_options.workers
+        : std::max (std::thread::hardware_concurrency(), 1U);
+
+    workers = std::min (workers, std::max<size_t> (paths_.size(), 1));
+
+    std::vector<std::vector<char>> buffers (m_options.depth + workers);
+    std::vector<std::vector<char> *> free;
+
+    for (auto & buffer : buffers) {
+        buffer.resize (m_options.bufferSize);
+        free.push_back (&buffer);
+    }
+
+    std::vector<Slot> slots (m_options.depth);
+    std::vector<unsigned> idle;
+
+    for (unsigned i { 0 } ; i < slots.size() ; ++i) {
+        idle.push_back (i);
+    }
+
+    std::mutex mutex;
+    std::condition_variable ready, returned;
+    std::deque<Ready> queue;
+    bool done { false };
+
+    std::atomic<bool> failed { false };
+    std::exception_ptr failure;
+
+    auto work = [&]() {
+        for (;;) {
+            Ready r;
+
+            {
+                std::unique_lock<std::mutex> lock (mutex);
+                ready.wait (lock, [&]() { return done || !queue.empty(); });
+
+                if (queue.empty()) {
+                    return;
+                }
+
+                r = queue.front();
+                queue.pop_front();
+            }
+
+            if (!failed) {
+                try {
+                    consumer_ ({
+                        r.index,
+                        paths_[r.index],
+                        r.error ? nullptr : r.buffer->data(),
+                        r.error ? 0 : r.size,
+                        r.error });
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock (mutex);
+
+                    if (!failure) {
+                        failure = std::current_exception();
+                    }
+
+                    failed = true;
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock (mutex);
+                free.push_back (r.buffer);
+            }
+
+            returned.notify_one();
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (size_t i { 0 } ; i < workers ; ++i) {
+        threads.emplace_back (work);
+    }
+
+    /*
+     * Reads are queued one after another until one comes back empty, a
+     * read can stop short of the end of the file, on a network or FUSE
+     * filesystem say, so nothing less tells us it's whole. Each read asks
+     * for whatever's left of the buffer and a full buffer is doubled
+     * first. Buffers are pooled so the room's kept for later files.
+     */
+    auto readNext = [&](Slot & slot_, uint64_t i_) {
+        if (slot_.size == slot_.buffer->size()) {
+            slot_.buffer->resize (std::max<size_t> (slot_.buffer->size() * 2, 4096));
+        }
+
+        auto * e = sqe();
+        e->opcode = IORING_OP_READ;
+        e->fd = slot_.fd;
+        e->addr = reinterpret_cast<uintptr_t>(slot_.buffer->data() + slot_.size);
+        e->len = static_cast<uint32_t>(std::min<size_t> (
+            slot_.buffer->size() - slot_.size, 1U << 30));
+        e->off = slot_.size;
+        e->user_data = i_;
+    };
+
+    auto handOff = [&](const Slot & slot_, size_t size_, int error_) {
+        {
+            std::lock_guard<std::mutex> lock (mutex);
+            queue.push_back ({ slot_.index, slot_.buffer, size_, error_ });
+        }
+
+        ready.notify_one();
+    };
+
+    try {
+        size_t next { 0 };
+        size_t inflight { 0 };
+
+        while (inflight || (next < paths_.size() && !failed)) {
+            while (next < paths_.size() && !idle.empty() && !failed) {
+                std::vector<char> * buffer;
+
+                {
+                    std::unique_lock<std::mutex> lock (mutex);
+
+                    if (free.empty()) {
+                        // rather than block, reap what's in flight
+                        if (inflight) {
+                            break;
+                        }
+
+                        returned.wait (lock, [&]() { return !free.empty(); });
+                    }
+
+                    buffer = free.back();
+                    free.pop_back();
+                }
+
+                auto i = idle.back();
+                idle.pop_back();
+
+                slots[i] = { Slot::Opening, next, -1, buffer, 0 };
+
+                auto * e = sqe();
+                e->opcode = IORING_OP_OPENAT;
+                e->fd = AT_FDCWD;
+                e->addr = reinterpret_cast<uintptr_t>(paths_[next].c_str());
+                e->open_flags = O_RDONLY | O_CLOEXEC;
+                e->user_data = i;
+
+                ++next;
+                ++inflight;
+            }
+
+            if (!inflight) {
+                break;
+            }
+
+            submit (1);
+
+            unsigned head = *m_cqHead;
+
+            for (unsigned tail = acquire (m_cqTail) ; head != tail ; ++head) {
+                const auto & cqe = m_cqes[head & *m_cqMask];
+                auto & slot = slots[cqe.user_data];
+
+                switch (slot.state) {
+                    case Slot::Opening : {
+                        if (cqe.res < 0) {
+                            handOff (slot, 0, -cqe.res);
+                            idle.push_back (cqe.user_data);
+                            --inflight;
+                            break;
+                        }
+
+                        slot.state = Slot::Reading;
+                        slot.fd = cqe.res;
+
+                        readNext (slot, cqe.user_data);
+                        break;
+                    }
+                    case Slot::Reading : {
+                        if (cqe.res > 0) {
+                            slot.size += cqe.res;
+                            readNext (slot, cqe.user_data);
+                            break;
+                        }
+
+                        // the buffer's done with so decoding can start
+                        // while the close is still in flight
+                        handOff (slot, slot.size, cqe.res < 0 ? -cqe.res : 0);
+
+                        slot.state = Slot::Closing;
+
+                        auto * e = sqe();
+                        e->opcode = IORING_OP_CLOSE;
+                        e->fd = slot.fd;
+                        e->user_data = cqe.user_data;
+                        break;
+                    }
+                    case Slot::Closing : {
+                        idle.push_back (cqe.user_data);
+                        --inflight;
+                        break;
+                    }
+                }
+            }
+
+            release (m_cqHead, head);
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock (mutex);
+
+        if (!failure) {
+            failure = std::current_exception();
+        }
+
+        failed = true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        done = true;
+    }
+
+    ready.notify_all();
+
+    for (auto & thread : threads) {
+        thread.join();
+    }
+
+    if (failure) {
+        std::rethrow_exception (failure);
+    }
+}
+
+/******************************************************************************/
+
+#else
+
+/******************************************************************************/
+
+/*
+ * Without io_uring there's nothing to set up, [make] always declines and
+ * [batchReader] falls back to pread
+ */
+
+io::
+UringReader::UringReader (const Options & options_)
+    : m_options (options_)
+{ }
+
+io::
+UringReader::~UringReader() = default;
+
+uPtr<io::UringReader>
+io::
+UringReader::make (const Options &) {
+    return nullptr;
+}
+
+void
+io::
+UringReader::read (const std::vector<std::string> &, const Consumer &) { }
+
+/******************************************************************************/
+
+#endif
+
+/******************************************************************************/
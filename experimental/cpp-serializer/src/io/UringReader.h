@@ -0,0 +1,82 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "BatchReader.h"
+
+/******************************************************************************/
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+/******************************************************************************/
+
+namespace io {
+
+    /**
+     * Opens, reads and closes are queued on an io_uring set up directly
+     * through the raw syscalls, there's no dependency on liburing, and
+     * driven by the calling thread while the workers decode
+     */
+    class UringReader : public BatchReader {
+        private :
+            Options m_options;
+
+            int m_fd;
+
+            /**
+             * The two rings and the submission queue entries, mapped
+             * from the kernel
+             */
+            void * m_sq;
+            size_t m_sqSize;
+            void * m_cq;
+            size_t m_cqSize;
+            io_uring_sqe * m_sqes;
+            size_t m_sqesSize;
+
+            unsigned * m_sqHead;
+            unsigned * m_sqTail;
+            unsigned * m_sqMask;
+            unsigned * m_sqArray;
+            unsigned   m_sqEntries;
+
+            unsigned * m_cqHead;
+            unsigned * m_cqTail;
+            unsigned * m_cqMask;
+            io_uring_cqe * m_cqes;
+
+            /**
+             * Entries written to the submission queue the kernel hasn't
+             * yet been told about
+             */
+            unsigned m_pending;
+
+            explicit UringReader (const Options &);
+
+            bool setup();
+            bool supported() const;
+
+            io_uring_sqe * sqe();
+            void submit (unsigned);
+
+        public :
+            /**
+             * @return nullptr if io_uring is unavailable or lacks the
+             * operations we need
+             */
+            static uPtr<UringReader> make (const Options &);
+
+            UringReader (const UringReader &) = delete;
+            ~UringReader() override;
+
+            void read (
+                const std::vector<std::string> &,
+                const Consumer &) override;
+
+            const char * name() const override { return "io_uring"; }
+    };
+
+}
+
+/******************************************************************************/
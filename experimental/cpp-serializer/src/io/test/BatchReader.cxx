@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <fstream>
+#include <stdexcept>
+#include <filesystem>
+
+#include <errno.h>
+#include <unistd.h>
+
+#include "io/BatchReader.h"
+#include "io/UringReader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * A directory of files, each of which is its index repeated to some
+     * length, one bigger than the default buffer and one missing
+     */
+    class Files {
+        public :
+            std::filesystem::path    dir;
+            std::vector<std::string> paths;
+            std::vector<std::string> contents;
+
+            explicit Files (size_t count_) {
+                dir = std::filesystem::temp_directory_path()
+                    / ("corda-io-test-" + std::to_string (::getpid()));
+
+                std::filesystem::create_directories (dir);
+
+                for (size_t i { 0 } ; i < count_ ; ++i) {
+                    auto path = (dir / std::to_string (i)).string();
+                    auto size = i == 1 ? 200 * 1024 : (i * 37) % 500;
+
+                    std::string content (size, static_cast<char>('a' + i % 26));
+
+                    if (i != 2) {
+                        std::ofstream (path, std::ios::binary) << content;
+                    }
+
+                    paths.push_back (path);
+                    contents.push_back (content);
+                }
+            }
+
+            ~Files() {
+                std::filesystem::remove_all (dir);
+            }
+    };
+
+    void
+    readsEverything (io::BatchReader & reader_) {
+        Files files (300);
+
+        std::mutex mutex;
+        std::vector<int> seen (files.paths.size());
+
+        reader_.read (files.paths, [&](const io::Completion & c_) {
+            std::lock_guard<std::mutex> lock (mutex);
+
+            ++seen[c_.index];
+
+            EXPECT_EQ (files.paths[c_.index], c_.path);
+
+            if (c_.index == 2) {
+                EXPECT_EQ (ENOENT, c_.error);
+                EXPECT_EQ (nullptr, c_.data);
+            } else {
+                ASSERT_EQ (0, c_.error);
+                EXPECT_EQ (files.contents[c_.index], std::string (c_.data, c_.size));
+            }
+        });
+
+        EXPECT_EQ (std::vector<int> (files.paths.size(), 1), seen);
+    }
+
+    void
+    rethrows (io::BatchReader & reader_) {
+        Files files (50);
+
+        EXPECT_THROW ( // NOLINT
+            reader_.read (files.paths, [](const io::Completion & c_) {
+                if (c_.index == 10) throw std::runtime_error ("stop");
+            }),
+            std::runtime_error);
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (BatchReader, pread) { // NOLINT
+    io::Options options;
+    options.uring = false;
+    options.workers = 4;
+
+    auto reader = io::batchReader (options);
+    EXPECT_STREQ ("pread", reader->name());
+
+    readsEverything (*reader);
+    rethrows (*reader);
+}
+
+/******************************************************************************/
+
+TEST (BatchReader, uring) { // NOLINT
+    io::Options options;
+    options.depth = 16;
+    options.workers = 4;
+
+    auto reader = io::UringReader::make (options);
+
+    if (!reader) {
+        GTEST_SKIP() << "io_uring unavailable";
+    }
+
+    readsEverything (*reader);
+    rethrows (*reader);
+
+    // and can be reused once done
+    readsEverything (*reader);
+}
+
+/******************************************************************************/
+
+/**
+ * With buffers smaller than most of the files, every one of those is
+ * read in pieces, the buffer growing as it goes
+ */
+TEST (BatchReader, uringSmallBuffers) { // NOLINT
+    io::Options options;
+    options.depth = 8;
+    options.workers = 2;
+    options.bufferSize = 16;
+
+    auto reader = io::UringReader::make (options);
+
+    if (!reader) {
+        GTEST_SKIP() << "io_uring unavailable";
+    }
+
+    readsEverything (*reader);
+}
+
+/******************************************************************************/
+
+TEST (BatchReader, empty) { // NOLINT
+    auto reader = io::batchReader();
+
+    reader->read ({ }, [](const io::Completion &) {
+        FAIL() << "nothing to read";
+    });
+}
+
+/******************************************************************************/
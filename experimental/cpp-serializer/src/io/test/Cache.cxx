@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <stdexcept>
+#include <filesystem>
+
+#include <unistd.h>
+
+#include "io/Cache.h"
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    directory (const std::string & name_) {
+        auto rtn = (std::filesystem::temp_directory_path()
+            / ("corda-cache-test-" + std::to_string (::getpid()) + "-" + name_)).string();
+
+        std::filesystem::remove_all (rtn);
+
+        return rtn;
+    }
+
+    io::CacheKey
+    key (size_t i_, std::string_view tag_ = "dump/1") {
+        auto blob = "blob " + std::to_string (i_);
+
+        return io::Cache::key (blob.data(), blob.size(), tag_);
+    }
+
+    std::string
+    output (size_t i_) {
+        return "output " + std::to_string (i_) + std::string (i_ % 7, '!');
+    }
+
+    std::string
+    get (const io::Cache & cache_, const io::CacheKey & key_) {
+        std::string rtn;
+
+        return cache_.get (key_, rtn) ? rtn : "<miss>";
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Cache, hitAndMiss) { // NOLINT
+    auto d = directory ("hit");
+
+    io::Cache cache (d);
+
+    EXPECT_EQ (0U, cache.size());
+    EXPECT_EQ ("<miss>", get (cache, key (1)));
+
+    cache.put (key (1), output (1));
+
+    EXPECT_EQ (output (1), get (cache, key (1)));
+    EXPECT_EQ (1U, cache.size());
+
+    // the tag is part of the key
+    EXPECT_EQ ("<miss>", get (cache, key (1, "dump/2")));
+
+    std::filesystem::remove_all (d);
+}
+
+/******************************************************************************/
+
+/**
+ * Entries survive reopening whether they made it into the index or
+ * have to be found again in the log
+ */
+TEST (Cache, reopen) { // NOLINT
+    auto d = directory ("reopen");
+
+    {
+        io::Cache cache (d);
+
+        for (size_t i { 0 } ; i < 500 ; ++i) cache.put (key (i), output (i));
+
+        cache.flush();
+
+        for (size_t i { 500 } ; i < 600 ; ++i) cache.put (key (i), output (i));
+
+        // replacing an indexed entry
+        cache.put (key (3), "replaced");
+
+        EXPECT_EQ (600U, cache.size());
+        EXPECT_EQ ("replaced", get (cache, key (3)));
+    }
+
+    {
+        io::Cache cache (d);
+
+        EXPECT_EQ (600U, cache.size());
+
+        for (size_t i { 0 } ; i < 600 ; ++i) {
+            if (i != 3) {
+                EXPECT_EQ (output (i), get (cache, key (i))) << i;
+            }
+        }
+
+        EXPECT_EQ ("replaced", get (cache, key (3)));
+        EXPECT_EQ ("<miss>", get (cache, key (600)));
+    }
+
+    // a stale index, the log having grown since it was written
+    std::filesystem::copy_file (d + "/index", d + "/old");
+
+    {
+        io::Cache cache (d);
+        cache.put (key (600), output (600));
+    }
+
+    std::filesystem::rename (d + "/old", d + "/index");
+
+    io::Cache cache (d);
+
+    EXPECT_EQ (601U, cache.size());
+    EXPECT_EQ (output (600), get (cache, key (600)));
+
+    std::filesystem::remove_all (d);
+}
+
+/******************************************************************************/
+
+/**
+ * A record cut short is dropped along with anything after it
+ */
+TEST (Cache, torn) { // NOLINT
+    auto d = directory ("torn");
+
+    {
+        io::Cache cache (d);
+        cache.put (key (1), output (1));
+        cache.put (key (2), output (2));
+    }
+
+    std::filesystem::remove (d + "/index");
+    std::filesystem::resize_file (d + "/log", std::filesystem::file_size (d + "/log") - 3);
+
+    {
+        io::Cache cache (d);
+
+        EXPECT_EQ (1U, cache.size());
+        EXPECT_EQ (output (1), get (cache, key (1)));
+        EXPECT_EQ ("<miss>", get (cache, key (2)));
+
+        cache.put (key (2), output (2));
+    }
+
+    io::Cache cache (d);
+    EXPECT_EQ (output (2), get (cache, key (2)));
+
+    std::filesystem::remove_all (d);
+}
+
+/******************************************************************************/
+
+TEST (Cache, notACache) { // NOLINT
+    auto d = directory ("not");
+
+    std::filesystem::create_directories (d);
+
+    {
+        std::ofstream out { d + "/log", std::ios::binary };
+        out << std::string (100, 'x');
+    }
+
+    EXPECT_THROW (io::Cache cache (d), std::runtime_error); // NOLINT
+
+    std::filesystem::remove_all (d);
+}
+
+/******************************************************************************/
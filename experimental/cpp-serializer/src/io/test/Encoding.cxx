@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "io/Encoding.h"
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    toHex (const std::vector<char> & bytes_, bool upper_) {
+        const char * digits = upper_ ? "0123456789ABCDEF" : "0123456789abcdef";
+        std::string rtn;
+
+        for (unsigned char c : bytes_) {
+            rtn += digits[c >> 4];
+            rtn += digits[c & 0xf];
+        }
+
+        return rtn;
+    }
+
+    std::string
+    toBase64 (const std::vector<char> & bytes_, bool pad_) {
+        const char * alphabet =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string rtn;
+
+        size_t i { 0 };
+
+        for ( ; i + 3 <= bytes_.size() ; i += 3) {
+            uint32_t bits = static_cast<uint8_t>(bytes_[i]) << 16
+                | static_cast<uint8_t>(bytes_[i + 1]) << 8
+                | static_cast<uint8_t>(bytes_[i + 2]);
+
+            for (int shift : { 18, 12, 6, 0 }) rtn += alphabet[(bits >> shift) & 63];
+        }
+
+        if (bytes_.size() - i == 1) {
+            uint32_t bits = static_cast<uint8_t>(bytes_[i]) << 16;
+            rtn += alphabet[bits >> 18];
+            rtn += alphabet[(bits >> 12) & 63];
+            if (pad_) rtn += "==";
+        } else if (bytes_.size() - i == 2) {
+            uint32_t bits = static_cast<uint8_t>(bytes_[i]) << 16
+                | static_cast<uint8_t>(bytes_[i + 1]) << 8;
+            rtn += alphabet[bits >> 18];
+            rtn += alphabet[(bits >> 12) & 63];
+            rtn += alphabet[(bits >> 6) & 63];
+            if (pad_) rtn += "=";
+        }
+
+        return rtn;
+    }
+
+    /**
+     * Every byte value, at every length either side of the 16 character
+     * blocks
+     */
+    std::vector<std::vector<char>>
+    inputs() {
+        std::vector<std::vector<char>> rtn;
+
+        for (size_t size { 0 } ; size < 100 ; ++size) {
+            std::vector<char> bytes;
+
+            for (size_t i { 0 } ; i < size ; ++i) {
+                bytes.push_back (static_cast<char>(i * 37 + size));
+            }
+
+            rtn.push_back (bytes);
+        }
+
+        std::vector<char> all;
+
+        for (int i { 0 } ; i < 256 ; ++i) {
+            all.push_back (static_cast<char>(i));
+        }
+
+        rtn.push_back (all);
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Encoding, hex) { // NOLINT
+    std::vector<char> out;
+
+    for (const auto & bytes : inputs()) {
+        for (bool upper : { false, true }) {
+            auto text = toHex (bytes, upper);
+
+            ASSERT_TRUE (io::hex::decode (text.data(), text.size(), out)) << text;
+            EXPECT_EQ (bytes, out) << text;
+        }
+    }
+}
+
+/******************************************************************************/
+
+TEST (Encoding, badHex) { // NOLINT
+    std::vector<char> out;
+
+    auto good = toHex (std::vector<char> (40, 'x'), false);
+
+    EXPECT_FALSE (io::hex::decode (good.data(), good.size() - 1, out));
+
+    // one bad character at every position, in and out of the blocks
+    for (size_t i { 0 } ; i < good.size() ; ++i) {
+        for (char c : { 'g', 'G', '/', ':', '@', '`', ' ', '\0', '\x80', '\xb5' }) {
+            auto bad = good;
+            bad[i] = c;
+
+            EXPECT_FALSE (io::hex::decode (bad.data(), bad.size(), out)) << i << " " << c;
+        }
+    }
+}
+
+/******************************************************************************/
+
+TEST (Encoding, base64) { // NOLINT
+    std::vector<char> out;
+
+    for (const auto & bytes : inputs()) {
+        for (bool pad : { false, true }) {
+            auto text = toBase64 (bytes, pad);
+
+            ASSERT_TRUE (io::base64::decode (text.data(), text.size(), out)) << text;
+            EXPECT_EQ (bytes, out) << text;
+        }
+    }
+}
+
+/******************************************************************************/
+
+TEST (Encoding, badBase64) { // NOLINT
+    std::vector<char> out;
+
+    auto good = toBase64 (std::vector<char> (60, 'x'), true);
+
+    // a single character can't make a byte
+    EXPECT_FALSE (io::base64::decode (good.data(), good.size() - 3, out));
+    EXPECT_FALSE (io::base64::decode ("A===", 4, out));
+
+    for (size_t i { 0 } ; i < good.size() ; ++i) {
+        for (char c : { '=', '-', '_', ' ', '.', '\0', '\x80', '\xc1' }) {
+            // padding is allowed at the very end
+            if (c == '=' && i + 2 >= good.size()) continue;
+
+            auto bad = good;
+            bad[i] = c;
+
+            EXPECT_FALSE (io::base64::decode (bad.data(), bad.size(), out)) << i << " " << c;
+        }
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "io/Hash.h"
+
+/******************************************************************************/
+
+namespace {
+
+    uint64_t
+    fmix (uint64_t h_) {
+        h_ ^= h_ >> 33;
+        h_ *= 0xff51afd7ed558ccdULL;
+        h_ ^= h_ >> 33;
+        h_ *= 0xc4ceb9fe1a85ec53ULL;
+        h_ ^= h_ >> 33;
+
+        return h_;
+    }
+
+    /**
+     * The hash as described, a byte and a lane at a time, to check the
+     * vectorised version against
+     */
+    io::Hash128
+    reference (const std::string & in_) {
+        const uint64_t P1 { 0x9e3779b185ebca87ULL };
+        const uint64_t P2 { 0xc2b2ae3d27d4eb4fULL };
+        const uint64_t P3 { 0x165667b19e3779f9ULL };
+
+        uint64_t acc[8] { }, keys[8];
+
+        for (uint64_t i { 0 } ; i < 8 ; ++i) keys[i] = fmix (P1 * (i + 1));
+
+        auto padded = in_;
+        padded.resize ((in_.size() + 63) / 64 * 64, '\0');
+
+        for (size_t s { 0 } ; s < padded.size() ; s += 64) {
+            uint64_t words[8] { };
+
+            for (size_t i { 0 } ; i < 64 ; ++i) {
+                words[i / 8] |= static_cast<uint64_t>(
+                    static_cast<uint8_t>(padded[s + i])) << (8 * (i % 8));
+            }
+
+            for (size_t i { 0 } ; i < 8 ; ++i) {
+                auto k = words[i] ^ keys[i];
+                acc[i] += words[i ^ 1] + (k & 0xffffffff) * (k >> 32);
+                keys[i] += P3;
+            }
+        }
+
+        uint64_t lo { in_.size() * P1 + P3 }, hi { in_.size() ^ P2 };
+
+        for (auto a : acc) {
+            lo = fmix (lo ^ a);
+            hi = fmix (hi + a * P2);
+        }
+
+        return { lo, hi };
+    }
+
+    std::string
+    bytes (size_t size_, uint32_t seed_) {
+        std::string rtn;
+
+        for (size_t i { 0 } ; i < size_ ; ++i) {
+            seed_ = seed_ * 1103515245 + 12345;
+            rtn += static_cast<char>(seed_ >> 16);
+        }
+
+        return rtn;
+    }
+
+    io::Hash128
+    hash (const std::string & in_) {
+        return io::hash128 (in_.data(), in_.size());
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Every length either side of whole stripes, at every alignment
+ */
+TEST (Hash, reference) { // NOLINT
+    for (size_t size { 0 } ; size < 300 ; ++size) {
+        auto in = bytes (size, static_cast<uint32_t>(size));
+
+        for (size_t offset { 0 } ; offset < 8 ; ++offset) {
+            std::string shifted (offset, 'x');
+            shifted += in;
+
+            auto h = io::hash128 (shifted.data() + offset, size);
+            auto r = reference (in);
+
+            EXPECT_EQ (r.lo, h.lo) << size << " " << offset;
+            EXPECT_EQ (r.hi, h.hi) << size << " " << offset;
+        }
+    }
+}
+
+/******************************************************************************/
+
+TEST (Hash, distinct) { // NOLINT
+    std::set<std::pair<uint64_t, uint64_t>> seen;
+
+    auto add = [&seen](const std::string & in_) {
+        auto h = hash (in_);
+        return seen.emplace (h.lo, h.hi).second;
+    };
+
+    // zero padding doesn't make lengths collide
+    for (size_t size { 0 } ; size < 200 ; ++size) {
+        EXPECT_TRUE (add (std::string (size, '\0'))) << size;
+    }
+
+    // every single bit flip of a blob
+    auto blob = bytes (256, 7);
+
+    for (size_t bit { 0 } ; bit < blob.size() * 8 ; ++bit) {
+        auto flipped = blob;
+        flipped[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+        EXPECT_TRUE (add (flipped)) << bit;
+    }
+
+    // swapping stripes
+    auto a = bytes (64, 1), b = bytes (64, 2);
+    EXPECT_NE (hash (a + b), hash (b + a));
+}
+
+/******************************************************************************/
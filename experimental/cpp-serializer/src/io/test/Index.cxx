@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <stdexcept>
+#include <filesystem>
+
+#include <unistd.h>
+
+#include "io/Index.h"
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    path (const std::string & name_) {
+        return (std::filesystem::temp_directory_path()
+            / ("corda-index-test-" + std::to_string (::getpid()) + "-" + name_)).string();
+    }
+
+    /**
+     * Keys that sort as the numbers they hold
+     */
+    std::string
+    key (size_t i_) {
+        char buffer[16];
+        std::snprintf (buffer, sizeof (buffer), "%08zu", i_);
+
+        return buffer;
+    }
+
+    /**
+     * Blob i holds i % 100 in "a" and i in "b", in pack "p" for odd i
+     * and a file of its own otherwise
+     */
+    void
+    write (const std::string & path_, size_t count_, size_t budget_) {
+        io::IndexWriter writer (path_, { "a", "b" }, budget_);
+
+        for (size_t i { 0 } ; i < count_ ; ++i) {
+            auto blob = i % 2
+                ? writer.blob ("p", "id" + std::to_string (i))
+                : writer.blob ("", "dir/" + std::to_string (i));
+
+            writer.add (1, blob, key (i));
+            writer.add (0, blob, key (i % 100));
+
+            // held twice, indexed once
+            writer.add (0, blob, key (i % 100));
+        }
+
+        writer.close();
+    }
+
+    std::vector<uint32_t>
+    range (
+        const io::Index & index_,
+        const std::string & path_,
+        std::optional<io::Bound> from_,
+        std::optional<io::Bound> to_
+    ) {
+        std::vector<uint32_t> rtn;
+
+        index_.range (path_, from_, to_, [&rtn](const io::IndexEntry & e_) {
+            rtn.push_back (e_.blob);
+        });
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Index, point) { // NOLINT
+    auto p = path ("point");
+    write (p, 1000, 1 << 30);
+
+    io::Index index (p);
+
+    EXPECT_EQ (2000U, index.size());
+    EXPECT_EQ (1000U, index.blobs());
+    EXPECT_EQ ((std::vector<std::string_view> { "a", "b" }), index.paths());
+
+    auto hits = range (index, "a", io::Bound { key (42), true }, io::Bound { key (42), true });
+    EXPECT_EQ ((std::vector<uint32_t> { 42, 142, 242, 342, 442, 542, 642, 742, 842, 942 }), hits);
+
+    EXPECT_EQ (std::make_pair (std::string_view ("p"), std::string_view ("id143")), index.blob (143));
+    EXPECT_EQ (std::make_pair (std::string_view (""), std::string_view ("dir/142")), index.blob (142));
+
+    EXPECT_TRUE (range (index, "b", io::Bound { key (1000), true }, io::Bound { key (1000), true }).empty());
+    EXPECT_THROW (range (index, "c", std::nullopt, std::nullopt), std::runtime_error); // NOLINT
+
+    std::filesystem::remove (p);
+}
+
+/******************************************************************************/
+
+TEST (Index, range) { // NOLINT
+    auto p = path ("range");
+    write (p, 1000, 1 << 30);
+
+    io::Index index (p);
+
+    EXPECT_EQ (
+        (std::vector<uint32_t> { 11, 12, 13 }),
+        range (index, "b", io::Bound { key (10), false }, io::Bound { key (14), false }));
+
+    EXPECT_EQ (
+        (std::vector<uint32_t> { 10, 11, 12, 13, 14 }),
+        range (index, "b", io::Bound { key (10), true }, io::Bound { key (14), true }));
+
+    EXPECT_EQ (1000U, range (index, "b", std::nullopt, std::nullopt).size());
+    EXPECT_EQ (3U, range (index, "b", io::Bound { key (997), true }, std::nullopt).size());
+    EXPECT_EQ (2U, range (index, "b", std::nullopt, io::Bound { key (2), false }).size());
+
+    // the end of one path doesn't run into the next
+    EXPECT_EQ (10U, range (index, "a", io::Bound { key (99), true }, std::nullopt).size());
+
+    std::filesystem::remove (p);
+}
+
+/******************************************************************************/
+
+/**
+ * A budget too small for more than a few entries forces hundreds of runs
+ * to be merged, the result has to be the same
+ */
+TEST (Index, spill) { // NOLINT
+    auto a = path ("spill-a");
+    auto b = path ("spill-b");
+
+    write (a, 1000, 1 << 30);
+    write (b, 1000, 256);
+
+    std::ifstream fa { a, std::ios::binary }, fb { b, std::ios::binary };
+
+    std::string ca { std::istreambuf_iterator<char> (fa), std::istreambuf_iterator<char>() };
+    std::string cb { std::istreambuf_iterator<char> (fb), std::istreambuf_iterator<char>() };
+
+    EXPECT_EQ (ca, cb);
+
+    std::filesystem::remove (a);
+    std::filesystem::remove (b);
+}
+
+/******************************************************************************/
+
+TEST (Index, corrupt) { // NOLINT
+    auto p = path ("corrupt");
+
+    {
+        std::ofstream out { p, std::ios::binary };
+        out << std::string (200, 'x');
+    }
+
+    EXPECT_THROW (io::Index index (p), std::runtime_error); // NOLINT
+
+    write (p, 10, 1 << 30);
+    std::filesystem::resize_file (p, std::filesystem::file_size (p) - 1);
+
+    EXPECT_THROW (io::Index index (p), std::runtime_error); // NOLINT
+
+    std::filesystem::remove (p);
+}
+
+/******************************************************************************/
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <stdexcept>
+#include <filesystem>
+
+#include <unistd.h>
+
+#include "io/Pack.h"
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    path (const std::string & name_) {
+        return (std::filesystem::temp_directory_path()
+            / ("corda-pack-test-" + std::to_string (::getpid()) + "-" + name_)).string();
+    }
+
+    std::string
+    blob (size_t i_) {
+        return "corda-blob-" + std::to_string (i_)
+            + std::string (i_ % 100, static_cast<char>(i_));
+    }
+
+    /**
+     * Ids are written out of order so the by id table has some work to do
+     */
+    std::string
+    id (size_t i_) {
+        return "dir/" + std::to_string ((i_ * 7919) % 1000);
+    }
+
+    void
+    write (const std::string & path_, size_t count_) {
+        io::PackWriter writer (path_);
+
+        for (size_t i { 0 } ; i < count_ ; ++i) {
+            auto b = blob (i);
+            writer.add (id (i), i % 2 ? "net.corda:A" : "net.corda:B", b.data(), b.size());
+        }
+
+        writer.close();
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Pack, roundTrip) { // NOLINT
+    auto p = path ("roundTrip");
+    write (p, 1000);
+
+    io::Pack pack (p);
+
+    ASSERT_EQ (1000U, pack.size());
+
+    for (size_t i { 0 } ; i < pack.size() ; ++i) {
+        auto entry = pack[i];
+
+        EXPECT_EQ (id (i), entry.id);
+        EXPECT_EQ (i % 2 ? "net.corda:A" : "net.corda:B", entry.fingerprint);
+        EXPECT_EQ (blob (i), std::string (entry.data, entry.size));
+    }
+
+    std::filesystem::remove (p);
+}
+
+/******************************************************************************/
+
+TEST (Pack, find) { // NOLINT
+    auto p = path ("find");
+    write (p, 1000);
+
+    io::Pack pack (p);
+
+    for (size_t i : { 0, 1, 500, 999 }) {
+        auto entry = pack.find (id (i));
+
+        ASSERT_TRUE (entry) << id (i);
+        EXPECT_EQ (blob (i), std::string (entry->data, entry->size));
+    }
+
+    EXPECT_FALSE (pack.find ("dir/1000"));
+    EXPECT_FALSE (pack.find (""));
+
+    std::filesystem::remove (p);
+}
+
+/******************************************************************************/
+
+TEST (Pack, scan) { // NOLINT
+    auto p = path ("scan");
+    write (p, 100);
+
+    io::Pack pack (p);
+
+    size_t i { 0 };
+
+    pack.scan ([&i](const io::PackEntry & entry_) {
+        EXPECT_EQ (blob (i++), std::string (entry_.data, entry_.size));
+    });
+
+    EXPECT_EQ (100U, i);
+
+    std::filesystem::remove (p);
+}
+
+/******************************************************************************/
+
+TEST (Pack, empty) { // NOLINT
+    auto p = path ("empty");
+    write (p, 0);
+
+    io::Pack pack (p);
+
+    EXPECT_EQ (0U, pack.size());
+    EXPECT_FALSE (pack.find ("a"));
+
+    std::filesystem::remove (p);
+}
+
+/******************************************************************************/
+
+TEST (Pack, duplicate) { // NOLINT
+    auto p = path ("duplicate");
+
+    io::PackWriter writer (p);
+    writer.add ("a", "f", "x", 1);
+
+    EXPECT_THROW (writer.add ("a", "f", "y", 1), std::runtime_error); // NOLINT
+
+    std::filesystem::remove (p);
+}
+
+/******************************************************************************/
+
+TEST (Pack, corrupt) { // NOLINT
+    auto p = path ("corrupt");
+
+    std::ofstream (p, std::ios::binary) << std::string (100, 'x');
+    EXPECT_THROW (io::Pack pack (p), std::runtime_error); // NOLINT
+
+    // an index that doesn't fit between the header and the footer
+    write (p, 10);
+    {
+        std::fstream f (p, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp (-16, std::ios::end);
+        f.put ('\xff');
+    }
+    EXPECT_THROW (io::Pack pack (p), std::runtime_error); // NOLINT
+
+    // and one never finished
+    {
+        io::PackWriter writer (p);
+        writer.add ("a", "f", "x", 1);
+    }
+    EXPECT_THROW (io::Pack pack (p), std::runtime_error); // NOLINT
+
+    std::filesystem::remove (p);
+}
+
+/******************************************************************************/
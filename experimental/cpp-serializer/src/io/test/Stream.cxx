@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "io/Stream.h"
+
+/******************************************************************************/
+
+namespace {
+
+    void
+    writeAll (int fd_, const std::string & bytes_) {
+        for (size_t done { 0 } ; done < bytes_.size() ; ) {
+            auto n = ::write (fd_, bytes_.data() + done, std::min<size_t> (bytes_.size() - done, 1000));
+            ASSERT_GT (n, 0);
+            done += n;
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * With buffers far smaller than what's written the two are swapped many
+ * times over and every byte should come through in order
+ */
+TEST (Stream, pipe) { // NOLINT
+    int fds[2];
+    ASSERT_EQ (0, ::pipe (fds));
+
+    std::string sent;
+
+    for (int i { 0 } ; i < 100000 ; ++i) {
+        sent += std::to_string (i);
+    }
+
+    std::thread writer ([&]() {
+        writeAll (fds[1], sent);
+        ::close (fds[1]);
+    });
+
+    std::string received;
+
+    {
+        io::Stream stream (fds[0], 64);
+
+        for (auto chunk = stream.next() ; !chunk.empty() ; chunk = stream.next()) {
+            EXPECT_LE (chunk.size(), 64U);
+            received.append (chunk);
+        }
+
+        // and it stays ended
+        EXPECT_TRUE (stream.next().empty());
+    }
+
+    writer.join();
+    ::close (fds[0]);
+
+    EXPECT_EQ (sent, received);
+}
+
+/******************************************************************************/
+
+TEST (Stream, empty) { // NOLINT
+    int fds[2];
+    ASSERT_EQ (0, ::pipe (fds));
+    ::close (fds[1]);
+
+    io::Stream stream (fds[0]);
+    EXPECT_TRUE (stream.next().empty());
+
+    ::close (fds[0]);
+}
+
+/******************************************************************************/
+
+TEST (Stream, error) { // NOLINT
+    // a directory polls as readable but reading it fails
+    int fd = ::open (".", O_RDONLY | O_DIRECTORY);
+    ASSERT_LE (0, fd);
+
+    {
+        io::Stream stream (fd);
+        EXPECT_THROW (stream.next(), std::system_error); // NOLINT
+    }
+
+    ::close (fd);
+}
+
+/******************************************************************************/
+
+/**
+ * Destroying a stream on a quiet pipe stops its thread rather than leave
+ * it blocked in a read, so whatever's written afterwards is still there
+ * for whoever reads the pipe next
+ */
+TEST (Stream, stop) { // NOLINT
+    int fds[2];
+    ASSERT_EQ (0, ::pipe (fds));
+
+    {
+        io::Stream stream (fds[0]);
+    }
+
+    ASSERT_EQ (1, ::write (fds[1], "x", 1));
+
+    char c { 0 };
+    EXPECT_EQ (1, ::read (fds[0], &c, 1));
+    EXPECT_EQ ('x', c);
+
+    ::close (fds[0]);
+    ::close (fds[1]);
+}
+
+/******************************************************************************/
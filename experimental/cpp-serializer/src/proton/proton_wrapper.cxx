@@ -7,6 +7,29 @@
 #include <proton/types.h>
 #include <proton/codec.h>
 
+#include "utf8.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Copy an AMQP string out of proton, refusing any that aren't the
+     * UTF-8 the spec says they have to be
+     */
+    std::string
+    utf8String (const pn_bytes_t & bytes_) {
+        std::string rtn;
+
+        if (!proton::utf8::assign (rtn, bytes_.start, bytes_.size)) {
+            throw std::runtime_error ("String is not valid UTF-8");
+        }
+
+        return rtn;
+    }
+
+}
+
 /******************************************************************************/
 
 std::ostream&
@@ -76,7 +99,7 @@ proton::pn_data_enter(pn_data_t * data_) {
 /******************************************************************************/
 
 void
-proton::is_described (pn_data_t * data_) {
+proton::checks::is_described (pn_data_t * data_) {
     if (pn_data_type(data_) != PN_DESCRIBED) {
         throw std::runtime_error ("Expected a described type");
     }
@@ -85,7 +108,7 @@ proton::is_described (pn_data_t * data_) {
 /******************************************************************************/
 
 void
-proton::is_ulong (pn_data_t * data_) {
+proton::checks::is_ulong (pn_data_t * data_) {
     auto t = pn_data_type(data_);
     if (t != PN_ULONG) {
         std::stringstream ss;
@@ -97,16 +120,16 @@ proton::is_ulong (pn_data_t * data_) {
 /******************************************************************************/
 
 void
-proton::is_symbol (pn_data_t * data_) {
+proton::checks::is_symbol (pn_data_t * data_) {
     if (pn_data_type(data_) != PN_SYMBOL) {
-        throw std::runtime_error ("Expected an unsigned long");
+        throw std::runtime_error ("Expected a symbol");
     }
 }
 
 /******************************************************************************/
 
 void
-proton::is_list (pn_data_t * data_) {
+proton::checks::is_list (pn_data_t * data_) {
     if (pn_data_type(data_) != PN_LIST) {
         throw std::runtime_error ("Expected a list");
     }
@@ -115,7 +138,7 @@ proton::is_list (pn_data_t * data_) {
 /******************************************************************************/
 
 void
-proton::is_string (pn_data_t * data_, bool allowNull) {
+proton::checks::is_string (pn_data_t * data_, bool allowNull) {
     if (pn_data_type(data_) != PN_STRING) {
         if (allowNull && pn_data_type(data_) != PN_NULL) {
             throw std::runtime_error ("Expected a String");
@@ -128,8 +151,7 @@ proton::is_string (pn_data_t * data_, bool allowNull) {
 std::string
 proton::get_string (pn_data_t * data_, bool allowNull) {
     if (pn_data_type(data_) == PN_STRING) {
-        auto str = pn_data_get_string (data_);
-        return std::string (str.start, str.size);
+        return utf8String (pn_data_get_string (data_));
     } else  if (allowNull && pn_data_type(data_) == PN_NULL) {
         return "";
     }
@@ -267,38 +289,33 @@ auto_map_enter::elements() const {
     return m_elements;
 }
 
+/******************************************************************************/
+
+void
+proton::checks::mismatch (const char * expected_, pn_data_t * data_) {
+    std::stringstream ss;
+    ss << "Expected " << expected_ << " but found "
+       << pn_type_name (pn_data_type (data_));
+    throw std::runtime_error (ss.str());
+}
+
 /******************************************************************************
  *
  *
  *
  ******************************************************************************/
 
-template<>
-int32_t
-proton::
-readAndNext<int32_t> (
-    pn_data_t * data_,
-    bool tolerateDeviance_
-) {
-    int rtn = pn_data_get_int (data_);
-    pn_data_next(data_);
-    return rtn;
-}
-
-/******************************************************************************/
-
 template<>
 std::string
 proton::
-readAndNext<std::string> (
+readAndNext<std::string, proton::Checked> (
     pn_data_t * data_,
     bool tolerateDeviance_
 ) {
     auto_next an (data_);
 
     if (pn_data_type(data_) == PN_STRING) {
-        auto str = pn_data_get_string(data_);
-        return std::string(str.start, str.size);
+        return utf8String (pn_data_get_string (data_));
     } else if (pn_data_type(data_) == PN_SYMBOL) {
         auto symbol = pn_data_get_symbol(data_);
         return std::string(symbol.start, symbol.size);
@@ -312,57 +329,28 @@ readAndNext<std::string> (
 
 /******************************************************************************/
 
+/**
+ * Still has to tell strings from symbols to know which accessor to use,
+ * anything else reads as empty
+ */
 template<>
-bool
-proton::
-readAndNext<bool> (
-    pn_data_t * data_,
-    bool tolerateDeviance_
-) {
-    bool rtn = pn_data_get_bool (data_);
-    pn_data_next(data_);
-    return rtn;
-}
-
-/******************************************************************************/
-
-template<>
-double
+std::string
 proton::
-readAndNext<double> (
+readAndNext<std::string, proton::Trusted> (
     pn_data_t * data_,
-    bool tolerateDeviance_
+    bool
 ) {
     auto_next an (data_);
-    return pn_data_get_double (data_);
-}
 
-/******************************************************************************/
+    pn_bytes_t bytes;
 
-template<>
-long
-proton::
-readAndNext<long> (
-    pn_data_t * data_,
-    bool tolerateDeviance_
-) {
-    long rtn = pn_data_get_long (data_);
-    pn_data_next (data_);
-    return rtn;
-}
-
-/******************************************************************************/
+    switch (pn_data_type (data_)) {
+        case PN_STRING : bytes = pn_data_get_string (data_); break;
+        case PN_SYMBOL : bytes = pn_data_get_symbol (data_); break;
+        default : return "";
+    }
 
-template<>
-u_long
-proton::
-readAndNext<u_long > (
-        pn_data_t * data_,
-        bool tolerateDeviance_
-) {
-    long rtn = pn_data_get_ulong (data_);
-    pn_data_next (data_);
-    return rtn;
+    return std::string (bytes.start, bytes.size);
 }
 
 /******************************************************************************/
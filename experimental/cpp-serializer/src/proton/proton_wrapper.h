@@ -4,6 +4,7 @@
 
 #include <iosfwd>
 #include <string>
+#include <sys/types.h>
 
 #include <proton/types.h>
 #include <proton/codec.h>
@@ -25,20 +26,91 @@ namespace proton {
      */
     bool pn_data_enter(pn_data_t *);
 
-    void is_list (pn_data_t *);
-    void is_ulong (pn_data_t *);
-    void is_symbol (pn_data_t *);
-    void is_string (pn_data_t *, bool allowNull = false);
-    void is_described (pn_data_t *);
+}
+
+/******************************************************************************/
+
+/**
+ * Decode policies. Every helper below that checks what it's been handed
+ * takes one as a template parameter, defaulting to [Checked]. [Trusted]
+ * is for blobs whose integrity has already been established some other
+ * way, a signature or an earlier verify, and compiles every check away,
+ * along with the UTF-8 validation of strings.
+ *
+ * e.g.
+ *
+ *      auto i = proton::readAndNext<int32_t> (data);                   // checked
+ *      auto j = proton::readAndNext<int32_t, proton::Trusted> (data);  // not
+ */
+namespace proton {
+
+    struct Checked {
+        static constexpr bool validate = true;
+    };
+
+    struct Trusted {
+        static constexpr bool validate = false;
+    };
+
+    /*
+     * The checks themselves, each throws if the current node isn't what
+     * its name says
+     */
+    namespace checks {
+
+        void is_list (pn_data_t *);
+        void is_ulong (pn_data_t *);
+        void is_symbol (pn_data_t *);
+        void is_string (pn_data_t *, bool allowNull = false);
+        void is_described (pn_data_t *);
+
+        [[noreturn]] void mismatch (const char *, pn_data_t *);
+
+    }
+
+    template<typename Policy = Checked>
+    void is_list (pn_data_t * data_) {
+        if constexpr (Policy::validate) checks::is_list (data_);
+    }
+
+    template<typename Policy = Checked>
+    void is_ulong (pn_data_t * data_) {
+        if constexpr (Policy::validate) checks::is_ulong (data_);
+    }
+
+    template<typename Policy = Checked>
+    void is_symbol (pn_data_t * data_) {
+        if constexpr (Policy::validate) checks::is_symbol (data_);
+    }
+
+    template<typename Policy = Checked>
+    void is_string (pn_data_t * data_, bool allowNull = false) {
+        if constexpr (Policy::validate) checks::is_string (data_, allowNull);
+    }
+
+    template<typename Policy = Checked>
+    void is_described (pn_data_t * data_) {
+        if constexpr (Policy::validate) checks::is_described (data_);
+    }
+
+}
+
+/******************************************************************************/
+
+namespace proton {
 
     /**
-     * Specialised in the CXX file
+     * Specialised in the CXX file and declared here so callers don't
+     * instantiate the template instead
      */
     template<typename T>
     T get_symbol (pn_data_t *) {
         return T {};
     }
 
+    template<> std::string get_symbol<std::string> (pn_data_t *);
+    template<> pn_bytes_t get_symbol<pn_bytes_t> (pn_data_t *);
+
     std::string get_symbol (pn_data_t *);
 
     bool get_boolean (pn_data_t *);
@@ -96,14 +168,96 @@ namespace proton {
 
 /******************************************************************************/
 
-namespace proton {
+/**
+ * How each primitive is read out of proton and the type code it has to
+ * carry for that to be meaningful
+ */
+namespace proton::values {
 
     template<typename T>
+    struct Value;
+
+    template<>
+    struct Value<int32_t> {
+        static constexpr pn_type_t type { PN_INT };
+        static constexpr const char * name { "an int" };
+        static int32_t get (pn_data_t * data_) { return pn_data_get_int (data_); }
+    };
+
+    template<>
+    struct Value<bool> {
+        static constexpr pn_type_t type { PN_BOOL };
+        static constexpr const char * name { "a boolean" };
+        static bool get (pn_data_t * data_) { return pn_data_get_bool (data_); }
+    };
+
+    template<>
+    struct Value<double> {
+        static constexpr pn_type_t type { PN_DOUBLE };
+        static constexpr const char * name { "a double" };
+        static double get (pn_data_t * data_) { return pn_data_get_double (data_); }
+    };
+
+    template<>
+    struct Value<long> {
+        static constexpr pn_type_t type { PN_LONG };
+        static constexpr const char * name { "a long" };
+        static long get (pn_data_t * data_) { return pn_data_get_long (data_); }
+    };
+
+    template<>
+    struct Value<u_long> {
+        static constexpr pn_type_t type { PN_ULONG };
+        static constexpr const char * name { "an unsigned long" };
+        static u_long get (pn_data_t * data_) { return pn_data_get_ulong (data_); }
+    };
+
+    /**
+     * The bytes point into proton's copy of the blob so are only good
+     * for as long as the pn_data_t they were read from
+     */
+    template<>
+    struct Value<pn_bytes_t> {
+        static constexpr pn_type_t type { PN_BINARY };
+        static constexpr const char * name { "binary" };
+        static pn_bytes_t get (pn_data_t * data_) { return pn_data_get_binary (data_); }
+    };
+
+}
+
+/******************************************************************************/
+
+namespace proton {
+
+    /**
+     * Read the current node as a [T] and move to the next. Checked reads
+     * throw if the node's type isn't [T]'s, trusted ones take it on faith.
+     */
+    template<typename T, typename Policy = Checked>
     T
-    readAndNext (pn_data_t *, bool tolerateDeviance_ = false) {
-        return T{};
+    readAndNext (pn_data_t * data_, bool tolerateDeviance_ = false) {
+        using V = values::Value<T>;
+
+        if constexpr (Policy::validate) {
+            if (pn_data_type (data_) != V::type) {
+                checks::mismatch (V::name, data_);
+            }
+        }
+
+        T rtn = V::get (data_);
+        pn_data_next (data_);
+
+        return rtn;
     }
 
+    /*
+     * Strings may also be written as symbols or, if [tolerateDeviance_],
+     * null. Specialised in the CXX file and declared here so callers
+     * don't instantiate the template above instead
+     */
+    template<> std::string readAndNext<std::string, Checked> (pn_data_t *, bool);
+    template<> std::string readAndNext<std::string, Trusted> (pn_data_t *, bool);
+
 }
 
 /******************************************************************************/
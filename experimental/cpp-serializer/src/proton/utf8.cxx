@@ -0,0 +1,156 @@
+#include "utf8.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined (__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    inline bool
+    continuation (uint8_t c_, uint8_t lo_ = 0x80, uint8_t hi_ = 0xbf) {
+        return c_ >= lo_ && c_ <= hi_;
+    }
+
+    /**
+     * @return the length of the sequence starting at [p_], which must
+     * not be ASCII, or 0 if it's malformed or truncated
+     */
+    size_t
+    sequence (const uint8_t * p_, size_t remaining_) {
+        auto c = p_[0];
+
+        if (c < 0xc2) {
+            // a stray continuation byte or an overlong two byte form
+            return 0;
+        }
+
+        if (c < 0xe0) {
+            return remaining_ >= 2 && continuation (p_[1]) ? 2 : 0;
+        }
+
+        if (c < 0xf0) {
+            if (remaining_ < 3) return 0;
+
+            // no overlong forms, no UTF-16 surrogates
+            auto lo = c == 0xe0 ? 0xa0 : 0x80;
+            auto hi = c == 0xed ? 0x9f : 0xbf;
+
+            return continuation (p_[1], lo, hi) && continuation (p_[2]) ? 3 : 0;
+        }
+
+        if (c < 0xf5) {
+            if (remaining_ < 4) return 0;
+
+            // no overlong forms, nothing past U+10FFFF
+            auto lo = c == 0xf0 ? 0x90 : 0x80;
+            auto hi = c == 0xf4 ? 0x8f : 0xbf;
+
+            return continuation (p_[1], lo, hi)
+                && continuation (p_[2])
+                && continuation (p_[3]) ? 4 : 0;
+        }
+
+        return 0;
+    }
+
+    /**
+     * @return how many bytes from the start of [p_] are ASCII, looked at
+     * a block at a time so may stop short of the first that isn't
+     */
+    size_t
+    ascii (const uint8_t * p_, size_t size_) {
+        size_t i { 0 };
+
+#if defined (__SSE2__)
+        for ( ; i + 16 <= size_ ; i += 16) {
+            auto block = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(p_ + i));
+
+            if (_mm_movemask_epi8 (block)) {
+                break;
+            }
+        }
+#else
+        for ( ; i + 8 <= size_ ; i += 8) {
+            uint64_t block;
+            std::memcpy (&block, p_ + i, sizeof (block));
+
+            if (block & 0x8080808080808080ULL) {
+                break;
+            }
+        }
+#endif
+
+        return i;
+    }
+
+}
+
+/******************************************************************************/
+
+bool
+proton::utf8::
+valid (const char * str_, size_t size_) {
+    const auto * p = reinterpret_cast<const uint8_t *>(str_);
+
+    for (size_t i { 0 } ; i < size_ ; ) {
+        i += ascii (p + i, size_ - i);
+
+        if (i == size_) {
+            break;
+        }
+
+        if (p[i] < 0x80) {
+            ++i;
+            continue;
+        }
+
+        auto length = sequence (p + i, size_ - i);
+
+        if (!length) {
+            return false;
+        }
+
+        i += length;
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+
+bool
+proton::utf8::
+assign (std::string & out_, const char * str_, size_t size_) {
+    out_.resize (size_);
+
+    const auto * p = reinterpret_cast<const uint8_t *>(str_);
+    auto * dst = out_.data();
+
+    for (size_t i { 0 } ; i < size_ ; ) {
+        auto run = ascii (p + i, size_ - i);
+
+        if (run) {
+            std::memcpy (dst + i, str_ + i, run);
+            i += run;
+            continue;
+        }
+
+        size_t length = p[i] < 0x80 ? 1 : sequence (p + i, size_ - i);
+
+        if (!length) {
+            return false;
+        }
+
+        std::memcpy (dst + i, str_ + i, length);
+        i += length;
+    }
+
+    return true;
+}
+
+/******************************************************************************/
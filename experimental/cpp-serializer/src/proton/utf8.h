@@ -0,0 +1,33 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstddef>
+
+/******************************************************************************/
+
+/**
+ * AMQP strings are UTF-8 by definition but nothing on the decode path
+ * checks it, so a damaged blob can turn into output downstream tools
+ * can't parse. These check well formedness as defined by RFC 3629, so
+ * overlong forms, surrogates and anything past U+10FFFF are rejected.
+ *
+ * Text is overwhelmingly ASCII so that's checked a block at a time,
+ * only multi-byte sequences are picked apart a byte at a time.
+ */
+namespace proton::utf8 {
+
+    bool valid (const char * str_, size_t size_);
+
+    /**
+     * Copy [size_] bytes from [str_] into [out_], validating them as
+     * they go so the check costs little over the copy itself
+     *
+     * @return false if they aren't valid UTF-8, [out_] is unspecified
+     */
+    bool assign (std::string & out_, const char * str_, size_t size_);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,158 @@
+#include "AllocationScope.h"
+
+#include <new>
+#include <cstdlib>
+
+/******************************************************************************
+ *
+ * Per thread allocation counters. These are plain integers so the
+ * thread_local storage needs no dynamic initialisation, which matters as
+ * operator new can be called before main and during thread start up.
+ *
+ ******************************************************************************/
+
+namespace {
+
+    thread_local size_t allocations { 0 };
+    thread_local size_t deallocations { 0 };
+    thread_local size_t bytes { 0 };
+
+    void *
+    allocate (size_t size_) {
+        ++allocations;
+        bytes += size_;
+
+        // malloc (0) may legitimately return nullptr, operator new may not
+        if (auto * p = std::malloc (size_ ? size_ : 1)) {
+            return p;
+        }
+
+        throw std::bad_alloc();
+    }
+
+    void *
+    allocate (size_t size_, std::align_val_t align_) {
+        ++allocations;
+        bytes += size_;
+
+        void * p { nullptr };
+        auto align = static_cast<size_t>(align_);
+
+        if (align < sizeof (void *)) {
+            align = sizeof (void *);
+        }
+
+        if (::posix_memalign (&p, align, size_ ? size_ : 1) != 0) {
+            throw std::bad_alloc();
+        }
+
+        return p;
+    }
+
+    void
+    release (void * p_) noexcept {
+        if (p_) {
+            ++deallocations;
+            std::free (p_);
+        }
+    }
+
+}
+
+/******************************************************************************
+ *
+ * Global operator new / delete replacements
+ *
+ ******************************************************************************/
+
+void * operator new (size_t size_) {
+    return allocate (size_);
+}
+
+void * operator new[] (size_t size_) {
+    return allocate (size_);
+}
+
+void * operator new (size_t size_, const std::nothrow_t &) noexcept {
+    try {
+        return allocate (size_);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void * operator new[] (size_t size_, const std::nothrow_t &) noexcept {
+    try {
+        return allocate (size_);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void * operator new (size_t size_, std::align_val_t align_) {
+    return allocate (size_, align_);
+}
+
+void * operator new[] (size_t size_, std::align_val_t align_) {
+    return allocate (size_, align_);
+}
+
+void operator delete (void * p_) noexcept { release (p_); }
+void operator delete[] (void * p_) noexcept { release (p_); }
+void operator delete (void * p_, size_t) noexcept { release (p_); }
+void operator delete[] (void * p_, size_t) noexcept { release (p_); }
+void operator delete (void * p_, const std::nothrow_t &) noexcept { release (p_); }
+void operator delete[] (void * p_, const std::nothrow_t &) noexcept { release (p_); }
+void operator delete (void * p_, std::align_val_t) noexcept { release (p_); }
+void operator delete[] (void * p_, std::align_val_t) noexcept { release (p_); }
+void operator delete (void * p_, size_t, std::align_val_t) noexcept { release (p_); }
+void operator delete[] (void * p_, size_t, std::align_val_t) noexcept { release (p_); }
+
+/******************************************************************************
+ *
+ * test::AllocationScope
+ *
+ ******************************************************************************/
+
+test::
+AllocationScope::AllocationScope()
+    : m_allocations (::allocations)
+    , m_deallocations (::deallocations)
+    , m_bytes (::bytes)
+{ }
+
+/******************************************************************************/
+
+size_t
+test::
+AllocationScope::allocations() const {
+    return ::allocations - m_allocations;
+}
+
+/******************************************************************************/
+
+size_t
+test::
+AllocationScope::deallocations() const {
+    return ::deallocations - m_deallocations;
+}
+
+/******************************************************************************/
+
+size_t
+test::
+AllocationScope::bytes() const {
+    return ::bytes - m_bytes;
+}
+
+/******************************************************************************/
+
+void
+test::
+AllocationScope::reset() {
+    m_allocations = ::allocations;
+    m_deallocations = ::deallocations;
+    m_bytes = ::bytes;
+}
+
+/******************************************************************************/
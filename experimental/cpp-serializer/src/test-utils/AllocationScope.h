@@ -0,0 +1,64 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstddef>
+
+/******************************************************************************/
+
+/**
+ * Linking this into a test binary replaces the global operator new and
+ * delete with versions that count every allocation made on the calling
+ * thread. An [AllocationScope] snapshots those counters on construction
+ * so a test can ask how many allocations, and how many bytes, some block
+ * of code cost.
+ *
+ * e.g.
+ *
+ *      test::AllocationScope scope;
+ *      auto val = BlobInspector (cb).dump();
+ *      EXPECT_LE (scope.allocations(), budget);
+ *
+ * Counters are per thread so gtest's own bookkeeping on other threads
+ * never leaks into a measurement.
+ */
+namespace test {
+
+    class AllocationScope {
+        private :
+            size_t m_allocations;
+            size_t m_deallocations;
+            size_t m_bytes;
+
+        public :
+            AllocationScope();
+
+            AllocationScope (const AllocationScope &) = delete;
+
+            /**
+             * @return how many calls to operator new have been made on this
+             * thread since the scope was created
+             */
+            size_t allocations() const;
+
+            /**
+             * @return how many calls to operator delete have been made on
+             * this thread since the scope was created
+             */
+            size_t deallocations() const;
+
+            /**
+             * @return the total number of bytes requested from operator
+             * new on this thread since the scope was created
+             */
+            size_t bytes() const;
+
+            /**
+             * Start counting again from now
+             */
+            void reset();
+    };
+
+}
+
+/******************************************************************************/
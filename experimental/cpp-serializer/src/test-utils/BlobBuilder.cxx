@@ -0,0 +1,367 @@
+#include "BlobBuilder.h"
+
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+
+#include <unistd.h>
+
+#include <proton/types.h>
+#include <proton/codec.h>
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+#include "amqp/schema/Descriptors.h"
+
+/******************************************************************************/
+
+namespace {
+
+    uint64_t
+    corda (int id_) {
+        return static_cast<uint64_t>(id_)
+            | amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS;
+    }
+
+    /**
+     * Both composite and restricted types describe themselves with a
+     * described list holding the fingerprint
+     */
+    void
+    putDescriptor (pn_data_t * data_, const std::string & fingerprint_) {
+        pn_data_put_described (data_);
+        pn_data_enter (data_);
+        pn_data_put_ulong (data_, corda (amqp::schema::descriptors::OBJECT));
+        test::putList (data_, [&fingerprint_](pn_data_t * data_) {
+            test::putSymbol (data_, fingerprint_);
+            pn_data_put_null (data_);
+        });
+        pn_data_exit (data_);
+    }
+
+    void
+    putCordaDescribed (
+        pn_data_t * data_,
+        int id_,
+        const std::function<void (pn_data_t *)> & f_
+    ) {
+        pn_data_put_described (data_);
+        pn_data_enter (data_);
+        pn_data_put_ulong (data_, corda (id_));
+        test::putList (data_, f_);
+        pn_data_exit (data_);
+    }
+
+}
+
+/******************************************************************************
+ *
+ * test::BlobBuilder
+ *
+ ******************************************************************************/
+
+test::BlobBuilder &
+test::
+BlobBuilder::composite (
+    const std::string & name_,
+    const std::string & fingerprint_,
+    const std::vector<FieldDef> & fields_,
+    const std::list<std::string> & provides_
+) {
+    m_types.emplace_back ([=](pn_data_t * data_) {
+        putCordaDescribed (
+            data_,
+            amqp::schema::descriptors::COMPOSITE_TYPE,
+            [&](pn_data_t * data_) {
+                putString (data_, name_);
+                pn_data_put_null (data_);
+                putList (data_, [&](pn_data_t * data_) {
+                    for (const auto & p : provides_) putString (data_, p);
+                });
+                putDescriptor (data_, fingerprint_);
+                putList (data_, [&](pn_data_t * data_) {
+                    for (const auto & f : fields_) {
+                        putCordaDescribed (
+                            data_,
+                            amqp::schema::descriptors::FIELD,
+                            [&f](pn_data_t * data_) {
+                                putString (data_, f.name);
+                                putString (data_, f.type);
+                                putList (data_, [&f](pn_data_t * data_) {
+                                    for (const auto & r : f.requires) {
+                                        putString (data_, r);
+                                    }
+                                });
+                                pn_data_put_null (data_);
+                                pn_data_put_null (data_);
+                                pn_data_put_bool (data_, f.mandatory);
+                                pn_data_put_bool (data_, false);
+                            });
+                    }
+                });
+            });
+    });
+
+    return *this;
+}
+
+/******************************************************************************/
+
+test::BlobBuilder &
+test::
+BlobBuilder::restricted (
+    const std::string & name_,
+    const std::string & fingerprint_,
+    const std::string & source_,
+    const std::vector<std::string> & choices_
+) {
+    m_types.emplace_back ([=](pn_data_t * data_) {
+        putCordaDescribed (
+            data_,
+            amqp::schema::descriptors::RESTRICTED_TYPE,
+            [&](pn_data_t * data_) {
+                putString (data_, name_);
+                pn_data_put_null (data_);
+                putList (data_, [](pn_data_t *) { });
+                putString (data_, source_);
+                putDescriptor (data_, fingerprint_);
+                putList (data_, [&](pn_data_t * data_) {
+                    for (const auto & c : choices_) {
+                        putCordaDescribed (
+                            data_,
+                            amqp::schema::descriptors::CHOICE,
+                            [&c](pn_data_t * data_) {
+                                putString (data_, c);
+                            });
+                    }
+                });
+            });
+    });
+
+    return *this;
+}
+
+/******************************************************************************/
+
+test::BlobBuilder &
+test::
+BlobBuilder::enumDefault (
+    const std::string & type_,
+    const std::string & old_,
+    const std::string & new_
+) {
+    m_transforms[type_].push_back ({ 1, "EnumDefault", old_, new_ });
+
+    return *this;
+}
+
+/******************************************************************************/
+
+test::BlobBuilder &
+test::
+BlobBuilder::rename (
+    const std::string & type_,
+    const std::string & from_,
+    const std::string & to_
+) {
+    m_transforms[type_].push_back ({ 2, "Rename", from_, to_ });
+
+    return *this;
+}
+
+/******************************************************************************/
+
+std::vector<char>
+test::
+BlobBuilder::build (
+    const std::string & fingerprint_,
+    const Writer & payload_
+) const {
+    auto data = pn_data (0);
+
+    putCordaDescribed (
+        data,
+        amqp::schema::descriptors::ENVELOPE,
+        [&](pn_data_t * data_) {
+            // the object
+            putDescribed (data_, fingerprint_, payload_);
+
+            // the schema, a list of lists of type notations
+            putCordaDescribed (
+                data_,
+                amqp::schema::descriptors::SCHEMA,
+                [this](pn_data_t * data_) {
+                    putList (data_, [this](pn_data_t * data_) {
+                        for (const auto & t : m_types) t (data_);
+                    });
+                });
+
+            // and the transforms schema, a map of type to a map of
+            // each kind of transform to a list of them
+            pn_data_put_described (data_);
+            pn_data_enter (data_);
+            pn_data_put_ulong (
+                data_,
+                corda (amqp::schema::descriptors::TRANSFORM_SCHEMA));
+            putMap (data_, [this](pn_data_t * data_) {
+                for (const auto & type : m_transforms) {
+                    putString (data_, type.first);
+                    putMap (data_, [&type](pn_data_t * data_) {
+                        for (int kind : { 1, 2 }) {
+                            if (std::none_of (
+                                    type.second.begin(),
+                                    type.second.end(),
+                                    [kind](const Transform & t_) { return t_.kind == kind; }))
+                            {
+                                continue;
+                            }
+
+                            pn_data_put_described (data_);
+                            pn_data_enter (data_);
+                            pn_data_put_ulong (
+                                data_,
+                                corda (amqp::schema::descriptors::TRANSFORM_ELEMENT_KEY));
+                            pn_data_put_int (data_, kind);
+                            pn_data_exit (data_);
+
+                            putList (data_, [&type, kind](pn_data_t * data_) {
+                                for (const auto & t : type.second) {
+                                    if (t.kind != kind) continue;
+
+                                    putCordaDescribed (
+                                        data_,
+                                        amqp::schema::descriptors::TRANSFORM_ELEMENT,
+                                        [&t](pn_data_t * data_) {
+                                            putString (data_, t.name);
+                                            putString (data_, t.first);
+                                            putString (data_, t.second);
+                                        });
+                                }
+                            });
+                        }
+                    });
+                }
+            });
+            pn_data_exit (data_);
+        });
+
+    std::vector<char> rtn (amqp::AMQP_HEADER.begin(), amqp::AMQP_HEADER.end());
+    rtn.push_back (amqp::DATA_AND_STOP);
+
+    auto header = rtn.size();
+
+    for (size_t size { 4096 } ; ; size *= 2) {
+        rtn.resize (header + size);
+
+        auto encoded = pn_data_encode (data, rtn.data() + header, size);
+
+        if (encoded >= 0) {
+            rtn.resize (header + encoded);
+            break;
+        } else if (size > (1UL << 30)) {
+            pn_data_free (data);
+            throw std::runtime_error ("Failed to encode test blob");
+        }
+    }
+
+    pn_data_free (data);
+
+    return rtn;
+}
+
+/******************************************************************************
+ *
+ * Payload helpers
+ *
+ ******************************************************************************/
+
+void
+test::putDescribed (
+    pn_data_t * data_,
+    const std::string & fingerprint_,
+    const std::function<void (pn_data_t *)> & f_
+) {
+    pn_data_put_described (data_);
+    pn_data_enter (data_);
+    putSymbol (data_, fingerprint_);
+    f_ (data_);
+    pn_data_exit (data_);
+}
+
+/******************************************************************************/
+
+void
+test::putList (
+    pn_data_t * data_,
+    const std::function<void (pn_data_t *)> & f_
+) {
+    pn_data_put_list (data_);
+    pn_data_enter (data_);
+    f_ (data_);
+    pn_data_exit (data_);
+}
+
+/******************************************************************************/
+
+void
+test::putMap (
+    pn_data_t * data_,
+    const std::function<void (pn_data_t *)> & f_
+) {
+    pn_data_put_map (data_);
+    pn_data_enter (data_);
+    f_ (data_);
+    pn_data_exit (data_);
+}
+
+/******************************************************************************/
+
+void
+test::putString (pn_data_t * data_, const std::string & str_) {
+    pn_data_put_string (data_, pn_bytes (str_.size(), str_.data()));
+}
+
+/******************************************************************************/
+
+void
+test::putSymbol (pn_data_t * data_, const std::string & str_) {
+    pn_data_put_symbol (data_, pn_bytes (str_.size(), str_.data()));
+}
+
+/******************************************************************************/
+
+void
+test::putEnum (
+    pn_data_t * data_,
+    const std::string & fingerprint_,
+    const std::string & constant_,
+    int ordinal_
+) {
+    putDescribed (data_, fingerprint_, [&](pn_data_t * data_) {
+        putList (data_, [&](pn_data_t * data_) {
+            putString (data_, constant_);
+            pn_data_put_int (data_, ordinal_);
+        });
+    });
+}
+
+/******************************************************************************/
+
+std::string
+test::toFile (const std::vector<char> & blob_) {
+    static int count { 0 };
+
+    auto path = std::filesystem::temp_directory_path() / (
+        "corda-test-blob-"
+            + std::to_string (::getpid())
+            + "-"
+            + std::to_string (count++));
+
+    std::ofstream file { path, std::ios::out | std::ios::binary };
+    file.write (blob_.data(), blob_.size());
+
+    return path.string();
+}
+
+/******************************************************************************/
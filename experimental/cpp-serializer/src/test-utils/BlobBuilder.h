@@ -0,0 +1,132 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <list>
+#include <string>
+#include <vector>
+#include <functional>
+
+/******************************************************************************/
+
+struct pn_data_t;
+
+/******************************************************************************/
+
+/**
+ * Builds synthetic Corda blobs so tests aren't limited to the handful of
+ * fixtures the JVM blob writer produced for us. Types are added to the
+ * schema one at a time and the payload is written by a callback using
+ * the put helpers below, e.g.
+ *
+ *      test::BlobBuilder bb;
+ *
+ *      bb.composite ("net.corda.A", "net.corda:A", { { "a", "int" } });
+ *
+ *      auto blob = bb.build ("net.corda:A", [](pn_data_t * data_) {
+ *          test::putList (data_, [](pn_data_t * data_) {
+ *              pn_data_put_int (data_, 1);
+ *          });
+ *      });
+ *
+ * The result includes the Corda header and section id so can be written
+ * straight to disk or handed to anything that consumes a blob.
+ */
+namespace test {
+
+    struct FieldDef {
+        std::string            name;
+        std::string            type;
+        std::list<std::string> requires { };
+        bool                   mandatory { true };
+    };
+
+    class BlobBuilder {
+        private :
+            using Writer = std::function<void (pn_data_t *)>;
+
+            struct Transform {
+                int         kind;
+                std::string name;
+                std::string first;
+                std::string second;
+            };
+
+            std::vector<Writer> m_types;
+            std::map<std::string, std::vector<Transform>> m_transforms;
+
+        public :
+            /**
+             * Add a composite (class) type to the schema
+             */
+            BlobBuilder & composite (
+                const std::string & name_,
+                const std::string & fingerprint_,
+                const std::vector<FieldDef> & fields_,
+                const std::list<std::string> & provides_ = { });
+
+            /**
+             * Add a restricted type (list, map or array, or an enum if
+             * choices are supplied) to the schema
+             */
+            BlobBuilder & restricted (
+                const std::string & name_,
+                const std::string & fingerprint_,
+                const std::string & source_,
+                const std::vector<std::string> & choices_ = { });
+
+            /**
+             * Record that constant [new_] was added to enum [type_] and
+             * readers that don't know it should use [old_]
+             */
+            BlobBuilder & enumDefault (
+                const std::string & type_,
+                const std::string & old_,
+                const std::string & new_);
+
+            /**
+             * Record that constant [from_] of enum [type_] was renamed [to_]
+             */
+            BlobBuilder & rename (
+                const std::string & type_,
+                const std::string & from_,
+                const std::string & to_);
+
+            /**
+             * @return the encoded blob with [fingerprint_] as the outer
+             * type and [payload_] responsible for writing its value
+             */
+            std::vector<char> build (
+                const std::string & fingerprint_,
+                const Writer & payload_) const;
+    };
+
+    /*
+     * Payload helpers, each wraps the enter / exit dance proton requires
+     * when writing compound types
+     */
+    void putDescribed (
+        pn_data_t *,
+        const std::string &,
+        const std::function<void (pn_data_t *)> &);
+
+    void putList (pn_data_t *, const std::function<void (pn_data_t *)> &);
+    void putMap (pn_data_t *, const std::function<void (pn_data_t *)> &);
+    void putString (pn_data_t *, const std::string &);
+    void putSymbol (pn_data_t *, const std::string &);
+
+    /**
+     * An enum value as the JVM writes it, the constant's name and its
+     * ordinal wrapped up in a described list
+     */
+    void putEnum (pn_data_t *, const std::string &, const std::string &, int);
+
+    /**
+     * Write a blob to a uniquely named temporary file, returning its path
+     */
+    std::string toFile (const std::vector<char> &);
+
+}
+
+/******************************************************************************/